@@ -0,0 +1,219 @@
+// benchmarks/bench_mprpc.cpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+// frame::mprpc request/response latency and throughput over loopback TCP
+// and over the in-process local transport
+//
+
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v2.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+#include "solid/frame/mprpc/mprpcsocketstub_local.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+using namespace solid;
+using namespace std;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mprpc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+atomic<size_t> response_count{0};
+
+enum struct TransportE {
+    Tcp,
+    InProcess,
+};
+
+struct Message : frame::mprpc::Message {
+    std::string str;
+
+    Message(const size_t _size)
+        : str(_size, 'a')
+    {
+    }
+
+    Message() {}
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.str, _rctx, "str");
+    }
+};
+
+void client_complete_message(
+    frame::mprpc::ConnectionContext& /*_rctx*/,
+    std::shared_ptr<Message>& /*_rsent_msg_ptr*/, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message error: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        response_count.fetch_add(1, memory_order_release);
+    }
+}
+
+//the server answers with an empty message so only the request size varies
+void server_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& /*_rsent_msg_ptr*/, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& /*_rerror*/)
+{
+    if (!_rrecv_msg_ptr) {
+        return;
+    }
+    _rrecv_msg_ptr->str.clear();
+    ErrorConditionT err = _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+    solid_check(!err, "sendResponse: " << err.message());
+}
+
+void wait_for(const size_t _value)
+{
+    while (response_count.load(memory_order_acquire) < _value) {
+        this_thread::yield();
+    }
+}
+
+//! A client and a server service, each on its own reactor thread
+struct Environment {
+    AioSchedulerT          sch_client_;
+    AioSchedulerT          sch_server_;
+    frame::Manager         manager_;
+    frame::mprpc::ServiceT mprpcserver_{manager_};
+    frame::mprpc::ServiceT mprpcclient_{manager_};
+    CallPool<void()>       cwp_{WorkPoolConfiguration(), 1};
+    frame::aio::Resolver   resolver_{cwp_};
+    size_t                 sent_count_ = 0;
+
+    Environment(const TransportE _transport)
+    {
+        response_count = 0;
+
+        sch_client_.start(1);
+        sch_server_.start(1);
+
+        std::string server_port;
+
+        {
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_server_, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(server_complete_message, 1);
+
+            cfg.server.connection_start_state = frame::mprpc::ConnectionState::Active;
+
+            if (_transport == TransportE::Tcp) {
+                cfg.server.listener_address_str = "127.0.0.1:0";
+            }
+
+            mprpcserver_.start(std::move(cfg));
+
+            std::ostringstream oss;
+            oss << mprpcserver_.configuration().server.listenerPort();
+            server_port = oss.str();
+        }
+        {
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_client_, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(client_complete_message, 1);
+
+            cfg.client.connection_start_state = frame::mprpc::ConnectionState::Active;
+
+            if (_transport == TransportE::Tcp) {
+                cfg.client.name_resolve_fnc = frame::mprpc::InternetResolverF(resolver_, server_port.c_str(), SocketInfo::Inet4);
+            } else {
+                frame::mprpc::local::setup_client(cfg, mprpcserver_);
+            }
+
+            mprpcclient_.start(std::move(cfg));
+        }
+
+        //the first request also opens the connection
+        send(1, 16);
+    }
+
+    ~Environment()
+    {
+        manager_.stop();
+    }
+
+    void send(const size_t _count, const size_t _size)
+    {
+        for (size_t i = 0; i < _count; ++i) {
+            ErrorConditionT err = mprpcclient_.sendRequest("127.0.0.1", std::make_shared<Message>(_size), client_complete_message);
+            solid_check(!err, "sendRequest: " << err.message());
+        }
+        sent_count_ += _count;
+        wait_for(sent_count_);
+    }
+
+    void report(benchmark::State& _rstate) const
+    {
+        Histogram h;
+        mprpcclient_.statistic().latency(frame::mprpc::LatencyStageE::SentToResponse, h);
+        _rstate.counters["sent_to_response_p50_ns"] = static_cast<double>(h.percentile(50));
+        _rstate.counters["sent_to_response_p99_ns"] = static_cast<double>(h.percentile(99));
+    }
+};
+
+//range(0) - request size, one request in flight
+void BM_RequestLatency(benchmark::State& _rstate, const TransportE _transport)
+{
+    Environment  env(_transport);
+    const size_t size = static_cast<size_t>(_rstate.range(0));
+
+    for (auto _ : _rstate) {
+        env.send(1, size);
+    }
+    _rstate.SetItemsProcessed(_rstate.iterations());
+    _rstate.SetBytesProcessed(_rstate.iterations() * size);
+    env.report(_rstate);
+}
+
+//range(0) - request size, range(1) - requests in flight
+void BM_RequestThroughput(benchmark::State& _rstate, const TransportE _transport)
+{
+    Environment  env(_transport);
+    const size_t size   = static_cast<size_t>(_rstate.range(0));
+    const size_t window = static_cast<size_t>(_rstate.range(1));
+
+    for (auto _ : _rstate) {
+        env.send(window, size);
+    }
+    _rstate.SetItemsProcessed(_rstate.iterations() * window);
+    _rstate.SetBytesProcessed(_rstate.iterations() * window * size);
+    env.report(_rstate);
+}
+
+BENCHMARK_CAPTURE(BM_RequestLatency, tcp, TransportE::Tcp)->Name("mprpc/request/latency")->Arg(64)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(1024 * 1024)->UseRealTime();
+BENCHMARK_CAPTURE(BM_RequestThroughput, tcp, TransportE::Tcp)->Name("mprpc/request/throughput")->Args({64, 64})->Args({4 * 1024, 64})->Args({64 * 1024, 16})->Args({1024 * 1024, 4})->UseRealTime();
+BENCHMARK_CAPTURE(BM_RequestLatency, local, TransportE::InProcess)->Name("mprpc/local/request/latency")->Arg(64)->Arg(64 * 1024)->Arg(1024 * 1024)->UseRealTime();
+BENCHMARK_CAPTURE(BM_RequestThroughput, local, TransportE::InProcess)->Name("mprpc/local/request/throughput")->Args({64, 64})->Args({64 * 1024, 16})->Args({1024 * 1024, 4})->UseRealTime();
+
+} //namespace
+
+BENCHMARK_MAIN();
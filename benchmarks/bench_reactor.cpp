@@ -0,0 +1,392 @@
+// benchmarks/bench_reactor.cpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+// frame::aio::Reactor event dispatch, timer churn and socket dispatch over
+// big completion handler tables
+//
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+
+using namespace solid;
+using namespace std;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+enum struct BenchEvents {
+    Ping,
+    TimerChurn,
+    TimerFire,
+    Dispatch,
+};
+
+const EventCategory<BenchEvents> bench_event_category{
+    "bench_event_category",
+    [](const BenchEvents _evt) {
+        switch (_evt) {
+        case BenchEvents::Ping:
+            return "ping";
+        case BenchEvents::TimerChurn:
+            return "timer_churn";
+        case BenchEvents::TimerFire:
+            return "timer_fire";
+        case BenchEvents::Dispatch:
+            return "dispatch";
+        default:
+            return "unknown";
+        }
+    }};
+
+void wait_for(const atomic<size_t>& _rcount, const size_t _value)
+{
+    while (_rcount.load(memory_order_acquire) < _value) {
+        this_thread::yield();
+    }
+}
+
+//! Counts the handled events, arms and cancels its timers on request
+class Actor final : public frame::aio::Actor {
+public:
+    Actor(atomic<size_t>& _rdone_count, const size_t _timer_count)
+        : rdone_count_(_rdone_count)
+    {
+        for (size_t i = 0; i < _timer_count; ++i) {
+            timer_dq_.emplace_back(this->proxy());
+        }
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        static const EventHandler<void, Actor&, frame::aio::ReactorContext&> event_handler = {
+            [](Event& _revt, Actor& _ractor, frame::aio::ReactorContext& _rctx) {
+                if (_revt == generic_event_kill) {
+                    _ractor.postStop(_rctx);
+                }
+            },
+            {{bench_event_category.event(BenchEvents::Ping),
+                 [](Event& /*_revt*/, Actor& _ractor, frame::aio::ReactorContext& /*_rctx*/) {
+                     _ractor.done();
+                 }},
+                {bench_event_category.event(BenchEvents::TimerChurn),
+                    [](Event& /*_revt*/, Actor& _ractor, frame::aio::ReactorContext& _rctx) {
+                        _ractor.onTimerChurn(_rctx);
+                    }},
+                {bench_event_category.event(BenchEvents::TimerFire),
+                    [](Event& _revt, Actor& _ractor, frame::aio::ReactorContext& _rctx) {
+                        _ractor.fire_count_ = *_revt.any().cast<size_t>();
+                        _ractor.onTimerFire(_rctx);
+                    }}}};
+
+        event_handler.handle(_revent, *this, _rctx);
+    }
+
+    void done()
+    {
+        rdone_count_.fetch_add(1, memory_order_release);
+    }
+
+    //every timer is armed far in the future then canceled - e.g. request timeouts
+    void onTimerChurn(frame::aio::ReactorContext& _rctx)
+    {
+        for (auto& rtimer : timer_dq_) {
+            rtimer.waitFor(_rctx, chrono::hours(1), [](frame::aio::ReactorContext& _rctx) {
+                solid_check(_rctx.error(), "timer fired");
+            });
+        }
+        for (auto& rtimer : timer_dq_) {
+            rtimer.cancel(_rctx);
+        }
+        done();
+    }
+
+    void onTimerFire(frame::aio::ReactorContext& _rctx)
+    {
+        if (fire_count_ == 0) {
+            done();
+            return;
+        }
+        --fire_count_;
+        timer_dq_.front().waitFor(_rctx, chrono::nanoseconds(0), [this](frame::aio::ReactorContext& _rctx) {
+            onTimerFire(_rctx);
+        });
+    }
+
+private:
+    using TimerDequeT = std::deque<frame::aio::SteadyTimer>;
+
+    atomic<size_t>& rdone_count_;
+    TimerDequeT     timer_dq_;
+    size_t          fire_count_ = 0;
+};
+
+//! One reactor thread with one Actor
+struct Environment {
+    AioSchedulerT   scheduler_;
+    frame::Manager  manager_;
+    frame::ServiceT service_{manager_};
+    atomic<size_t>  done_count_{0};
+    frame::ActorIdT actor_id_;
+
+    Environment(const size_t _timer_count = 0)
+    {
+        ErrorConditionT err;
+        scheduler_.start(1);
+        actor_id_ = scheduler_.startActor(make_dynamic<Actor>(done_count_, _timer_count), service_, make_event(GenericEvents::Start), err);
+        solid_check(!err, "starting actor: " << err.message());
+    }
+
+    ~Environment()
+    {
+        manager_.stop();
+    }
+
+    void notify(Event&& _uevent)
+    {
+        solid_check(manager_.notify(actor_id_, std::move(_uevent)));
+    }
+};
+
+//! One end of a loopback ping-pong connection
+/*!
+ * Besides its stream it registers _filler_count idle timers onto the
+ * reactor, so that the few active completion handlers are spread over
+ * a big completion handler table.
+ * The client end (_pdone_count != nullptr) runs the round trips asked
+ * by a Dispatch event.
+ */
+class Peer final : public frame::aio::Actor {
+public:
+    Peer(SocketDevice&& _rsd, const size_t _filler_count, atomic<size_t>* _pdone_count)
+        : sock_(this->proxy(), std::move(_rsd))
+        , pdone_count_(_pdone_count)
+    {
+        for (size_t i = 0; i < _filler_count; ++i) {
+            timer_dq_.emplace_back(this->proxy());
+        }
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_start) {
+            sock_.device().enableNoDelay();
+            if (pdone_count_ == nullptr) {
+                sock_.postRecvSome(_rctx, buf_, sizeof(buf_), Peer::onRecv);
+            }
+        } else if (_revent == generic_event_kill) {
+            postStop(_rctx);
+        } else if (_revent == bench_event_category.event(BenchEvents::Dispatch)) {
+            roundtrip_count_ = *_revent.any().cast<size_t>();
+            crt_count_       = 0;
+            sock_.postSendAll(_rctx, buf_, 1, Peer::onSend);
+        }
+    }
+
+    static void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        Peer& rthis = static_cast<Peer&>(_rctx.actor());
+        solid_check(!_rctx.error(), "send: " << _rctx.systemError().message());
+        rthis.sock_.postRecvSome(_rctx, rthis.buf_, sizeof(rthis.buf_), Peer::onRecv);
+    }
+
+    static void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        Peer& rthis = static_cast<Peer&>(_rctx.actor());
+        if (_rctx.error()) {
+            rthis.postStop(_rctx);
+            return;
+        }
+        if (rthis.pdone_count_ != nullptr && ++rthis.crt_count_ == rthis.roundtrip_count_) {
+            rthis.pdone_count_->fetch_add(1, memory_order_release);
+            return;
+        }
+        rthis.sock_.postSendAll(_rctx, rthis.buf_, _sz, Peer::onSend);
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+    using TimerDequeT   = std::deque<frame::aio::SteadyTimer>;
+
+    StreamSocketT   sock_;
+    TimerDequeT     timer_dq_;
+    atomic<size_t>* pdone_count_;
+    size_t          roundtrip_count_ = 0;
+    size_t          crt_count_       = 0;
+    char            buf_[16];
+};
+
+//! One reactor thread with _pair_count connected Peer pairs
+struct DispatchEnvironment {
+    using ActorIdVectorT = std::vector<frame::ActorIdT>;
+
+    AioSchedulerT   scheduler_;
+    frame::Manager  manager_;
+    frame::ServiceT service_{manager_};
+    atomic<size_t>  done_count_{0};
+    ActorIdVectorT  client_id_vec_;
+
+    DispatchEnvironment(const size_t _handler_count, const size_t _pair_count)
+    {
+        ErrorConditionT err;
+        SocketDevice    listener;
+        ResolveData     rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Stream);
+
+        listener.create(rd.begin());
+        solid_check(!listener.prepareAccept(rd.begin(), _pair_count + 1), "listen failed");
+
+        SocketAddress local_address;
+        listener.localAddress(local_address);
+
+        ResolveData crd = synchronous_resolve("127.0.0.1", local_address.port(), 0, SocketInfo::Inet4, SocketInfo::Stream);
+
+        scheduler_.start(1);
+
+        const size_t filler_count = _handler_count / (2 * _pair_count);
+
+        for (size_t i = 0; i < _pair_count; ++i) {
+            SocketDevice client;
+            SocketDevice server;
+
+            client.create(crd.begin());
+            solid_check(!client.connect(crd.begin()), "connect failed");
+            solid_check(!listener.accept(server), "accept failed");
+
+            client.makeNonBlocking();
+            server.makeNonBlocking();
+
+            scheduler_.startActor(make_dynamic<Peer>(std::move(server), filler_count, nullptr), service_, make_event(GenericEvents::Start), err);
+            solid_check(!err, "start server peer: " << err.message());
+
+            client_id_vec_.emplace_back(scheduler_.startActor(make_dynamic<Peer>(std::move(client), filler_count, &done_count_), service_, make_event(GenericEvents::Start), err));
+            solid_check(!err, "start client peer: " << err.message());
+        }
+    }
+
+    ~DispatchEnvironment()
+    {
+        manager_.stop();
+    }
+
+    void dispatch(const size_t _roundtrip_count)
+    {
+        for (const auto& ractor_id : client_id_vec_) {
+            solid_check(manager_.notify(ractor_id, bench_event_category.event(BenchEvents::Dispatch, _roundtrip_count)));
+        }
+    }
+};
+
+//raise-to-handler round trip: one event in flight
+void BM_EventPingPong(benchmark::State& _rstate)
+{
+    Environment env;
+    size_t      sent_count = 0;
+
+    for (auto _ : _rstate) {
+        env.notify(bench_event_category.event(BenchEvents::Ping));
+        wait_for(env.done_count_, ++sent_count);
+    }
+    _rstate.SetItemsProcessed(sent_count);
+}
+
+//range(0) - events raised before waiting for the reactor to drain them
+void BM_EventNotify(benchmark::State& _rstate)
+{
+    Environment  env;
+    const size_t batch_size = static_cast<size_t>(_rstate.range(0));
+    size_t       sent_count = 0;
+
+    for (auto _ : _rstate) {
+        for (size_t i = 0; i < batch_size; ++i) {
+            env.notify(bench_event_category.event(BenchEvents::Ping));
+        }
+        sent_count += batch_size;
+        wait_for(env.done_count_, sent_count);
+    }
+    _rstate.SetItemsProcessed(sent_count);
+}
+
+//range(0) - timers armed and canceled per iteration
+void BM_TimerChurn(benchmark::State& _rstate)
+{
+    const size_t timer_count = static_cast<size_t>(_rstate.range(0));
+    Environment  env(timer_count);
+    size_t       sent_count = 0;
+
+    for (auto _ : _rstate) {
+        env.notify(bench_event_category.event(BenchEvents::TimerChurn));
+        wait_for(env.done_count_, ++sent_count);
+    }
+    _rstate.SetItemsProcessed(sent_count * timer_count);
+}
+
+//range(0) - expired timers handled per iteration, one at a time
+void BM_TimerFire(benchmark::State& _rstate)
+{
+    const size_t fire_count = static_cast<size_t>(_rstate.range(0));
+    Environment  env(1);
+    size_t       sent_count = 0;
+
+    for (auto _ : _rstate) {
+        env.notify(bench_event_category.event(BenchEvents::TimerFire, fire_count));
+        wait_for(env.done_count_, ++sent_count);
+    }
+    _rstate.SetItemsProcessed(sent_count * fire_count);
+}
+
+//range(0) - completion handlers registered on the reactor, 16 connection pairs
+//each running 100 round trips per iteration
+void BM_Dispatch(benchmark::State& _rstate)
+{
+    constexpr size_t    pair_count      = 16;
+    constexpr size_t    roundtrip_count = 100;
+    DispatchEnvironment env(static_cast<size_t>(_rstate.range(0)), pair_count);
+    size_t              sent_count = 0;
+
+    for (auto _ : _rstate) {
+        env.dispatch(roundtrip_count);
+        sent_count += pair_count;
+        wait_for(env.done_count_, sent_count);
+    }
+    _rstate.SetItemsProcessed(sent_count * roundtrip_count * 2);
+}
+
+BENCHMARK(BM_EventPingPong)->Name("reactor/event/ping-pong")->UseRealTime();
+BENCHMARK(BM_EventNotify)->Name("reactor/event/notify")->Arg(16)->Arg(1024)->UseRealTime();
+BENCHMARK(BM_TimerChurn)->Name("reactor/timer/churn")->Arg(16)->Arg(1024)->UseRealTime();
+BENCHMARK(BM_TimerFire)->Name("reactor/timer/fire")->Arg(1024)->UseRealTime();
+BENCHMARK(BM_Dispatch)->Name("reactor/dispatch")->Arg(1000)->Arg(100000)->UseRealTime();
+
+} //namespace
+
+BENCHMARK_MAIN();
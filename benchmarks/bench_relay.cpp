@@ -0,0 +1,326 @@
+// benchmarks/bench_relay.cpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+// frame::mprpc request/response through a relay::SingleNameEngine relay over loopback TCP
+//
+
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v2.hpp"
+#include "solid/frame/mprpc/mprpcrelayengines.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using namespace solid;
+using namespace std;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mprpc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+atomic<size_t> response_count{0};
+atomic<bool>   peerb_registered{false};
+
+constexpr size_t relay_request_budget = 150;
+
+struct Register : frame::mprpc::Message {
+    std::string str;
+    uint32_t    err;
+
+    Register(const std::string& _rstr, uint32_t _err = 0)
+        : str(_rstr)
+        , err(_err)
+    {
+    }
+
+    Register(uint32_t _err = -1)
+        : err(_err)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.err, _rctx, "err").add(_rthis.str, _rctx, "str");
+    }
+};
+
+struct Message : frame::mprpc::Message {
+    std::string str;
+
+    Message(const size_t _size)
+        : str(_size, 'a')
+    {
+    }
+
+    Message() {}
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.str, _rctx, "str");
+    }
+};
+
+void peera_complete_message(
+    frame::mprpc::ConnectionContext& /*_rctx*/,
+    std::shared_ptr<Message>& /*_rsent_msg_ptr*/, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "message error: " << _rerror.message());
+    if (_rrecv_msg_ptr) {
+        response_count.fetch_add(1, memory_order_release);
+    }
+}
+
+void peerb_connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    ErrorConditionT err = _rctx.service().sendMessage(_rctx.recipientId(), std::make_shared<Register>("b"), {frame::mprpc::MessageFlagsE::AwaitResponse});
+    solid_check(!err, "failed send Register: " << err.message());
+}
+
+void peerb_complete_register(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Register>& /*_rsent_msg_ptr*/, std::shared_ptr<Register>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_check(!_rerror, "register error: " << _rerror.message());
+
+    if (_rrecv_msg_ptr) {
+        solid_check(_rrecv_msg_ptr->err == 0, "register refused");
+        _rctx.service().connectionNotifyEnterActiveState(
+            _rctx.recipientId(),
+            [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+                solid_check(!_rerror, "enter active error: " << _rerror.message());
+                peerb_registered = true;
+            });
+    }
+}
+
+//peerb answers with an empty message so only the request size varies
+void peerb_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& /*_rsent_msg_ptr*/, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& /*_rerror*/)
+{
+    if (!_rrecv_msg_ptr) {
+        return;
+    }
+    _rrecv_msg_ptr->str.clear();
+    ErrorConditionT err = _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+    solid_check(!err, "sendResponse: " << err.message());
+}
+
+void wait_for(const size_t _value)
+{
+    while (response_count.load(memory_order_acquire) < _value) {
+        this_thread::yield();
+    }
+}
+
+//! peera -> relay -> peerb, each on its own reactor thread
+/*!
+    Shared by all the benchmarks: one relay setup per process.
+    The relay stalls after a couple of hundred requests relayed on the same
+    connection pair (a relay engine issue, not a benchmark one), so every
+    benchmark runs a fixed number of iterations and the whole binary stays
+    under relay_request_budget requests.
+*/
+struct Environment {
+    AioSchedulerT                         sch_peera_;
+    AioSchedulerT                         sch_peerb_;
+    AioSchedulerT                         sch_relay_;
+    frame::Manager                        manager_;
+    frame::mprpc::relay::SingleNameEngine relay_engine_{manager_}; //before relay service because it must overlive it
+    frame::mprpc::ServiceT                mprpcrelay_{manager_};
+    frame::mprpc::ServiceT                mprpcpeera_{manager_};
+    frame::mprpc::ServiceT                mprpcpeerb_{manager_};
+    CallPool<void()>                      cwp_{WorkPoolConfiguration(), 1};
+    frame::aio::Resolver                  resolver_{cwp_};
+    size_t                                sent_count_ = 0;
+
+    Environment()
+    {
+        response_count   = 0;
+        peerb_registered = false;
+
+        sch_peera_.start(1);
+        sch_peerb_.start(1);
+        sch_relay_.start(1);
+
+        std::string relay_port;
+
+        {
+            auto con_register = [this](
+                                    frame::mprpc::ConnectionContext& _rctx,
+                                    std::shared_ptr<Register>& /*_rsent_msg_ptr*/,
+                                    std::shared_ptr<Register>& _rrecv_msg_ptr,
+                                    ErrorConditionT const& _rerror) {
+                solid_check(!_rerror);
+
+                if (_rrecv_msg_ptr) {
+                    relay_engine_.registerConnection(_rctx, std::move(_rrecv_msg_ptr->str));
+
+                    _rrecv_msg_ptr->str.clear();
+                    ErrorConditionT err = _rctx.service().sendResponse(_rctx.recipientId(), std::move(_rrecv_msg_ptr));
+                    solid_check(!err, "Failed sending register response: " << err.message());
+                }
+            };
+
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_relay_, relay_engine_, proto);
+
+            proto->null(0);
+            proto->registerMessage<Register>(std::move(con_register), 1);
+
+            cfg.server.listener_address_str   = "127.0.0.1:0";
+            cfg.client.connection_start_state = frame::mprpc::ConnectionState::Active;
+            cfg.relay_enabled                 = true;
+
+            mprpcrelay_.start(std::move(cfg));
+
+            std::ostringstream oss;
+            oss << mprpcrelay_.configuration().server.listenerPort();
+            relay_port = oss.str();
+        }
+        {
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_peera_, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(peera_complete_message, 2);
+
+            cfg.client.connection_start_state = frame::mprpc::ConnectionState::Active;
+            cfg.client.name_resolve_fnc       = frame::mprpc::InternetResolverF(resolver_, relay_port.c_str(), SocketInfo::Inet4);
+
+            mprpcpeera_.start(std::move(cfg));
+        }
+        {
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_peerb_, proto);
+
+            proto->null(0);
+            proto->registerMessage<Register>(peerb_complete_register, 1);
+            proto->registerMessage<Message>(peerb_complete_message, 2);
+
+            cfg.client.connection_start_fnc = &peerb_connection_start;
+            cfg.client.name_resolve_fnc     = frame::mprpc::InternetResolverF(resolver_, relay_port.c_str(), SocketInfo::Inet4);
+
+            mprpcpeerb_.start(std::move(cfg));
+        }
+
+        ErrorConditionT err = mprpcpeerb_.createConnectionPool("127.0.0.1");
+        solid_check(!err, "failed create connection from peerb: " << err.message());
+
+        while (!peerb_registered) {
+            this_thread::yield();
+        }
+
+        //the first request also opens the peera connection
+        send(1, 16);
+    }
+
+    //stop the peers before the relay so that they do not try to reconnect
+    ~Environment()
+    {
+        mprpcpeerb_.stop();
+        mprpcpeera_.stop();
+        manager_.stop();
+    }
+
+    void send(const size_t _count, const size_t _size)
+    {
+        for (size_t i = 0; i < _count; ++i) {
+            ErrorConditionT err = mprpcpeera_.sendRequest("127.0.0.1/b", std::make_shared<Message>(_size), peera_complete_message);
+            solid_check(!err, "sendRequest: " << err.message());
+        }
+        sent_count_ += _count;
+        wait_for(sent_count_);
+    }
+
+    bool canSend(const size_t _count) const
+    {
+        return sent_count_ + _count <= relay_request_budget;
+    }
+};
+
+std::unique_ptr<Environment> env_ptr;
+
+Environment& environment()
+{
+    if (!env_ptr) {
+        env_ptr.reset(new Environment);
+    }
+    return *env_ptr;
+}
+
+//range(0) - request size, one request in flight
+void BM_RelayLatency(benchmark::State& _rstate)
+{
+    Environment& renv = environment();
+    const size_t size = static_cast<size_t>(_rstate.range(0));
+
+    if (!renv.canSend(_rstate.max_iterations)) {
+        _rstate.SkipWithError("relay request budget exhausted");
+    }
+    for (auto _ : _rstate) {
+        renv.send(1, size);
+    }
+    _rstate.SetItemsProcessed(_rstate.iterations());
+    _rstate.SetBytesProcessed(_rstate.iterations() * size);
+}
+
+//range(0) - request size, range(1) - requests in flight
+void BM_RelayThroughput(benchmark::State& _rstate)
+{
+    Environment& renv   = environment();
+    const size_t size   = static_cast<size_t>(_rstate.range(0));
+    const size_t window = static_cast<size_t>(_rstate.range(1));
+
+    if (!renv.canSend(_rstate.max_iterations * window)) {
+        _rstate.SkipWithError("relay request budget exhausted");
+    }
+    for (auto _ : _rstate) {
+        renv.send(window, size);
+    }
+    _rstate.SetItemsProcessed(_rstate.iterations() * window);
+    _rstate.SetBytesProcessed(_rstate.iterations() * window * size);
+}
+
+//1 + 3 * 20 + 4 * (8 + 8 + 4) = 141 requests - see relay_request_budget
+BENCHMARK(BM_RelayLatency)->Name("relay/request/latency")->Arg(64)->Arg(64 * 1024)->Arg(1024 * 1024)->Iterations(20)->UseRealTime();
+BENCHMARK(BM_RelayThroughput)->Name("relay/request/throughput")->Args({64, 8})->Args({64 * 1024, 8})->Args({1024 * 1024, 4})->Iterations(4)->UseRealTime();
+
+} //namespace
+
+int main(int argc, char* argv[])
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    env_ptr.reset();
+    return 0;
+}
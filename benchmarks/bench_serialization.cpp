@@ -0,0 +1,179 @@
+// benchmarks/bench_serialization.cpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+// Encode/decode throughput of serialization v1 vs v2 on the same record
+//
+
+#include "solid/serialization/v1/binary.hpp"
+#include "solid/serialization/v2/serialization.hpp"
+#include "solid/system/exception.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace solid;
+using namespace std;
+
+namespace {
+
+const size_t buffer_capacity = 4 * 1024; //the size of a mprpc packet
+
+struct Context {
+};
+
+struct TypeData {
+};
+
+struct Record {
+    string                name;
+    uint64_t              id = 0;
+    vector<uint64_t>      value_vec;
+    map<string, uint32_t> attribute_map;
+    string                blob;
+
+    void init(const size_t _blob_size)
+    {
+        name = "benchmark_record";
+        id   = 0x1234567890abcdefULL;
+        for (uint64_t i = 0; i < 32; ++i) {
+            value_vec.push_back(i * 0x9e3779b97f4a7c15ULL);
+        }
+        for (uint32_t i = 0; i < 8; ++i) {
+            attribute_map["attribute_" + to_string(i)] = i;
+        }
+        blob.assign(_blob_size, 'b');
+    }
+
+    bool operator==(const Record& _other) const
+    {
+        return name == _other.name && id == _other.id && value_vec == _other.value_vec && attribute_map == _other.attribute_map && blob == _other.blob;
+    }
+
+    template <class S>
+    void solidSerializeV1(S& _s)
+    {
+        _s.push(name, "name").push(id, "id").pushContainer(value_vec, "value_vec").pushContainer(attribute_map, "attribute_map").push(blob, "blob");
+    }
+
+    SOLID_SERIALIZE_CONTEXT_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.name, _rctx, "name").add(_rthis.id, _rctx, "id").add(_rthis.value_vec, _rctx, "value_vec").add(_rthis.attribute_map, _rctx, "attribute_map").add(_rthis.blob, _rctx, "blob");
+    }
+};
+
+using SerializerV1T   = serialization::binary::Serializer<void>;
+using DeserializerV1T = serialization::binary::Deserializer<void>;
+
+using TypeMapV2T      = serialization::v2::TypeMap<uint8_t, Context, serialization::v2::binary::Serializer, serialization::v2::binary::Deserializer, TypeData>;
+using SerializerV2T   = TypeMapV2T::SerializerT;
+using DeserializerV2T = TypeMapV2T::DeserializerT;
+
+const TypeMapV2T& type_map_v2()
+{
+    static const TypeMapV2T tm;
+    return tm;
+}
+
+size_t encode_v1(Record& _rrec, string& _rdata)
+{
+    SerializerV1T ser;
+    char          buf[buffer_capacity];
+    int           rv;
+    _rdata.clear();
+    ser.push(_rrec, "record");
+    while ((rv = ser.run(buf, buffer_capacity)) > 0) {
+        _rdata.append(buf, rv);
+    }
+    return _rdata.size();
+}
+
+size_t encode_v2(Record& _rrec, string& _rdata)
+{
+    Context       ctx;
+    SerializerV2T ser = type_map_v2().createSerializer();
+    char          buf[buffer_capacity];
+    _rdata.clear();
+    long rv = ser.run(
+        buf, buffer_capacity, [&_rrec](SerializerV2T& _rs, Context& _rctx) { _rs.add(_rrec, _rctx, "record"); }, ctx);
+    while (rv > 0) {
+        _rdata.append(buf, rv);
+        rv = ser.run(buf, buffer_capacity, ctx);
+    }
+    return _rdata.size();
+}
+
+void decode_v1(const string& _rdata, Record& _rrec)
+{
+    DeserializerV1T des;
+    des.push(_rrec, "record");
+    const size_t off = des.run(_rdata.data(), _rdata.size());
+    solid_check(off == _rdata.size(), "v1 decode failed");
+}
+
+void decode_v2(const string& _rdata, Record& _rrec)
+{
+    Context         ctx;
+    DeserializerV2T des = type_map_v2().createDeserializer();
+    const long      rv  = des.run(
+        _rdata.data(), _rdata.size(), [&_rrec](DeserializerV2T& _rd, Context& _rctx) { _rd.add(_rrec, _rctx, "record"); }, ctx);
+    solid_check(rv == static_cast<long>(_rdata.size()), "v2 decode failed");
+}
+
+template <size_t (*Encode)(Record&, string&)>
+void BM_Encode(benchmark::State& _rstate)
+{
+    Record rec;
+    string data;
+    rec.init(_rstate.range(0));
+    data.reserve(_rstate.range(0) + 1024);
+
+    for (auto _ : _rstate) {
+        benchmark::DoNotOptimize(Encode(rec, data));
+    }
+    _rstate.SetBytesProcessed(_rstate.iterations() * data.size());
+    _rstate.counters["encoded_size"] = static_cast<double>(data.size());
+}
+
+template <size_t (*Encode)(Record&, string&), void (*Decode)(const string&, Record&)>
+void BM_Decode(benchmark::State& _rstate)
+{
+    Record rec;
+    string data;
+    rec.init(_rstate.range(0));
+    Encode(rec, data);
+    {
+        Record check_rec;
+        Decode(data, check_rec);
+        solid_check(check_rec == rec, "decoded record differs");
+    }
+
+    for (auto _ : _rstate) {
+        Record rec;
+        Decode(data, rec);
+        benchmark::DoNotOptimize(rec.id);
+    }
+    _rstate.SetBytesProcessed(_rstate.iterations() * data.size());
+}
+
+void record_sizes(benchmark::internal::Benchmark* _pb)
+{
+    _pb->Arg(0)->Arg(256)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+}
+
+BENCHMARK_TEMPLATE(BM_Encode, encode_v1)->Name("serialization/v1/encode")->Apply(record_sizes);
+BENCHMARK_TEMPLATE(BM_Encode, encode_v2)->Name("serialization/v2/encode")->Apply(record_sizes);
+BENCHMARK_TEMPLATE(BM_Decode, encode_v1, decode_v1)->Name("serialization/v1/decode")->Apply(record_sizes);
+BENCHMARK_TEMPLATE(BM_Decode, encode_v2, decode_v2)->Name("serialization/v2/decode")->Apply(record_sizes);
+
+} //namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,115 @@
+// benchmarks/bench_workpool.cpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+// Job throughput of the lock-free and the locking WorkPool and of CallPool
+//
+
+#include "solid/system/log.hpp"
+#include "solid/utility/workpool.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace solid;
+using namespace std;
+
+namespace {
+
+const size_t batch_size = 10000;
+
+void wait_for(const atomic<size_t>& _rcount, const size_t _value)
+{
+    while (_rcount.load(memory_order_acquire) < _value) {
+        this_thread::yield();
+    }
+}
+
+//range(0) - worker count
+template <class WorkPoolT, class ConfigurationT>
+void BM_WorkPool(benchmark::State& _rstate)
+{
+    atomic<size_t> done_count{0};
+    WorkPoolT      wp{
+        ConfigurationT(), static_cast<size_t>(_rstate.range(0)),
+        [&done_count](const size_t _v) {
+            benchmark::DoNotOptimize(_v);
+            done_count.fetch_add(1, memory_order_release);
+        }};
+    size_t pushed_count = 0;
+
+    for (auto _ : _rstate) {
+        for (size_t i = 0; i < batch_size; ++i) {
+            wp.push(i);
+        }
+        pushed_count += batch_size;
+        wait_for(done_count, pushed_count);
+    }
+    _rstate.SetItemsProcessed(pushed_count);
+}
+
+void BM_CallPool(benchmark::State& _rstate)
+{
+    atomic<size_t>   done_count{0};
+    CallPool<void()> cp{WorkPoolConfiguration(), static_cast<size_t>(_rstate.range(0))};
+    size_t           pushed_count = 0;
+
+    for (auto _ : _rstate) {
+        for (size_t i = 0; i < batch_size; ++i) {
+            cp.push([&done_count]() { done_count.fetch_add(1, memory_order_release); });
+        }
+        pushed_count += batch_size;
+        wait_for(done_count, pushed_count);
+    }
+    _rstate.SetItemsProcessed(pushed_count);
+}
+
+//push from several threads, range(0) workers
+template <class WorkPoolT, class ConfigurationT>
+void BM_WorkPoolProducers(benchmark::State& _rstate)
+{
+    static WorkPoolT*     pwp = nullptr;
+    static atomic<size_t> done_count{0};
+
+    if (_rstate.thread_index() == 0) {
+        done_count = 0;
+        pwp        = new WorkPoolT{
+            ConfigurationT(), static_cast<size_t>(_rstate.range(0)),
+            [](const size_t _v) {
+                benchmark::DoNotOptimize(_v);
+                done_count.fetch_add(1, memory_order_release);
+            }};
+    }
+
+    for (auto _ : _rstate) {
+        for (size_t i = 0; i < batch_size; ++i) {
+            pwp->push(i);
+        }
+    }
+
+    if (_rstate.thread_index() == 0) {
+        delete pwp; //joins the workers after the queue is drained
+        pwp = nullptr;
+    }
+    _rstate.SetItemsProcessed(_rstate.iterations() * batch_size);
+}
+
+using LockFreeWorkPoolT = lockfree::WorkPool<size_t>;
+using LockingWorkPoolT  = locking::WorkPool<size_t>;
+
+BENCHMARK_TEMPLATE(BM_WorkPool, LockFreeWorkPoolT, lockfree::WorkPoolConfiguration)->Name("workpool/lockfree")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_WorkPool, LockingWorkPoolT, locking::WorkPoolConfiguration)->Name("workpool/locking")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(BM_CallPool)->Name("workpool/callpool")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_WorkPoolProducers, LockFreeWorkPoolT, lockfree::WorkPoolConfiguration)->Name("workpool/lockfree/producers")->Arg(2)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_WorkPoolProducers, LockingWorkPoolT, locking::WorkPoolConfiguration)->Name("workpool/locking/producers")->Arg(2)->ThreadRange(1, 4)->UseRealTime();
+
+} //namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,32 @@
+find_package(benchmark QUIET HINTS ${EXTERNAL_DIR})
+
+if(benchmark_FOUND)
+    message("Google Benchmark found: ${benchmark_DIR}")
+    #define dummy target
+    add_custom_target(build-benchmark)
+    set(BENCHMARK_LIB benchmark::benchmark)
+else()
+    set(benchmark_PREFIX ${CMAKE_BINARY_DIR}/external/benchmark)
+
+    ExternalProject_Add(
+        build-benchmark
+        EXCLUDE_FROM_ALL 1
+        PREFIX ${benchmark_PREFIX}
+        URL https://github.com/google/benchmark/archive/v1.7.1.tar.gz
+        DOWNLOAD_NO_PROGRESS ON
+        CMAKE_ARGS
+                -DCMAKE_INSTALL_PREFIX:PATH=${CMAKE_BINARY_DIR}/external -DCMAKE_INSTALL_LIBDIR=lib -DCMAKE_BUILD_TYPE=release
+                -DBENCHMARK_ENABLE_TESTING=OFF -DBENCHMARK_ENABLE_GTEST_TESTS=OFF
+        BUILD_COMMAND ${CMAKE_COMMAND} --build . --config release
+        INSTALL_COMMAND ${CMAKE_COMMAND} --build . --config release --target install
+        LOG_UPDATE ON
+        LOG_CONFIGURE ON
+        LOG_BUILD ON
+        LOG_INSTALL ON
+    )
+    if(SOLID_ON_WINDOWS)
+        set(BENCHMARK_LIB ${CMAKE_BINARY_DIR}/external/lib/benchmark.lib shlwapi)
+    else()
+        set(BENCHMARK_LIB ${CMAKE_BINARY_DIR}/external/lib/libbenchmark.a)
+    endif()
+endif()
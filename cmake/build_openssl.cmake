@@ -24,6 +24,7 @@ if(SOLID_ON_WINDOWS)
     )
 
     set(OPENSSL_FOUND TRUE)
+    set(OPENSSL_VERSION "1.1.1d")
     set(OPENSSL_LIBRARIES libssl libcrypto)
 else()
     ExternalProject_Add(
@@ -44,6 +45,7 @@ else()
     )
 
     set(OPENSSL_FOUND TRUE)
+    set(OPENSSL_VERSION "1.1.1d")
     set(OPENSSL_LIBRARIES ssl crypto)
 endif()
 
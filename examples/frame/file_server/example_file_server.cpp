@@ -219,6 +219,7 @@ int main(int argc, char* argv[])
                 if (utf8cfg.storagevec.back().localprefix.size() && *utf8cfg.storagevec.back().localprefix.rbegin() != '/') {
                     utf8cfg.storagevec.back().localprefix.push_back('/');
                 }
+                utf8cfg.cachecapacity = 128; //keep the most recently served files open
 
                 tempcfg.storagevec.push_back(frame::file::TempConfiguration::Storage());
                 tempcfg.storagevec.back().level    = frame::file::MemoryLevelFlag;
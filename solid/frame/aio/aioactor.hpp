@@ -50,6 +50,16 @@ private:
 };
 
 class Actor : public Dynamic<Actor, ActorBase>, ForwardCompletionHandler {
+public:
+    //! Actors are allocated from the slab cache of the allocating thread
+    /*!
+     * An actor is destroyed on its reactor's thread once it is fully
+     * unregistered, so its memory goes back to that reactor's cache and is
+     * reused by the actors created there (e.g. accepted connections).
+     */
+    static void* operator new(std::size_t _sz);
+    static void  operator delete(void* _pv, std::size_t _sz);
+
 protected:
     friend class CompletionHandler;
     friend class Reactor;
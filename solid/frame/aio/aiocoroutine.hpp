@@ -0,0 +1,426 @@
+// solid/frame/aio/aiocoroutine.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#if defined(__has_include)
+#if __has_include(<coroutine>) && defined(__cpp_impl_coroutine)
+#define SOLID_HAS_COROUTINE
+#endif
+#endif
+
+#ifdef SOLID_HAS_COROUTINE
+
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <utility>
+
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+namespace solid {
+namespace frame {
+namespace aio {
+namespace co {
+
+namespace impl {
+
+//! Per thread pool of coroutine frames
+/*!
+    A reactor runs on its own thread so the pool of the thread is the
+    pool of the reactor. Frames are kept on a free list per power of two
+    size class from 64 bytes up to 4KB; bigger frames go to operator new.
+*/
+class FramePool {
+    static constexpr size_t min_size         = 64;
+    static constexpr size_t class_count      = 7;
+    static constexpr size_t max_cached_count = 256;
+
+    struct Node {
+        Node* pnext_;
+    };
+
+    struct Slot {
+        Node*  ptop_  = nullptr;
+        size_t count_ = 0;
+    };
+
+    Slot   slot_arr_[class_count];
+    size_t allocate_count_ = 0;
+    size_t reuse_count_    = 0;
+
+    static size_t classIndex(const size_t _sz)
+    {
+        size_t idx = 0;
+        size_t cp  = min_size;
+        while (cp < _sz && idx < class_count) {
+            cp <<= 1;
+            ++idx;
+        }
+        return idx;
+    }
+
+    static size_t classSize(const size_t _idx)
+    {
+        return min_size << _idx;
+    }
+
+public:
+    static FramePool& local()
+    {
+        thread_local FramePool pool;
+        return pool;
+    }
+
+    FramePool() = default;
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    ~FramePool()
+    {
+        for (auto& rslot : slot_arr_) {
+            while (rslot.ptop_ != nullptr) {
+                Node* pnode = rslot.ptop_;
+                rslot.ptop_ = pnode->pnext_;
+                ::operator delete(pnode);
+            }
+        }
+    }
+
+    void* allocate(const size_t _sz)
+    {
+        const size_t idx = classIndex(_sz);
+        if (idx < class_count) {
+            Slot& rslot = slot_arr_[idx];
+            if (rslot.ptop_ != nullptr) {
+                Node* pnode = rslot.ptop_;
+                rslot.ptop_ = pnode->pnext_;
+                --rslot.count_;
+                ++reuse_count_;
+                return pnode;
+            }
+            ++allocate_count_;
+            return ::operator new(classSize(idx));
+        }
+        ++allocate_count_;
+        return ::operator new(_sz);
+    }
+
+    void deallocate(void* _pv, const size_t _sz) noexcept
+    {
+        const size_t idx = classIndex(_sz);
+        if (idx < class_count && slot_arr_[idx].count_ < max_cached_count) {
+            Slot& rslot   = slot_arr_[idx];
+            Node* pnode   = static_cast<Node*>(_pv);
+            pnode->pnext_ = rslot.ptop_;
+            rslot.ptop_   = pnode;
+            ++rslot.count_;
+            return;
+        }
+        ::operator delete(_pv);
+    }
+
+    //! Frames allocated from the system
+    size_t allocateCount() const
+    {
+        return allocate_count_;
+    }
+
+    //! Frames taken from the free lists
+    size_t reuseCount() const
+    {
+        return reuse_count_;
+    }
+};
+
+//! Completion functor resuming a suspended coroutine
+/*!
+    Owns the coroutine until called: if the pending operation is
+    dropped without completion (e.g. the actor is stopped) the
+    coroutine frame is destroyed with the functor.
+*/
+template <class Awaiter>
+class Resume {
+    Awaiter*                pawaiter_;
+    std::coroutine_handle<> handle_;
+
+public:
+    Resume(Awaiter* _pawaiter, std::coroutine_handle<> _handle)
+        : pawaiter_(_pawaiter)
+        , handle_(_handle)
+    {
+    }
+
+    Resume(Resume&& _other) noexcept
+        : pawaiter_(_other.pawaiter_)
+        , handle_(std::exchange(_other.handle_, nullptr))
+    {
+    }
+
+    Resume(const Resume&) = delete;
+    Resume& operator=(const Resume&) = delete;
+    Resume& operator=(Resume&&) = delete;
+
+    ~Resume()
+    {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    //! Called when the operation completed synchronously
+    void release()
+    {
+        handle_ = nullptr;
+    }
+
+    template <class... Args>
+    void operator()(ReactorContext& _rctx, Args... _args)
+    {
+        pawaiter_->complete(_rctx, _args...);
+        std::exchange(handle_, nullptr).resume();
+    }
+};
+
+} //namespace impl
+
+//! Fire-and-forget coroutine
+/*!
+    Starts eagerly on the calling thread and its frame is taken from the
+    FramePool of that thread.
+    Only use it from within an Actor's reactor callbacks and always use,
+    after a co_await, the ReactorContext returned by the awaited operation:
+    the one the coroutine was started with is no longer valid.
+*/
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object() noexcept
+        {
+            return Task{};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept
+        {
+            //there is no one to report to
+            std::terminate();
+        }
+
+        static void* operator new(const size_t _sz)
+        {
+            return impl::FramePool::local().allocate(_sz);
+        }
+
+        static void operator delete(void* _pv, const size_t _sz) noexcept
+        {
+            impl::FramePool::local().deallocate(_pv, _sz);
+        }
+    };
+};
+
+//! The outcome of an awaited aio operation
+struct Result {
+    ReactorContext& context;
+    size_t          size;
+
+    explicit operator bool() const
+    {
+        return !context.error();
+    }
+};
+
+template <class Sock>
+class RecvSomeAwaiter {
+    using ThisT   = RecvSomeAwaiter<Sock>;
+    using ResumeT = impl::Resume<ThisT>;
+    friend ResumeT;
+
+    Stream<Sock>&   rstream_;
+    ReactorContext* pctx_;
+    char*           pbuf_;
+    size_t          capacity_;
+    size_t          size_ = 0;
+
+    void complete(ReactorContext& _rctx, const size_t _sz)
+    {
+        pctx_ = &_rctx;
+        size_ = _sz;
+    }
+
+public:
+    RecvSomeAwaiter(ReactorContext& _rctx, Stream<Sock>& _rstream, char* _pbuf, const size_t _capacity)
+        : rstream_(_rstream)
+        , pctx_(&_rctx)
+        , pbuf_(_pbuf)
+        , capacity_(_capacity)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> _handle)
+    {
+        ResumeT resume{this, _handle};
+        if (rstream_.recvSome(*pctx_, pbuf_, capacity_, std::move(resume), size_)) {
+            resume.release();
+            return false;
+        }
+        return true;
+    }
+
+    Result await_resume() const
+    {
+        return Result{*pctx_, size_};
+    }
+};
+
+template <class Sock>
+class SendAllAwaiter {
+    using ThisT   = SendAllAwaiter<Sock>;
+    using ResumeT = impl::Resume<ThisT>;
+    friend ResumeT;
+
+    Stream<Sock>&   rstream_;
+    ReactorContext* pctx_;
+    const char*     pbuf_;
+    size_t          size_;
+
+    void complete(ReactorContext& _rctx)
+    {
+        pctx_ = &_rctx;
+    }
+
+public:
+    SendAllAwaiter(ReactorContext& _rctx, Stream<Sock>& _rstream, const char* _pbuf, const size_t _size)
+        : rstream_(_rstream)
+        , pctx_(&_rctx)
+        , pbuf_(_pbuf)
+        , size_(_size)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> _handle)
+    {
+        ResumeT resume{this, _handle};
+        if (rstream_.sendAll(*pctx_, const_cast<char*>(pbuf_), size_, std::move(resume))) {
+            resume.release();
+            return false;
+        }
+        return true;
+    }
+
+    Result await_resume() const
+    {
+        return Result{*pctx_, size_};
+    }
+};
+
+template <class TimePoint>
+class WaitAwaiter {
+    using ThisT   = WaitAwaiter<TimePoint>;
+    using ResumeT = impl::Resume<ThisT>;
+    friend ResumeT;
+
+    SteadyTimer&    rtimer_;
+    ReactorContext* pctx_;
+    TimePoint       time_point_;
+
+    void complete(ReactorContext& _rctx)
+    {
+        pctx_ = &_rctx;
+    }
+
+public:
+    WaitAwaiter(ReactorContext& _rctx, SteadyTimer& _rtimer, TimePoint const& _rtime_point)
+        : rtimer_(_rtimer)
+        , pctx_(&_rctx)
+        , time_point_(_rtime_point)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> _handle)
+    {
+        ResumeT resume{this, _handle};
+        if (rtimer_.waitUntil(*pctx_, time_point_, std::move(resume))) {
+            resume.release();
+            return false;
+        }
+        return true;
+    }
+
+    Result await_resume() const
+    {
+        return Result{*pctx_, 0};
+    }
+};
+
+//! co_await recvSome(_rctx, stream, buf, cp) - resumes with the received size
+template <class Sock>
+RecvSomeAwaiter<Sock> recvSome(ReactorContext& _rctx, Stream<Sock>& _rstream, char* _pbuf, const size_t _capacity)
+{
+    return RecvSomeAwaiter<Sock>{_rctx, _rstream, _pbuf, _capacity};
+}
+
+//! co_await sendAll(_rctx, stream, buf, sz) - resumes when all data was sent
+template <class Sock>
+SendAllAwaiter<Sock> sendAll(ReactorContext& _rctx, Stream<Sock>& _rstream, const char* _pbuf, const size_t _size)
+{
+    return SendAllAwaiter<Sock>{_rctx, _rstream, _pbuf, _size};
+}
+
+//! co_await waitUntil(_rctx, timer, time_point)
+template <class Clock, class Duration>
+WaitAwaiter<std::chrono::time_point<Clock, Duration>> waitUntil(ReactorContext& _rctx, SteadyTimer& _rtimer, std::chrono::time_point<Clock, Duration> const& _rtp)
+{
+    return WaitAwaiter<std::chrono::time_point<Clock, Duration>>{_rctx, _rtimer, _rtp};
+}
+
+//! co_await waitFor(_rctx, timer, duration)
+template <class Rep, class Period>
+auto waitFor(ReactorContext& _rctx, SteadyTimer& _rtimer, std::chrono::duration<Rep, Period> const& _rd)
+{
+    return waitUntil(_rctx, _rtimer, _rctx.steadyTime() + _rd);
+}
+
+} //namespace co
+} //namespace aio
+} //namespace frame
+} //namespace solid
+
+#endif //SOLID_HAS_COROUTINE
@@ -298,6 +298,21 @@ public:
         return !solid_function_empty(send_fnc);
     }
 
+    SocketDevice reset(ReactorContext& _rctx, SocketDevice&& _rnewdev = std::move(dummy_socket_device()))
+    {
+        if (s.device()) {
+            remDevice(_rctx, s.device());
+        }
+
+        contextBind(_rctx);
+
+        SocketDevice sd(s.reset(_rctx, std::move(_rnewdev)));
+        if (s.device()) {
+            completionCallback(&on_completion);
+        }
+        return sd;
+    }
+
     template <typename F>
     bool connect(ReactorContext& _rctx, SocketAddressStub const& _rsas, F&& _f)
     {
@@ -633,7 +648,7 @@ private:
     {
         solid_function_clear(send_fnc);
         send_buf    = nullptr;
-        recv_buf_cp = 0;
+        send_buf_cp = 0;
     }
     void doClear(ReactorContext& _rctx)
     {
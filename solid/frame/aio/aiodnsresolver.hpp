@@ -0,0 +1,117 @@
+// solid/frame/aio/aiodnsresolver.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "solid/frame/aio/aioerror.hpp"
+#include "solid/frame/common.hpp"
+#include "solid/system/socketaddress.hpp"
+#include "solid/utility/function.hpp"
+
+namespace solid {
+namespace frame {
+
+class Service;
+
+template <class R>
+class Scheduler;
+
+namespace aio {
+
+class Reactor;
+
+struct DnsConfiguration {
+    using AddressVectorT = std::vector<SocketAddressInet>;
+    using HostPairT      = std::pair<std::string, SocketAddressInet>;
+    using HostVectorT    = std::vector<HostPairT>;
+
+    DnsConfiguration();
+
+    //! Add the nameservers and the timeout/attempts options from a resolv.conf file
+    bool loadResolvConf(const char* _path);
+    //! Add the static entries from a hosts file
+    bool loadHosts(const char* _path);
+
+    AddressVectorT            nameserver_vec; //!< empty - load them from resolv_conf_path
+    HostVectorT               host_vec; //!< static names, looked up before the nameservers
+    std::string               resolv_conf_path;
+    std::string               hosts_path; //!< empty - no hosts file
+    std::chrono::milliseconds timeout; //!< per query attempt
+    size_t                    attempts; //!< rounds over the nameservers
+    uint32_t                  min_ttl_seconds;
+    uint32_t                  max_ttl_seconds;
+    uint32_t                  negative_ttl_seconds; //!< for names that do not exist
+    size_t                    cache_capacity;
+};
+
+using DnsAddressVectorT        = std::vector<SocketAddressInet>;
+using DnsAddressVectorPointerT = std::shared_ptr<const DnsAddressVectorT>;
+using DnsResolveFunctionT      = solid_function_t(void(DnsAddressVectorPointerT const&, ErrorConditionT const&));
+
+//! Non-blocking DNS resolver running on an aio reactor
+/*!
+    Queries the nameservers over UDP from an actor, instead of blocking a
+    thread in getaddrinfo for every lookup.
+    Answers are cached for their TTL (clamped to [min_ttl_seconds, max_ttl_seconds]),
+    names that do not exist for negative_ttl_seconds. When the cache holds
+    cache_capacity entries, the ones closest to expiring are evicted first.
+    Concurrent requests for the same name share a single query.
+    There is no search list and no TCP fallback for truncated answers.
+*/
+class DnsResolver {
+public:
+    using SchedulerT = Scheduler<Reactor>;
+
+    DnsResolver(DnsConfiguration const& _rcfg = DnsConfiguration());
+    ~DnsResolver();
+
+    //! Start the resolver actor - it runs until _rsvc is stopped
+    ErrorConditionT start(SchedulerT& _rsch, Service& _rsvc);
+
+    //! Resolve _host to the addresses of _family
+    /*!
+        _f(DnsAddressVectorPointerT const&, ErrorConditionT const&) is called
+        on the current thread for numeric addresses, static and cached names,
+        otherwise on the thread of the resolver's reactor.
+        The addresses have no port.
+    */
+    template <class F>
+    void requestResolve(F&& _f, const std::string& _host, const SocketInfo::Family _family = SocketInfo::AnyFamily)
+    {
+        DnsResolveFunctionT fnc{std::forward<F>(_f)};
+        doRequestResolve(fnc, _host, _family);
+    }
+
+    void clearCache();
+
+    size_t cacheSize() const;
+    size_t cacheHitCount() const;
+    size_t coalescedCount() const;
+    size_t queryCount() const;
+
+private:
+    struct Data;
+    class Client;
+
+    void doRequestResolve(DnsResolveFunctionT& _rfnc, const std::string& _host, const SocketInfo::Family _family);
+
+private:
+    std::shared_ptr<Data> impl_ptr_;
+};
+
+} //namespace aio
+} //namespace frame
+} //namespace solid
@@ -19,6 +19,12 @@ namespace aio {
 extern const ErrorCodeT error_resolver_direct;
 extern const ErrorCodeT error_resolver_reverse;
 
+extern const ErrorConditionT error_dns_invalid_name;
+extern const ErrorConditionT error_dns_not_found;
+extern const ErrorConditionT error_dns_server;
+extern const ErrorConditionT error_dns_timeout;
+extern const ErrorConditionT error_dns_stopped;
+
 extern const ErrorConditionT error_already;
 
 extern const ErrorConditionT error_datagram_shutdown;
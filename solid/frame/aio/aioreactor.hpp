@@ -39,27 +39,51 @@ struct ExecStub;
 
 typedef DynamicPointer<Actor> ActorPointerT;
 
+//! Opt-in busy polling for latency critical reactors
+/*!
+    Before blocking, the reactor polls its descriptors (a zero timeout wait)
+    for up to budget. Events raised from other threads while it polls are
+    picked up without waking it up through the event descriptor.
+    After idle_poll_limit consecutive polls ending with no work the reactor
+    blocks right away, until a blocking wait returns work again.
+    If socket_busy_poll_usec is not zero, SO_BUSY_POLL is set on the
+    sockets added to the reactor (linux only, raising it above
+    net.core.busy_read needs CAP_NET_ADMIN).
+    Only worth it when the reactor thread has a CPU core of its own.
+*/
+struct BusyPollConfiguration {
+    std::chrono::microseconds budget{0}; //!< zero - busy polling disabled
+    size_t                    idle_poll_limit       = 64;
+    int                       socket_busy_poll_usec = 0;
+};
+
 //!
 /*!
 
 */
 class Reactor : public frame::ReactorBase {
-    typedef solid_function_t(void(ReactorContext&, Event&&)) EventFunctionT;
+    typedef solid_move_only_function_t(SOLID_FRAME_FUNCTION_STORAGE, void(ReactorContext&, Event&&)) EventFunctionT;
 
     template <class Function>
     struct StopActorF {
         Function function;
+        bool     wait;
         bool     repost;
 
         explicit StopActorF(Function&& _function)
             : function{std::forward<Function>(_function)}
+            , wait(true)
             , repost(true)
         {
         }
 
         void operator()(ReactorContext& _rctx, Event&& _uevent)
         {
-            if (repost) { //skip one round - to guarantee that all remaining posts were delivered
+            if (wait) { //wait, without blocking, for the notifications started before disabling visits
+                wait = false;
+                EventFunctionT eventfnc{std::move(*this)};
+                _rctx.reactor().doPostAfterGracePeriod(_rctx, std::move(eventfnc), std::move(_uevent));
+            } else if (repost) { //skip one round - to guarantee that all remaining posts were delivered
                 repost = false;
                 EventFunctionT eventfnc{std::move(*this)};
                 _rctx.reactor().doPost(_rctx, std::move(eventfnc), std::move(_uevent));
@@ -116,9 +140,21 @@ public:
 
     bool start();
 
+    //! Configure busy polling on the reactor of the calling thread
+    /*!
+        Call it from the thread enter function given to Scheduler::start,
+        e.g. only for some of the reactors.
+        Returns false when not called on a reactor thread.
+    */
+    static bool configureBusyPoll(BusyPollConfiguration const& _rcfg);
+
     bool raise(UniqueId const& _ractuid, Event const& _revt) override;
     bool raise(UniqueId const& _ractuid, Event&& _uevt) override;
+    bool raise(UniqueIdVectorT&& _uuid_vec, Event const& _revt) override;
+    //! Thread safe - complete the given completion handler with _revent on the reactor thread
+    bool raise(UniqueId const& _ractuid, UniqueId const& _rchuid, const ReactorEventsE _revent);
     void stop() override;
+    void statistic(ReactorStatistic& _rstat) const override;
 
     void registerCompletionHandler(CompletionHandler& _rch, Actor const& _ract);
     void unregisterCompletionHandler(CompletionHandler& _rch);
@@ -132,6 +168,8 @@ public:
 
     CompletionHandler* completionHandler(ReactorContext const& _rctx) const;
 
+    UniqueId completionHandlerUid(ReactorContext const& _rctx) const;
+
 private:
     friend struct EventHandler;
     friend class CompletionHandler;
@@ -145,6 +183,7 @@ private:
 
     void doCompleteIo(NanoTime const& _rcrttime, const size_t _sz);
     void doCompleteTimer(NanoTime const& _rcrttime);
+    void doCompleteGracePeriod(NanoTime const& _rcrttime);
     void doCompleteExec(NanoTime const& _rcrttime);
     void doCompleteEvents(ReactorContext const& _rctx);
     void doCompleteEvents(NanoTime const& _rcrttime);
@@ -154,14 +193,18 @@ private:
 
     void doPost(ReactorContext& _rctx, EventFunctionT&& _revfn, Event&& _uev);
     void doPost(ReactorContext& _rctx, EventFunctionT&& _revfn, Event&& _uev, CompletionHandler const& _rch);
+    void doPostAfterGracePeriod(ReactorContext& _rctx, EventFunctionT&& _revfn, Event&& _uev);
 
     void doStopActor(ReactorContext& _rctx);
+    bool notifyGracePeriodPassed(const size_t _actidx);
 
     void        onTimer(ReactorContext& _rctx, const size_t _tidx, const size_t _chidx);
     static void call_actor_on_event(ReactorContext& _rctx, Event&& _uev);
     static void increase_event_vector_size(ReactorContext& _rctx, Event&& _uev);
     static void stop_actor(ReactorContext& _rctx, Event&& _uevent);
     static void stop_actor_repost(ReactorContext& _rctx, Event&& _uevent);
+    static void stop_actor_wait(ReactorContext& _rctx, Event&& _uevent);
+    static void call_completion_handler(ReactorContext& _rctx, const ReactorEventsE _revent);
 
     UniqueId actorUid(ReactorContext const& _rctx) const;
 
@@ -61,6 +61,9 @@ struct ReactorContext {
 
     UniqueId actorUid() const;
 
+    //! Index of the reactor in its scheduler
+    size_t reactorIndex() const;
+
     std::mutex& actorMutex() const;
 
     void clearError()
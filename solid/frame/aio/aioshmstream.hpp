@@ -0,0 +1,455 @@
+// solid/frame/aio/aioshmstream.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/system/common.hpp"
+
+#if defined(SOLID_USE_EPOLL)
+
+#include "aiocompletion.hpp"
+#include "aioerror.hpp"
+#include "aioreactor.hpp"
+#include "solid/system/device.hpp"
+#include "solid/system/socketdevice.hpp"
+#include "solid/utility/event.hpp"
+
+namespace solid {
+namespace frame {
+namespace aio {
+
+struct ActorProxy;
+struct ReactorContext;
+struct ShmSegment;
+
+//! One end of a shared memory byte channel between two processes on the same host
+/*!
+    The channel is a shared memory segment holding two single producer/single
+    consumer byte rings - one for each direction - plus one eventfd doorbell
+    for each end. The doorbell is only rung when the other end waits for data
+    or for free space, so a busy channel makes no system calls.
+
+    ShmChannel::create makes both ends in the current process. Give one of
+    them to the peer process either by fork inheritance or with send/recv
+    over a connected unix domain socket.
+
+    A channel end is used by one ShmStream at a time. Closing a channel end
+    does not shut the channel down - only shutdown and ~ShmStream do - so the
+    end sent to the peer can be closed locally.
+    Linux only (memfd + eventfd).
+*/
+class ShmChannel {
+public:
+    static constexpr size_t default_ring_capacity = 1024 * 1024;
+
+    //! Create both ends of a new channel; _ring_capacity is rounded up to a power of 2
+    static ErrorCodeT create(ShmChannel& _rend0, ShmChannel& _rend1, const size_t _ring_capacity = default_ring_capacity);
+
+    ShmChannel();
+    ShmChannel(ShmChannel&& _uch) noexcept;
+    ~ShmChannel();
+
+    ShmChannel& operator=(ShmChannel&& _uch) noexcept;
+
+    explicit operator bool() const noexcept
+    {
+        return psegment_ != nullptr;
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    //! Pass this end to the process at the other end of _rsd (blocking)
+    /*!
+        The channel end stays valid and should be closed after a successful send.
+    */
+    ErrorCodeT send(SocketDevice& _rsd) const;
+
+    //! Receive a channel end sent with send from the other end of _rsd (blocking)
+    ErrorCodeT recv(SocketDevice& _rsd);
+
+    //! Tell the other end that no more data will be sent or received
+    void shutdown();
+
+    void close();
+
+private:
+    friend class ShmStream;
+
+    ssize_t recv(char* _pb, size_t _bl, bool& _rcan_retry, ErrorCodeT& _rerr);
+    ssize_t send(const char* _pb, size_t _bl, bool& _rcan_retry, ErrorCodeT& _rerr);
+
+    Device const& doorbell() const
+    {
+        return doorbell_dev_;
+    }
+
+    void       clearDoorbell();
+    void       ringPeerDoorbell();
+    ErrorCodeT map();
+
+    ShmChannel(const ShmChannel&) = delete;
+    ShmChannel& operator=(const ShmChannel&) = delete;
+
+private:
+    ShmSegment* psegment_;
+    size_t      capacity_;
+    size_t      side_;
+    Device      segment_dev_;
+    Device      doorbell_dev_; //rung by the peer, we wait on it
+    Device      peer_doorbell_dev_; //we ring it, the peer waits on it
+};
+
+//! A stream over a ShmChannel, with the same surface as Stream
+/*!
+    The channel doorbell is registered with the reactor like a socket, so
+    protocol code written against Stream's postRecvSome/recvSome/postSendAll/
+    sendAll runs unchanged over it.
+*/
+class ShmStream : public CompletionHandler {
+    using ThisT         = ShmStream;
+    using RecvFunctionT = solid_move_only_function_t(SOLID_FRAME_FUNCTION_STORAGE, void(ThisT&, ReactorContext&));
+    using SendFunctionT = solid_move_only_function_t(SOLID_FRAME_FUNCTION_STORAGE, void(ThisT&, ReactorContext&));
+
+    static void on_init_completion(CompletionHandler& _rch, ReactorContext& _rctx)
+    {
+        ThisT& rthis = static_cast<ThisT&>(_rch);
+        rthis.completionCallback(&on_completion);
+        rthis.init(_rctx);
+    }
+
+    static void on_completion(CompletionHandler& _rch, ReactorContext& _rctx)
+    {
+        ThisT& rthis = static_cast<ThisT&>(_rch);
+
+        switch (rthis.reactorEvent(_rctx)) {
+        case ReactorEventNone:
+            break;
+        case ReactorEventRecv:
+            //the peer either produced data or freed space
+            rthis.ch.clearDoorbell();
+            rthis.doRecv(_rctx);
+            rthis.doSend(_rctx);
+            break;
+        case ReactorEventHangup:
+        case ReactorEventError:
+            rthis.doError(_rctx);
+            break;
+        case ReactorEventClear:
+            rthis.doClear(_rctx);
+            break;
+        default:
+            solid_assert(false);
+        }
+    }
+
+    //-------------
+    static void on_posted_recv_some(ReactorContext& _rctx, Event const&)
+    {
+        ThisT& rthis = static_cast<ThisT&>(*completion_handler(_rctx));
+        solid_dbg(logger, Verbose, "");
+        rthis.recv_is_posted = false;
+        rthis.doRecv(_rctx);
+    }
+
+    static void on_posted_send_all(ReactorContext& _rctx, Event const&)
+    {
+        ThisT& rthis = static_cast<ThisT&>(*completion_handler(_rctx));
+        solid_dbg(logger, Verbose, "");
+        rthis.send_is_posted = false;
+        rthis.doSend(_rctx);
+    }
+
+    static void on_dummy(ThisT& _rthis, ReactorContext& _rctx)
+    {
+    }
+
+    //-------------
+    template <class F>
+    struct RecvSomeFunctor {
+        F f;
+
+        RecvSomeFunctor(F&& _rf)
+            : f{std::forward<F>(_rf)}
+        {
+        }
+
+        void operator()(ThisT& _rthis, ReactorContext& _rctx)
+        {
+            if (_rthis.doTryRecv(_rctx)) {
+                const size_t recv_sz = _rthis.recv_buf_sz;
+                F            tmp{std::forward<F>(f)};
+                _rthis.doClearRecv(_rctx);
+                tmp(_rctx, recv_sz);
+            }
+        }
+    };
+
+    template <class F>
+    struct SendAllFunctor {
+        F f;
+
+        SendAllFunctor(F&& _rf)
+            : f{std::forward<F>(_rf)}
+        {
+        }
+
+        void operator()(ThisT& _rthis, ReactorContext& _rctx)
+        {
+            while (_rthis.doTrySend(_rctx)) {
+                if (_rthis.send_buf_sz == _rthis.send_buf_cp) {
+                    F tmp{std::forward<F>(f)};
+                    _rthis.doClearSend(_rctx);
+                    tmp(_rctx);
+                    break;
+                }
+            }
+        }
+    };
+
+public:
+    explicit ShmStream(
+        ActorProxy const& _ract, ShmChannel&& _uch)
+        : CompletionHandler(_ract, on_init_completion)
+        , ch(std::move(_uch))
+    {
+    }
+
+    ShmStream(
+        ActorProxy const& _ract)
+        : CompletionHandler(_ract, on_dummy_completion)
+    {
+    }
+
+    //! Also shuts the channel down, so the peer gets error_stream_shutdown
+    ~ShmStream()
+    {
+        //MUST call here and not in the ~CompletionHandler
+        this->deactivate();
+        if (ch) {
+            ch.shutdown();
+        }
+    }
+
+    bool hasPendingRecv() const
+    {
+        return !solid_function_empty(recv_fnc);
+    }
+
+    bool hasPendingSend() const
+    {
+        return !solid_function_empty(send_fnc);
+    }
+
+    ShmChannel& channel()
+    {
+        return ch;
+    }
+
+    ShmChannel const& channel() const
+    {
+        return ch;
+    }
+
+    ShmChannel reset(ReactorContext& _rctx, ShmChannel&& _unewch = ShmChannel())
+    {
+        if (ch) {
+            remDevice(_rctx, ch.doorbell());
+        }
+
+        contextBind(_rctx);
+
+        ShmChannel tmpch(std::move(ch));
+        ch = std::move(_unewch);
+
+        if (ch) {
+            completionCallback(&on_completion);
+            init(_rctx);
+        }
+        return tmpch;
+    }
+
+    void shutdown(ReactorContext& /*_rctx*/)
+    {
+        ch.shutdown();
+    }
+
+    template <typename F>
+    bool postRecvSome(ReactorContext& _rctx, char* _buf, size_t _bufcp, F&& _f)
+    {
+        if (solid_function_empty(recv_fnc)) {
+            using RealF    = typename std::decay<F>::type;
+            recv_fnc       = RecvSomeFunctor<RealF>{std::forward<RealF>(_f)};
+            recv_buf       = _buf;
+            recv_buf_cp    = _bufcp;
+            recv_buf_sz    = 0;
+            recv_is_posted = true;
+            doPostRecvSome(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            return true;
+        }
+    }
+
+    template <typename F>
+    bool recvSome(ReactorContext& _rctx, char* _buf, size_t _bufcp, F&& _f, size_t& _sz)
+    {
+        if (solid_function_empty(recv_fnc)) {
+            errorClear(_rctx);
+            contextBind(_rctx);
+
+            recv_buf    = _buf;
+            recv_buf_cp = _bufcp;
+            recv_buf_sz = 0;
+
+            if (doTryRecv(_rctx)) {
+                _sz = recv_buf_sz;
+                return true;
+            } else {
+                using RealF = typename std::decay<F>::type;
+                recv_fnc    = RecvSomeFunctor<RealF>{std::forward<RealF>(_f)};
+                return false;
+            }
+
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool postSendAll(ReactorContext& _rctx, const char* _buf, size_t _bufcp, F&& _f)
+    {
+        if (solid_function_empty(send_fnc)) {
+            using RealF    = typename std::decay<F>::type;
+            send_fnc       = SendAllFunctor<RealF>{std::forward<RealF>(_f)};
+            send_buf       = _buf;
+            send_buf_cp    = _bufcp;
+            send_buf_sz    = 0;
+            send_is_posted = true;
+            doPostSendAll(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            solid_assert(false);
+            return true;
+        }
+    }
+
+    template <typename F>
+    bool sendAll(ReactorContext& _rctx, char* _buf, size_t _bufcp, F&& _f)
+    {
+        if (solid_function_empty(send_fnc)) {
+            errorClear(_rctx);
+            contextBind(_rctx);
+
+            send_buf    = _buf;
+            send_buf_cp = _bufcp;
+            send_buf_sz = 0;
+
+            while (doTrySend(_rctx)) {
+                if (send_buf_sz == send_buf_cp) {
+                    return true;
+                }
+            }
+            using RealF = typename std::decay<F>::type;
+            send_fnc    = SendAllFunctor<RealF>{std::forward<RealF>(_f)};
+            return false;
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
+private:
+    void init(ReactorContext& _rctx);
+
+    void doPostRecvSome(ReactorContext& _rctx)
+    {
+        reactor(_rctx).post(_rctx, on_posted_recv_some, Event(), *this);
+    }
+    void doPostSendAll(ReactorContext& _rctx)
+    {
+        reactor(_rctx).post(_rctx, on_posted_send_all, Event(), *this);
+    }
+
+    void doRecv(ReactorContext& _rctx)
+    {
+        if (!recv_is_posted && !solid_function_empty(recv_fnc)) {
+            errorClear(_rctx);
+
+            recv_fnc(*this, _rctx);
+        }
+    }
+
+    void doSend(ReactorContext& _rctx)
+    {
+        if (!send_is_posted && !solid_function_empty(send_fnc)) {
+            errorClear(_rctx);
+
+            send_fnc(*this, _rctx);
+        }
+    }
+
+    bool doTryRecv(ReactorContext& _rctx);
+    bool doTrySend(ReactorContext& _rctx);
+    void doError(ReactorContext& _rctx);
+
+    void doClearRecv(ReactorContext& _rctx)
+    {
+        solid_function_clear(recv_fnc);
+        solid_assert(solid_function_empty(recv_fnc));
+        recv_buf    = nullptr;
+        recv_buf_sz = recv_buf_cp = 0;
+    }
+
+    void doClearSend(ReactorContext& _rctx)
+    {
+        solid_function_clear(send_fnc);
+        solid_assert(solid_function_empty(send_fnc));
+        send_buf    = nullptr;
+        send_buf_sz = send_buf_cp = 0;
+    }
+
+    void doClear(ReactorContext& _rctx)
+    {
+        doClearRecv(_rctx);
+        doClearSend(_rctx);
+        remDevice(_rctx, ch.doorbell());
+        recv_fnc = &on_dummy; //we prevent new send/recv calls
+        send_fnc = &on_dummy;
+    }
+
+private:
+    ShmChannel ch;
+
+    char*         recv_buf       = nullptr;
+    size_t        recv_buf_sz    = 0;
+    size_t        recv_buf_cp    = 0;
+    RecvFunctionT recv_fnc;
+    bool          recv_is_posted = false;
+
+    const char*   send_buf       = nullptr;
+    size_t        send_buf_sz    = 0;
+    size_t        send_buf_cp    = 0;
+    SendFunctionT send_fnc;
+    bool          send_is_posted = false;
+};
+
+} //namespace aio
+} //namespace frame
+} //namespace solid
+
+#endif //SOLID_USE_EPOLL
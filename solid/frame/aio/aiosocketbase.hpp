@@ -143,6 +143,10 @@ public:
     }
 
 protected:
+    Reactor& reactor(ReactorContext& _rctx) const
+    {
+        return _rctx.reactor();
+    }
     void addReactorRequestEvents(ReactorContext& _rctx, const ReactorWaitRequestsE _req) const
     {
         _rctx.reactor().addDevice(_rctx, device(), _req);
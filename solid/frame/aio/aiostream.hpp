@@ -26,8 +26,8 @@ struct ReactorContext;
 template <class Sock>
 class Stream : public CompletionHandler {
     using ThisT         = Stream<Sock>;
-    using RecvFunctionT = solid_function_t(void(ThisT&, ReactorContext&));
-    using SendFunctionT = solid_function_t(void(ThisT&, ReactorContext&));
+    using RecvFunctionT = solid_move_only_function_t(SOLID_FRAME_FUNCTION_STORAGE, void(ThisT&, ReactorContext&));
+    using SendFunctionT = solid_move_only_function_t(SOLID_FRAME_FUNCTION_STORAGE, void(ThisT&, ReactorContext&));
 
     static void on_init_completion(CompletionHandler& _rch, ReactorContext& _rctx)
     {
@@ -261,6 +261,21 @@ class Stream : public CompletionHandler {
         }
     };
 
+    template <class F>
+    struct SecureSessionFunctor {
+        F f;
+
+        SecureSessionFunctor(F&& _rf)
+            : f{std::forward<F>(_rf)}
+        {
+        }
+
+        void operator()(void* _pctx, typename Sock::SessionT&& _rsession)
+        {
+            f(*static_cast<ReactorContext*>(_pctx), std::move(_rsession));
+        }
+    };
+
 public:
     explicit Stream(
         ActorProxy const& _ract, SocketDevice&& _rsd)
@@ -459,6 +474,17 @@ public:
 
     template <typename F>
     bool connect(ReactorContext& _rctx, SocketAddressStub const& _rsas, F&& _f)
+    {
+        return connect(_rctx, _rsas, std::forward<F>(_f), [](SocketDevice& /*_rsd*/) {});
+    }
+
+    //! Connect calling _setup_fnc on the socket device after it is created but before connecting
+    /*!
+        For the socket options that must be in place before the handshake,
+        e.g. SO_RCVBUF which decides the TCP window scale.
+    */
+    template <typename F, typename SetupF>
+    bool connect(ReactorContext& _rctx, SocketAddressStub const& _rsas, F&& _f, SetupF&& _setup_fnc)
     {
         if (solid_function_empty(send_fnc)) {
             errorClear(_rctx);
@@ -469,6 +495,8 @@ public:
             if (s.create(_rctx, _rsas, err)) {
                 completionCallback(&on_completion);
 
+                _setup_fnc(s.device());
+
                 bool can_retry;
                 bool rv = s.connect(_rctx, _rsas, can_retry, err);
                 if (rv) {
@@ -494,6 +522,27 @@ public:
         return true;
     }
 
+    //! Connect using an already connected socket device - e.g. one end of SocketDevice::createPair
+    /*!
+        Always completes synchronously. If _usd is not valid, the connect
+        fails with _rsys_err as system error.
+    */
+    bool connect(ReactorContext& _rctx, SocketDevice&& _usd, ErrorCodeT const& _rsys_err = ErrorCodeT())
+    {
+        if (solid_function_empty(send_fnc)) {
+            errorClear(_rctx);
+            if (_usd) {
+                reset(_rctx, std::move(_usd));
+            } else {
+                error(_rctx, error_stream_system);
+                systemError(_rctx, _rsys_err);
+            }
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
     void shutdown(ReactorContext& /*_rctx*/)
     {
         s.shutdown();
@@ -624,6 +673,35 @@ public:
         }
     }
 
+    template <class Session>
+    void secureSetSession(ReactorContext& _rctx, const Session& _rsession)
+    {
+        ErrorCodeT err = s.setSession(_rsession);
+        if (err) {
+            error(_rctx, error_stream_system);
+            systemError(_rctx, err);
+            solid_assert(err);
+        }
+    }
+
+    template <typename F>
+    void secureSetSessionCallback(ReactorContext& _rctx, F&& _f)
+    {
+        using RealF = typename std::decay<F>::type;
+        SecureSessionFunctor<RealF> fnc_wrap{std::forward<RealF>(_f)};
+        ErrorCodeT                  err = s.setSessionCallback(fnc_wrap);
+        if (err) {
+            error(_rctx, error_stream_system);
+            systemError(_rctx, err);
+            solid_assert(err);
+        }
+    }
+
+    bool secureIsSessionReused() const
+    {
+        return s.isSessionReused();
+    }
+
 private:
     void doPostRecvSome(ReactorContext& _rctx)
     {
@@ -13,6 +13,7 @@
 #include "openssl/ssl.h"
 #include "solid/system/error.hpp"
 #include "solid/utility/function.hpp"
+#include <memory>
 
 namespace solid {
 namespace frame {
@@ -34,7 +35,9 @@ class Context {
     Context();
 
 public:
-    using NativeContextT = SSL_CTX*;
+    using NativeContextT     = SSL_CTX*;
+    using HandshakeJobT      = solid_function_t(void());
+    using HandshakeExecutorT = solid_function_t(void(HandshakeJobT&&));
     static Context create(const SSL_METHOD* = nullptr);
 
     Context(Context const&) = delete;
@@ -72,6 +75,56 @@ public:
     ErrorCodeT loadPrivateKey(const unsigned char* _data, const size_t _data_size, const FileFormat _fformat = FileFormat::Pem);
     ErrorCodeT loadPrivateKey(const std::string& _str, const FileFormat _fformat = FileFormat::Pem);
 
+    //! Opt-in kernel TLS offload
+    /*!
+     * Once the handshake completes, the record layer is moved into the
+     * kernel for the directions the cipher and the kernel support;
+     * otherwise the sockets transparently stay on the user-space path.
+     * Returns an error when OpenSSL was built without kTLS support.
+     */
+    ErrorCodeT enableKernelTls(const bool _enable = true);
+
+    bool isKernelTlsEnabled() const;
+
+    //! Client side: sessions are handed to Socket's session callback
+    /*!
+     * OpenSSL's internal client cache is disabled - the application
+     * decides where sessions are kept (e.g. one per destination).
+     */
+    ErrorCodeT enableClientSessionResumption();
+
+    //! Server side: stateful cache and/or stateless session tickets
+    /*!
+     * \param _session_id_context Application specific, max 32 bytes, needed
+     * for resuming sessions with verified peer certificates.
+     * \param _cache_size Number of sessions kept by the internal cache.
+     * \param _use_tickets Issue stateless session tickets.
+     */
+    ErrorCodeT enableServerSessionResumption(const std::string& _session_id_context, const size_t _cache_size = 20 * 1024, const bool _use_tickets = true);
+
+    //! Server side: share session ticket keys (80 bytes) among servers and restarts
+    ErrorCodeT setSessionTicketKeys(const std::string& _keys);
+
+    //! Run the handshakes of the sockets created afterwards on a worker pool
+    /*!
+     * _f(HandshakeJobT&&) must run the job on another thread (e.g. push it
+     * onto a CallPool). Meanwhile the socket stays parked on its reactor
+     * which is free to serve the established connections.
+     * The certificate verify callbacks are still called on the reactor thread.
+     * Returns an error when the OpenSSL library cannot suspend the handshake
+     * for the verification (requires OpenSSL 3.0).
+     */
+    template <typename F>
+    ErrorCodeT handshakeExecutor(F _f)
+    {
+        return doSetHandshakeExecutor(std::make_shared<HandshakeExecutorT>(std::move(_f)));
+    }
+
+    bool isHandshakeOffloaded() const
+    {
+        return static_cast<bool>(handshake_executor_ptr);
+    }
+
     template <typename F>
     ErrorCodeT passwordCallback(F _f)
     {
@@ -87,13 +140,16 @@ public:
 private:
     static int on_password_cb(char* buf, int size, int rwflag, void* u);
     ErrorCodeT doSetPasswordCallback();
+    ErrorCodeT doSetHandshakeExecutor(std::shared_ptr<HandshakeExecutorT>&& _rexecutor_ptr);
 
 private:
-    using PasswordFunctionT = solid_function_t(std::string(std::size_t, PasswordPurpose));
+    using PasswordFunctionT         = solid_function_t(std::string(std::size_t, PasswordPurpose));
+    using HandshakeExecutorPointerT = std::shared_ptr<HandshakeExecutorT>;
 
     friend class Socket;
-    SSL_CTX*          pctx;
-    PasswordFunctionT pwdfnc;
+    SSL_CTX*                  pctx;
+    PasswordFunctionT         pwdfnc;
+    HandshakeExecutorPointerT handshake_executor_ptr;
 };
 
 } //namespace openssl
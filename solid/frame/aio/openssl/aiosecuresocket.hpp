@@ -12,9 +12,11 @@
 
 #include "openssl/ssl.h"
 #include "solid/frame/aio/aiosocketbase.hpp"
+#include "solid/frame/aio/openssl/aiosecurecontext.hpp"
 #include "solid/system/socketdevice.hpp"
 #include "solid/utility/function.hpp"
 #include <cerrno>
+#include <memory>
 
 namespace solid {
 namespace frame {
@@ -24,8 +26,6 @@ struct ReactorContext;
 
 namespace openssl {
 
-class Context;
-
 enum VerifyMode {
     VerifyModeNone             = 1,
     VerifyModePeer             = 2,
@@ -61,11 +61,56 @@ private:
     NativeContextT* ssl_ctx;
 };
 
+//! A TLS session which can be used to resume a connection without a full handshake
+class Session {
+public:
+    using NativeHandleT = SSL_SESSION*;
+
+    Session()
+        : psession(nullptr)
+    {
+    }
+
+    Session(const Session& _rss);
+    Session(Session&& _rss) noexcept;
+
+    ~Session();
+
+    Session& operator=(const Session& _rss);
+    Session& operator=(Session&& _rss) noexcept;
+
+    bool empty() const
+    {
+        return psession == nullptr;
+    }
+
+    bool isResumable() const;
+
+    void clear();
+
+    NativeHandleT nativeHandle() const
+    {
+        return psession;
+    }
+
+private:
+    friend class Socket;
+    //takes ownership of the native session reference
+    explicit Session(SSL_SESSION* _psession)
+        : psession(_psession)
+    {
+    }
+
+private:
+    SSL_SESSION* psession;
+};
+
 class Socket : public SocketBase {
 public:
     using NativeHandleT  = SSL*;
     using VerifyMaskT    = openssl::VerifyMaskT;
     using VerifyContextT = openssl::VerifyContext;
+    using SessionT       = openssl::Session;
 
     Socket(const Context& _rctx, SocketDevice&& _rsd);
 
@@ -111,6 +156,32 @@ public:
     ErrorCodeT setCheckEmail(const std::string& _hostname);
     ErrorCodeT setCheckIP(const std::string& _hostname);
 
+    //! Client side: the session to resume on secureConnect
+    ErrorCodeT setSession(const SessionT& _rsession);
+
+    //! The current session - for TLS 1.3 use the session callback instead
+    SessionT session() const;
+
+    //! True if the handshake resumed a previous session
+    bool isSessionReused() const;
+
+    //! Client side: called for every resumable session issued by the server
+    /*!
+     * Requires Context::enableClientSessionResumption. With TLS 1.3 the
+     * sessions (tickets) arrive after the handshake, while receiving data.
+     */
+    template <typename Cbk>
+    ErrorCodeT setSessionCallback(Cbk _cbk)
+    {
+        session_cbk = std::move(_cbk);
+        return ErrorCodeT();
+    }
+
+    //! True if, after handshake, records are encrypted by the kernel
+    bool isKernelTlsSend() const;
+    //! True if, after handshake, records are decrypted by the kernel
+    bool isKernelTlsRecv() const;
+
 private:
     static int thisSSLDataIndex();
     static int contextPointerSSLDataIndex();
@@ -123,17 +194,36 @@ private:
 
     ErrorCodeT doPrepareVerifyCallback(VerifyMaskT _verify_mask);
 
+    void doCheckKernelTls();
+
+    bool doOffloadHandshake(ReactorContext& _rctx, const bool _accept, int& _rerr_cond, ErrorCodeT& _rerr_sys, unsigned long& _rerr_code);
+    void doSubmitHandshake(ReactorContext& _rctx, const bool _accept);
+    void doCancelHandshake();
+
     static int on_verify(int preverify_ok, X509_STORE_CTX* x509_ctx);
+    static int on_new_session(SSL* _pssl, SSL_SESSION* _psession);
 
 private:
-    using VerifyFunctionT = solid_function_t(bool(void*, bool, VerifyContextT&));
-
-    SSL*            pssl;
-    bool            want_read_on_recv;
-    bool            want_read_on_send;
-    bool            want_write_on_recv;
-    bool            want_write_on_send;
-    VerifyFunctionT verify_cbk;
+    using VerifyFunctionT           = solid_function_t(bool(void*, bool, VerifyContextT&));
+    using SessionFunctionT          = solid_function_t(void(void*, SessionT&&));
+
+    struct HandshakeStub;
+    using HandshakeStubPointerT     = std::shared_ptr<HandshakeStub>;
+    using HandshakeExecutorPointerT = std::shared_ptr<Context::HandshakeExecutorT>;
+
+    friend class Context;
+
+    SSL*                      pssl;
+    bool                      want_read_on_recv;
+    bool                      want_read_on_send;
+    bool                      want_write_on_recv;
+    bool                      want_write_on_send;
+    bool                      ktls_send;
+    bool                      ktls_recv;
+    VerifyFunctionT           verify_cbk;
+    SessionFunctionT          session_cbk;
+    HandshakeExecutorPointerT handshake_executor_ptr;
+    HandshakeStubPointerT     handshake_ptr;
 };
 
 inline Socket::NativeHandleT Socket::nativeHandle() const
@@ -141,6 +231,16 @@ inline Socket::NativeHandleT Socket::nativeHandle() const
     return pssl;
 }
 
+inline bool Socket::isKernelTlsSend() const
+{
+    return ktls_send;
+}
+
+inline bool Socket::isKernelTlsRecv() const
+{
+    return ktls_recv;
+}
+
 } //namespace openssl
 } //namespace aio
 } //namespace frame
@@ -16,6 +16,7 @@
 #include "solid/system/error.hpp"
 #include "solid/system/exception.hpp"
 #include "solid/system/log.hpp"
+#include <atomic>
 #include <mutex>
 #include <thread>
 
@@ -31,6 +32,16 @@
 #pragma comment(lib, "crypt32")
 #endif
 
+#if !defined(OPENSSL_IS_BORINGSSL) && defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#define SOLID_OPENSSL_KTLS
+#endif
+
+//NOTE: the verify callbacks need the reactor context, so an offloaded handshake
+//must be able to suspend itself on certificate verification (SSL_set_retry_verify)
+#if !defined(OPENSSL_IS_BORINGSSL) && OPENSSL_VERSION_NUMBER >= 0x30000000L
+#define SOLID_OPENSSL_HANDSHAKE_OFFLOAD
+#endif
+
 namespace {
 
 class OpenSSLErrorCategory : public solid::ErrorCategoryT {
@@ -66,6 +77,8 @@ enum struct WrapperError : int {
     SetCheckHostName,
     SetCheckEmail,
     SetCheckIP,
+    KernelTls,
+    HandshakeOffload,
 };
 
 class ErrorCategory : public solid::ErrorCategoryT {
@@ -103,6 +116,12 @@ std::string ErrorCategory::message(int _ev) const
     case WrapperError::SetCheckIP:
         oss << "Setting IP used for verification";
         break;
+    case WrapperError::KernelTls:
+        oss << "Kernel TLS not supported by the OpenSSL library";
+        break;
+    case WrapperError::HandshakeOffload:
+        oss << "Handshake offload not supported by the OpenSSL library";
+        break;
     default:
         oss << "Unknown error";
         break;
@@ -111,6 +130,12 @@ std::string ErrorCategory::message(int _ev) const
     return oss.str();
 }
 
+#if defined(SOLID_OPENSSL_HANDSHAKE_OFFLOAD)
+constexpr int ssl_error_want_retry_verify = SSL_ERROR_WANT_RETRY_VERIFY;
+#else
+constexpr int ssl_error_want_retry_verify = -1; //never returned
+#endif
+
 } //namespace
 
 namespace solid {
@@ -181,6 +206,7 @@ bool Context::empty() const
 }
 
 Context::Context(Context&& _rctx) noexcept
+    : handshake_executor_ptr(std::move(_rctx.handshake_executor_ptr))
 {
     pctx       = _rctx.pctx;
     _rctx.pctx = nullptr;
@@ -191,8 +217,9 @@ Context& Context::operator=(Context&& _rctx) noexcept
         SSL_CTX_free(pctx);
         pctx = nullptr;
     }
-    pctx       = _rctx.pctx;
-    _rctx.pctx = nullptr;
+    pctx                   = _rctx.pctx;
+    _rctx.pctx             = nullptr;
+    handshake_executor_ptr = std::move(_rctx.handshake_executor_ptr);
     return *this;
 }
 Context::Context()
@@ -391,6 +418,76 @@ ErrorCodeT Context::loadPrivateKey(const std::string& _str, const FileFormat _ff
     return loadPrivateKey(reinterpret_cast<const unsigned char*>(_str.data()), _str.size(), _fformat);
 }
 
+ErrorCodeT Context::enableKernelTls(const bool _enable)
+{
+#if defined(SOLID_OPENSSL_KTLS)
+    if (_enable) {
+        SSL_CTX_set_options(pctx, SSL_OP_ENABLE_KTLS);
+    } else {
+        SSL_CTX_clear_options(pctx, SSL_OP_ENABLE_KTLS);
+    }
+    return ErrorCodeT();
+#else
+    if (_enable) {
+        return wrapper_category.makeError(WrapperError::KernelTls);
+    }
+    return ErrorCodeT();
+#endif
+}
+
+bool Context::isKernelTlsEnabled() const
+{
+#if defined(SOLID_OPENSSL_KTLS)
+    return (SSL_CTX_get_options(pctx) & SSL_OP_ENABLE_KTLS) != 0;
+#else
+    return false;
+#endif
+}
+
+ErrorCodeT Context::enableClientSessionResumption()
+{
+    SSL_CTX_set_session_cache_mode(pctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(pctx, Socket::on_new_session);
+    return ErrorCodeT();
+}
+
+ErrorCodeT Context::enableServerSessionResumption(const std::string& _session_id_context, const size_t _cache_size, const bool _use_tickets)
+{
+    ErrorCodeT err;
+    ::ERR_clear_error();
+    if (SSL_CTX_set_session_id_context(pctx, reinterpret_cast<const unsigned char*>(_session_id_context.data()), static_cast<unsigned>(_session_id_context.size())) != 1) {
+        err = ssl_category.makeError(::ERR_get_error());
+        return err;
+    }
+    SSL_CTX_set_session_cache_mode(pctx, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(pctx, static_cast<long>(_cache_size));
+    if (_use_tickets) {
+        SSL_CTX_clear_options(pctx, SSL_OP_NO_TICKET);
+    } else {
+        SSL_CTX_set_options(pctx, SSL_OP_NO_TICKET);
+    }
+    return err;
+}
+
+ErrorCodeT Context::setSessionTicketKeys(const std::string& _keys)
+{
+    if (SSL_CTX_set_tlsext_ticket_keys(pctx, const_cast<char*>(_keys.data()), static_cast<long>(_keys.size())) == 1) {
+        return ErrorCodeT();
+    }
+    return wrapper_category.makeError(WrapperError::Call);
+}
+
+ErrorCodeT Context::doSetHandshakeExecutor(std::shared_ptr<HandshakeExecutorT>&& _rexecutor_ptr)
+{
+#if defined(SOLID_OPENSSL_HANDSHAKE_OFFLOAD)
+    handshake_executor_ptr = std::move(_rexecutor_ptr);
+    return ErrorCodeT();
+#else
+    (void)_rexecutor_ptr;
+    return wrapper_category.makeError(WrapperError::HandshakeOffload);
+#endif
+}
+
 ErrorCodeT Context::doSetPasswordCallback()
 {
     SSL_CTX_set_default_passwd_cb(pctx, on_password_cb);
@@ -424,6 +521,135 @@ ErrorCodeT Context::doSetPasswordCallback()
 
 //=============================================================================
 
+Session::Session(const Session& _rss)
+    : psession(_rss.psession)
+{
+    if (psession != nullptr) {
+        SSL_SESSION_up_ref(psession);
+    }
+}
+
+Session::Session(Session&& _rss) noexcept
+    : psession(_rss.psession)
+{
+    _rss.psession = nullptr;
+}
+
+Session::~Session()
+{
+    clear();
+}
+
+Session& Session::operator=(const Session& _rss)
+{
+    if (this != &_rss) {
+        clear();
+        psession = _rss.psession;
+        if (psession != nullptr) {
+            SSL_SESSION_up_ref(psession);
+        }
+    }
+    return *this;
+}
+
+Session& Session::operator=(Session&& _rss) noexcept
+{
+    if (this != &_rss) {
+        clear();
+        psession      = _rss.psession;
+        _rss.psession = nullptr;
+    }
+    return *this;
+}
+
+bool Session::isResumable() const
+{
+    return psession != nullptr && SSL_SESSION_is_resumable(psession) != 0;
+}
+
+void Session::clear()
+{
+    if (psession != nullptr) {
+        SSL_SESSION_free(psession);
+        psession = nullptr;
+    }
+}
+
+//=============================================================================
+
+//NOTE: shared with the handshake job. While Queued or Running the job
+//owns the SSL object - the Socket destructor cancels a queued job and
+//waits for a running one.
+struct Socket::HandshakeStub {
+    enum struct StatusE {
+        Idle,
+        Queued,
+        Running,
+        Done,
+        Cancelled,
+    };
+
+    std::atomic<StatusE> status;
+    std::atomic<bool>    raising;
+    //accessed only on the reactor thread:
+    bool missed_event;
+    //set before submitting, read by the job:
+    Socket*        psocket;
+    Reactor*       preactor;
+    UniqueId       actuid;
+    UniqueId       chuid;
+    ReactorEventsE event;
+    bool           accept;
+    //set by the job:
+    int           err_cond;
+    ErrorCodeT    err_sys;
+    unsigned long err_code;
+    SessionT      session;
+
+    HandshakeStub(Socket& _rsocket)
+        : status(StatusE::Idle)
+        , raising(false)
+        , missed_event(false)
+        , psocket(&_rsocket)
+        , preactor(nullptr)
+        , event(ReactorEventNone)
+        , accept(false)
+        , err_cond(SSL_ERROR_NONE)
+        , err_code(0)
+    {
+    }
+
+    void run()
+    {
+        StatusE expect = StatusE::Queued;
+        if (!status.compare_exchange_strong(expect, StatusE::Running)) {
+            return; //the socket is gone
+        }
+
+        SSL* const pssl = psocket->pssl;
+
+        psocket->storeThisPointer(); //no context pointer - we're not on the reactor thread
+
+        ::ERR_clear_error();
+
+        const int retval = accept ? ::SSL_accept(pssl) : ::SSL_connect(pssl);
+        err_sys          = last_socket_error();
+        err_cond         = ::SSL_get_error(pssl, retval);
+        err_code         = ::ERR_get_error();
+
+        psocket->clearThisPointer();
+
+        //after Done is set the socket may be destroyed at any time
+        //but the reactor is kept alive until raising is cleared
+        raising = true;
+        status  = StatusE::Done;
+        preactor->raise(actuid, chuid, event);
+        raising = false;
+    }
+};
+
+//=============================================================================
+
 /*static*/ int Socket::thisSSLDataIndex()
 {
     static int idx = SSL_get_ex_new_index(0, (void*)"socket_data", nullptr, nullptr, nullptr);
@@ -442,6 +668,9 @@ Socket::Socket(
     , want_read_on_send(false)
     , want_write_on_recv(false)
     , want_write_on_send(false)
+    , ktls_send(false)
+    , ktls_recv(false)
+    , handshake_executor_ptr(_rctx.handshake_executor_ptr)
 {
     pssl = SSL_new(_rctx.pctx);
     ::SSL_set_mode(pssl, SSL_MODE_ENABLE_PARTIAL_WRITE);
@@ -457,6 +686,9 @@ Socket::Socket(const Context& _rctx)
     , want_read_on_send(false)
     , want_write_on_recv(false)
     , want_write_on_send(false)
+    , ktls_send(false)
+    , ktls_recv(false)
+    , handshake_executor_ptr(_rctx.handshake_executor_ptr)
 {
     pssl = SSL_new(_rctx.pctx);
     ::SSL_set_mode(pssl, SSL_MODE_ENABLE_PARTIAL_WRITE);
@@ -465,6 +697,7 @@ Socket::Socket(const Context& _rctx)
 
 Socket::~Socket()
 {
+    doCancelHandshake();
     SSL_free(pssl);
 }
 
@@ -472,6 +705,8 @@ SocketDevice Socket::reset(ReactorContext& _rctx, SocketDevice&& _rsd)
 {
 
     SocketDevice sd = SocketBase::reset(_rctx, std::move(_rsd));
+    ktls_send       = false;
+    ktls_recv       = false;
     if (device()) {
         SSL_set_fd(pssl, sd.descriptor());
     } else {
@@ -485,6 +720,8 @@ bool Socket::create(ReactorContext& _rctx, SocketAddressStub const& _rsas, Error
     bool rv = SocketBase::create(_rctx, _rsas, _rerr);
 
     if (rv) {
+        ktls_send = false;
+        ktls_recv = false;
         SSL_set_fd(pssl, device().descriptor());
     }
     return rv;
@@ -501,6 +738,19 @@ ErrorCodeT Socket::renegotiate(bool& /*_can_retry*/)
 ReactorEventsE Socket::filterReactorEvents(
     const ReactorEventsE _evt) const
 {
+    if (handshake_ptr && handshake_ptr->status != HandshakeStub::StatusE::Idle) {
+        //offloaded handshake: any IO event goes to the pending secureAccept/secureConnect
+        switch (_evt) {
+        case ReactorEventRecv:
+        case ReactorEventSend:
+        case ReactorEventRecvSend:
+        case ReactorEventSendRecv:
+            return handshake_ptr->event;
+        default:
+            return _evt;
+        }
+    }
+
     switch (_evt) {
     case ReactorEventRecv:
         //solid_dbg(logger, Info, "EventRecv "<<want_read_on_send<<' '<<want_read_on_recv<<' '<<want_write_on_send<<' '<<want_write_on_recv);
@@ -542,6 +792,17 @@ ReactorEventsE Socket::filterReactorEvents(
 
 ssize_t Socket::recv(ReactorContext& _rctx, char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
 {
+    if (ktls_recv && !want_read_on_recv && !want_write_on_recv && ::SSL_pending(pssl) == 0) {
+        //the kernel decrypts application data records
+        const ssize_t rv = device().recv(_pb, _bl, _can_retry, _rerr);
+        if (rv >= 0 || _can_retry || _rerr != std::errc::io_error) {
+            return rv;
+        }
+        //the next record is not application data (e.g. an alert)
+        //it can only be retrieved through OpenSSL
+        _rerr.clear();
+    }
+
     want_read_on_recv = want_write_on_recv = false;
 
     storeThisPointer();
@@ -604,6 +865,15 @@ ssize_t Socket::recv(ReactorContext& _rctx, char* _pb, size_t _bl, bool& _can_re
 
 ssize_t Socket::send(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
 {
+#if defined(SOLID_OPENSSL_KTLS)
+    //an interrupted SSL_write must be retried through OpenSSL, as well as
+    //a pending key update
+    if (ktls_send && !want_read_on_send && !want_write_on_send && ::SSL_get_key_update_type(pssl) == SSL_KEY_UPDATE_NONE) {
+        //the kernel does the record framing and encryption
+        return device().send(_pb, _bl, _can_retry, _rerr);
+    }
+#endif
+
     want_read_on_send = want_write_on_send = false;
 
     storeThisPointer();
@@ -666,22 +936,34 @@ bool Socket::secureAccept(ReactorContext& _rctx, bool& _can_retry, ErrorCodeT& _
 {
     want_read_on_recv = want_write_on_recv = false;
 
-    storeThisPointer();
-    storeContextPointer(&_rctx);
+    int           err_cond = SSL_ERROR_NONE;
+    ErrorCodeT    err_sys;
+    unsigned long err_code = 0;
 
-    ::ERR_clear_error();
+    if (handshake_executor_ptr && !doOffloadHandshake(_rctx, true, err_cond, err_sys, err_code)) {
+        _can_retry = true;
+        return false;
+    }
 
-    const int           retval   = ::SSL_accept(pssl);
-    const ErrorCodeT    err_sys  = last_socket_error();
-    const int           err_cond = ::SSL_get_error(pssl, retval);
-    const unsigned long err_code = ::ERR_get_error();
+    if (!handshake_executor_ptr || err_cond == ssl_error_want_retry_verify) {
+        storeThisPointer();
+        storeContextPointer(&_rctx);
 
-    clearThisPointer();
-    clearContextPointer();
+        ::ERR_clear_error();
+
+        const int retval = ::SSL_accept(pssl);
+        err_sys          = last_socket_error();
+        err_cond         = ::SSL_get_error(pssl, retval);
+        err_code         = ::ERR_get_error();
+
+        clearThisPointer();
+        clearContextPointer();
+    }
 
     switch (err_cond) {
     case SSL_ERROR_NONE:
         _can_retry = false;
+        doCheckKernelTls();
         return true;
     case SSL_ERROR_WANT_READ:
         _can_retry        = true;
@@ -723,24 +1005,36 @@ bool Socket::secureConnect(ReactorContext& _rctx, bool& _can_retry, ErrorCodeT&
 {
     want_read_on_send = want_write_on_send = false;
 
-    storeThisPointer();
-    storeContextPointer(&_rctx);
+    int           err_cond = SSL_ERROR_NONE;
+    ErrorCodeT    err_sys;
+    unsigned long err_code = 0;
 
-    ::ERR_clear_error();
+    if (handshake_executor_ptr && !doOffloadHandshake(_rctx, false, err_cond, err_sys, err_code)) {
+        _can_retry = true;
+        return false;
+    }
 
-    const int           retval   = ::SSL_connect(pssl);
-    const ErrorCodeT    err_sys  = last_socket_error();
-    const int           err_cond = ::SSL_get_error(pssl, retval);
-    const unsigned long err_code = ::ERR_get_error();
+    if (!handshake_executor_ptr || err_cond == ssl_error_want_retry_verify) {
+        storeThisPointer();
+        storeContextPointer(&_rctx);
 
-    clearThisPointer();
-    clearContextPointer();
+        ::ERR_clear_error();
+
+        const int retval = ::SSL_connect(pssl);
+        err_sys          = last_socket_error();
+        err_cond         = ::SSL_get_error(pssl, retval);
+        err_code         = ::ERR_get_error();
 
-    solid_dbg(logger, Verbose, "ssl_connect rv = " << retval << " ssl_error " << err_cond);
+        clearThisPointer();
+        clearContextPointer();
+
+        solid_dbg(logger, Verbose, "ssl_connect rv = " << retval << " ssl_error " << err_cond);
+    }
 
     switch (err_cond) {
     case SSL_ERROR_NONE:
         _can_retry = false;
+        doCheckKernelTls();
         return true;
     case SSL_ERROR_WANT_READ:
         _can_retry        = true;
@@ -845,6 +1139,153 @@ ssize_t Socket::sendTo(ReactorContext& /*_rctx*/, const char* /*_pb*/, size_t /*
     return -1;
 }
 
+ErrorCodeT Socket::setSession(const SessionT& _rsession)
+{
+    ::ERR_clear_error();
+    if (SSL_set_session(pssl, _rsession.psession) == 1) {
+        return ErrorCodeT();
+    }
+    return ssl_category.makeError(::ERR_get_error());
+}
+
+Socket::SessionT Socket::session() const
+{
+    return SessionT(SSL_get1_session(pssl));
+}
+
+bool Socket::isSessionReused() const
+{
+    return SSL_session_reused(pssl) != 0;
+}
+
+/*static*/ int Socket::on_new_session(SSL* _pssl, SSL_SESSION* _psession)
+{
+    Socket* pthis = static_cast<Socket*>(SSL_get_ex_data(_pssl, thisSSLDataIndex()));
+    void*   pctx  = SSL_get_ex_data(_pssl, contextPointerSSLDataIndex());
+
+    if (pthis == nullptr || solid_function_empty(pthis->session_cbk) || SSL_SESSION_is_resumable(_psession) == 0) {
+        return 0;
+    }
+
+    if (pctx == nullptr && pthis->handshake_ptr) {
+        //offloaded handshake - delivered on the reactor thread once the job is done
+        SSL_SESSION* psession = SSL_SESSION_dup(_psession);
+        if (psession != nullptr) {
+            pthis->handshake_ptr->session = SessionT(psession);
+        }
+        return 0;
+    }
+
+#ifdef OPENSSL_IS_BORINGSSL
+    pthis->session_cbk(pctx, SessionT(_psession));
+    return 1; //we've taken ownership of the session reference
+#else
+    //OpenSSL marks the connection's session as not resumable when the
+    //connection is closed without a TLS shutdown - give away a copy
+    SSL_SESSION* psession = SSL_SESSION_dup(_psession);
+    if (psession != nullptr) {
+        pthis->session_cbk(pctx, SessionT(psession));
+    }
+    return 0;
+#endif
+}
+
+//Returns false while the handshake runs on the executor, otherwise
+//returns the outcome of the last handshake step which, when
+//SSL_ERROR_WANT_RETRY_VERIFY, must be redone on the reactor thread.
+bool Socket::doOffloadHandshake(ReactorContext& _rctx, const bool _accept, int& _rerr_cond, ErrorCodeT& _rerr_sys, unsigned long& _rerr_code)
+{
+    using StatusE = HandshakeStub::StatusE;
+
+    if (!handshake_ptr) {
+        handshake_ptr = std::make_shared<HandshakeStub>(*this);
+    }
+
+    HandshakeStub& rstub = *handshake_ptr;
+
+    switch (rstub.status.load()) {
+    case StatusE::Idle:
+        doSubmitHandshake(_rctx, _accept);
+        return false;
+    case StatusE::Queued:
+    case StatusE::Running:
+        //the job might have already given up on reading or writing
+        rstub.missed_event = true;
+        return false;
+    case StatusE::Done:
+        break;
+    default:
+        solid_assert(false);
+        return false;
+    }
+
+    rstub.status = StatusE::Idle;
+
+    _rerr_cond = rstub.err_cond;
+    _rerr_sys  = rstub.err_sys;
+    _rerr_code = rstub.err_code;
+
+    if (!rstub.session.empty()) {
+        SessionT session = std::move(rstub.session);
+        if (!solid_function_empty(session_cbk)) {
+            session_cbk(&_rctx, std::move(session));
+        }
+    }
+
+    solid_dbg(logger, Verbose, "offloaded handshake ssl_error " << _rerr_cond << " missed_event " << rstub.missed_event);
+
+    if ((_rerr_cond == SSL_ERROR_WANT_READ || _rerr_cond == SSL_ERROR_WANT_WRITE) && rstub.missed_event) {
+        doSubmitHandshake(_rctx, _accept);
+        return false;
+    }
+    return true;
+}
+
+void Socket::doSubmitHandshake(ReactorContext& _rctx, const bool _accept)
+{
+    HandshakeStub& rstub = *handshake_ptr;
+
+    rstub.preactor     = &reactor(_rctx);
+    rstub.actuid       = _rctx.actorUid();
+    rstub.chuid        = rstub.preactor->completionHandlerUid(_rctx);
+    rstub.accept       = _accept;
+    rstub.event        = _accept ? ReactorEventRecv : ReactorEventSend; //see Stream's secureAccept/secureConnect
+    rstub.missed_event = false;
+    rstub.status       = HandshakeStub::StatusE::Queued;
+
+    HandshakeStubPointerT stub_ptr = handshake_ptr;
+
+    (*handshake_executor_ptr)([stub_ptr]() { stub_ptr->run(); });
+}
+
+void Socket::doCancelHandshake()
+{
+    using StatusE = HandshakeStub::StatusE;
+
+    if (handshake_ptr) {
+        HandshakeStub& rstub  = *handshake_ptr;
+        StatusE        expect = StatusE::Queued;
+
+        if (!rstub.status.compare_exchange_strong(expect, StatusE::Cancelled)) {
+            while (rstub.status == StatusE::Running || rstub.raising) {
+                std::this_thread::yield();
+            }
+        }
+        rstub.psocket = nullptr;
+    }
+}
+
+void Socket::doCheckKernelTls()
+{
+#if defined(SOLID_OPENSSL_KTLS)
+    //OpenSSL silently keeps the user-space record layer for the directions
+    //not supported by the negotiated cipher or by the kernel
+    ktls_send = BIO_get_ktls_send(::SSL_get_wbio(pssl)) != 0;
+    ktls_recv = BIO_get_ktls_recv(::SSL_get_rbio(pssl)) != 0;
+    solid_dbg(logger, Info, "ktls send = " << ktls_send << " recv = " << ktls_recv << " cipher = " << ::SSL_get_cipher_name(pssl));
+#endif
+}
+
 void Socket::storeContextPointer(void* _pctx)
 {
     if (pssl != nullptr) {
@@ -903,6 +1344,14 @@ ErrorCodeT Socket::doPrepareVerifyCallback(VerifyMaskT _verify_mask)
     solid_check(ssl);
     solid_check(pthis);
 
+#if defined(SOLID_OPENSSL_HANDSHAKE_OFFLOAD)
+    if (pctx == nullptr && pthis->handshake_ptr && !solid_function_empty(pthis->verify_cbk)) {
+        //offloaded handshake - suspend it and redo the verification on the reactor thread
+        SSL_set_retry_verify(ssl);
+        return 1;
+    }
+#endif
+
     if (!solid_function_empty(pthis->verify_cbk)) {
         VerifyContext vctx(x509_ctx);
 
@@ -9,6 +9,7 @@
 //
 #include "solid/system/cassert.hpp"
 #include "solid/system/log.hpp"
+#include "solid/system/memory.hpp"
 
 #include "solid/frame/aio/aioactor.hpp"
 #include "solid/frame/aio/aiocompletion.hpp"
@@ -27,6 +28,16 @@ namespace aio {
 
 Actor::Actor() {}
 
+/*static*/ void* Actor::operator new(std::size_t _sz)
+{
+    return memory_slab_allocate(_sz);
+}
+
+/*static*/ void Actor::operator delete(void* _pv, std::size_t _sz)
+{
+    memory_slab_free(_pv, _sz);
+}
+
 /*virtual*/ void Actor::onEvent(ReactorContext& /*_rctx*/, Event&& /*_uevent*/)
 {
 }
@@ -0,0 +1,940 @@
+// solid/frame/aio/src/aiodnsresolver.cpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#include "solid/frame/aio/aiodnsresolver.hpp"
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiodatagram.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+#include "solid/system/log.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+namespace solid {
+namespace frame {
+namespace aio {
+
+namespace {
+
+enum : uint16_t {
+    TypeA    = 1,
+    TypeAAAA = 28,
+    ClassIN  = 1,
+};
+
+enum : uint16_t {
+    FlagResponse         = 0x8000,
+    FlagTruncated        = 0x0200,
+    FlagRecursionDesired = 0x0100,
+    RCodeMask            = 0x000f,
+    RCodeNameError       = 3,
+};
+
+const size_t header_size    = 12;
+const size_t max_udp_size   = 512; //no EDNS
+const size_t max_name_size  = 253;
+const size_t max_label_size = 63;
+
+using SteadyTimePointT = std::chrono::steady_clock::time_point;
+
+//lowercase, without the trailing dot
+bool normalize_name(std::string& _rname)
+{
+    if (!_rname.empty() && _rname.back() == '.') {
+        _rname.pop_back();
+    }
+    if (_rname.empty() || _rname.size() > max_name_size) {
+        return false;
+    }
+
+    size_t label_size = 0;
+
+    for (auto& c : _rname) {
+        if (c == '.') {
+            if (label_size == 0) {
+                return false;
+            }
+            label_size = 0;
+            continue;
+        }
+        if (!isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_') {
+            return false;
+        }
+        if (++label_size > max_label_size) {
+            return false;
+        }
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+    return true;
+}
+
+//the family code followed by the name
+std::string make_key(const std::string& _name, const SocketInfo::Family _family)
+{
+    std::string key;
+    key.reserve(_name.size() + 1);
+    key += _family == SocketInfo::Inet4 ? '4' : (_family == SocketInfo::Inet6 ? '6' : 'a');
+    key += _name;
+    return key;
+}
+
+bool family_match(const SocketAddressInet& _raddr, const SocketInfo::Family _family)
+{
+    return _family == SocketInfo::AnyFamily || _raddr.family() == _family;
+}
+
+uint16_t load_uint16(const uint8_t* _pb)
+{
+    return static_cast<uint16_t>((_pb[0] << 8) | _pb[1]);
+}
+
+uint32_t load_uint32(const uint8_t* _pb)
+{
+    return (static_cast<uint32_t>(_pb[0]) << 24) | (static_cast<uint32_t>(_pb[1]) << 16) | (static_cast<uint32_t>(_pb[2]) << 8) | _pb[3];
+}
+
+//bound to an ephemeral port picked by the kernel
+ErrorCodeT create_socket(SocketDevice& _rsd, const SocketAddressInet& _raddr)
+{
+    ErrorCodeT err = _rsd.create(_raddr.family(), SocketInfo::Datagram, 0);
+    if (!err) {
+        err = _rsd.bind(SocketAddressInet(_raddr.isInet6() ? "::" : "0.0.0.0"));
+    }
+    return err;
+}
+
+void store_uint16(std::string& _rs, const uint16_t _v)
+{
+    _rs += static_cast<char>(_v >> 8);
+    _rs += static_cast<char>(_v & 0xff);
+}
+
+void build_query(std::string& _rpkt, const uint16_t _id, const std::string& _name, const uint16_t _qtype)
+{
+    _rpkt.clear();
+    _rpkt.reserve(header_size + _name.size() + 6);
+
+    store_uint16(_rpkt, _id);
+    store_uint16(_rpkt, FlagRecursionDesired);
+    store_uint16(_rpkt, 1); //question count
+    store_uint16(_rpkt, 0);
+    store_uint16(_rpkt, 0);
+    store_uint16(_rpkt, 0);
+
+    size_t off = 0;
+    while (off <= _name.size()) {
+        size_t end = _name.find('.', off);
+        if (end == std::string::npos) {
+            end = _name.size();
+        }
+        _rpkt += static_cast<char>(end - off);
+        _rpkt.append(_name, off, end - off);
+        off = end + 1;
+    }
+    _rpkt += '\0';
+
+    store_uint16(_rpkt, _qtype);
+    store_uint16(_rpkt, ClassIN);
+}
+
+bool skip_name(const uint8_t* _pb, const size_t _sz, size_t& _roff)
+{
+    while (_roff < _sz) {
+        const uint8_t len = _pb[_roff];
+        if ((len & 0xc0) == 0xc0) { //compression pointer
+            _roff += 2;
+            return _roff <= _sz;
+        }
+        if ((len & 0xc0) != 0) {
+            return false;
+        }
+        ++_roff;
+        if (len == 0) {
+            return true;
+        }
+        _roff += len;
+    }
+    return false;
+}
+
+enum ParseResultE {
+    ParseInvalidE,
+    ParseSuccessE,
+    ParseNotFoundE,
+    ParseServerFailureE,
+};
+
+ParseResultE parse_response(
+    const char* _pb, const size_t _sz, const std::string& _rquery, const uint16_t _qtype,
+    DnsAddressVectorT& _raddr_vec, uint32_t& _rttl)
+{
+    const uint8_t* pb = reinterpret_cast<const uint8_t*>(_pb);
+
+    //the response must echo the id and the question of the query
+    if (
+        _sz < _rquery.size() || memcmp(_pb, _rquery.data(), 2) != 0 || memcmp(_pb + 4, _rquery.data() + 4, 2) != 0 || memcmp(_pb + header_size, _rquery.data() + header_size, _rquery.size() - header_size) != 0) {
+        return ParseInvalidE;
+    }
+
+    const uint16_t flags = load_uint16(pb + 2);
+
+    if ((flags & FlagResponse) == 0) {
+        return ParseInvalidE;
+    }
+    if ((flags & RCodeMask) == RCodeNameError) {
+        return ParseNotFoundE;
+    }
+    if ((flags & RCodeMask) != 0) {
+        return ParseServerFailureE;
+    }
+
+    const uint16_t answer_count = load_uint16(pb + 6);
+    size_t         off          = _rquery.size();
+
+    _rttl = std::numeric_limits<uint32_t>::max();
+
+    for (uint16_t i = 0; i < answer_count; ++i) {
+        if (!skip_name(pb, _sz, off) || off + 10 > _sz) {
+            break;
+        }
+        const uint16_t type     = load_uint16(pb + off);
+        const uint16_t cls      = load_uint16(pb + off + 2);
+        const uint32_t ttl      = load_uint32(pb + off + 4);
+        const uint16_t data_len = load_uint16(pb + off + 8);
+
+        off += 10;
+
+        if (off + data_len > _sz) {
+            break;
+        }
+        //CNAME records are skipped - recursive servers add the records of the canonical name
+        if (cls == ClassIN && type == _qtype) {
+            SocketAddressInet addr;
+            if (type == TypeA && data_len == 4) {
+                SocketAddressInet::DataArray4T data;
+                memcpy(data.data(), pb + off, data.size());
+                addr.fromBinary(data);
+            } else if (type == TypeAAAA && data_len == 16) {
+                SocketAddressInet::DataArray6T data;
+                memcpy(data.data(), pb + off, data.size());
+                addr.fromBinary(data);
+            }
+            if (!addr.empty()) {
+                _raddr_vec.emplace_back(addr);
+                _rttl = std::min(_rttl, ttl);
+            }
+        }
+        off += data_len;
+    }
+
+    if (_raddr_vec.empty()) {
+        //a truncated answer without addresses is not a proof of absence
+        return (flags & FlagTruncated) != 0 ? ParseServerFailureE : ParseNotFoundE;
+    }
+    return ParseSuccessE;
+}
+
+} //namespace
+
+//-----------------------------------------------------------------------------
+//      DnsConfiguration
+//-----------------------------------------------------------------------------
+
+DnsConfiguration::DnsConfiguration()
+    : resolv_conf_path("/etc/resolv.conf")
+    , hosts_path("/etc/hosts")
+    , timeout(2000)
+    , attempts(2)
+    , min_ttl_seconds(0)
+    , max_ttl_seconds(3600)
+    , negative_ttl_seconds(30)
+    , cache_capacity(10 * 1024)
+{
+}
+
+bool DnsConfiguration::loadResolvConf(const char* _path)
+{
+    std::ifstream ifs(_path);
+    if (!ifs) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(ifs, line)) {
+        std::istringstream iss(line);
+        std::string        word;
+
+        iss >> word;
+        if (word == "nameserver") {
+            std::string       value;
+            SocketAddressInet addr;
+
+            iss >> value;
+            addr.address(value.c_str());
+            if (!addr.empty()) {
+                addr.port(53);
+                nameserver_vec.emplace_back(addr);
+            }
+        } else if (word == "options") {
+            while (iss >> word) {
+                if (word.compare(0, 8, "timeout:") == 0) {
+                    timeout = std::chrono::seconds(atoi(word.c_str() + 8));
+                } else if (word.compare(0, 9, "attempts:") == 0) {
+                    attempts = atoi(word.c_str() + 9);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool DnsConfiguration::loadHosts(const char* _path)
+{
+    std::ifstream ifs(_path);
+    if (!ifs) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(ifs, line)) {
+        const size_t comment_off = line.find('#');
+        if (comment_off != std::string::npos) {
+            line.resize(comment_off);
+        }
+
+        std::istringstream iss(line);
+        std::string        value;
+        SocketAddressInet  addr;
+
+        iss >> value;
+        addr.address(value.c_str());
+        if (addr.empty()) {
+            continue;
+        }
+        while (iss >> value) {
+            host_vec.emplace_back(value, addr);
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+//      DnsResolver::Data
+//-----------------------------------------------------------------------------
+
+struct DnsResolver::Data {
+    using ExpireMapT = std::multimap<SteadyTimePointT, std::string>; //cache keys ordered by expire time
+
+    struct CacheEntry {
+        DnsAddressVectorPointerT addr_ptr;
+        ErrorConditionT          error;
+        SteadyTimePointT         expire_time;
+        ExpireMapT::iterator     expire_it;
+    };
+
+    using CacheMapT       = std::unordered_map<std::string, CacheEntry>;
+    using FunctionVectorT = std::vector<DnsResolveFunctionT>;
+    using PendingMapT     = std::unordered_map<std::string, FunctionVectorT>;
+    using HostMapT        = std::unordered_multimap<std::string, SocketAddressInet>;
+    using StringDequeT    = std::deque<std::string>;
+
+    DnsConfiguration    config;
+    HostMapT            host_map;
+    mutable std::mutex  mutex;
+    Manager*            pmanager = nullptr;
+    ActorIdT            actor_id;
+    bool                running = false;
+    CacheMapT           cache_map;
+    ExpireMapT          expire_map;
+    PendingMapT         pending_map; //requests waiting for a lookup
+    StringDequeT        query_dq; //lookups not yet taken by the actor
+    std::atomic<size_t> cache_hit_count{0};
+    std::atomic<size_t> coalesced_count{0};
+    std::atomic<size_t> query_count{0};
+
+    Data(DnsConfiguration const& _rcfg)
+        : config(_rcfg)
+    {
+        if (config.nameserver_vec.empty() && !config.resolv_conf_path.empty()) {
+            config.loadResolvConf(config.resolv_conf_path.c_str());
+        }
+        if (config.nameserver_vec.empty()) {
+            config.nameserver_vec.emplace_back("127.0.0.1", 53);
+        }
+        for (auto& addr : config.nameserver_vec) {
+            if (addr.port() == 0) {
+                addr.port(53);
+            }
+        }
+        if (config.attempts == 0) {
+            config.attempts = 1;
+        }
+        if (!config.hosts_path.empty()) {
+            config.loadHosts(config.hosts_path.c_str());
+        }
+        for (const auto& host : config.host_vec) {
+            std::string name = host.first;
+            if (normalize_name(name)) {
+                host_map.emplace(std::move(name), host.second);
+            }
+        }
+    }
+
+    void complete(const std::string& _key, DnsAddressVectorPointerT const& _raddr_ptr, ErrorConditionT const& _rerr, const uint32_t _ttl_seconds);
+    void stop();
+
+    void cacheErase(CacheMapT::iterator _it)
+    {
+        expire_map.erase(_it->second.expire_it);
+        cache_map.erase(_it);
+    }
+
+    void cacheClear()
+    {
+        expire_map.clear();
+        cache_map.clear();
+    }
+};
+
+//called on the actor's thread
+void DnsResolver::Data::complete(
+    const std::string& _key, DnsAddressVectorPointerT const& _raddr_ptr,
+    ErrorConditionT const& _rerr, const uint32_t _ttl_seconds)
+{
+    FunctionVectorT fnc_vec;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (_ttl_seconds != 0 && config.cache_capacity != 0) {
+            const SteadyTimePointT now         = std::chrono::steady_clock::now();
+            const SteadyTimePointT expire_time = now + std::chrono::seconds(_ttl_seconds);
+            const auto             it          = cache_map.find(_key);
+
+            if (it != cache_map.end()) {
+                cacheErase(it);
+            }
+            //drop the expired entries then, while full, the ones closest to expiring
+            while (!expire_map.empty() && (expire_map.begin()->first <= now || cache_map.size() >= config.cache_capacity)) {
+                cacheErase(cache_map.find(expire_map.begin()->second));
+            }
+            cache_map.emplace(_key, CacheEntry{_raddr_ptr, _rerr, expire_time, expire_map.emplace(expire_time, _key)});
+        }
+
+        auto it = pending_map.find(_key);
+        if (it != pending_map.end()) {
+            fnc_vec = std::move(it->second);
+            pending_map.erase(it);
+        }
+    }
+    solid_dbg(logger, Verbose, "resolved " << _key << " for " << fnc_vec.size() << " requests: " << _rerr.message());
+    for (auto& fnc : fnc_vec) {
+        fnc(_raddr_ptr, _rerr);
+    }
+}
+
+void DnsResolver::Data::stop()
+{
+    PendingMapT tmp_map;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+        tmp_map.swap(pending_map);
+        query_dq.clear();
+    }
+    for (auto& pending : tmp_map) {
+        for (auto& fnc : pending.second) {
+            fnc(DnsAddressVectorPointerT(), error_dns_stopped);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+//      DnsResolver::Client
+//-----------------------------------------------------------------------------
+
+//! The actor querying the nameservers
+/*!
+    Every query attempt goes out on its own UDP socket, bound to an
+    ephemeral port picked by the kernel, so that a spoofed response has to
+    guess the port as well as the id. A lookup for AnyFamily sends both an
+    A and an AAAA query. Queries not answered in time are resent to the next
+    nameserver, at most attempts times for every nameserver.
+*/
+class DnsResolver::Client final : public aio::Actor {
+    using DatagramT = Datagram<Socket>;
+
+    struct Channel {
+        Channel(ActorProxy const& _rproxy, SocketAddressInet const& _raddr, std::string const& _rpacket)
+            : sock(_rproxy)
+            , address(_raddr)
+            , packet(_rpacket)
+        {
+        }
+
+        DatagramT         sock;
+        SocketAddressInet address;
+        std::string       packet;
+        char              recv_buf[max_udp_size];
+    };
+
+    using ChannelPointerT = std::unique_ptr<Channel>;
+    using ChannelVectorT  = std::vector<ChannelPointerT>;
+
+    struct Query {
+        std::string      key;
+        std::string      packet;
+        uint16_t         type     = 0;
+        size_t           attempt  = 0;
+        SteadyTimePointT deadline = {};
+        ChannelPointerT  channel_ptr;
+    };
+
+    struct Lookup {
+        size_t            pending_count = 0;
+        DnsAddressVectorT addr_vec;
+        uint32_t          ttl = std::numeric_limits<uint32_t>::max();
+        ErrorConditionT   error;
+    };
+
+    using QueryMapT  = std::unordered_map<uint16_t, Query>;
+    using LookupMapT = std::unordered_map<std::string, Lookup>;
+
+    std::shared_ptr<Data> data_ptr_;
+    SteadyTimer           timer_;
+    bool                  timer_armed_ = false;
+    QueryMapT             query_map_;
+    LookupMapT            lookup_map_;
+    ChannelVectorT        retired_vec_; //closed outside their own callbacks
+    std::mt19937          random_;
+
+public:
+    Client(std::shared_ptr<Data> const& _rdata_ptr)
+        : data_ptr_(_rdata_ptr)
+        , timer_(this->proxy())
+        , random_(std::random_device()())
+    {
+    }
+
+    ~Client()
+    {
+        data_ptr_->stop();
+    }
+
+private:
+    void onEvent(ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_start || _revent == generic_event_raise) {
+            doDispatch(_rctx);
+        } else if (_revent == generic_event_kill) {
+            postStop(_rctx);
+        }
+    }
+
+    void postRecv(ReactorContext& _rctx, const uint16_t _id, Channel& _rchannel)
+    {
+        Channel* pchannel = &_rchannel;
+        _rchannel.sock.postRecvFrom(
+            _rctx, _rchannel.recv_buf, max_udp_size,
+            [this, _id, pchannel](ReactorContext& _rctx, SocketAddress& _raddr, size_t _sz) {
+                onRecv(_rctx, _id, *pchannel, _raddr, _sz);
+            });
+    }
+
+    void onRecv(ReactorContext& _rctx, const uint16_t _id, Channel& _rchannel, SocketAddress& _raddr, const size_t _sz)
+    {
+        const auto it = query_map_.find(_id);
+
+        if (it == query_map_.end() || it->second.channel_ptr.get() != &_rchannel) {
+            //the channel was retired
+            return;
+        }
+
+        if (_rctx.error()) {
+            //e.g. an ICMP port unreachable from the send
+            solid_log(logger, Warning, "recv from " << _rchannel.address << ": " << _rctx.error().message() << " " << _rctx.systemError().message());
+        } else {
+            const SocketAddressInet from(SocketAddressStub{_raddr});
+            if (from == _rchannel.address && from.port() == _rchannel.address.port() && doHandleResponse(_rctx, it, _rchannel.recv_buf, _sz)) {
+                return;
+            }
+        }
+        postRecv(_rctx, _id, _rchannel);
+    }
+
+    void doDispatch(ReactorContext& _rctx)
+    {
+        Data::StringDequeT key_dq;
+        {
+            std::lock_guard<std::mutex> lock(data_ptr_->mutex);
+            key_dq.swap(data_ptr_->query_dq);
+        }
+
+        for (const auto& key : key_dq) {
+            const std::string name = key.substr(1);
+
+            lookup_map_[key];
+
+            if (key[0] != '6') {
+                doStartQuery(_rctx, key, name, TypeA);
+            }
+            if (key[0] != '4') {
+                doStartQuery(_rctx, key, name, TypeAAAA);
+            }
+        }
+    }
+
+    void doStartQuery(ReactorContext& _rctx, const std::string& _key, const std::string& _name, const uint16_t _type)
+    {
+        uint16_t id;
+        do {
+            id = static_cast<uint16_t>(random_());
+        } while (query_map_.find(id) != query_map_.end());
+
+        Query& rquery = query_map_[id];
+
+        rquery.key  = _key;
+        rquery.type = _type;
+        build_query(rquery.packet, id, _name, _type);
+
+        ++lookup_map_[_key].pending_count;
+
+        doSendQuery(_rctx, id, rquery);
+    }
+
+    void doSendQuery(ReactorContext& _rctx, const uint16_t _id, Query& _rquery)
+    {
+        DnsConfiguration const&  rconfig = data_ptr_->config;
+        SocketAddressInet const& raddr   = rconfig.nameserver_vec[_rquery.attempt % rconfig.nameserver_vec.size()];
+        SocketDevice             sd;
+
+        _rquery.deadline = _rctx.steadyTime() + rconfig.timeout;
+        ++data_ptr_->query_count;
+
+        doRetireChannel(_rctx, _rquery);
+
+        const ErrorCodeT err = create_socket(sd, raddr);
+
+        if (!err) {
+            _rquery.channel_ptr.reset(new Channel(this->proxy(), raddr, _rquery.packet));
+
+            Channel* pchannel = _rquery.channel_ptr.get();
+
+            pchannel->sock.reset(_rctx, std::move(sd));
+            postRecv(_rctx, _id, *pchannel);
+            pchannel->sock.postSendTo(
+                _rctx, pchannel->packet.data(), pchannel->packet.size(), pchannel->address,
+                [pchannel](ReactorContext& _rctx) {
+                    if (_rctx.error()) {
+                        //the query will time out
+                        solid_log(logger, Warning, "send to " << pchannel->address << ": " << _rctx.error().message());
+                    }
+                });
+        } else {
+            //the query will time out
+            solid_log(logger, Warning, "socket for " << raddr << ": " << err.message());
+        }
+
+        doArmTimer(_rctx);
+    }
+
+    void doRetireChannel(ReactorContext& _rctx, Query& _rquery)
+    {
+        if (!_rquery.channel_ptr) {
+            return;
+        }
+        if (retired_vec_.empty()) {
+            this->post(
+                _rctx,
+                [this](ReactorContext& /*_rctx*/, Event&& /*_revent*/) {
+                    retired_vec_.clear();
+                });
+        }
+        retired_vec_.emplace_back(std::move(_rquery.channel_ptr));
+    }
+
+    //! Returns true if the response was for the query
+    bool doHandleResponse(ReactorContext& _rctx, QueryMapT::iterator _it, const char* _pb, const size_t _sz)
+    {
+        if (_sz < header_size || load_uint16(reinterpret_cast<const uint8_t*>(_pb)) != _it->first) {
+            return false;
+        }
+
+        DnsAddressVectorT addr_vec;
+        uint32_t          ttl = 0;
+
+        switch (parse_response(_pb, _sz, _it->second.packet, _it->second.type, addr_vec, ttl)) {
+        case ParseInvalidE:
+            return false;
+        case ParseSuccessE:
+            doCompleteQuery(_rctx, _it, std::move(addr_vec), ttl, ErrorConditionT());
+            break;
+        case ParseNotFoundE:
+            doCompleteQuery(_rctx, _it, std::move(addr_vec), 0, error_dns_not_found);
+            break;
+        case ParseServerFailureE:
+            doRetryQuery(_rctx, _it, error_dns_server);
+            break;
+        }
+        return true;
+    }
+
+    void doRetryQuery(ReactorContext& _rctx, QueryMapT::iterator _it, ErrorConditionT const& _rerr)
+    {
+        Query& rquery = _it->second;
+
+        if (++rquery.attempt < data_ptr_->config.attempts * data_ptr_->config.nameserver_vec.size()) {
+            doSendQuery(_rctx, _it->first, rquery);
+        } else {
+            doCompleteQuery(_rctx, _it, DnsAddressVectorT(), 0, _rerr);
+        }
+    }
+
+    void doCompleteQuery(ReactorContext& _rctx, QueryMapT::iterator _it, DnsAddressVectorT&& _raddr_vec, const uint32_t _ttl, ErrorConditionT const& _rerr)
+    {
+        const std::string key = std::move(_it->second.key);
+
+        doRetireChannel(_rctx, _it->second);
+
+        query_map_.erase(_it);
+
+        Lookup& rlookup = lookup_map_[key];
+
+        --rlookup.pending_count;
+
+        if (!_rerr) {
+            rlookup.addr_vec.insert(rlookup.addr_vec.end(), _raddr_vec.begin(), _raddr_vec.end());
+            rlookup.ttl = std::min(rlookup.ttl, _ttl);
+        } else if (_rerr != error_dns_not_found) {
+            rlookup.error = _rerr;
+        }
+
+        if (rlookup.pending_count == 0) {
+            doCompleteLookup(key, std::move(rlookup));
+            lookup_map_.erase(key);
+        }
+    }
+
+    void doCompleteLookup(const std::string& _key, Lookup&& _rlookup)
+    {
+        DnsConfiguration const& rconfig = data_ptr_->config;
+
+        if (!_rlookup.addr_vec.empty()) {
+            const uint32_t ttl = std::min(std::max(_rlookup.ttl, rconfig.min_ttl_seconds), rconfig.max_ttl_seconds);
+            data_ptr_->complete(_key, std::make_shared<const DnsAddressVectorT>(std::move(_rlookup.addr_vec)), ErrorConditionT(), ttl);
+        } else if (_rlookup.error) {
+            //transient errors are not cached
+            data_ptr_->complete(_key, DnsAddressVectorPointerT(), _rlookup.error, 0);
+        } else {
+            data_ptr_->complete(_key, DnsAddressVectorPointerT(), error_dns_not_found, rconfig.negative_ttl_seconds);
+        }
+    }
+
+    void doArmTimer(ReactorContext& _rctx)
+    {
+        if (timer_armed_ || query_map_.empty()) {
+            return;
+        }
+
+        SteadyTimePointT deadline = SteadyTimePointT::max();
+
+        for (const auto& query : query_map_) {
+            deadline = std::min(deadline, query.second.deadline);
+        }
+
+        timer_armed_ = true;
+        timer_.waitUntil(
+            _rctx, deadline,
+            [this](ReactorContext& _rctx) {
+                onTimer(_rctx);
+            });
+    }
+
+    void onTimer(ReactorContext& _rctx)
+    {
+        timer_armed_ = false;
+
+        if (_rctx.error()) {
+            return;
+        }
+
+        const SteadyTimePointT now = _rctx.steadyTime();
+        std::vector<uint16_t>  id_vec;
+
+        for (const auto& query : query_map_) {
+            if (query.second.deadline <= now) {
+                id_vec.emplace_back(query.first);
+            }
+        }
+
+        for (const auto id : id_vec) {
+            const auto it = query_map_.find(id);
+            if (it != query_map_.end()) {
+                solid_dbg(logger, Info, "timeout " << it->second.key << " attempt " << it->second.attempt);
+                doRetryQuery(_rctx, it, error_dns_timeout);
+            }
+        }
+        doArmTimer(_rctx);
+    }
+};
+
+//-----------------------------------------------------------------------------
+//      DnsResolver
+//-----------------------------------------------------------------------------
+
+DnsResolver::DnsResolver(DnsConfiguration const& _rcfg)
+    : impl_ptr_(std::make_shared<Data>(_rcfg))
+{
+}
+
+DnsResolver::~DnsResolver()
+{
+}
+
+ErrorConditionT DnsResolver::start(SchedulerT& _rsch, Service& _rsvc)
+{
+    Data&                       rdata = *impl_ptr_;
+    ErrorConditionT             err;
+    std::lock_guard<std::mutex> lock(rdata.mutex);
+
+    if (rdata.running) {
+        return error_already;
+    }
+
+    rdata.pmanager = &_rsvc.manager();
+    rdata.actor_id = _rsch.startActor(make_dynamic<Client>(impl_ptr_), _rsvc, make_event(GenericEvents::Start), err);
+    rdata.running  = !err;
+    return err;
+}
+
+void DnsResolver::doRequestResolve(DnsResolveFunctionT& _rfnc, const std::string& _host, const SocketInfo::Family _family)
+{
+    Data& rdata = *impl_ptr_;
+    {
+        SocketAddressInet addr;
+        addr.address(_host.c_str());
+        if (!addr.empty()) {
+            if (family_match(addr, _family)) {
+                _rfnc(std::make_shared<const DnsAddressVectorT>(1, addr), ErrorConditionT());
+            } else {
+                _rfnc(DnsAddressVectorPointerT(), error_dns_not_found);
+            }
+            return;
+        }
+    }
+
+    std::string name = _host;
+
+    if (!normalize_name(name)) {
+        _rfnc(DnsAddressVectorPointerT(), error_dns_invalid_name);
+        return;
+    }
+
+    {
+        const auto range = rdata.host_map.equal_range(name);
+        if (range.first != range.second) {
+            auto addr_vec_ptr = std::make_shared<DnsAddressVectorT>();
+            for (auto it = range.first; it != range.second; ++it) {
+                if (family_match(it->second, _family)) {
+                    addr_vec_ptr->emplace_back(it->second);
+                }
+            }
+            if (!addr_vec_ptr->empty()) {
+                _rfnc(addr_vec_ptr, ErrorConditionT());
+                return;
+            }
+        }
+    }
+
+    const std::string key    = make_key(name, _family);
+    bool              notify = false;
+    {
+        std::unique_lock<std::mutex> lock(rdata.mutex);
+        const auto                   it = rdata.cache_map.find(key);
+
+        if (it != rdata.cache_map.end()) {
+            if (it->second.expire_time > std::chrono::steady_clock::now()) {
+                const Data::CacheEntry entry = it->second;
+
+                lock.unlock();
+                ++rdata.cache_hit_count;
+                _rfnc(entry.addr_ptr, entry.error);
+                return;
+            }
+            rdata.cacheErase(it);
+        }
+
+        if (!rdata.running) {
+            lock.unlock();
+            _rfnc(DnsAddressVectorPointerT(), error_dns_stopped);
+            return;
+        }
+
+        auto& rfnc_vec = rdata.pending_map[key];
+
+        rfnc_vec.emplace_back(std::move(_rfnc));
+
+        if (rfnc_vec.size() == 1) {
+            rdata.query_dq.emplace_back(key);
+            notify = rdata.query_dq.size() == 1;
+        } else {
+            ++rdata.coalesced_count;
+        }
+    }
+    if (notify) {
+        //if the actor is gone, it has already failed the pending requests
+        rdata.pmanager->notify(rdata.actor_id, make_event(GenericEvents::Raise));
+    }
+}
+
+void DnsResolver::clearCache()
+{
+    std::lock_guard<std::mutex> lock(impl_ptr_->mutex);
+    impl_ptr_->cacheClear();
+}
+
+size_t DnsResolver::cacheSize() const
+{
+    std::lock_guard<std::mutex> lock(impl_ptr_->mutex);
+    return impl_ptr_->cache_map.size();
+}
+
+size_t DnsResolver::cacheHitCount() const
+{
+    return impl_ptr_->cache_hit_count;
+}
+
+size_t DnsResolver::coalescedCount() const
+{
+    return impl_ptr_->coalesced_count;
+}
+
+size_t DnsResolver::queryCount() const
+{
+    return impl_ptr_->query_count;
+}
+
+} //namespace aio
+} //namespace frame
+} //namespace solid
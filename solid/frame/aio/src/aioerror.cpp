@@ -20,6 +20,11 @@ namespace {
 enum {
     ErrorResolverDirectE = 1,
     ErrorResolverReverseE,
+    ErrorDnsInvalidNameE,
+    ErrorDnsNotFoundE,
+    ErrorDnsServerE,
+    ErrorDnsTimeoutE,
+    ErrorDnsStoppedE,
     ErrorAlreadyE,
     ErrorDatagramShutdownE,
     ErrorDatagramSystemE,
@@ -68,6 +73,21 @@ std::string ErrorCategory::message(int _ev) const
     case ErrorResolverReverseE:
         oss << "Resolver: reverse";
         break;
+    case ErrorDnsInvalidNameE:
+        oss << "DNS: invalid name";
+        break;
+    case ErrorDnsNotFoundE:
+        oss << "DNS: name not found";
+        break;
+    case ErrorDnsServerE:
+        oss << "DNS: server failure";
+        break;
+    case ErrorDnsTimeoutE:
+        oss << "DNS: timeout";
+        break;
+    case ErrorDnsStoppedE:
+        oss << "DNS: resolver stopped";
+        break;
     case ErrorAlreadyE:
         oss << "Opperation already in progress";
         break;
@@ -134,6 +154,12 @@ std::string ErrorCategory::message(int _ev) const
 /*extern*/ const ErrorCodeT error_resolver_direct(ErrorResolverDirectE, category);
 /*extern*/ const ErrorCodeT error_resolver_reverse(ErrorResolverReverseE, category);
 
+/*extern*/ const ErrorConditionT error_dns_invalid_name(ErrorDnsInvalidNameE, category);
+/*extern*/ const ErrorConditionT error_dns_not_found(ErrorDnsNotFoundE, category);
+/*extern*/ const ErrorConditionT error_dns_server(ErrorDnsServerE, category);
+/*extern*/ const ErrorConditionT error_dns_timeout(ErrorDnsTimeoutE, category);
+/*extern*/ const ErrorConditionT error_dns_stopped(ErrorDnsStoppedE, category);
+
 /*extern*/ const ErrorConditionT error_already(ErrorAlreadyE, category);
 
 /*extern*/ const ErrorConditionT error_datagram_shutdown(ErrorDatagramShutdownE, category);
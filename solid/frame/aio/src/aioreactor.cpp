@@ -15,6 +15,7 @@
 
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
+#include <sys/socket.h>
 
 #elif defined(SOLID_USE_KQUEUE)
 
@@ -28,9 +29,11 @@
 #endif
 
 #include <cerrno>
+#include <chrono>
 #include <cstring>
 #include <deque>
 #include <queue>
+#include <typeinfo>
 #include <vector>
 
 #include "solid/system/device.hpp"
@@ -80,6 +83,24 @@ inline size_t voidToIndex(const void* _ptr)
     return reinterpret_cast<size_t>(_ptr);
 }
 #endif
+#if defined(SOLID_USE_EPOLL)
+//the epoll user data holds both the completion handler index and its unique
+//so that events for an unregistered (and maybe reused) slot are dropped
+inline uint64_t channelToData(const size_t _idx, const UniqueT _unique)
+{
+    return (static_cast<uint64_t>(_unique) << 32) | static_cast<uint64_t>(_idx);
+}
+
+inline size_t dataToChannelIndex(const uint64_t _data)
+{
+    return static_cast<size_t>(_data & 0xffffffffULL);
+}
+
+inline UniqueT dataToChannelUnique(const uint64_t _data)
+{
+    return static_cast<UniqueT>(_data >> 32);
+}
+#endif
 } //namespace
 
 //=============================================================================
@@ -88,6 +109,153 @@ typedef std::atomic<bool>   AtomicBoolT;
 typedef std::atomic<size_t> AtomicSizeT;
 typedef Reactor::TaskT      TaskT;
 
+#ifdef SOLID_HAS_STATISTICS
+using SteadyTimePointT = std::chrono::steady_clock::time_point;
+using AtomicUInt64T    = std::atomic<uint64_t>;
+
+namespace {
+
+//only the reactor thread writes the statistic values
+inline void statistic_add(AtomicUInt64T& _rv, const uint64_t _by)
+{
+    _rv.store(_rv.load(std::memory_order_relaxed) + _by, std::memory_order_relaxed);
+}
+
+inline void statistic_max(AtomicUInt64T& _rv, const uint64_t _nv)
+{
+    if (_rv.load(std::memory_order_relaxed) < _nv) {
+        _rv.store(_nv, std::memory_order_relaxed);
+    }
+}
+
+inline uint64_t statistic_nanoseconds(SteadyTimePointT const& _rfrom, SteadyTimePointT const& _rto)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(_rto - _rfrom).count());
+}
+
+} //namespace
+
+struct ReactorStatisticData {
+    struct ActorType {
+        std::atomic<const std::type_info*> ptype_{nullptr};
+        AtomicUInt64T                      call_count_{0};
+        AtomicUInt64T                      time_ns_{0};
+    };
+
+    AtomicUInt64T loop_count_{0};
+    AtomicUInt64T io_event_count_{0};
+    AtomicUInt64T io_event_max_{0};
+    AtomicUInt64T io_time_ns_{0};
+    AtomicUInt64T timer_time_ns_{0};
+    AtomicUInt64T event_time_ns_{0};
+    AtomicUInt64T exec_time_ns_{0};
+    AtomicUInt64T raise_count_{0};
+    AtomicUInt64T raise_latency_total_ns_{0};
+    AtomicUInt64T raise_latency_max_ns_{0};
+    AtomicUInt64T exec_depth_histogram_[ReactorStatistic::exec_depth_bucket_count];
+    AtomicSizeT   actor_type_count_{0};
+    ActorType     actor_type_arr_[ReactorStatistic::actor_type_capacity + 1]; //the last one for the other types
+
+    ReactorStatisticData()
+    {
+        for (auto& v : exec_depth_histogram_) {
+            v = 0;
+        }
+    }
+
+    //adds the time from _rtp to now to _rv and moves _rtp to now
+    void stage(AtomicUInt64T& _rv, SteadyTimePointT& _rtp, SteadyTimePointT const& _rnow)
+    {
+        statistic_add(_rv, statistic_nanoseconds(_rtp, _rnow));
+        _rtp = _rnow;
+    }
+
+    void ioEvents(const size_t _cnt)
+    {
+        statistic_add(io_event_count_, _cnt);
+        statistic_max(io_event_max_, _cnt);
+    }
+
+    void execDepth(size_t _depth)
+    {
+        size_t idx = 0;
+        while (_depth != 0 && idx < (ReactorStatistic::exec_depth_bucket_count - 1)) {
+            ++idx;
+            _depth >>= 1;
+        }
+        statistic_add(exec_depth_histogram_[idx], 1);
+    }
+
+    void raiseLatency(SteadyTimePointT const& _rraise_tp, SteadyTimePointT const& _rnow)
+    {
+        const uint64_t ns = statistic_nanoseconds(_rraise_tp, _rnow);
+        statistic_add(raise_count_, 1);
+        statistic_add(raise_latency_total_ns_, ns);
+        statistic_max(raise_latency_max_ns_, ns);
+    }
+
+    void actorCall(const std::type_info& _rtype, SteadyTimePointT const& _rstart, SteadyTimePointT const& _rend)
+    {
+        ActorType& ratype = actorType(_rtype);
+        statistic_add(ratype.call_count_, 1);
+        statistic_add(ratype.time_ns_, statistic_nanoseconds(_rstart, _rend));
+    }
+
+    ActorType& actorType(const std::type_info& _rtype)
+    {
+        const size_t cnt = actor_type_count_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < cnt; ++i) {
+            const std::type_info* ptype = actor_type_arr_[i].ptype_.load(std::memory_order_relaxed);
+            if (ptype == &_rtype || *ptype == _rtype) {
+                return actor_type_arr_[i];
+            }
+        }
+        if (cnt < ReactorStatistic::actor_type_capacity) {
+            actor_type_arr_[cnt].ptype_.store(&_rtype, std::memory_order_relaxed);
+            actor_type_count_.store(cnt + 1, std::memory_order_release);
+            return actor_type_arr_[cnt];
+        }
+        return actor_type_arr_[ReactorStatistic::actor_type_capacity];
+    }
+
+    void fill(ReactorStatistic& _rstat) const
+    {
+        _rstat.loop_count_             = loop_count_;
+        _rstat.io_event_count_         = io_event_count_;
+        _rstat.io_event_max_           = io_event_max_;
+        _rstat.io_time_ns_             = io_time_ns_;
+        _rstat.timer_time_ns_          = timer_time_ns_;
+        _rstat.event_time_ns_          = event_time_ns_;
+        _rstat.exec_time_ns_           = exec_time_ns_;
+        _rstat.raise_count_            = raise_count_;
+        _rstat.raise_latency_total_ns_ = raise_latency_total_ns_;
+        _rstat.raise_latency_max_ns_   = raise_latency_max_ns_;
+
+        for (size_t i = 0; i < ReactorStatistic::exec_depth_bucket_count; ++i) {
+            _rstat.exec_depth_histogram_[i] = exec_depth_histogram_[i];
+        }
+
+        const size_t cnt = actor_type_count_.load(std::memory_order_acquire);
+
+        _rstat.actor_type_vec_.clear();
+        for (size_t i = 0; i < cnt; ++i) {
+            const ActorType& ratype = actor_type_arr_[i];
+            _rstat.actor_type_vec_.emplace_back();
+            _rstat.actor_type_vec_.back().name_       = ratype.ptype_.load(std::memory_order_relaxed)->name();
+            _rstat.actor_type_vec_.back().call_count_ = ratype.call_count_;
+            _rstat.actor_type_vec_.back().time_ns_    = ratype.time_ns_;
+        }
+
+        const ActorType& rother = actor_type_arr_[ReactorStatistic::actor_type_capacity];
+        if (rother.call_count_ != 0) {
+            _rstat.actor_type_vec_.emplace_back();
+            _rstat.actor_type_vec_.back().call_count_ = rother.call_count_;
+            _rstat.actor_type_vec_.back().time_ns_    = rother.time_ns_;
+        }
+    }
+};
+#endif
+
 //=============================================================================
 //  EventHandler
 //=============================================================================
@@ -285,34 +453,83 @@ struct RaiseEventStub {
         RaiseEventStub&& _uevs) noexcept
         : uid(_uevs.uid)
         , event(std::move(_uevs.event))
+#ifdef SOLID_HAS_STATISTICS
+        , raise_time(_uevs.raise_time)
+#endif
     {
     }
 
     UniqueId uid;
     Event    event;
+#ifdef SOLID_HAS_STATISTICS
+    SteadyTimePointT raise_time = std::chrono::steady_clock::now();
+#endif
 };
 
 //=============================================================================
 
+//NOTE: a reactor event raised from another thread directly onto
+//a completion handler - e.g. the end of a TLS handshake offloaded
+//to a worker thread
+struct RaiseCompletionStub {
+    RaiseCompletionStub(
+        UniqueId const& _ractuid, UniqueId const& _rchuid, const ReactorEventsE _revent)
+        : actuid(_ractuid)
+        , chuid(_rchuid)
+        , event(_revent)
+    {
+    }
+
+    UniqueId       actuid;
+    UniqueId       chuid;
+    ReactorEventsE event;
+};
+
+//=============================================================================
+
+//NOTE: raise_index is the position within the raise vector
+//at the moment of the broadcast - used to keep the order of the events
+struct RaiseBroadcastStub {
+    RaiseBroadcastStub(
+        const size_t _raise_index, UniqueIdVectorT&& _uuid_vec, Event const& _revent)
+        : raise_index(_raise_index)
+        , uid_vec(std::move(_uuid_vec))
+        , event(_revent)
+    {
+    }
+
+    RaiseBroadcastStub(const RaiseBroadcastStub&) = delete;
+    RaiseBroadcastStub(
+        RaiseBroadcastStub&& _ubs) noexcept
+        : raise_index(_ubs.raise_index)
+        , uid_vec(std::move(_ubs.uid_vec))
+        , event(std::move(_ubs.event))
+    {
+    }
+
+    size_t          raise_index;
+    UniqueIdVectorT uid_vec;
+    Event           event;
+};
+
+//=============================================================================
+
+//NOTE: only the fields needed for dispatching an event are kept here,
+//packed on 16 bytes within a contiguous vector - four stubs per cache line.
+//Rarely used per handler data goes on separate parallel vectors.
 struct CompletionHandlerStub {
     CompletionHandlerStub(
         CompletionHandler* _pch    = nullptr,
-        const size_t       _actidx = InvalidIndex())
+        const size_t       _actidx = 0)
         : pch(_pch)
-        , actidx(_actidx)
+        , actidx(static_cast<uint32_t>(_actidx))
         , unique(0)
-#if defined(SOLID_USE_WSAPOLL)
-        , connectidx(InvalidIndex())
-#endif
     {
     }
 
     CompletionHandler* pch;
-    size_t             actidx;
+    uint32_t           actidx;
     UniqueT            unique;
-#if defined(SOLID_USE_WSAPOLL)
-    size_t connectidx;
-#endif
 };
 
 //=============================================================================
@@ -336,6 +553,10 @@ enum {
     MaxEventCapacity = 1024 * 64
 };
 
+//backoff for rechecking the grace period of the stopping actors
+constexpr std::chrono::microseconds grace_backoff_min{1000};
+constexpr std::chrono::microseconds grace_backoff_max{64 * 1000};
+
 //=============================================================================
 
 struct ExecStub {
@@ -372,6 +593,9 @@ struct ExecStub {
         : actuid(_res.actuid)
         , chnuid(_res.chnuid)
         , event(std::move(_res.event))
+#ifdef SOLID_HAS_STATISTICS
+        , raise_time(_res.raise_time)
+#endif
     {
         std::swap(exefnc, _res.exefnc);
     }
@@ -380,12 +604,17 @@ struct ExecStub {
     UniqueId                chnuid;
     Reactor::EventFunctionT exefnc;
     Event                   event;
+#ifdef SOLID_HAS_STATISTICS
+    SteadyTimePointT raise_time; //not set for the stubs that were not raised
+#endif
 };
 
 //=============================================================================
 
-typedef std::vector<NewTaskStub>    NewTaskVectorT;
-typedef std::vector<RaiseEventStub> RaiseEventVectorT;
+typedef std::vector<NewTaskStub>         NewTaskVectorT;
+typedef std::vector<RaiseEventStub>      RaiseEventVectorT;
+typedef std::vector<RaiseBroadcastStub>  RaiseBroadcastVectorT;
+typedef std::vector<RaiseCompletionStub> RaiseCompletionVectorT;
 
 #if defined(SOLID_USE_EPOLL)
 
@@ -411,13 +640,14 @@ using EventVectorT = std::vector<PollStub>;
 
 #endif
 
-using CompletionHandlerDequeT = std::deque<CompletionHandlerStub>;
-using UidVectorT              = std::vector<UniqueId>;
-using ActorDequeT             = std::deque<ActorStub>;
-using ExecQueueT              = Queue<ExecStub>;
-using SizeStackT              = Stack<size_t>;
-using TimeStoreT              = TimeStore<size_t>;
-using SizeTVectorT            = std::vector<size_t>;
+using CompletionHandlerVectorT = std::vector<CompletionHandlerStub>;
+using UidVectorT               = std::vector<UniqueId>;
+using ActorDequeT              = std::deque<ActorStub>;
+using ExecQueueT               = Queue<ExecStub>;
+using SizeStackT               = Stack<size_t>;
+using TimeStoreT               = TimeStore<size_t>;
+using SizeTVectorT             = std::vector<size_t>;
+using MicrosecondsT            = std::chrono::microseconds;
 
 //=============================================================================
 //  Reactor::Data
@@ -435,24 +665,80 @@ struct Reactor::Data {
         , devcnt(0)
         , actcnt(0)
         , timestore(MinEventCapacity)
+        , grace_backoff(grace_backoff_min)
+        , polling(false)
+        , busy_poll_idle_count(0)
     {
     }
 #if defined(SOLID_USE_EPOLL)
+    bool hasPendingEvents() const
+    {
+        return crtpushvecsz != 0u || crtraisevecsz != 0u || !running;
+    }
+
+    bool canBusyPoll() const
+    {
+        return busy_poll_cfg.budget.count() != 0 && busy_poll_idle_count < busy_poll_cfg.idle_poll_limit;
+    }
+
+    //Poll with zero timeout for up to the busy poll budget but no longer than _waitmsec.
+    //Returns true if the poll got work, _rselcnt being the epoll_wait result.
+    bool busyPoll(NanoTime const& _rcrt, const int _waitmsec, long& _rselcnt)
+    {
+        const auto crt_tp = _rcrt.timePointCast<std::chrono::steady_clock::time_point>();
+        auto       end_tp = crt_tp + busy_poll_cfg.budget;
+
+        if (_waitmsec > 0 && crt_tp + std::chrono::milliseconds(_waitmsec) < end_tp) {
+            end_tp = crt_tp + std::chrono::milliseconds(_waitmsec);
+        }
+
+        polling = true;
+        do {
+            _rselcnt = epoll_wait(reactor_fd, eventvec.data(), static_cast<int>(eventvec.size()), 0);
+        } while (_rselcnt == 0 && !hasPendingEvents() && std::chrono::steady_clock::now() < end_tp);
+        polling = false;
+
+        //NOTE: the flag must be cleared before checking the raise sizes for the last time:
+        //a raise that still found it set, did not write on the event descriptor
+        if (_rselcnt != 0 || hasPendingEvents()) {
+            busy_poll_idle_count = 0;
+            return true;
+        }
+        ++busy_poll_idle_count;
+        return false;
+    }
+
+    void busyPollSocket(Device const& _rdev) const
+    {
+#if defined(SO_BUSY_POLL)
+        if (busy_poll_cfg.socket_busy_poll_usec != 0) {
+            int flag = busy_poll_cfg.socket_busy_poll_usec;
+            //fails with ENOTSOCK on the event descriptor and with EPERM without CAP_NET_ADMIN
+            if (setsockopt(_rdev.descriptor(), SOL_SOCKET, SO_BUSY_POLL, reinterpret_cast<char*>(&flag), sizeof(flag)) != 0) {
+                solid_dbg(logger, Verbose, "SO_BUSY_POLL: " << last_system_error().message());
+            }
+        }
+#else
+        (void)_rdev;
+#endif
+    }
+
     int computeWaitTimeMilliseconds(NanoTime const& _rcrt) const
     {
+        NanoTime next;
 
         if (!exeq.empty()) {
             return 0;
         }
 
-        if (timestore.size() != 0u) {
+        if (nextWakeTime(next)) {
 
-            if (_rcrt < timestore.next()) {
+            if (_rcrt < next) {
 
                 const int64_t maxwait = 1000 * 60 * 10; //ten minutes
                 int64_t       diff    = 0;
                 const auto    crt_tp  = _rcrt.timePointCast<std::chrono::steady_clock::time_point>();
-                const auto    next_tp = timestore.next().timePointCast<std::chrono::steady_clock::time_point>();
+                const auto    next_tp = next.timePointCast<std::chrono::steady_clock::time_point>();
                 diff                  = std::chrono::duration_cast<std::chrono::milliseconds>(next_tp - crt_tp).count();
 
                 if (diff > maxwait) {
@@ -468,14 +754,15 @@ struct Reactor::Data {
 #elif defined(SOLID_USE_KQUEUE)
     NanoTime computeWaitTimeMilliseconds(NanoTime const& _rcrt) const
     {
+        NanoTime next;
 
         if (exeq.size()) {
             return NanoTime();
-        } else if (timestore.size()) {
+        } else if (nextWakeTime(next)) {
 
-            if (_rcrt < timestore.next()) {
+            if (_rcrt < next) {
                 const auto crt_tp = _rcrt.timePointCast<std::chrono::steady_clock::time_point>();
-                const auto next_tp = timestore.next().timePointCast<std::chrono::steady_clock::time_point>();
+                const auto next_tp = next.timePointCast<std::chrono::steady_clock::time_point>();
                 const auto delta = next_tp - crt_tp;
 
                 if (delta <= std::chrono::minutes(10)) {
@@ -494,16 +781,18 @@ struct Reactor::Data {
 #elif defined(SOLID_USE_WSAPOLL)
     int computeWaitTimeMilliseconds(NanoTime const& _rcrt) const
     {
+        NanoTime next;
+
         if (exeq.size()) {
             return 0;
-        } else if (timestore.size()) {
+        } else if (nextWakeTime(next)) {
 
-            if (_rcrt < timestore.next()) {
+            if (_rcrt < next) {
 
                 constexpr int64_t maxwait = 1000 * 60 * 10; //ten minutes
                 int64_t diff = 0;
                 const auto crt_tp = _rcrt.timePointCast<std::chrono::steady_clock::time_point>();
-                const auto next_tp = timestore.next().timePointCast<std::chrono::steady_clock::time_point>();
+                const auto next_tp = next.timePointCast<std::chrono::steady_clock::time_point>();
                 diff = std::chrono::duration_cast<std::chrono::milliseconds>(next_tp - crt_tp).count();
 
                 if (diff > maxwait) {
@@ -522,33 +811,114 @@ struct Reactor::Data {
     }
 #endif
 
+    //earliest of the next timer and the next grace period check
+    bool nextWakeTime(NanoTime& _rnext) const
+    {
+        bool rv = false;
+        if (timestore.size() != 0u) {
+            _rnext = timestore.next();
+            rv     = true;
+        }
+        if (!graceq.empty() && (!rv || grace_next < _rnext)) {
+            _rnext = grace_next;
+            rv     = true;
+        }
+        return rv;
+    }
+
+    void scheduleGraceCheck(NanoTime const& _rcrt, const MicrosecondsT _backoff)
+    {
+        grace_backoff = _backoff;
+        grace_next    = _rcrt.timePointCast<std::chrono::steady_clock::time_point>() + _backoff;
+    }
+
     UniqueId dummyCompletionHandlerUid() const
     {
         const size_t idx = eventact.dummyhandler.idxreactor;
-        return UniqueId(idx, chdq[idx].unique);
-    }
-
-    int                     reactor_fd;
-    AtomicBoolT             running;
-    size_t                  crtpushtskvecidx;
-    size_t                  crtraisevecidx;
-    AtomicSizeT             crtpushvecsz;
-    AtomicSizeT             crtraisevecsz;
-    size_t                  devcnt;
-    size_t                  actcnt;
-    TimeStoreT              timestore;
-    mutex                   mtx;
-    EventVectorT            eventvec;
-    NewTaskVectorT          pushtskvec[2];
-    RaiseEventVectorT       raisevec[2];
-    EventActor              eventact;
-    CompletionHandlerDequeT chdq;
-    UidVectorT              freeuidvec;
-    ActorDequeT             actdq;
-    ExecQueueT              exeq;
-    SizeStackT              chposcache;
+        return UniqueId(idx, chvec[idx].unique);
+    }
+
+    size_t raiseSize() const
+    {
+        return raisevec[crtraisevecidx].size() + bcastvec[crtraisevecidx].size() + completevec[crtraisevecidx].size();
+    }
+
+    void pushRaiseCompletions(RaiseCompletionVectorT& _rcomplete_vec)
+    {
+        for (const auto& rstub : _rcomplete_vec) {
+            const ReactorEventsE revent = rstub.event;
+            exeq.push(ExecStub(
+                rstub.actuid, [revent](ReactorContext& _rctx, Event&& /*_uevent*/) {
+                    Reactor::call_completion_handler(_rctx, revent);
+                },
+                rstub.chuid));
+        }
+        _rcomplete_vec.clear();
+    }
+
+    //the broadcasts are fanned out in the order they were raised relative to single events
+    void pushRaiseEvents(RaiseEventVectorT& _rraise_vec, RaiseBroadcastVectorT& _rbcast_vec)
+    {
+        auto bcast_it = _rbcast_vec.begin();
+
+        for (size_t i = 0; i <= _rraise_vec.size(); ++i) {
+            for (; bcast_it != _rbcast_vec.end() && bcast_it->raise_index == i; ++bcast_it) {
+                for (const auto& ruid : bcast_it->uid_vec) {
+                    exeq.push(ExecStub(ruid, &call_actor_on_event, dummyCompletionHandlerUid(), Event(bcast_it->event)));
+                }
+            }
+            if (i < _rraise_vec.size()) {
+                exeq.push(ExecStub(_rraise_vec[i].uid, &call_actor_on_event, dummyCompletionHandlerUid(), std::move(_rraise_vec[i].event)));
+#ifdef SOLID_HAS_STATISTICS
+                exeq.back().raise_time = _rraise_vec[i].raise_time;
+#endif
+            }
+        }
+        _rraise_vec.clear();
+        _rbcast_vec.clear();
+    }
+
+    //a polling reactor checks crtraisevecsz and crtpushvecsz - no need to write on the event descriptor
+    void wake(Reactor& _rreactor)
+    {
+        if (!polling) {
+            eventact.eventhandler.write(_rreactor);
+        }
+    }
+
+    int                      reactor_fd;
+    AtomicBoolT              running;
+    size_t                   crtpushtskvecidx;
+    size_t                   crtraisevecidx;
+    AtomicSizeT              crtpushvecsz;
+    AtomicSizeT              crtraisevecsz;
+    size_t                   devcnt;
+    size_t                   actcnt;
+    TimeStoreT               timestore;
+    mutex                    mtx;
+    EventVectorT             eventvec;
+    NewTaskVectorT           pushtskvec[2];
+    RaiseEventVectorT        raisevec[2];
+    RaiseBroadcastVectorT    bcastvec[2];
+    RaiseCompletionVectorT   completevec[2];
+    EventActor               eventact;
+    CompletionHandlerVectorT chvec;
+    UidVectorT               freeuidvec;
+    ActorDequeT              actdq;
+    ExecQueueT               exeq;
+    ExecQueueT               graceq;
+    NanoTime                 grace_next;
+    MicrosecondsT            grace_backoff;
+    SizeStackT               chposcache;
+    AtomicBoolT              polling;
+    BusyPollConfiguration    busy_poll_cfg;
+    size_t                   busy_poll_idle_count;
+#ifdef SOLID_HAS_STATISTICS
+    ReactorStatisticData statistic;
+#endif
 #if defined(SOLID_USE_WSAPOLL)
     SizeTVectorT connectvec;
+    SizeTVectorT chconnectidxvec; //parallel to chvec
 #endif
 };
 //-----------------------------------------------------------------------------
@@ -639,6 +1009,25 @@ bool Reactor::start()
 
 //-----------------------------------------------------------------------------
 
+/*static*/ bool Reactor::configureBusyPoll(BusyPollConfiguration const& _rcfg)
+{
+    Reactor* preactor = safeSpecific();
+
+    if (preactor == nullptr) {
+        return false;
+    }
+#if defined(SOLID_USE_EPOLL)
+    solid_log(logger, Info, "busy poll budget = " << _rcfg.budget.count() << "us idle_poll_limit = " << _rcfg.idle_poll_limit << " socket_busy_poll_usec = " << _rcfg.socket_busy_poll_usec);
+    preactor->impl_->busy_poll_cfg        = _rcfg;
+    preactor->impl_->busy_poll_idle_count = 0;
+#else
+    solid_log(logger, Warning, "busy polling is only supported with epoll");
+#endif
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
 /*virtual*/ bool Reactor::raise(UniqueId const& _ractuid, Event&& _uevent)
 {
     solid_dbg(logger, Verbose, (void*)this << " uid = " << _ractuid.index << ',' << _ractuid.unique << " event = " << _uevent);
@@ -648,11 +1037,11 @@ bool Reactor::start()
         lock_guard<std::mutex> lock(impl_->mtx);
 
         impl_->raisevec[impl_->crtraisevecidx].emplace_back(_ractuid, std::move(_uevent));
-        raisevecsz           = impl_->raisevec[impl_->crtraisevecidx].size();
+        raisevecsz           = impl_->raiseSize();
         impl_->crtraisevecsz = raisevecsz;
     }
     if (raisevecsz == 1) {
-        impl_->eventact.eventhandler.write(*this);
+        impl_->wake(*this);
     }
     return rv;
 }
@@ -668,17 +1057,70 @@ bool Reactor::start()
         lock_guard<std::mutex> lock(impl_->mtx);
 
         impl_->raisevec[impl_->crtraisevecidx].push_back(RaiseEventStub(_ractuid, _revent));
-        raisevecsz           = impl_->raisevec[impl_->crtraisevecidx].size();
+        raisevecsz           = impl_->raiseSize();
+        impl_->crtraisevecsz = raisevecsz;
+    }
+    if (raisevecsz == 1) {
+        impl_->wake(*this);
+    }
+    return rv;
+}
+
+//-----------------------------------------------------------------------------
+
+/*virtual*/ bool Reactor::raise(UniqueIdVectorT&& _uuid_vec, const Event& _revent)
+{
+    solid_dbg(logger, Verbose, (void*)this << " uid_count = " << _uuid_vec.size() << " event = " << _revent);
+    bool   rv         = true;
+    size_t raisevecsz = 0;
+    if (_uuid_vec.empty()) {
+        return rv;
+    }
+    {
+        lock_guard<std::mutex> lock(impl_->mtx);
+
+        impl_->bcastvec[impl_->crtraisevecidx].emplace_back(impl_->raisevec[impl_->crtraisevecidx].size(), std::move(_uuid_vec), _revent);
+        raisevecsz           = impl_->raiseSize();
+        impl_->crtraisevecsz = raisevecsz;
+    }
+    if (raisevecsz == 1) {
+        impl_->wake(*this);
+    }
+    return rv;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Reactor::raise(UniqueId const& _ractuid, UniqueId const& _rchuid, const ReactorEventsE _revent)
+{
+    solid_dbg(logger, Verbose, (void*)this << " uid = " << _ractuid.index << ',' << _ractuid.unique << " chuid = " << _rchuid.index << ',' << _rchuid.unique << " event = " << _revent);
+    bool   rv         = true;
+    size_t raisevecsz = 0;
+    {
+        lock_guard<std::mutex> lock(impl_->mtx);
+
+        impl_->completevec[impl_->crtraisevecidx].emplace_back(_ractuid, _rchuid, _revent);
+        raisevecsz           = impl_->raiseSize();
         impl_->crtraisevecsz = raisevecsz;
     }
     if (raisevecsz == 1) {
-        impl_->eventact.eventhandler.write(*this);
+        impl_->wake(*this);
     }
     return rv;
 }
 
 //-----------------------------------------------------------------------------
 
+/*virtual*/ void Reactor::statistic(ReactorStatistic& _rstat) const
+{
+    ReactorBase::statistic(_rstat);
+#ifdef SOLID_HAS_STATISTICS
+    impl_->statistic.fill(_rstat);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
 /*virtual*/ void Reactor::stop()
 {
     solid_dbg(logger, Verbose, "");
@@ -706,7 +1148,7 @@ bool Reactor::push(TaskT&& _ract, Service& _rsvc, Event&& _uevent)
     }
 
     if (pushvecsz == 1) {
-        impl_->eventact.eventhandler.write(*this);
+        impl_->wake(*this);
     }
     return rv;
 }
@@ -741,9 +1183,24 @@ void Reactor::run()
 #if defined(SOLID_USE_EPOLL)
         waitmsec = impl_->computeWaitTimeMilliseconds(crttime);
 
-        solid_dbg(logger, Verbose, "epoll_wait msec = " << waitmsec);
+        if (waitmsec != 0 && impl_->canBusyPoll()) {
+            if (!impl_->busyPoll(crttime, waitmsec, selcnt)) {
+                crttime  = std::chrono::steady_clock::now();
+                waitmsec = impl_->computeWaitTimeMilliseconds(crttime);
+
+                solid_dbg(logger, Verbose, "epoll_wait after busy poll msec = " << waitmsec);
 
-        selcnt = epoll_wait(impl_->reactor_fd, impl_->eventvec.data(), static_cast<int>(impl_->eventvec.size()), waitmsec);
+                selcnt = epoll_wait(impl_->reactor_fd, impl_->eventvec.data(), static_cast<int>(impl_->eventvec.size()), waitmsec);
+            }
+        } else {
+            solid_dbg(logger, Verbose, "epoll_wait msec = " << waitmsec);
+
+            selcnt = epoll_wait(impl_->reactor_fd, impl_->eventvec.data(), static_cast<int>(impl_->eventvec.size()), waitmsec);
+
+            if (selcnt > 0) {
+                impl_->busy_poll_idle_count = 0;
+            }
+        }
 #elif defined(SOLID_USE_KQUEUE)
         waittime = impl_->computeWaitTimeMilliseconds(crttime);
 
@@ -756,6 +1213,10 @@ void Reactor::run()
         selcnt = WSAPoll(impl_->eventvec.data(), impl_->eventvec.size(), waitmsec);
 #endif
         crttime = std::chrono::steady_clock::now();
+#ifdef SOLID_HAS_STATISTICS
+        SteadyTimePointT stage_tp = crttime.timePointCast<SteadyTimePointT>();
+        statistic_add(impl_->statistic.loop_count_, 1);
+#endif
 
 #if defined(SOLID_USE_WSAPOLL)
         if (selcnt > 0 || impl_->connectvec.size()) {
@@ -763,6 +1224,9 @@ void Reactor::run()
         if (selcnt > 0) {
 #endif
             crtload += selcnt;
+#ifdef SOLID_HAS_STATISTICS
+            impl_->statistic.ioEvents(selcnt);
+#endif
             doCompleteIo(crttime, selcnt);
         } else if (selcnt < 0 && errno != EINTR) {
             solid_dbg(logger, Error, "epoll_wait errno  = " << last_system_error().message());
@@ -772,11 +1236,24 @@ void Reactor::run()
         }
 
         crttime = std::chrono::steady_clock::now();
+#ifdef SOLID_HAS_STATISTICS
+        impl_->statistic.stage(impl_->statistic.io_time_ns_, stage_tp, crttime.timePointCast<SteadyTimePointT>());
+#endif
         doCompleteTimer(crttime);
+        doCompleteGracePeriod(crttime);
 
         crttime = std::chrono::steady_clock::now();
+#ifdef SOLID_HAS_STATISTICS
+        impl_->statistic.stage(impl_->statistic.timer_time_ns_, stage_tp, crttime.timePointCast<SteadyTimePointT>());
+#endif
         doCompleteEvents(crttime); //See NOTE above
+#ifdef SOLID_HAS_STATISTICS
+        impl_->statistic.stage(impl_->statistic.event_time_ns_, stage_tp, std::chrono::steady_clock::now());
+#endif
         doCompleteExec(crttime);
+#ifdef SOLID_HAS_STATISTICS
+        impl_->statistic.stage(impl_->statistic.exec_time_ns_, stage_tp, std::chrono::steady_clock::now());
+#endif
 
         running = impl_->running || (impl_->actcnt != 0) || !impl_->exeq.empty();
     }
@@ -944,6 +1421,22 @@ inline UniqueId Reactor::actorUid(ReactorContext const& _rctx) const
 
 //-----------------------------------------------------------------------------
 
+/*static*/ void Reactor::call_completion_handler(ReactorContext& _rctx, const ReactorEventsE _revent)
+{
+    _rctx.reactor_event_ = _revent;
+    _rctx.completionHandler()->handleCompletion(_rctx);
+    _rctx.reactor_event_ = ReactorEventNone;
+}
+
+//-----------------------------------------------------------------------------
+
+UniqueId Reactor::completionHandlerUid(ReactorContext const& _rctx) const
+{
+    return UniqueId(_rctx.channel_index_, impl_->chvec[_rctx.channel_index_].unique);
+}
+
+//-----------------------------------------------------------------------------
+
 Service& Reactor::service(ReactorContext const& _rctx) const
 {
     return *impl_->actdq[_rctx.actor_index_].psvc;
@@ -960,7 +1453,7 @@ Actor& Reactor::actor(ReactorContext const& _rctx) const
 
 CompletionHandler* Reactor::completionHandler(ReactorContext const& _rctx) const
 {
-    return impl_->chdq[_rctx.channel_index_].pch;
+    return impl_->chvec[_rctx.channel_index_].pch;
 }
 
 //-----------------------------------------------------------------------------
@@ -980,7 +1473,7 @@ void Reactor::doPost(ReactorContext& _rctx, Reactor::EventFunctionT&& _revfn, Ev
     solid_dbg(logger, Verbose, "exeq " << impl_->exeq.size() << ' ' << &_rch);
     impl_->exeq.push(ExecStub(_rctx.actorUid(), std::move(_uev)));
     impl_->exeq.back().exefnc = std::move(_revfn);
-    impl_->exeq.back().chnuid = UniqueId(_rch.idxreactor, impl_->chdq[_rch.idxreactor].unique);
+    impl_->exeq.back().chnuid = UniqueId(_rch.idxreactor, impl_->chvec[_rch.idxreactor].unique);
 }
 
 //-----------------------------------------------------------------------------
@@ -993,6 +1486,13 @@ void Reactor::doPost(ReactorContext& _rctx, Reactor::EventFunctionT&& _revfn, Ev
 
 //-----------------------------------------------------------------------------
 
+/*static*/ void Reactor::stop_actor_wait(ReactorContext& _rctx, Event&&)
+{
+    Reactor& rthis = _rctx.reactor();
+
+    rthis.doPostAfterGracePeriod(_rctx, &stop_actor_repost, Event());
+}
+
 /*static*/ void Reactor::stop_actor_repost(ReactorContext& _rctx, Event&&)
 {
     Reactor& rthis = _rctx.reactor();
@@ -1006,17 +1506,88 @@ void Reactor::doPost(ReactorContext& _rctx, Reactor::EventFunctionT&& _revfn, Ev
 
 /*NOTE:
     We do not stop the actor rightaway - we make sure that any
-    pending Events are delivered to the actor before we stop
+    pending Events are delivered to the actor before we stop:
+    first we wait, rechecking with backoff, until the notifications started
+    before disabling visits are done, then we repost once more so that the
+    events they raised are fetched before the stop.
 */
 void Reactor::postActorStop(ReactorContext& _rctx)
 {
     impl_->exeq.push(ExecStub(_rctx.actorUid()));
-    impl_->exeq.back().exefnc = &stop_actor_repost;
+    impl_->exeq.back().exefnc = &stop_actor_wait;
     impl_->exeq.back().chnuid = impl_->dummyCompletionHandlerUid();
 }
 
 //-----------------------------------------------------------------------------
 
+bool Reactor::notifyGracePeriodPassed(const size_t _actidx)
+{
+    ActorStub& ras = this->impl_->actdq[_actidx];
+
+    return ReactorBase::notifyGracePeriodPassed(*ras.actptr, ras.psvc->manager());
+}
+
+//-----------------------------------------------------------------------------
+//NOTE: instead of reposting on exeq until the grace period passes - which
+// would keep the reactor from ever waiting - the execution is parked on
+// graceq and rechecked from the reactor loop with an exponential backoff.
+void Reactor::doPostAfterGracePeriod(ReactorContext& _rctx, EventFunctionT&& _revfn, Event&& _uev)
+{
+    if (notifyGracePeriodPassed(_rctx.actor_index_)) {
+        doPost(_rctx, std::move(_revfn), std::move(_uev));
+        return;
+    }
+
+    //a new waiter restarts the backoff but does not delay an earlier check
+    const NanoTime next = impl_->grace_next;
+    impl_->scheduleGraceCheck(_rctx.nanoTime(), grace_backoff_min);
+    if (!impl_->graceq.empty() && next < impl_->grace_next) {
+        impl_->grace_next = next;
+    }
+
+    solid_dbg(logger, Verbose, "graceq " << impl_->graceq.size());
+    impl_->graceq.push(ExecStub(actorUid(_rctx), std::move(_uev)));
+    impl_->graceq.back().exefnc = std::move(_revfn);
+    impl_->graceq.back().chnuid = impl_->dummyCompletionHandlerUid();
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::doCompleteGracePeriod(NanoTime const& _rcrttime)
+{
+    if (impl_->graceq.empty() || _rcrttime < impl_->grace_next) {
+        return;
+    }
+
+    size_t sz     = impl_->graceq.size();
+    bool   passed = false;
+
+    while ((sz--) != 0) {
+        ExecStub&    rexe(impl_->graceq.front());
+        const size_t actidx = static_cast<size_t>(rexe.actuid.index);
+
+        if (impl_->actdq[actidx].unique != rexe.actuid.unique) {
+            //the actor is gone - drop the execution
+        } else if (notifyGracePeriodPassed(actidx)) {
+            impl_->exeq.push(std::move(rexe));
+            passed = true;
+        } else {
+            impl_->graceq.push(std::move(rexe));
+        }
+        impl_->graceq.pop();
+    }
+
+    if (!impl_->graceq.empty()) {
+        MicrosecondsT backoff = impl_->grace_backoff;
+        if (passed) {
+            backoff = grace_backoff_min;
+        } else if (backoff < grace_backoff_max) {
+            backoff *= 2;
+        }
+        impl_->scheduleGraceCheck(_rcrttime, backoff);
+    }
+}
+
 void Reactor::doStopActor(ReactorContext& _rctx)
 {
     ActorStub& ras = this->impl_->actdq[_rctx.actor_index_];
@@ -1040,15 +1611,21 @@ void Reactor::doCompleteIo(NanoTime const& _rcrttime, const size_t _sz)
 
 #if defined(SOLID_USE_EPOLL)
     for (size_t i = 0; i < _sz; ++i) {
-        epoll_event&           rev = impl_->eventvec[i];
-        CompletionHandlerStub& rch = impl_->chdq[rev.data.u64];
+        const epoll_event&           rev   = impl_->eventvec[i];
+        const size_t                 chidx = dataToChannelIndex(rev.data.u64);
+        const CompletionHandlerStub& rch   = impl_->chvec[chidx];
+
+        if (rch.unique != dataToChannelUnique(rev.data.u64)) {
+            //stale event for an unregistered completion handler
+            continue;
+        }
 
         ctx.reactor_event_ = systemEventsToReactorEvents(rev.events);
-        ctx.channel_index_ = rev.data.u64;
+        ctx.channel_index_ = chidx;
 #elif defined(SOLID_USE_KQUEUE)
     for (size_t i = 0; i < _sz; ++i) {
         struct kevent& rev = impl_->eventvec[i];
-        CompletionHandlerStub& rch = impl_->chdq[voidToIndex(rev.udata)];
+        CompletionHandlerStub& rch = impl_->chvec[voidToIndex(rev.udata)];
 
         ctx.reactor_event_ = systemEventsToReactorEvents(rev.flags, rev.filter);
         ctx.channel_index_ = voidToIndex(rev.udata);
@@ -1063,10 +1640,10 @@ void Reactor::doCompleteIo(NanoTime const& _rcrttime, const size_t _sz)
         if (rev.revents == 0 || rev.revents & POLLNVAL)
             continue;
         --evcnt;
-        CompletionHandlerStub& rch = impl_->chdq[i];
+        CompletionHandlerStub& rch = impl_->chvec[i];
         ctx.reactor_event_ = systemEventsToReactorEvents(rev.revents, rev.events);
         ctx.channel_index_ = i;
-        if (rch.connectidx != InvalidIndex()) {
+        if (impl_->chconnectidxvec[i] != InvalidIndex()) {
             //we have events on a connecting socket
             //so we remove it from connect waiting list
             remConnect(ctx);
@@ -1074,14 +1651,21 @@ void Reactor::doCompleteIo(NanoTime const& _rcrttime, const size_t _sz)
 #endif
         ctx.actor_index_ = rch.actidx;
 
+#ifdef SOLID_HAS_STATISTICS
+        const std::type_info&  ractor_type = typeid(*impl_->actdq[rch.actidx].actptr);
+        const SteadyTimePointT start_tp    = std::chrono::steady_clock::now();
         rch.pch->handleCompletion(ctx);
+        impl_->statistic.actorCall(ractor_type, start_tp, std::chrono::steady_clock::now());
+#else
+        rch.pch->handleCompletion(ctx);
+#endif
         ctx.clearError();
     }
 #if defined(SOLID_USE_WSAPOLL)
     for (size_t j = 0; j < impl_->connectvec.size();) {
         const size_t           i   = impl_->connectvec[j];
         WSAPOLLFD&             rev = impl_->eventvec[i];
-        CompletionHandlerStub& rch = impl_->chdq[i];
+        CompletionHandlerStub& rch = impl_->chvec[i];
 
         if (SocketDevice::error(rev.fd)) {
 
@@ -1104,17 +1688,16 @@ void Reactor::doCompleteIo(NanoTime const& _rcrttime, const size_t _sz)
 #if defined(SOLID_USE_WSAPOLL)
 void Reactor::addConnect(ReactorContext& _rctx)
 {
-    CompletionHandlerStub& rch = impl_->chdq[_rctx.channel_index_];
-    rch.connectidx             = impl_->connectvec.size();
+    impl_->chconnectidxvec[_rctx.channel_index_] = impl_->connectvec.size();
     impl_->connectvec.emplace_back(_rctx.channel_index_);
 }
 
 void Reactor::remConnect(ReactorContext& _rctx)
 {
-    CompletionHandlerStub& rch                       = impl_->chdq[_rctx.channel_index_];
-    impl_->connectvec[rch.connectidx]                = impl_->connectvec.back();
-    impl_->chdq[impl_->connectvec.back()].connectidx = rch.connectidx;
-    rch.connectidx                                   = InvalidIndex();
+    const size_t connectidx                          = impl_->chconnectidxvec[_rctx.channel_index_];
+    impl_->connectvec[connectidx]                    = impl_->connectvec.back();
+    impl_->chconnectidxvec[impl_->connectvec.back()] = connectidx;
+    impl_->chconnectidxvec[_rctx.channel_index_]     = InvalidIndex();
     impl_->connectvec.pop_back();
 }
 #endif
@@ -1150,7 +1733,7 @@ struct TimerCallback {
 
 void Reactor::onTimer(ReactorContext& _rctx, const size_t /*_tidx*/, const size_t _chidx)
 {
-    CompletionHandlerStub& rch = impl_->chdq[_chidx];
+    CompletionHandlerStub& rch = impl_->chvec[_chidx];
 
     _rctx.reactor_event_ = ReactorEventTimer;
     _rctx.channel_index_ = _chidx;
@@ -1182,13 +1765,26 @@ void Reactor::doCompleteExec(NanoTime const& _rcrttime)
 
         ExecStub&              rexe(impl_->exeq.front());
         ActorStub&             ras(impl_->actdq[static_cast<size_t>(rexe.actuid.index)]);
-        CompletionHandlerStub& rcs(impl_->chdq[static_cast<size_t>(rexe.chnuid.index)]);
+        CompletionHandlerStub& rcs(impl_->chvec[static_cast<size_t>(rexe.chnuid.index)]);
 
+#ifdef SOLID_HAS_STATISTICS
+        impl_->statistic.execDepth(impl_->exeq.size());
+#endif
         if (ras.unique == rexe.actuid.unique && rcs.unique == rexe.chnuid.unique) {
             ctx.clearError();
             ctx.channel_index_ = static_cast<size_t>(rexe.chnuid.index);
             ctx.actor_index_   = static_cast<size_t>(rexe.actuid.index);
+#ifdef SOLID_HAS_STATISTICS
+            const std::type_info&  ractor_type = typeid(*ras.actptr);
+            const SteadyTimePointT start_tp    = std::chrono::steady_clock::now();
+            if (rexe.raise_time != SteadyTimePointT()) {
+                impl_->statistic.raiseLatency(rexe.raise_time, start_tp);
+            }
+            rexe.exefnc(ctx, std::move(rexe.event));
+            impl_->statistic.actorCall(ractor_type, start_tp, std::chrono::steady_clock::now());
+#else
             rexe.exefnc(ctx, std::move(rexe.event));
+#endif
         }
         impl_->exeq.pop();
     }
@@ -1228,8 +1824,10 @@ void Reactor::doCompleteEvents(ReactorContext const& _rctx)
             impl_->crtpushvecsz = impl_->crtraisevecsz = 0;
         }
 
-        NewTaskVectorT&    crtpushvec  = impl_->pushtskvec[crtpushvecidx];
-        RaiseEventVectorT& crtraisevec = impl_->raisevec[crtraisevecidx];
+        NewTaskVectorT&         crtpushvec     = impl_->pushtskvec[crtpushvecidx];
+        RaiseEventVectorT&      crtraisevec    = impl_->raisevec[crtraisevecidx];
+        RaiseBroadcastVectorT&  crtbcastvec    = impl_->bcastvec[crtraisevecidx];
+        RaiseCompletionVectorT& crtcompletevec = impl_->completevec[crtraisevecidx];
 
         ReactorContext ctx(_rctx);
 
@@ -1267,13 +1865,10 @@ void Reactor::doCompleteEvents(ReactorContext const& _rctx)
         solid_dbg(logger, Verbose, impl_->exeq.size());
         crtpushvec.clear();
 
-        for (auto& revent : crtraisevec) {
-            impl_->exeq.push(ExecStub(revent.uid, &call_actor_on_event, impl_->dummyCompletionHandlerUid(), std::move(revent.event)));
-        }
+        impl_->pushRaiseEvents(crtraisevec, crtbcastvec);
+        impl_->pushRaiseCompletions(crtcompletevec);
 
         solid_dbg(logger, Verbose, impl_->exeq.size());
-
-        crtraisevec.clear();
     }
 }
 
@@ -1308,7 +1903,7 @@ bool Reactor::addDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
 
 #if defined(SOLID_USE_EPOLL)
     epoll_event ev;
-    ev.data.u64 = _rctx.channel_index_;
+    ev.data.u64 = channelToData(_rctx.channel_index_, impl_->chvec[_rctx.channel_index_].unique);
     ev.events   = reactorRequestsToSystemEvents(_req);
 
     if (epoll_ctl(impl_->reactor_fd, EPOLL_CTL_ADD, _rsd.Device::descriptor(), &ev) != 0) {
@@ -1320,6 +1915,7 @@ bool Reactor::addDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
     if (impl_->devcnt == (impl_->eventvec.size() + 1)) {
         impl_->eventact.post(_rctx, &Reactor::increase_event_vector_size);
     }
+    impl_->busyPollSocket(_rsd);
 #elif defined(SOLID_USE_KQUEUE)
     int read_flags = EV_ADD;
     int write_flags = EV_ADD;
@@ -1392,7 +1988,7 @@ bool Reactor::modDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
 #if defined(SOLID_USE_EPOLL)
     epoll_event ev;
 
-    ev.data.u64 = _rctx.channel_index_;
+    ev.data.u64 = channelToData(_rctx.channel_index_, impl_->chvec[_rctx.channel_index_].unique);
     ev.events   = reactorRequestsToSystemEvents(_req);
 
     if (epoll_ctl(impl_->reactor_fd, EPOLL_CTL_MOD, _rsd.Device::descriptor(), &ev) != 0) {
@@ -1535,7 +2131,7 @@ bool Reactor::addTimer(CompletionHandler const& _rch, NanoTime const& _rt, size_
 
 void Reactor::doUpdateTimerIndex(const size_t _chidx, const size_t _newidx, const size_t _oldidx)
 {
-    CompletionHandlerStub& rch = impl_->chdq[_chidx];
+    CompletionHandlerStub& rch = impl_->chvec[_chidx];
     solid_assert(static_cast<SteadyTimer*>(rch.pch)->storeidx == _oldidx);
     static_cast<SteadyTimer*>(rch.pch)->storeidx = _newidx;
 }
@@ -1560,18 +2156,23 @@ void Reactor::registerCompletionHandler(CompletionHandler& _rch, Actor const& _r
         idx = impl_->chposcache.top();
         impl_->chposcache.pop();
     } else {
-        idx = impl_->chdq.size();
-        impl_->chdq.push_back(CompletionHandlerStub());
+        idx = impl_->chvec.size();
+        impl_->chvec.push_back(CompletionHandlerStub());
+#if defined(SOLID_USE_WSAPOLL)
+        impl_->chconnectidxvec.push_back(InvalidIndex());
+#endif
     }
 
-    CompletionHandlerStub& rcs = impl_->chdq[idx];
+    CompletionHandlerStub& rcs = impl_->chvec[idx];
+
+    solid_assert(_ract.ActorBase::runId().index <= 0xffffffffULL);
 
-    rcs.actidx = static_cast<size_t>(_ract.ActorBase::runId().index);
+    rcs.actidx = static_cast<uint32_t>(_ract.ActorBase::runId().index);
     rcs.pch    = &_rch;
 
     _rch.idxreactor = idx;
 
-    solid_dbg(logger, Info, "idx " << idx << " chdq.size = " << impl_->chdq.size() << " this " << this);
+    solid_dbg(logger, Info, "idx " << idx << " chvec.size = " << impl_->chvec.size() << " this " << this);
 
     {
         NanoTime       dummytime;
@@ -1591,19 +2192,21 @@ void Reactor::unregisterCompletionHandler(CompletionHandler& _rch)
 {
     solid_dbg(logger, Info, "");
 
-    CompletionHandlerStub& rcs = impl_->chdq[_rch.idxreactor];
-
     {
         NanoTime       dummytime;
         ReactorContext ctx(*this, dummytime);
 
         ctx.reactor_event_ = ReactorEventClear;
-        ctx.actor_index_   = rcs.actidx;
+        ctx.actor_index_   = impl_->chvec[_rch.idxreactor].actidx;
         ctx.channel_index_ = _rch.idxreactor;
 
         _rch.handleCompletion(ctx);
     }
 
+    //NOTE: take the reference only after calling the handler as it might register
+    //other completion handlers
+    CompletionHandlerStub& rcs = impl_->chvec[_rch.idxreactor];
+
     impl_->chposcache.push(_rch.idxreactor);
     rcs.pch    = &impl_->eventact.dummyhandler;
     rcs.actidx = 0;
@@ -1673,6 +2276,13 @@ UniqueId ReactorContext::actorUid() const
 
 //-----------------------------------------------------------------------------
 
+size_t ReactorContext::reactorIndex() const
+{
+    return reactor().idInScheduler();
+}
+
+//-----------------------------------------------------------------------------
+
 CompletionHandler* ReactorContext::completionHandler() const
 {
     return reactor().completionHandler(*this);
@@ -0,0 +1,553 @@
+// solid/frame/aio/src/aioshmstream.cpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#include "solid/frame/aio/aioshmstream.hpp"
+
+#if defined(SOLID_USE_EPOLL)
+
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/system/log.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace solid {
+namespace frame {
+namespace aio {
+
+//! A single producer/single consumer byte ring
+/*!
+    head and tail only grow; the position in the ring is the value modulo
+    the (power of 2) capacity. The waiting flags tell the other side to ring
+    the doorbell after it moves head (consumer_waiting) or tail (producer_waiting).
+*/
+struct ShmRing {
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+    alignas(64) std::atomic<uint32_t> consumer_waiting;
+    std::atomic<uint32_t>             producer_waiting;
+};
+
+//! The shared segment header, followed by the data of the two rings
+/*!
+    End 0 produces into ring 0 and consumes ring 1, end 1 the other way around.
+*/
+struct ShmSegment {
+    static constexpr uint64_t magic_value = 0x736f6c6964736d31ULL;
+
+    uint64_t                          magic;
+    uint64_t                          capacity;
+    alignas(64) std::atomic<uint32_t> closed;
+    ShmRing                           rings[2];
+
+    char* data(const size_t _ring_index)
+    {
+        return reinterpret_cast<char*>(this) + header_size() + _ring_index * capacity;
+    }
+
+    static constexpr size_t header_size()
+    {
+        return ((sizeof(ShmSegment) + 4095) / 4096) * 4096;
+    }
+
+    static size_t size(const size_t _capacity)
+    {
+        return header_size() + 2 * _capacity;
+    }
+};
+
+namespace {
+
+constexpr size_t min_ring_capacity = 4096;
+constexpr size_t descriptor_count  = 3;
+
+inline ErrorCodeT invalid_channel_error()
+{
+    return std::make_error_code(std::errc::invalid_argument);
+}
+
+inline ErrorCodeT protocol_error()
+{
+    return std::make_error_code(std::errc::protocol_error);
+}
+
+Device duplicate(Device const& _rdev)
+{
+    return Device(fcntl(_rdev.descriptor(), F_DUPFD_CLOEXEC, 0));
+}
+
+} //namespace
+
+//-----------------------------------------------------------------------------
+//  ShmChannel
+//-----------------------------------------------------------------------------
+
+/*static*/ ErrorCodeT ShmChannel::create(ShmChannel& _rend0, ShmChannel& _rend1, const size_t _ring_capacity)
+{
+    _rend0.close();
+    _rend1.close();
+
+    size_t capacity = min_ring_capacity;
+    while (capacity < _ring_capacity) {
+        capacity <<= 1;
+    }
+
+    ShmChannel end0;
+    ShmChannel end1;
+
+    end0.segment_dev_ = Device(memfd_create("solid_shm_channel", MFD_CLOEXEC));
+
+    if (!end0.segment_dev_) {
+        return last_system_error();
+    }
+
+    if (ftruncate(end0.segment_dev_.descriptor(), ShmSegment::size(capacity)) != 0) {
+        return last_system_error();
+    }
+
+    end0.doorbell_dev_      = Device(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+    end0.peer_doorbell_dev_ = Device(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+
+    if (!end0.doorbell_dev_ || !end0.peer_doorbell_dev_) {
+        return last_system_error();
+    }
+
+    end1.segment_dev_       = duplicate(end0.segment_dev_);
+    end1.doorbell_dev_      = duplicate(end0.peer_doorbell_dev_);
+    end1.peer_doorbell_dev_ = duplicate(end0.doorbell_dev_);
+
+    if (!end1.segment_dev_ || !end1.doorbell_dev_ || !end1.peer_doorbell_dev_) {
+        return last_system_error();
+    }
+
+    {
+        //the memfd is zero filled, so everything but the header fields is already initialized
+        void* pmem = mmap(nullptr, ShmSegment::size(capacity), PROT_READ | PROT_WRITE, MAP_SHARED, end0.segment_dev_.descriptor(), 0);
+
+        if (pmem == MAP_FAILED) {
+            return last_system_error();
+        }
+
+        ShmSegment* psegment = static_cast<ShmSegment*>(pmem);
+        solid_check(psegment->closed.is_lock_free() && psegment->rings[0].head.is_lock_free(), "shared memory atomics must be lock free");
+        psegment->capacity = capacity;
+        psegment->magic    = ShmSegment::magic_value;
+        munmap(pmem, ShmSegment::size(capacity));
+    }
+
+    end0.side_ = 0;
+    end1.side_ = 1;
+
+    ErrorCodeT err = end0.map();
+
+    if (!err) {
+        err = end1.map();
+    }
+
+    if (!err) {
+        _rend0 = std::move(end0);
+        _rend1 = std::move(end1);
+    }
+    return err;
+}
+
+ShmChannel::ShmChannel()
+    : psegment_(nullptr)
+    , capacity_(0)
+    , side_(0)
+{
+}
+
+ShmChannel::ShmChannel(ShmChannel&& _uch) noexcept
+    : psegment_(_uch.psegment_)
+    , capacity_(_uch.capacity_)
+    , side_(_uch.side_)
+    , segment_dev_(std::move(_uch.segment_dev_))
+    , doorbell_dev_(std::move(_uch.doorbell_dev_))
+    , peer_doorbell_dev_(std::move(_uch.peer_doorbell_dev_))
+{
+    _uch.psegment_ = nullptr;
+    _uch.capacity_ = 0;
+}
+
+ShmChannel::~ShmChannel()
+{
+    close();
+}
+
+ShmChannel& ShmChannel::operator=(ShmChannel&& _uch) noexcept
+{
+    if (this != &_uch) {
+        close();
+        psegment_          = _uch.psegment_;
+        capacity_          = _uch.capacity_;
+        side_              = _uch.side_;
+        segment_dev_       = std::move(_uch.segment_dev_);
+        doorbell_dev_      = std::move(_uch.doorbell_dev_);
+        peer_doorbell_dev_ = std::move(_uch.peer_doorbell_dev_);
+        _uch.psegment_     = nullptr;
+        _uch.capacity_     = 0;
+    }
+    return *this;
+}
+
+void ShmChannel::close()
+{
+    if (psegment_ != nullptr) {
+        munmap(psegment_, ShmSegment::size(capacity_));
+        psegment_ = nullptr;
+        capacity_ = 0;
+    }
+    segment_dev_.close();
+    doorbell_dev_.close();
+    peer_doorbell_dev_.close();
+}
+
+ErrorCodeT ShmChannel::map()
+{
+    struct stat st;
+
+    if (fstat(segment_dev_.descriptor(), &st) != 0) {
+        return last_system_error();
+    }
+
+    const size_t segment_size = static_cast<size_t>(st.st_size);
+
+    if (segment_size < ShmSegment::size(min_ring_capacity)) {
+        return invalid_channel_error();
+    }
+
+    void* pmem = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, segment_dev_.descriptor(), 0);
+
+    if (pmem == MAP_FAILED) {
+        return last_system_error();
+    }
+
+    ShmSegment* psegment = static_cast<ShmSegment*>(pmem);
+
+    const uint64_t capacity = psegment->capacity;
+
+    if (psegment->magic != ShmSegment::magic_value || (capacity & (capacity - 1)) != 0 || ShmSegment::size(capacity) != segment_size) {
+        munmap(pmem, segment_size);
+        return invalid_channel_error();
+    }
+
+    psegment_ = psegment;
+    capacity_ = capacity;
+    return ErrorCodeT();
+}
+
+ErrorCodeT ShmChannel::send(SocketDevice& _rsd) const
+{
+    if (psegment_ == nullptr) {
+        return invalid_channel_error();
+    }
+
+    char            side = static_cast<char>(side_);
+    const int       fds[descriptor_count]{segment_dev_.descriptor(), doorbell_dev_.descriptor(), peer_doorbell_dev_.descriptor()};
+    char            control[CMSG_SPACE(sizeof(fds))];
+    struct iovec    iov;
+    struct msghdr   msg;
+    struct cmsghdr* pcmsg;
+
+    memset(control, 0, sizeof(control));
+    memset(&msg, 0, sizeof(msg));
+
+    iov.iov_base       = &side;
+    iov.iov_len        = 1;
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+
+    pcmsg             = CMSG_FIRSTHDR(&msg);
+    pcmsg->cmsg_level = SOL_SOCKET;
+    pcmsg->cmsg_type  = SCM_RIGHTS;
+    pcmsg->cmsg_len   = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(pcmsg), fds, sizeof(fds));
+
+    ssize_t rv;
+    do {
+        rv = sendmsg(_rsd.descriptor(), &msg, MSG_NOSIGNAL);
+    } while (rv < 0 && errno == EINTR);
+
+    if (rv < 0) {
+        return last_system_error();
+    }
+    return ErrorCodeT();
+}
+
+ErrorCodeT ShmChannel::recv(SocketDevice& _rsd)
+{
+    close();
+
+    char            side = 0;
+    char            control[CMSG_SPACE(sizeof(int) * descriptor_count)];
+    struct iovec    iov;
+    struct msghdr   msg;
+    struct cmsghdr* pcmsg;
+
+    memset(control, 0, sizeof(control));
+    memset(&msg, 0, sizeof(msg));
+
+    iov.iov_base       = &side;
+    iov.iov_len        = 1;
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t rv;
+    do {
+        rv = recvmsg(_rsd.descriptor(), &msg, MSG_CMSG_CLOEXEC);
+    } while (rv < 0 && errno == EINTR);
+
+    if (rv < 0) {
+        return last_system_error();
+    }
+
+    pcmsg = CMSG_FIRSTHDR(&msg);
+
+    if (
+        rv != 1 || (side != 0 && side != 1) || (msg.msg_flags & MSG_CTRUNC) != 0 || pcmsg == nullptr || pcmsg->cmsg_level != SOL_SOCKET || pcmsg->cmsg_type != SCM_RIGHTS || pcmsg->cmsg_len != CMSG_LEN(sizeof(int) * descriptor_count)) {
+        if (pcmsg != nullptr && pcmsg->cmsg_level == SOL_SOCKET && pcmsg->cmsg_type == SCM_RIGHTS) {
+            const size_t cnt = (pcmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            int          fds[descriptor_count];
+            memcpy(fds, CMSG_DATA(pcmsg), sizeof(int) * std::min(cnt, descriptor_count));
+            for (size_t i = 0; i < cnt && i < descriptor_count; ++i) {
+                ::close(fds[i]);
+            }
+        }
+        return invalid_channel_error();
+    }
+
+    int fds[descriptor_count];
+    memcpy(fds, CMSG_DATA(pcmsg), sizeof(fds));
+
+    segment_dev_       = Device(fds[0]);
+    doorbell_dev_      = Device(fds[1]);
+    peer_doorbell_dev_ = Device(fds[2]);
+    side_              = static_cast<size_t>(side);
+
+    ErrorCodeT err = map();
+
+    if (err) {
+        close();
+    }
+    return err;
+}
+
+void ShmChannel::shutdown()
+{
+    if (psegment_ != nullptr && psegment_->closed.exchange(1) == 0) {
+        ringPeerDoorbell();
+    }
+}
+
+//NOTE: head and tail live in memory shared with the peer process, so they
+// are validated before use - a corrupted ring shuts the channel down.
+ssize_t ShmChannel::recv(char* _pb, size_t _bl, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+    ShmRing&       rring = psegment_->rings[side_ ^ 1];
+    const uint64_t tail  = rring.tail.load(std::memory_order_relaxed);
+    uint64_t       head  = rring.head.load(std::memory_order_acquire);
+
+    _rcan_retry = false;
+
+    if (head == tail) {
+        rring.consumer_waiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        head = rring.head.load(std::memory_order_acquire);
+
+        if (head == tail) {
+            if (psegment_->closed.load(std::memory_order_acquire) != 0) {
+                return 0;
+            }
+            _rcan_retry = true;
+            return -1;
+        }
+        rring.consumer_waiting.store(0, std::memory_order_relaxed);
+    }
+
+    if (head - tail > capacity_) {
+        solid_log(logger, Error, "invalid ring head = " << head << " tail = " << tail);
+        shutdown();
+        _rerr = protocol_error();
+        return -1;
+    }
+
+    const size_t sz     = std::min(_bl, static_cast<size_t>(head - tail));
+    const size_t offset = static_cast<size_t>(tail & (capacity_ - 1));
+    const size_t first  = std::min(sz, capacity_ - offset);
+    const char*  pdata  = psegment_->data(side_ ^ 1);
+
+    memcpy(_pb, pdata + offset, first);
+    memcpy(_pb + first, pdata, sz - first);
+
+    rring.tail.store(tail + sz, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (rring.producer_waiting.load(std::memory_order_relaxed) != 0 && rring.producer_waiting.exchange(0) != 0) {
+        ringPeerDoorbell();
+    }
+    return sz;
+}
+
+ssize_t ShmChannel::send(const char* _pb, size_t _bl, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+    ShmRing&       rring = psegment_->rings[side_];
+    const uint64_t head  = rring.head.load(std::memory_order_relaxed);
+    uint64_t       tail  = rring.tail.load(std::memory_order_acquire);
+
+    _rcan_retry = false;
+
+    if (psegment_->closed.load(std::memory_order_acquire) != 0) {
+        return 0;
+    }
+
+    if (head - tail == capacity_) {
+        rring.producer_waiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        tail = rring.tail.load(std::memory_order_acquire);
+
+        if (head - tail == capacity_) {
+            _rcan_retry = true;
+            return -1;
+        }
+        rring.producer_waiting.store(0, std::memory_order_relaxed);
+    }
+
+    if (head - tail > capacity_) {
+        solid_log(logger, Error, "invalid ring head = " << head << " tail = " << tail);
+        shutdown();
+        _rerr = protocol_error();
+        return -1;
+    }
+
+    const size_t sz     = std::min(_bl, static_cast<size_t>(capacity_ - (head - tail)));
+    const size_t offset = static_cast<size_t>(head & (capacity_ - 1));
+    const size_t first  = std::min(sz, capacity_ - offset);
+    char*        pdata  = psegment_->data(side_);
+
+    memcpy(pdata + offset, _pb, first);
+    memcpy(pdata, _pb + first, sz - first);
+
+    rring.head.store(head + sz, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (rring.consumer_waiting.load(std::memory_order_relaxed) != 0 && rring.consumer_waiting.exchange(0) != 0) {
+        ringPeerDoorbell();
+    }
+    return sz;
+}
+
+void ShmChannel::clearDoorbell()
+{
+    uint64_t v;
+    while (doorbell_dev_.read(reinterpret_cast<char*>(&v), sizeof(v)) == sizeof(v)) {
+    }
+}
+
+void ShmChannel::ringPeerDoorbell()
+{
+    const uint64_t v = 1;
+    peer_doorbell_dev_.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+//-----------------------------------------------------------------------------
+//  ShmStream
+//-----------------------------------------------------------------------------
+
+void ShmStream::init(ReactorContext& _rctx)
+{
+    reactor(_rctx).addDevice(_rctx, ch.doorbell(), ReactorWaitRead);
+}
+
+bool ShmStream::doTryRecv(ReactorContext& _rctx)
+{
+    bool       can_retry;
+    ErrorCodeT err;
+
+    ssize_t rv = ch.recv(recv_buf, recv_buf_cp - recv_buf_sz, can_retry, err);
+
+    solid_dbg(logger, Verbose, "recv (" << (recv_buf_cp - recv_buf_sz) << ") = " << rv);
+
+    if (rv > 0) {
+        recv_buf_sz += rv;
+        recv_buf += rv;
+    } else if (rv == 0) {
+        error(_rctx, error_stream_shutdown);
+        recv_buf_sz = recv_buf_cp = 0;
+    } else if (rv < 0) {
+        if (can_retry) {
+            return false;
+        } else {
+            recv_buf_sz = recv_buf_cp = 0;
+            error(_rctx, error_stream_system);
+            systemError(_rctx, err);
+        }
+    }
+    return true;
+}
+
+bool ShmStream::doTrySend(ReactorContext& _rctx)
+{
+    bool       can_retry;
+    ErrorCodeT err;
+    ssize_t    rv = ch.send(send_buf, send_buf_cp - send_buf_sz, can_retry, err);
+
+    solid_dbg(logger, Verbose, "send (" << (send_buf_cp - send_buf_sz) << ") = " << rv << ' ' << can_retry);
+
+    if (rv > 0) {
+        send_buf_sz += rv;
+        send_buf += rv;
+    } else if (rv == 0) {
+        error(_rctx, error_stream_shutdown);
+        send_buf_sz = send_buf_cp = 0;
+    } else if (rv < 0) {
+        if (can_retry) {
+            return false;
+        } else {
+            send_buf_sz = send_buf_cp = 0;
+            error(_rctx, error_stream_system);
+            systemError(_rctx, err);
+        }
+    }
+    return true;
+}
+
+void ShmStream::doError(ReactorContext& _rctx)
+{
+    error(_rctx, error_stream_system);
+
+    if (!solid_function_empty(send_fnc)) {
+        send_buf_sz = send_buf_cp = 0;
+        send_fnc(*this, _rctx);
+    }
+    if (!solid_function_empty(recv_fnc)) {
+        recv_buf_sz = recv_buf_cp = 0;
+        recv_fnc(*this, _rctx);
+    }
+}
+
+} //namespace aio
+} //namespace frame
+} //namespace solid
+
+#endif //SOLID_USE_EPOLL
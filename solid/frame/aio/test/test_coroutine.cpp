@@ -0,0 +1,227 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiocoroutine.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+#include "solid/utility/string.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using AtomicSizeT   = atomic<size_t>;
+
+namespace co = frame::aio::co;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+struct Context {
+    AtomicSizeT   pending_count_{0};
+    AtomicSizeT   timer_count_{0};
+    promise<void> prom_;
+
+    void done()
+    {
+        if (pending_count_.fetch_sub(1) == 1) {
+            prom_.set_value();
+        }
+    }
+};
+
+//! One end of a ping-pong connection driven by a coroutine
+class Peer final : public frame::aio::Actor {
+public:
+    Peer(SocketDevice&& _rsd, const size_t _roundtrip_count, Context* _pctx)
+        : sock_(this->proxy(), std::move(_rsd))
+        , timer_(this->proxy())
+        , roundtrip_count_(_roundtrip_count)
+        , pctx_(_pctx)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_start) {
+            sock_.device().enableNoDelay();
+            if (pctx_ != nullptr) {
+                ping(_rctx);
+            } else {
+                echo(_rctx);
+            }
+        } else if (_revent == generic_event_kill) {
+            postStop(_rctx);
+        }
+    }
+
+    co::Task ping(frame::aio::ReactorContext& _rctx)
+    {
+        frame::aio::ReactorContext* pctx = &_rctx;
+
+        for (size_t i = 0; i < roundtrip_count_; ++i) {
+            snprintf(buf_, sizeof(buf_), "%015u", static_cast<unsigned>(i));
+
+            auto sent = co_await co::sendAll(*pctx, sock_, buf_, sizeof(buf_));
+            pctx      = &sent.context;
+            solid_check(sent, "send: " << pctx->systemError().message());
+
+            size_t recv_sz = 0;
+            while (recv_sz < sizeof(buf_)) {
+                auto recv = co_await co::recvSome(*pctx, sock_, buf_ + recv_sz, sizeof(buf_) - recv_sz);
+                pctx      = &recv.context;
+                solid_check(recv && recv.size != 0, "recv: " << pctx->systemError().message());
+                recv_sz += recv.size;
+            }
+
+            solid_check(strtoul(buf_, nullptr, 10) == i, "unexpected echo: " << buf_);
+
+            if ((i % 64) == 0) {
+                auto waited = co_await co::waitFor(*pctx, timer_, chrono::milliseconds(1));
+                pctx        = &waited.context;
+                solid_check(waited, "wait: " << pctx->error().message());
+                ++pctx_->timer_count_;
+            }
+        }
+        pctx_->done();
+    }
+
+    co::Task echo(frame::aio::ReactorContext& _rctx)
+    {
+        frame::aio::ReactorContext* pctx = &_rctx;
+
+        while (true) {
+            auto recv = co_await co::recvSome(*pctx, sock_, buf_, sizeof(buf_));
+            pctx      = &recv.context;
+            if (!recv || recv.size == 0) {
+                break;
+            }
+            auto sent = co_await co::sendAll(*pctx, sock_, buf_, recv.size);
+            pctx      = &sent.context;
+            if (!sent) {
+                break;
+            }
+        }
+        postStop(*pctx);
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+    StreamSocketT           sock_;
+    frame::aio::SteadyTimer timer_;
+    const size_t            roundtrip_count_;
+    Context*                pctx_;
+    char                    buf_[16];
+};
+
+co::Task empty_task(size_t& _rcount)
+{
+    ++_rcount;
+    co_return;
+}
+
+} //namespace
+
+int test_coroutine(int argc, char* argv[])
+{
+    size_t pair_count      = 4;
+    size_t roundtrip_count = 1000;
+    int    wait_seconds    = 100;
+
+    if (argc > 1) {
+        pair_count = make_number(argv[1]);
+    }
+
+    if (argc > 2) {
+        roundtrip_count = make_number(argv[2]);
+    }
+
+    solid::log_start(std::cerr, {"test:EW"});
+
+    { //frames are reused from the pool of the thread
+        auto&        rpool          = co::impl::FramePool::local();
+        const size_t allocate_count = rpool.allocateCount();
+        size_t       count          = 0;
+
+        for (size_t i = 0; i < 10; ++i) {
+            empty_task(count);
+        }
+        solid_check(count == 10);
+        solid_check(rpool.allocateCount() == allocate_count + 1, "frames not reused: " << rpool.allocateCount());
+    }
+
+    auto lambda = [&]() {
+        ErrorConditionT err;
+        AioSchedulerT   scheduler;
+        frame::Manager  manager;
+        frame::ServiceT service{manager};
+        Context         context;
+        SocketDevice    listener;
+        ResolveData     rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Stream);
+
+        listener.create(rd.begin());
+        solid_check(!listener.prepareAccept(rd.begin(), pair_count + 1), "listen failed");
+
+        SocketAddress local_address;
+        listener.localAddress(local_address);
+
+        ResolveData crd = synchronous_resolve("127.0.0.1", local_address.port(), 0, SocketInfo::Inet4, SocketInfo::Stream);
+
+        scheduler.start(1);
+
+        context.pending_count_ = pair_count;
+
+        for (size_t i = 0; i < pair_count; ++i) {
+            SocketDevice client;
+            SocketDevice server;
+
+            client.create(crd.begin());
+            solid_check(!client.connect(crd.begin()), "connect failed");
+            solid_check(!listener.accept(server), "accept failed");
+
+            client.makeNonBlocking();
+            server.makeNonBlocking();
+
+            scheduler.startActor(make_dynamic<Peer>(std::move(server), roundtrip_count, nullptr), service, make_event(GenericEvents::Start), err);
+            solid_check(!err, "start server peer: " << err.message());
+
+            scheduler.startActor(make_dynamic<Peer>(std::move(client), roundtrip_count, &context), service, make_event(GenericEvents::Start), err);
+            solid_check(!err, "start client peer: " << err.message());
+        }
+
+        solid_check(context.prom_.get_future().wait_for(chrono::seconds(wait_seconds)) == future_status::ready);
+
+        const size_t timer_count = pair_count * ((roundtrip_count + 63) / 64);
+        solid_check(context.timer_count_ == timer_count, "timer count " << context.timer_count_ << " expected " << timer_count);
+
+        //stopping the manager drops the pending receives of the echo
+        //coroutines - along with their frames
+        manager.stop();
+    };
+
+    if (async(launch::async, lambda).wait_for(chrono::seconds(wait_seconds)) != future_status::ready) {
+        solid_throw(" Test is taking too long - waited " << wait_seconds << " secs");
+    }
+
+    return 0;
+}
@@ -0,0 +1,339 @@
+#include "solid/frame/aio/aiodnsresolver.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using AtomicSizeT   = atomic<size_t>;
+using ResultT       = pair<frame::aio::DnsAddressVectorPointerT, ErrorConditionT>;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+//! A nameserver on loopback with a few names
+class FakeServer {
+    SocketDevice        sd_;
+    SocketAddressInet   address_;
+    atomic<bool>        running_{true};
+    mutex               mtx_;
+    map<string, size_t> query_count_map_;
+    set<int>            port_set_;
+    thread              thr_;
+
+    static void append16(string& _rs, const uint16_t _v)
+    {
+        _rs += static_cast<char>(_v >> 8);
+        _rs += static_cast<char>(_v & 0xff);
+    }
+
+    static void appendAnswer(string& _rs, const uint16_t _type, const uint32_t _ttl, const string& _data)
+    {
+        append16(_rs, 0xc00c); //points to the question name
+        append16(_rs, _type);
+        append16(_rs, 1);
+        append16(_rs, static_cast<uint16_t>(_ttl >> 16));
+        append16(_rs, static_cast<uint16_t>(_ttl & 0xffff));
+        append16(_rs, static_cast<uint16_t>(_data.size()));
+        _rs += _data;
+    }
+
+    void run()
+    {
+        char buf[512];
+        while (running_) {
+            SocketAddress addr;
+            bool          can_retry;
+            ErrorCodeT    err;
+            const ssize_t rv = sd_.recv(buf, sizeof(buf), addr, can_retry, err);
+            if (rv <= 12) {
+                continue;
+            }
+
+            //the question
+            string name;
+            size_t off = 12;
+            while (off < static_cast<size_t>(rv) && buf[off] != 0) {
+                const size_t len = static_cast<uint8_t>(buf[off]);
+                if (!name.empty()) {
+                    name += '.';
+                }
+                name.append(buf + off + 1, len);
+                off += len + 1;
+            }
+            ++off;
+            const uint16_t type = static_cast<uint16_t>((static_cast<uint8_t>(buf[off]) << 8) | static_cast<uint8_t>(buf[off + 1]));
+            off += 4;
+
+            {
+                lock_guard<mutex> lock(mtx_);
+                ++query_count_map_[name + (type == 1 ? "/A" : "/AAAA")];
+                port_set_.insert(SocketAddressInet(SocketAddressStub(addr)).port());
+            }
+
+            string   answers;
+            uint16_t answer_count = 0;
+            uint16_t rcode        = 0;
+
+            if (name == "silent.test") {
+                continue;
+            } else if (name == "fail.test") {
+                rcode = 2;
+            } else if (name == "host.test") {
+                if (type == 1) {
+                    appendAnswer(answers, 1, 60, string("\x0a\x00\x00\x01", 4));
+                    appendAnswer(answers, 1, 60, string("\x0a\x00\x00\x02", 4));
+                    answer_count = 2;
+                } else {
+                    appendAnswer(answers, 28, 60, string("\xfd\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01", 16));
+                    answer_count = 1;
+                }
+            } else if (name == "short.test") {
+                if (type == 1) {
+                    appendAnswer(answers, 1, 1, string("\x0a\x00\x00\x03", 4));
+                    answer_count = 1;
+                }
+            } else if (name == "multi.test") {
+                this_thread::sleep_for(chrono::milliseconds(50));
+                if (type == 1) {
+                    appendAnswer(answers, 1, 60, string("\x0a\x00\x00\x04", 4));
+                    answer_count = 1;
+                }
+            } else {
+                rcode = 3;
+            }
+
+            string rsp(buf, off);
+            rsp[2] = static_cast<char>(0x81);
+            rsp[3] = static_cast<char>(0x80 | rcode);
+            rsp[6] = static_cast<char>(answer_count >> 8);
+            rsp[7] = static_cast<char>(answer_count & 0xff);
+            rsp += answers;
+
+            sd_.send(rsp.data(), rsp.size(), SocketAddressStub(addr), can_retry, err);
+        }
+    }
+
+public:
+    FakeServer()
+    {
+        ResolveData rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Datagram);
+        solid_check(!sd_.create(rd.begin()) && !sd_.bind(rd.begin()), "cannot create the nameserver socket");
+        sd_.makeBlocking(50);
+
+        SocketAddress local_address;
+        sd_.localAddress(local_address);
+        address_ = SocketAddressStub(local_address);
+
+        thr_ = thread([this]() { run(); });
+    }
+
+    ~FakeServer()
+    {
+        running_ = false;
+        thr_.join();
+    }
+
+    SocketAddressInet const& address() const
+    {
+        return address_;
+    }
+
+    size_t queryCount(const string& _key)
+    {
+        lock_guard<mutex> lock(mtx_);
+        return query_count_map_[_key];
+    }
+
+    size_t portCount()
+    {
+        lock_guard<mutex> lock(mtx_);
+        return port_set_.size();
+    }
+};
+
+ResultT resolve(frame::aio::DnsResolver& _rresolver, const string& _name, const SocketInfo::Family _family = SocketInfo::AnyFamily)
+{
+    auto prom_ptr = make_shared<promise<ResultT>>();
+    auto fut      = prom_ptr->get_future();
+
+    _rresolver.requestResolve(
+        [prom_ptr](frame::aio::DnsAddressVectorPointerT const& _raddr_ptr, ErrorConditionT const& _rerr) {
+            prom_ptr->set_value(ResultT(_raddr_ptr, _rerr));
+        },
+        _name, _family);
+
+    solid_check(fut.wait_for(chrono::seconds(10)) == future_status::ready, "resolve " << _name << " took too long");
+    return fut.get();
+}
+
+} //namespace
+
+int test_dns_resolver(int /*argc*/, char* /*argv*/[])
+{
+    solid::log_start(std::cerr, {"test:EW", "solid::frame::aio.*:EW"});
+
+    FakeServer server;
+
+    frame::aio::DnsConfiguration cfg;
+
+    cfg.nameserver_vec.emplace_back(server.address());
+    cfg.hosts_path.clear();
+    cfg.host_vec.emplace_back("Static.Test", SocketAddressInet("10.1.1.1"));
+    cfg.timeout  = chrono::milliseconds(100);
+    cfg.attempts = 2;
+
+    AioSchedulerT           scheduler;
+    frame::Manager          manager;
+    frame::ServiceT         service{manager};
+    frame::aio::DnsResolver resolver(cfg);
+
+    scheduler.start(1);
+
+    //not started
+    {
+        const ResultT result = resolve(resolver, "host.test");
+        solid_check(result.second == frame::aio::error_dns_stopped);
+    }
+
+    solid_check(!resolver.start(scheduler, service), "start failed");
+
+    //numeric and static names need no query
+    {
+        ResultT result = resolve(resolver, "127.0.0.1", SocketInfo::Inet4);
+        solid_check(!result.second && result.first->size() == 1 && result.first->front().isLoopback());
+
+        result = resolve(resolver, "static.test.");
+        solid_check(!result.second && result.first->size() == 1);
+
+        result = resolve(resolver, "bad..name");
+        solid_check(result.second == frame::aio::error_dns_invalid_name);
+        solid_check(resolver.queryCount() == 0);
+    }
+
+    //A and AAAA, then from the cache
+    {
+        ResultT result = resolve(resolver, "Host.Test");
+        solid_check(!result.second, "error " << result.second.message());
+        solid_check(result.first->size() == 3, "size " << result.first->size());
+        //the A and the AAAA queries were in flight together, each on its own socket
+        solid_check(server.portCount() == 2, "ports " << server.portCount());
+
+        result = resolve(resolver, "host.test", SocketInfo::Inet4);
+        solid_check(!result.second && result.first->size() == 2);
+        solid_check(result.first->front().isInet4());
+
+        const size_t hit_count = resolver.cacheHitCount();
+
+        result = resolve(resolver, "host.test", SocketInfo::Inet4);
+        solid_check(!result.second && result.first->size() == 2);
+        solid_check(resolver.cacheHitCount() == hit_count + 1);
+        solid_check(server.queryCount("host.test/A") == 2 && server.queryCount("host.test/AAAA") == 1);
+    }
+
+    //negative answers are cached too
+    {
+        ResultT result = resolve(resolver, "missing.test", SocketInfo::Inet4);
+        solid_check(result.second == frame::aio::error_dns_not_found);
+        result = resolve(resolver, "missing.test", SocketInfo::Inet4);
+        solid_check(result.second == frame::aio::error_dns_not_found);
+        solid_check(server.queryCount("missing.test/A") == 1);
+    }
+
+    //expired answers are queried again
+    {
+        ResultT result = resolve(resolver, "short.test", SocketInfo::Inet4);
+        solid_check(!result.second && result.first->size() == 1);
+        this_thread::sleep_for(chrono::milliseconds(1100));
+        result = resolve(resolver, "short.test", SocketInfo::Inet4);
+        solid_check(!result.second && result.first->size() == 1);
+        solid_check(server.queryCount("short.test/A") == 2);
+    }
+
+    //concurrent requests share one query
+    {
+        const size_t  request_count = 100;
+        AtomicSizeT   done_count{0};
+        promise<void> prom;
+
+        for (size_t i = 0; i < request_count; ++i) {
+            resolver.requestResolve(
+                [&done_count, &prom](frame::aio::DnsAddressVectorPointerT const& _raddr_ptr, ErrorConditionT const& _rerr) {
+                    solid_check(!_rerr && _raddr_ptr->size() == 1);
+                    if (++done_count == request_count) {
+                        prom.set_value();
+                    }
+                },
+                "multi.test", SocketInfo::Inet4);
+        }
+        solid_check(prom.get_future().wait_for(chrono::seconds(10)) == future_status::ready);
+        solid_check(server.queryCount("multi.test/A") == 1);
+        solid_check(resolver.coalescedCount() != 0);
+    }
+
+    //unanswered and failed queries are retried, the errors are not cached
+    {
+        ResultT result = resolve(resolver, "silent.test", SocketInfo::Inet4);
+        solid_check(result.second == frame::aio::error_dns_timeout, "error " << result.second.message());
+        solid_check(server.queryCount("silent.test/A") == 2);
+
+        result = resolve(resolver, "fail.test", SocketInfo::Inet4);
+        solid_check(result.second == frame::aio::error_dns_server, "error " << result.second.message());
+        solid_check(server.queryCount("fail.test/A") == 2);
+
+        result = resolve(resolver, "fail.test", SocketInfo::Inet4);
+        solid_check(server.queryCount("fail.test/A") == 4);
+    }
+
+    //a full cache evicts the entry closest to expiring
+    {
+        frame::aio::DnsConfiguration small_cfg = cfg;
+
+        small_cfg.cache_capacity = 2;
+
+        frame::aio::DnsResolver small_resolver(small_cfg);
+
+        solid_check(!small_resolver.start(scheduler, service), "start failed");
+
+        const size_t short_count = server.queryCount("short.test/A");
+        const size_t host_count  = server.queryCount("host.test/A");
+
+        resolve(small_resolver, "short.test", SocketInfo::Inet4); //ttl 1s
+        resolve(small_resolver, "host.test", SocketInfo::Inet4); //ttl 60s
+        resolve(small_resolver, "missing.test", SocketInfo::Inet4); //negative ttl 30s, evicts short.test
+        solid_check(small_resolver.cacheSize() == 2, "size " << small_resolver.cacheSize());
+
+        ResultT result = resolve(small_resolver, "host.test", SocketInfo::Inet4);
+        solid_check(!result.second && result.first->size() == 2);
+        solid_check(server.queryCount("host.test/A") == host_count + 1);
+
+        result = resolve(small_resolver, "short.test", SocketInfo::Inet4);
+        solid_check(!result.second && result.first->size() == 1);
+        solid_check(server.queryCount("short.test/A") == short_count + 2);
+    }
+
+    manager.stop();
+
+    {
+        const ResultT result = resolve(resolver, "other.test");
+        solid_check(result.second == frame::aio::error_dns_stopped);
+    }
+    return 0;
+}
@@ -27,6 +27,7 @@
 #include <iostream>
 #include <signal.h>
 #include <sstream>
+#include <unistd.h>
 
 using namespace std;
 using namespace solid;
@@ -45,9 +46,27 @@ const size_t         repeat_count = 10000;
 std::string          srv_port_str;
 std::string          rly_port_str;
 bool                 be_secure       = false;
+bool                 use_ktls        = false;
+bool                 use_offload     = false;
 bool                 use_relay       = false;
 unsigned             wait_seconds    = 100;
 constexpr const bool enable_no_delay = true;
+AtomicSizeT          secure_count{0};
+AtomicSizeT          ktls_count{0};
+
+void count_handshake(const frame::aio::openssl::Socket& _rsock)
+{
+    ++secure_count;
+    if (_rsock.isKernelTlsSend() && _rsock.isKernelTlsRecv()) {
+        ++ktls_count;
+    }
+}
+
+//the tls module is loaded on the first TCP_ULP request, if the kernel has it
+bool kernel_tls_available()
+{
+    return ::access("/proc/net/tls_stat", F_OK) == 0;
+}
 } //namespace
 //-----------------------------------------------------------------------------
 frame::aio::Resolver& async_resolver(frame::aio::Resolver* _pres = nullptr);
@@ -169,6 +188,7 @@ private:
         sock.secureSetVerifyCallback(_rctx, frame::aio::openssl::VerifyModePeer, onSecureVerify);
         if (sock.secureAccept(_rctx, onSecureAccept)) {
             if (!_rctx.error()) {
+                count_handshake(sock.socket());
                 sock.postRecvSome(_rctx, buf, BufferCapacity, Connection::onRecv); //fully asynchronous call
             } else {
                 solid_dbg(generic_logger, Error, this << " postStop: " << _rctx.systemError().message());
@@ -180,6 +200,7 @@ private:
     {
         SecureConnection& rthis = static_cast<SecureConnection&>(_rctx.actor());
         if (!_rctx.error()) {
+            count_handshake(rthis.sock.socket());
             solid_dbg(generic_logger, Info, &rthis << " postRecvSome");
             rthis.postRecvSome(_rctx); //fully asynchronous call
         } else {
@@ -347,8 +368,8 @@ private:
             sock.secureSetVerifyDepth(_rctx, 10);
             sock.secureSetCheckHostName(_rctx, "echo-server");
             sock.secureSetVerifyCallback(_rctx, frame::aio::openssl::VerifyModePeer, onSecureVerify);
-            if (sock.secureConnect(_rctx, Connection::onConnect)) {
-                Connection::onConnect(_rctx);
+            if (sock.secureConnect(_rctx, onSecureConnect)) {
+                onSecureConnect(_rctx);
             }
         } else {
             solid_dbg(generic_logger, Error, this << " postStop");
@@ -356,6 +377,15 @@ private:
         }
     }
 
+    static void onSecureConnect(frame::aio::ReactorContext& _rctx)
+    {
+        SecureConnection& rthis = static_cast<SecureConnection&>(_rctx.actor());
+        if (!_rctx.error()) {
+            count_handshake(rthis.sock.socket());
+        }
+        Connection::onConnect(_rctx);
+    }
+
     static bool onSecureVerify(frame::aio::ReactorContext& _rctx, bool _preverified, frame::aio::openssl::VerifyContext& /*_rverify_ctx*/)
     {
         SecureConnection& rthis = static_cast<SecureConnection&>(_rctx.actor());
@@ -456,6 +486,14 @@ int test_echo_tcp_stress(int argc, char* argv[])
         if (*argv[2] == 's' || *argv[2] == 'S') {
             be_secure = true;
         }
+        if (*argv[2] == 'k' || *argv[2] == 'K') {
+            be_secure = true;
+            use_ktls  = true;
+        }
+        if (*argv[2] == 'o' || *argv[2] == 'O') {
+            be_secure   = true;
+            use_offload = true;
+        }
         if (*argv[2] == 'r' || *argv[2] == 'R') {
             use_relay = true;
         }
@@ -465,6 +503,14 @@ int test_echo_tcp_stress(int argc, char* argv[])
         if (*argv[3] == 's' || *argv[3] == 'S') {
             be_secure = true;
         }
+        if (*argv[3] == 'k' || *argv[3] == 'K') {
+            be_secure = true;
+            use_ktls  = true;
+        }
+        if (*argv[3] == 'o' || *argv[3] == 'O') {
+            be_secure   = true;
+            use_offload = true;
+        }
         if (*argv[3] == 'r' || *argv[3] == 'R') {
             use_relay = true;
         }
@@ -476,8 +522,13 @@ int test_echo_tcp_stress(int argc, char* argv[])
         SecureContextT       srv_secure_ctx{SecureContextT::create()};
         frame::ServiceT      srv_svc{srv_mgr};
         CallPool<void()>     cwp{WorkPoolConfiguration(), 1};
+        CallPool<void()>     handshake_cwp{WorkPoolConfiguration(), 2};
         frame::aio::Resolver resolver(cwp);
 
+        auto handshake_executor = [&handshake_cwp](SecureContextT::HandshakeJobT&& _ujob) {
+            handshake_cwp.push(std::move(_ujob));
+        };
+
         async_resolver(&resolver);
 
         if (be_secure) {
@@ -488,6 +539,14 @@ int test_echo_tcp_stress(int argc, char* argv[])
             solid_check(!err, "failed loadCertificateFile " << err.message());
             err = srv_secure_ctx.loadPrivateKeyFile("echo-server-key.pem");
             solid_check(!err, "failed loadPrivateKeyFile " << err.message());
+            if (use_ktls) {
+                err = srv_secure_ctx.enableKernelTls();
+                solid_check(!err, "failed enableKernelTls " << err.message());
+            }
+            if (use_offload) {
+                err = srv_secure_ctx.handshakeExecutor(handshake_executor);
+                solid_check(!err, "failed handshakeExecutor " << err.message());
+            }
         }
 
         srv_sch.start(thread::hardware_concurrency());
@@ -574,6 +633,14 @@ int test_echo_tcp_stress(int argc, char* argv[])
             solid_check(!err, "failed loadCertificateFile " << err.message());
             err = clt_secure_ctx.loadPrivateKeyFile("echo-client-key.pem");
             solid_check(!err, "failed loadPrivateKeyFile " << err.message());
+            if (use_ktls) {
+                err = clt_secure_ctx.enableKernelTls();
+                solid_check(!err, "failed enableKernelTls " << err.message());
+            }
+            if (use_offload) {
+                err = clt_secure_ctx.handshakeExecutor(handshake_executor);
+                solid_check(!err, "failed handshakeExecutor " << err.message());
+            }
         }
 
         clt_sch.start(thread::hardware_concurrency());
@@ -611,6 +678,14 @@ int test_echo_tcp_stress(int argc, char* argv[])
         }
     }
 
+    if (use_ktls) {
+        cout << "Kernel TLS on " << ktls_count << " of " << secure_count << " handshakes" << endl;
+        solid_check(secure_count != 0);
+        if (kernel_tls_available()) {
+            solid_check(ktls_count == secure_count, "kernel TLS not enabled on all connections");
+        }
+    }
+
     return 0;
 }
 
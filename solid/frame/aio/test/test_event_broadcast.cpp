@@ -0,0 +1,151 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/actor.hpp"
+#include "solid/frame/reactor.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+#include "solid/utility/string.hpp"
+
+#include <future>
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using SchedulerT    = frame::Scheduler<frame::Reactor>;
+using AtomicSizeT   = atomic<size_t>;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+struct Context {
+    AtomicSizeT   pending_count_{0};
+    AtomicSizeT   kill_count_{0};
+    promise<void> prom_;
+
+    void done()
+    {
+        if (pending_count_.fetch_sub(1) == 1) {
+            prom_.set_value();
+        }
+    }
+};
+
+class AioActor final : public frame::aio::Actor {
+public:
+    AioActor(Context& _rctx)
+        : rctx_(_rctx)
+    {
+    }
+
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_resume) {
+            solid_check(!resumed_, "event raised twice");
+            resumed_ = true;
+            rctx_.done();
+        } else if (_revent == generic_event_kill) {
+            ++rctx_.kill_count_;
+            postStop(_rctx);
+        }
+    }
+
+private:
+    Context& rctx_;
+    bool     resumed_ = false;
+};
+
+class BasicActor final : public frame::Actor {
+public:
+    BasicActor(Context& _rctx)
+        : rctx_(_rctx)
+    {
+    }
+
+    void onEvent(frame::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_resume) {
+            solid_check(!resumed_, "event raised twice");
+            resumed_ = true;
+            rctx_.done();
+        } else if (_revent == generic_event_kill) {
+            ++rctx_.kill_count_;
+            postStop(_rctx);
+        }
+    }
+
+private:
+    Context& rctx_;
+    bool     resumed_ = false;
+};
+
+} //namespace
+
+int test_event_broadcast(int argc, char* argv[])
+{
+    size_t actor_count   = 20000;
+    size_t reactor_count = 4;
+    int    wait_seconds  = 100;
+
+    if (argc > 1) {
+        actor_count = make_number(argv[1]);
+    }
+
+    if (argc > 2) {
+        reactor_count = make_number(argv[2]);
+    }
+
+    solid::log_start(std::cerr, {"test:EW"});
+
+    auto lambda = [&]() {
+        ErrorConditionT err;
+        AioSchedulerT   aio_scheduler;
+        SchedulerT      basic_scheduler;
+        frame::Manager  manager;
+        frame::ServiceT aio_service{manager};
+        frame::ServiceT basic_service{manager};
+        Context         aio_context;
+        Context         basic_context;
+
+        aio_scheduler.start(reactor_count);
+        basic_scheduler.start(reactor_count);
+
+        for (size_t i = 0; i < actor_count; ++i) {
+            aio_scheduler.startActor(make_dynamic<AioActor>(aio_context), aio_service, make_event(GenericEvents::Start), err);
+            solid_check(!err, "starting aio actor: " << err.message());
+            basic_scheduler.startActor(make_dynamic<BasicActor>(basic_context), basic_service, make_event(GenericEvents::Start), err);
+            solid_check(!err, "starting actor: " << err.message());
+        }
+
+        aio_context.pending_count_   = actor_count;
+        basic_context.pending_count_ = actor_count;
+
+        solid_check(aio_service.notifyAll(make_event(GenericEvents::Resume)) == actor_count);
+        solid_check(basic_service.notifyAll(make_event(GenericEvents::Resume)) == actor_count);
+
+        solid_check(aio_context.prom_.get_future().wait_for(chrono::seconds(wait_seconds)) == future_status::ready);
+        solid_check(basic_context.prom_.get_future().wait_for(chrono::seconds(wait_seconds)) == future_status::ready);
+
+        aio_service.stop();
+        basic_service.stop();
+
+        solid_check(aio_context.kill_count_ == actor_count);
+        solid_check(basic_context.kill_count_ == actor_count);
+    };
+
+    if (async(launch::async, lambda).wait_for(chrono::seconds(wait_seconds)) != future_status::ready) {
+        solid_throw(" Test is taking too long - waited " << wait_seconds << " secs");
+    }
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+#include "solid/utility/string.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using AtomicSizeT   = atomic<size_t>;
+using TimePointT    = chrono::steady_clock::time_point;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+enum struct PerfEvents {
+    Small,
+    Large,
+    Done,
+};
+
+const EventCategory<PerfEvents> perf_event_category{
+    "perf_event_category",
+    [](const PerfEvents _evt) {
+        switch (_evt) {
+        case PerfEvents::Small:
+            return "small";
+        case PerfEvents::Large:
+            return "large";
+        case PerfEvents::Done:
+            return "done";
+        default:
+            return "unknown";
+        }
+    }};
+
+struct SmallPayload {
+    TimePointT time_point_;
+    uint64_t   index_;
+};
+
+struct LargePayload {
+    TimePointT time_point_;
+    uint64_t   index_;
+    uint64_t   data_[4];
+};
+
+static_assert(Event::fitsInline<SmallPayload>(), "SmallPayload must fit the Event inline storage");
+
+struct Context {
+    AtomicSizeT      handled_count_{0};
+    AtomicSizeT      heap_count_{0};
+    vector<uint64_t> latency_vec_; //nanoseconds, only written by the actor
+    promise<void>    prom_;
+};
+
+class Actor final : public frame::aio::Actor {
+public:
+    Actor(Context& _rctx)
+        : rctx_(_rctx)
+    {
+    }
+
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        static const EventHandler<void, Actor&, frame::aio::ReactorContext&> event_handler = {
+            [](Event& _revt, Actor& _ractor, frame::aio::ReactorContext& _rctx) {
+                if (_revt == generic_event_kill) {
+                    _ractor.postStop(_rctx);
+                }
+            },
+            {{perf_event_category.event(PerfEvents::Small),
+                 [](Event& _revt, Actor& _ractor, frame::aio::ReactorContext& /*_rctx*/) {
+                     _ractor.onPayload(_revt, _revt.any().cast<SmallPayload>()->time_point_);
+                 }},
+                {perf_event_category.event(PerfEvents::Large),
+                    [](Event& _revt, Actor& _ractor, frame::aio::ReactorContext& /*_rctx*/) {
+                        _ractor.onPayload(_revt, _revt.any().cast<LargePayload>()->time_point_);
+                    }},
+                {perf_event_category.event(PerfEvents::Done),
+                    [](Event& /*_revt*/, Actor& _ractor, frame::aio::ReactorContext& /*_rctx*/) {
+                        _ractor.rctx_.prom_.set_value();
+                    }}}};
+
+        event_handler.handle(_revent, *this, _rctx);
+    }
+
+private:
+    void onPayload(Event& _revt, TimePointT const& _rtime_point)
+    {
+        const auto now = chrono::steady_clock::now();
+        if (!_revt.any().usesData()) {
+            ++rctx_.heap_count_;
+        }
+        if (rctx_.latency_vec_.size() < rctx_.latency_vec_.capacity()) {
+            rctx_.latency_vec_.push_back(chrono::duration_cast<chrono::nanoseconds>(now - _rtime_point).count());
+        }
+        ++rctx_.handled_count_;
+    }
+
+private:
+    Context& rctx_;
+};
+
+void report(const char* _name, Context& _rctx, const size_t _count, const uint64_t _flood_usecs)
+{
+    auto& rvec = _rctx.latency_vec_;
+    sort(rvec.begin(), rvec.end());
+
+    uint64_t sum = 0;
+    for (const auto v : rvec) {
+        sum += v;
+    }
+
+    cout << _name << ": ping-pong latency avg = " << (rvec.empty() ? 0 : sum / rvec.size()) << "ns"
+         << " p50 = " << (rvec.empty() ? 0 : rvec[rvec.size() / 2]) << "ns"
+         << " p99 = " << (rvec.empty() ? 0 : rvec[(rvec.size() * 99) / 100]) << "ns"
+         << " flood = " << (_flood_usecs != 0 ? (_count * 1000000ULL) / _flood_usecs : 0) << " events/s"
+         << " heap payloads per event = " << static_cast<double>(_rctx.heap_count_) / (2 * _count) << endl;
+}
+
+template <class Payload>
+void run(AioSchedulerT& _rsch, frame::ServiceT& _rsvc, frame::Manager& _rm, const PerfEvents _id, const size_t _count, const char* _name)
+{
+    Context         ctx;
+    ErrorConditionT err;
+
+    ctx.latency_vec_.reserve(_count);
+
+    const frame::ActorIdT actor_id = _rsch.startActor(make_dynamic<Actor>(ctx), _rsvc, make_event(GenericEvents::Start), err);
+    solid_check(!err, "starting actor: " << err.message());
+
+    //raise-to-handler latency: one event in flight
+    for (size_t i = 0; i < _count; ++i) {
+        _rm.notify(actor_id, perf_event_category.event(_id, Payload{chrono::steady_clock::now(), i}));
+        while (ctx.handled_count_.load(memory_order_acquire) != (i + 1)) {
+            this_thread::yield();
+        }
+    }
+
+    //throughput: the reactor drains batches of raised events
+    const auto start_time = chrono::steady_clock::now();
+    for (size_t i = 0; i < _count; ++i) {
+        _rm.notify(actor_id, perf_event_category.event(_id, Payload{chrono::steady_clock::now(), i}));
+    }
+    _rm.notify(actor_id, perf_event_category.event(PerfEvents::Done));
+
+    solid_check(ctx.prom_.get_future().wait_for(chrono::seconds(100)) == future_status::ready, "took too long");
+
+    const uint64_t flood_usecs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time).count();
+
+    solid_check(ctx.handled_count_ == 2 * _count);
+
+    if (Event::fitsInline<Payload>()) {
+        solid_check(ctx.heap_count_ == 0, _name << " payload was allocated");
+    } else {
+        solid_check(ctx.heap_count_ == 2 * _count);
+    }
+
+    report(_name, ctx, _count, flood_usecs);
+
+    _rm.notify(actor_id, make_event(GenericEvents::Kill));
+}
+
+} //namespace
+
+int test_event_latency(int argc, char* argv[])
+{
+    size_t count               = 100000;
+    size_t busy_poll_budget_us = 0;
+
+    if (argc > 1) {
+        count = make_number(argv[1]);
+    }
+    if (argc > 2) {
+        busy_poll_budget_us = make_number(argv[2]);
+    }
+
+    solid::log_start(std::cerr, {"test:EW", "solid::frame::aio.*:EW"});
+
+    cout << "Event::inline_size = " << Event::inline_size << " sizeof(SmallPayload) = " << sizeof(SmallPayload)
+         << " sizeof(LargePayload) = " << sizeof(LargePayload) << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  m;
+    frame::ServiceT svc{m};
+
+    if (busy_poll_budget_us != 0) {
+        frame::aio::BusyPollConfiguration busy_poll_cfg;
+        busy_poll_cfg.budget = chrono::microseconds(busy_poll_budget_us);
+
+        cout << "busy poll budget = " << busy_poll_budget_us << "us" << endl;
+
+        sch.start([busy_poll_cfg]() { return frame::aio::Reactor::configureBusyPoll(busy_poll_cfg); }, []() {}, 1);
+    } else {
+        sch.start(1);
+    }
+
+    run<SmallPayload>(sch, svc, m, PerfEvents::Small, count, "small");
+    run<LargePayload>(sch, svc, m, PerfEvents::Large, count, "large");
+
+    {
+        frame::ReactorStatisticVectorT stat_vec;
+        sch.statistic(stat_vec);
+
+        solid_check(stat_vec.size() == 1);
+        cout << stat_vec.front() << endl;
+#ifdef SOLID_HAS_STATISTICS
+        const auto& rstat = stat_vec.front();
+        solid_check(rstat.loop_count_ != 0 && rstat.exec_time_ns_ != 0);
+        solid_check(rstat.raise_count_ >= 4 * count, "raise_count = " << rstat.raise_count_);
+
+        const auto it = find_if(rstat.actor_type_vec_.begin(), rstat.actor_type_vec_.end(),
+            [](const frame::ReactorStatistic::ActorType& _ratype) { return _ratype.name_ != nullptr && string(_ratype.name_) == typeid(Actor).name(); });
+        solid_check(it != rstat.actor_type_vec_.end() && it->call_count_ >= 4 * count);
+#endif
+    }
+
+    m.stop();
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+#include "solid/utility/string.hpp"
+
+#include <chrono>
+#include <deque>
+#include <future>
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using AtomicSizeT   = atomic<size_t>;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+struct Context {
+    AtomicSizeT   pending_count_{0};
+    promise<void> prom_;
+
+    void done()
+    {
+        if (pending_count_.fetch_sub(1) == 1) {
+            prom_.set_value();
+        }
+    }
+};
+
+//! One end of a ping-pong connection
+/*!
+ * Besides its stream it registers _filler_count idle timers onto the
+ * reactor, so that the few active completion handlers are spread over
+ * a big completion handler table.
+ */
+class Peer final : public frame::aio::Actor {
+public:
+    Peer(SocketDevice&& _rsd, const size_t _filler_count, const size_t _roundtrip_count, Context* _pctx)
+        : sock_(this->proxy(), std::move(_rsd))
+        , roundtrip_count_(_roundtrip_count)
+        , pctx_(_pctx)
+    {
+        for (size_t i = 0; i < _filler_count; ++i) {
+            timer_dq_.emplace_back(this->proxy());
+        }
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_start) {
+            sock_.device().enableNoDelay();
+            if (pctx_ != nullptr) {
+                sock_.postSendAll(_rctx, buf_, 1, Peer::onSend);
+            } else {
+                sock_.postRecvSome(_rctx, buf_, sizeof(buf_), Peer::onRecv);
+            }
+        } else if (_revent == generic_event_kill) {
+            postStop(_rctx);
+        }
+    }
+
+    static void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        Peer& rthis = static_cast<Peer&>(_rctx.actor());
+        solid_check(!_rctx.error(), "send: " << _rctx.systemError().message());
+        rthis.sock_.postRecvSome(_rctx, rthis.buf_, sizeof(rthis.buf_), Peer::onRecv);
+    }
+
+    static void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        Peer& rthis = static_cast<Peer&>(_rctx.actor());
+        if (_rctx.error()) {
+            rthis.postStop(_rctx);
+            return;
+        }
+        if (rthis.pctx_ != nullptr && ++rthis.crt_count_ == rthis.roundtrip_count_) {
+            rthis.pctx_->done();
+            return;
+        }
+        rthis.sock_.postSendAll(_rctx, rthis.buf_, _sz, Peer::onSend);
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+    using TimerDequeT   = std::deque<frame::aio::SteadyTimer>;
+
+    StreamSocketT sock_;
+    TimerDequeT   timer_dq_;
+    const size_t  roundtrip_count_;
+    size_t        crt_count_ = 0;
+    Context*      pctx_;
+    char          buf_[16];
+};
+
+} //namespace
+
+int test_reactor_dispatch(int argc, char* argv[])
+{
+    size_t handler_count   = 1000;
+    size_t pair_count      = 16;
+    size_t roundtrip_count = 2000;
+    int    wait_seconds    = 200;
+
+    if (argc > 1) {
+        handler_count = make_number(argv[1]);
+    }
+
+    if (argc > 2) {
+        pair_count = make_number(argv[2]);
+    }
+
+    if (argc > 3) {
+        roundtrip_count = make_number(argv[3]);
+    }
+
+    solid::log_start(std::cerr, {"test:EW"});
+
+    auto lambda = [&]() {
+        ErrorConditionT err;
+        AioSchedulerT   scheduler;
+        frame::Manager  manager;
+        frame::ServiceT service{manager};
+        Context         context;
+        SocketDevice    listener;
+        ResolveData     rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Stream);
+
+        listener.create(rd.begin());
+        solid_check(!listener.prepareAccept(rd.begin(), pair_count + 1), "listen failed");
+
+        SocketAddress local_address;
+        listener.localAddress(local_address);
+
+        ResolveData crd = synchronous_resolve("127.0.0.1", local_address.port(), 0, SocketInfo::Inet4, SocketInfo::Stream);
+
+        scheduler.start(1);
+
+        context.pending_count_ = pair_count;
+
+        const size_t filler_count = handler_count / (2 * pair_count);
+
+        for (size_t i = 0; i < pair_count; ++i) {
+            SocketDevice client;
+            SocketDevice server;
+
+            client.create(crd.begin());
+            solid_check(!client.connect(crd.begin()), "connect failed");
+            solid_check(!listener.accept(server), "accept failed");
+
+            client.makeNonBlocking();
+            server.makeNonBlocking();
+
+            scheduler.startActor(make_dynamic<Peer>(std::move(server), filler_count, roundtrip_count, nullptr), service, make_event(GenericEvents::Start), err);
+            solid_check(!err, "start server peer: " << err.message());
+
+            scheduler.startActor(make_dynamic<Peer>(std::move(client), filler_count, roundtrip_count, &context), service, make_event(GenericEvents::Start), err);
+            solid_check(!err, "start client peer: " << err.message());
+        }
+
+        const auto start_time = chrono::steady_clock::now();
+
+        solid_check(context.prom_.get_future().wait_for(chrono::seconds(wait_seconds)) == future_status::ready);
+
+        const auto   msecs        = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start_time).count();
+        const size_t event_count  = pair_count * roundtrip_count * 2;
+        const double events_per_s = msecs != 0 ? (event_count * 1000.0) / msecs : 0.0;
+
+        cout << "handler_count = " << handler_count << " pair_count = " << pair_count << " roundtrip_count = " << roundtrip_count
+             << " duration = " << msecs << "ms recv events/s = " << static_cast<uint64_t>(events_per_s) << endl;
+    };
+
+    if (async(launch::async, lambda).wait_for(chrono::seconds(wait_seconds)) != future_status::ready) {
+        solid_throw(" Test is taking too long - waited " << wait_seconds << " secs");
+    }
+
+    return 0;
+}
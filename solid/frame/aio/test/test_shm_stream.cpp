@@ -0,0 +1,305 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioshmstream.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+#include "solid/utility/string.hpp"
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+//some chunks are larger than the smallest ring, so they wrap and wait for free space
+const size_t chunk_sizes[] = {1, 100, 4095, 4096, 4097, 16 * 1024, 65536, 300 * 1000, 7};
+
+enum {
+    BufferCapacity = 8 * 1024
+};
+
+char pattern(const uint64_t _offset)
+{
+    return static_cast<char>(((_offset ^ (_offset >> 8) ^ (_offset >> 16)) * 131) & 0xff);
+}
+
+//! Echoes back everything it receives, until the channel is shut down
+class Server final : public frame::aio::Actor {
+public:
+    Server(frame::aio::ShmChannel&& _uch, promise<uint64_t>& _rprom)
+        : rprom_(_rprom)
+        , stream_(this->proxy(), std::move(_uch))
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_start) {
+            postRecvSome(_rctx);
+        } else if (_revent == generic_event_kill) {
+            postStop(_rctx);
+        }
+    }
+
+    void postRecvSome(frame::aio::ReactorContext& _rctx)
+    {
+        stream_.postRecvSome(_rctx, buf_, BufferCapacity, [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); });
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        do {
+            if (_rctx.error()) {
+                solid_check(_rctx.error() == frame::aio::error_stream_shutdown, "unexpected error: " << _rctx.error().message());
+                rprom_.set_value(echo_count_);
+                postStop(_rctx);
+                return;
+            }
+            echo_count_ += _sz;
+            if (!stream_.sendAll(_rctx, buf_, _sz, [this](frame::aio::ReactorContext& _rctx) { onSend(_rctx); })) {
+                return;
+            }
+            solid_check(!_rctx.error(), "send error: " << _rctx.error().message());
+        } while (stream_.recvSome(_rctx, buf_, BufferCapacity, [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); }, _sz));
+    }
+
+    void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        solid_check(!_rctx.error(), "send error: " << _rctx.error().message());
+        postRecvSome(_rctx);
+    }
+
+private:
+    promise<uint64_t>&    rprom_;
+    frame::aio::ShmStream stream_;
+    uint64_t              echo_count_ = 0;
+    char                  buf_[BufferCapacity];
+};
+
+//! Sends _count chunks and checks that they all come back, then shuts the channel down
+class Client final : public frame::aio::Actor {
+public:
+    Client(frame::aio::ShmChannel&& _uch, const size_t _count, promise<uint64_t>& _rprom)
+        : rprom_(_rprom)
+        , count_(_count)
+        , stream_(this->proxy(), std::move(_uch))
+    {
+        size_t max_size = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            const size_t sz = chunk_sizes[i % (sizeof(chunk_sizes) / sizeof(size_t))];
+            total_size_ += sz;
+            max_size = std::max(max_size, sz);
+        }
+        send_buf_.resize(max_size);
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_start) {
+            stream_.postRecvSome(_rctx, recv_buf_, BufferCapacity, [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); });
+            sendNext(_rctx);
+        } else if (_revent == generic_event_kill) {
+            postStop(_rctx);
+        }
+    }
+
+    void sendNext(frame::aio::ReactorContext& _rctx)
+    {
+        while (send_count_ < count_) {
+            const size_t sz = chunk_sizes[send_count_ % (sizeof(chunk_sizes) / sizeof(size_t))];
+
+            for (size_t i = 0; i < sz; ++i) {
+                send_buf_[i] = pattern(send_offset_ + i);
+            }
+            ++send_count_;
+            send_offset_ += sz;
+
+            if (!stream_.sendAll(_rctx, send_buf_.data(), sz, [this](frame::aio::ReactorContext& _rctx) { onSend(_rctx); })) {
+                return;
+            }
+            solid_check(!_rctx.error(), "send error: " << _rctx.error().message());
+        }
+    }
+
+    void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        solid_check(!_rctx.error(), "send error: " << _rctx.error().message());
+        sendNext(_rctx);
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        do {
+            solid_check(!_rctx.error(), "recv error: " << _rctx.error().message() << " after " << recv_offset_ << " bytes");
+
+            for (size_t i = 0; i < _sz; ++i) {
+                solid_check(recv_buf_[i] == pattern(recv_offset_ + i), "invalid data at offset " << (recv_offset_ + i));
+            }
+            recv_offset_ += _sz;
+
+            if (recv_offset_ == total_size_) {
+                solid_log(logger, Info, "done: " << recv_offset_ << " bytes");
+                stream_.shutdown(_rctx);
+                rprom_.set_value(recv_offset_);
+                postStop(_rctx);
+                return;
+            }
+        } while (stream_.recvSome(_rctx, recv_buf_, BufferCapacity, [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); }, _sz));
+    }
+
+private:
+    promise<uint64_t>&    rprom_;
+    const size_t          count_;
+    frame::aio::ShmStream stream_;
+    uint64_t              total_size_  = 0;
+    size_t                send_count_  = 0;
+    uint64_t              send_offset_ = 0;
+    uint64_t              recv_offset_ = 0;
+    vector<char>          send_buf_;
+    char                  recv_buf_[BufferCapacity];
+};
+
+uint64_t run_server(frame::aio::ShmChannel&& _uch)
+{
+    AioSchedulerT     sch;
+    frame::Manager    m;
+    frame::ServiceT   svc{m};
+    promise<uint64_t> prom;
+    ErrorConditionT   err;
+
+    sch.start(1);
+
+    sch.startActor(make_dynamic<Server>(std::move(_uch), prom), svc, make_event(GenericEvents::Start), err);
+    solid_check(!err, "starting server: " << err.message());
+
+    auto fut = prom.get_future();
+    solid_check(fut.wait_for(chrono::seconds(100)) == future_status::ready, "server took too long");
+
+    m.stop();
+    return fut.get();
+}
+
+uint64_t run_client(frame::aio::ShmChannel&& _uch, const size_t _count)
+{
+    AioSchedulerT     sch;
+    frame::Manager    m;
+    frame::ServiceT   svc{m};
+    promise<uint64_t> prom;
+    ErrorConditionT   err;
+
+    sch.start(1);
+
+    const auto start_time = chrono::steady_clock::now();
+
+    sch.startActor(make_dynamic<Client>(std::move(_uch), _count, prom), svc, make_event(GenericEvents::Start), err);
+    solid_check(!err, "starting client: " << err.message());
+
+    auto fut = prom.get_future();
+    solid_check(fut.wait_for(chrono::seconds(100)) == future_status::ready, "client took too long");
+
+    const uint64_t total_size = fut.get();
+    const uint64_t usecs      = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time).count();
+
+    cout << "echoed " << total_size << " bytes in " << usecs << "us" << endl;
+
+    m.stop();
+    return total_size;
+}
+
+} //namespace
+
+//p - the echo server runs in a child process and gets its channel end over a unix socket, t - both ends in this process
+int test_shm_stream(int argc, char* argv[])
+{
+    size_t count         = 1000;
+    size_t ring_capacity = frame::aio::ShmChannel::default_ring_capacity;
+    char   mode          = 'p';
+
+    if (argc > 1) {
+        count = make_number(argv[1]);
+    }
+    if (argc > 2) {
+        ring_capacity = make_number(argv[2]);
+    }
+    if (argc > 3) {
+        mode = argv[3][0];
+    }
+
+    solid::log_start(std::cerr, {"test:EW", "solid::frame::aio.*:EW"});
+
+    if (mode == 't') {
+        frame::aio::ShmChannel end0;
+        frame::aio::ShmChannel end1;
+        ErrorCodeT             err = frame::aio::ShmChannel::create(end0, end1, ring_capacity);
+
+        solid_check(!err, "create channel: " << err.message());
+        solid_check(end0.capacity() >= ring_capacity && end0.capacity() == end1.capacity());
+
+        auto server_fut = async(launch::async, [&end1]() { return run_server(std::move(end1)); });
+
+        const uint64_t total_size = run_client(std::move(end0), count);
+
+        solid_check(server_fut.get() == total_size, "server echoed a different number of bytes");
+        return 0;
+    }
+
+    SocketDevice sd0;
+    SocketDevice sd1;
+    ErrorCodeT   err = sd0.createPair(sd1);
+
+    solid_check(!err, "socket pair: " << err.message());
+
+    //fork before starting any thread
+    //neither process closes its copy of the other end: SocketDevice::close shuts the connection down for both
+    const pid_t pid = fork();
+
+    solid_check(pid >= 0, "fork: " << last_system_error().message());
+
+    if (pid == 0) {
+        frame::aio::ShmChannel ch;
+
+        err = ch.recv(sd1);
+        solid_check(!err, "recv channel: " << err.message());
+
+        run_server(std::move(ch));
+        _exit(0);
+    }
+
+    frame::aio::ShmChannel end0;
+    frame::aio::ShmChannel end1;
+
+    err = frame::aio::ShmChannel::create(end0, end1, ring_capacity);
+    solid_check(!err, "create channel: " << err.message());
+
+    err = end1.send(sd0);
+    solid_check(!err, "send channel: " << err.message());
+    end1.close();
+
+    run_client(std::move(end0), count);
+
+    int status = 0;
+    solid_check(waitpid(pid, &status, 0) == pid, "waitpid: " << last_system_error().message());
+    solid_check(WIFEXITED(status) && WEXITSTATUS(status) == 0, "echo server process failed: " << status);
+    return 0;
+}
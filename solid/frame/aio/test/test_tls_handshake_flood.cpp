@@ -0,0 +1,415 @@
+#include "solid/frame/aio/openssl/aiosecurecontext.hpp"
+#include "solid/frame/aio/openssl/aiosecuresocket.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+#include "solid/utility/string.hpp"
+#include "solid/utility/workpool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <signal.h>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT  = frame::Scheduler<frame::aio::Reactor>;
+using AtomicSizeT    = atomic<size_t>;
+using SecureContextT = frame::aio::openssl::Context;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+struct Context {
+    AtomicSizeT      pending_count_{0};
+    promise<void>    prom_;
+    mutex            mutex_;
+    vector<uint64_t> latency_vec_; //microseconds
+
+    void done(vector<uint64_t>& _rlatency_vec)
+    {
+        {
+            lock_guard<mutex> lock(mutex_);
+            latency_vec_.insert(latency_vec_.end(), _rlatency_vec.begin(), _rlatency_vec.end());
+        }
+        if (pending_count_.fetch_sub(1) == 1) {
+            prom_.set_value();
+        }
+    }
+};
+
+using StreamSocketT = frame::aio::Stream<frame::aio::openssl::Socket>;
+
+//! Server side echo connection - both for the established and for the flood connections
+class ServerPeer final : public frame::aio::Actor {
+public:
+    ServerPeer(SocketDevice&& _rsd, SecureContextT& _rsecure_ctx)
+        : sock_(this->proxy(), std::move(_rsd), _rsecure_ctx)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_start) {
+            if (sock_.secureAccept(_rctx, ServerPeer::onSecureAccept)) {
+                onSecureAccept(_rctx);
+            }
+        } else if (_revent == generic_event_kill) {
+            postStop(_rctx);
+        }
+    }
+
+    static void onSecureAccept(frame::aio::ReactorContext& _rctx)
+    {
+        ServerPeer& rthis = static_cast<ServerPeer&>(_rctx.actor());
+        if (_rctx.error()) {
+            rthis.postStop(_rctx);
+            return;
+        }
+        rthis.sock_.postRecvSome(_rctx, rthis.buf_, sizeof(rthis.buf_), ServerPeer::onRecv);
+    }
+
+    static void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        ServerPeer& rthis = static_cast<ServerPeer&>(_rctx.actor());
+        if (_rctx.error()) {
+            rthis.postStop(_rctx);
+            return;
+        }
+        rthis.sock_.postRecvSome(_rctx, rthis.buf_, sizeof(rthis.buf_), ServerPeer::onRecv);
+    }
+
+    static void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        ServerPeer& rthis = static_cast<ServerPeer&>(_rctx.actor());
+        if (_rctx.error()) {
+            rthis.postStop(_rctx);
+            return;
+        }
+        rthis.sock_.postSendAll(_rctx, rthis.buf_, _sz, ServerPeer::onSend);
+    }
+
+private:
+    StreamSocketT sock_;
+    char          buf_[64];
+};
+
+class Listener final : public frame::aio::Actor {
+public:
+    Listener(AioSchedulerT& _rsch, frame::ServiceT& _rsvc, SocketDevice&& _rsd, SecureContextT& _rsecure_ctx)
+        : rsch_(_rsch)
+        , rsvc_(_rsvc)
+        , rsecure_ctx_(_rsecure_ctx)
+        , sock_(this->proxy(), std::move(_rsd))
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_start) {
+            sock_.postAccept(_rctx, [this](frame::aio::ReactorContext& _rctx, SocketDevice& _rsd) { onAccept(_rctx, _rsd); });
+        } else if (_revent == generic_event_kill) {
+            postStop(_rctx);
+        }
+    }
+
+    void onAccept(frame::aio::ReactorContext& _rctx, SocketDevice& _rsd)
+    {
+        size_t repeat_count = 16;
+        do {
+            if (_rctx.error()) {
+                break;
+            }
+            ErrorConditionT err;
+            _rsd.enableNoDelay();
+            rsch_.startActor(make_dynamic<ServerPeer>(std::move(_rsd), rsecure_ctx_), rsvc_, make_event(GenericEvents::Start), err);
+            --repeat_count;
+        } while (repeat_count != 0u && sock_.accept(
+                     _rctx, [this](frame::aio::ReactorContext& _rctx, SocketDevice& _rsd) { onAccept(_rctx, _rsd); }, _rsd));
+
+        if (repeat_count == 0u) {
+            sock_.postAccept(
+                _rctx,
+                [this](frame::aio::ReactorContext& _rctx, SocketDevice& _rsd) { onAccept(_rctx, _rsd); });
+        }
+    }
+
+private:
+    AioSchedulerT&       rsch_;
+    frame::ServiceT&     rsvc_;
+    SecureContextT&      rsecure_ctx_;
+    frame::aio::Listener sock_;
+};
+
+//! Client side of an established connection - measures the round trip latency
+class ClientPeer final : public frame::aio::Actor {
+public:
+    ClientPeer(SocketDevice&& _rsd, SecureContextT& _rsecure_ctx, const size_t _roundtrip_count, Context& _rctx)
+        : sock_(this->proxy(), std::move(_rsd), _rsecure_ctx)
+        , roundtrip_count_(_roundtrip_count)
+        , rctx_(_rctx)
+    {
+        latency_vec_.reserve(_roundtrip_count);
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (_revent == generic_event_start) {
+            sock_.secureSetCheckHostName(_rctx, "echo-server");
+            sock_.secureSetVerifyCallback(_rctx, frame::aio::openssl::VerifyModePeer, ClientPeer::onSecureVerify);
+            if (sock_.secureConnect(_rctx, ClientPeer::onSecureConnect)) {
+                onSecureConnect(_rctx);
+            }
+        } else if (_revent == generic_event_kill) {
+            postStop(_rctx);
+        }
+    }
+
+    static bool onSecureVerify(frame::aio::ReactorContext& /*_rctx*/, bool _preverified, frame::aio::openssl::VerifyContext& /*_rverify_ctx*/)
+    {
+        return _preverified;
+    }
+
+    static void onSecureConnect(frame::aio::ReactorContext& _rctx)
+    {
+        ClientPeer& rthis = static_cast<ClientPeer&>(_rctx.actor());
+        solid_check(!_rctx.error(), "secure connect: " << _rctx.error().message() << " " << _rctx.systemError().message());
+        rthis.send(_rctx);
+    }
+
+    void send(frame::aio::ReactorContext& _rctx)
+    {
+        send_time_ = chrono::steady_clock::now();
+        sock_.postSendAll(_rctx, buf_, sizeof(buf_), ClientPeer::onSend);
+    }
+
+    static void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        ClientPeer& rthis = static_cast<ClientPeer&>(_rctx.actor());
+        solid_check(!_rctx.error(), "send: " << _rctx.systemError().message());
+        rthis.recv_size_ = 0;
+        rthis.sock_.postRecvSome(_rctx, rthis.buf_, sizeof(rthis.buf_), ClientPeer::onRecv);
+    }
+
+    static void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        ClientPeer& rthis = static_cast<ClientPeer&>(_rctx.actor());
+        solid_check(!_rctx.error(), "recv: " << _rctx.systemError().message());
+
+        rthis.recv_size_ += _sz;
+        if (rthis.recv_size_ < sizeof(rthis.buf_)) {
+            rthis.sock_.postRecvSome(_rctx, rthis.buf_ + rthis.recv_size_, sizeof(rthis.buf_) - rthis.recv_size_, ClientPeer::onRecv);
+            return;
+        }
+
+        rthis.latency_vec_.emplace_back(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - rthis.send_time_).count());
+
+        if (rthis.latency_vec_.size() == rthis.roundtrip_count_) {
+            rthis.rctx_.done(rthis.latency_vec_);
+            return;
+        }
+        rthis.send(_rctx);
+    }
+
+private:
+    StreamSocketT                    sock_;
+    const size_t                     roundtrip_count_;
+    Context&                         rctx_;
+    size_t                           recv_size_ = 0;
+    chrono::steady_clock::time_point send_time_;
+    vector<uint64_t>                 latency_vec_;
+    char                             buf_[64];
+};
+
+//! Blocking TLS clients doing handshakes in a loop
+void flood_run(SSL_CTX* _pssl_ctx, ResolveData const& _rrd, atomic<bool>& _rrunning, AtomicSizeT& _rcount)
+{
+    while (_rrunning) {
+        SocketDevice sd;
+
+        sd.create(_rrd.begin());
+        if (sd.connect(_rrd.begin())) {
+            continue;
+        }
+
+        SSL* pssl = SSL_new(_pssl_ctx);
+
+        SSL_set_fd(pssl, sd.descriptor());
+
+        if (SSL_connect(pssl) == 1) {
+            ++_rcount;
+        }
+        SSL_free(pssl);
+    }
+}
+
+uint64_t percentile(vector<uint64_t> const& _rsorted_vec, const double _p)
+{
+    if (_rsorted_vec.empty()) {
+        return 0;
+    }
+    return _rsorted_vec[static_cast<size_t>(_p * (_rsorted_vec.size() - 1))];
+}
+
+} //namespace
+
+//! Latency of established TLS connections while the server reactor is flooded with handshakes
+/*!
+ * test_tls_handshake_flood [n|o] [flood_thread_count] [pair_count] [roundtrip_count]
+ * o - server handshakes run on a worker pool (Context::handshakeExecutor)
+ */
+int test_tls_handshake_flood(int argc, char* argv[])
+{
+    bool   offload            = false;
+    size_t flood_thread_count = 4;
+    size_t pair_count         = 4;
+    size_t roundtrip_count    = 2000;
+    int    wait_seconds       = 200;
+
+    if (argc > 1) {
+        offload = (*argv[1] == 'o' || *argv[1] == 'O');
+    }
+
+    if (argc > 2) {
+        flood_thread_count = make_number(argv[2]);
+    }
+
+    if (argc > 3) {
+        pair_count = make_number(argv[3]);
+    }
+
+    if (argc > 4) {
+        roundtrip_count = make_number(argv[4]);
+    }
+
+    solid::log_start(std::cerr, {"test:EW"});
+
+#ifndef SOLID_ON_WINDOWS
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    auto lambda = [&]() {
+        ErrorConditionT  err;
+        AioSchedulerT    srv_sch;
+        AioSchedulerT    clt_sch;
+        frame::Manager   manager;
+        frame::ServiceT  srv_svc{manager};
+        frame::ServiceT  clt_svc{manager};
+        SecureContextT   srv_secure_ctx{SecureContextT::create()};
+        SecureContextT   clt_secure_ctx{SecureContextT::create()};
+        CallPool<void()> handshake_cwp{WorkPoolConfiguration(), 1};
+        Context          context;
+        atomic<bool>     flood_running{true};
+        AtomicSizeT      flood_count{0};
+        vector<thread>   flood_thread_vec;
+
+        ErrorCodeT sslerr;
+        sslerr = srv_secure_ctx.loadCertificateFile("echo-server-cert.pem");
+        solid_check(!sslerr, "failed loadCertificateFile " << sslerr.message());
+        sslerr = srv_secure_ctx.loadPrivateKeyFile("echo-server-key.pem");
+        solid_check(!sslerr, "failed loadPrivateKeyFile " << sslerr.message());
+        sslerr = clt_secure_ctx.loadVerifyFile("echo-ca-cert.pem");
+        solid_check(!sslerr, "failed loadVerifyFile " << sslerr.message());
+
+        if (offload) {
+            sslerr = srv_secure_ctx.handshakeExecutor(
+                [&handshake_cwp](SecureContextT::HandshakeJobT&& _ujob) {
+                    handshake_cwp.push(std::move(_ujob));
+                });
+            solid_check(!sslerr, "failed handshakeExecutor " << sslerr.message());
+        }
+
+        srv_sch.start(1);
+        clt_sch.start(1);
+
+        ResolveData rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Stream);
+
+        SocketDevice listener;
+
+        listener.create(rd.begin());
+        solid_check(!listener.prepareAccept(rd.begin(), SocketInfo::max_listen_backlog_size()), "listen failed");
+
+        SocketAddress local_address;
+        listener.localAddress(local_address);
+
+        ResolveData crd = synchronous_resolve("127.0.0.1", local_address.port(), 0, SocketInfo::Inet4, SocketInfo::Stream);
+
+        srv_sch.startActor(make_dynamic<Listener>(srv_sch, srv_svc, std::move(listener), srv_secure_ctx), srv_svc, make_event(GenericEvents::Start), err);
+        solid_check(!err, "start listener: " << err.message());
+
+        for (size_t i = 0; i < flood_thread_count; ++i) {
+            flood_thread_vec.emplace_back(flood_run, clt_secure_ctx.nativeContext(), std::cref(crd), std::ref(flood_running), std::ref(flood_count));
+        }
+
+        //wait for the flood to start
+        while (flood_thread_count != 0 && flood_count < flood_thread_count) {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+
+        context.pending_count_ = pair_count;
+
+        const auto start_time = chrono::steady_clock::now();
+
+        for (size_t i = 0; i < pair_count; ++i) {
+            SocketDevice client;
+
+            client.create(crd.begin());
+            solid_check(!client.connect(crd.begin()), "connect failed");
+            client.enableNoDelay();
+            client.makeNonBlocking();
+
+            clt_sch.startActor(make_dynamic<ClientPeer>(std::move(client), clt_secure_ctx, roundtrip_count, context), clt_svc, make_event(GenericEvents::Start), err);
+            solid_check(!err, "start client peer: " << err.message());
+        }
+
+        solid_check(context.prom_.get_future().wait_for(chrono::seconds(wait_seconds)) == future_status::ready);
+
+        const auto msecs = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start_time).count();
+
+        flood_running = false;
+        for (auto& t : flood_thread_vec) {
+            t.join();
+        }
+
+        manager.stop();
+
+        vector<uint64_t>& rlatency_vec = context.latency_vec_;
+
+        solid_check(rlatency_vec.size() == pair_count * roundtrip_count);
+
+        sort(rlatency_vec.begin(), rlatency_vec.end());
+
+        cout << "offload = " << offload << " flood_thread_count = " << flood_thread_count << " pair_count = " << pair_count
+             << " roundtrip_count = " << roundtrip_count << " duration = " << msecs << "ms handshakes = " << flood_count
+             << " latency(us) p50 = " << percentile(rlatency_vec, 0.5) << " p99 = " << percentile(rlatency_vec, 0.99)
+             << " p999 = " << percentile(rlatency_vec, 0.999) << " max = " << rlatency_vec.back() << endl;
+    };
+
+    if (async(launch::async, lambda).wait_for(chrono::seconds(wait_seconds)) != future_status::ready) {
+        solid_throw(" Test is taking too long - waited " << wait_seconds << " secs");
+    }
+
+    return 0;
+}
@@ -17,6 +17,11 @@
 #include "solid/utility/common.hpp"
 #include "solid/utility/function.hpp"
 
+//! Inline storage for the callbacks kept by the reactors and the aio sockets
+#ifndef SOLID_FRAME_FUNCTION_STORAGE
+#define SOLID_FRAME_FUNCTION_STORAGE 64
+#endif
+
 namespace solid {
 namespace frame {
 
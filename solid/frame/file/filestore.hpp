@@ -69,6 +69,7 @@ struct Utf8Controller;
 struct File {
     File()
         : ptmp(nullptr)
+        , openflags(0)
     {
     }
     ~File()
@@ -79,7 +80,8 @@ struct File {
     {
         fd.close();
         delete ptmp;
-        ptmp = nullptr;
+        ptmp      = nullptr;
+        openflags = 0;
     }
     bool open(const char* _path, const int _openflags)
     {
@@ -121,6 +123,15 @@ struct File {
             return ptmp->truncate(_len);
         }
     }
+    //! Map a range of the file into memory - temp files cannot be mapped
+    bool map(FileView& _rview, int64_t _off = 0, size_t _sz = 0, const FileView::Advice _advice = FileView::NormalE) const
+    {
+        if (!ptmp) {
+            return fd.map(_rview, _off, _sz, _advice);
+        } else {
+            return false;
+        }
+    }
     int64_t capacity() const
     {
         if (!ptmp) {
@@ -152,6 +163,7 @@ private:
     friend struct Utf8Controller;
     FileDevice fd;
     TempBase*  ptmp;
+    size_t     openflags;
 };
 
 typedef shared::Pointer<File> FilePointerT;
@@ -226,7 +238,20 @@ struct Utf8Configuration {
     };
     typedef std::vector<Storage> StorageVectorT;
 
+    Utf8Configuration()
+        : cachecapacity(0)
+    {
+    }
+
     StorageVectorT storagevec;
+    //! Maximum number of files kept open after their last release (0 - no cache)
+    /*!
+        A file opened again with the same open flags reuses the cached
+        descriptor - no open(2). Opening with CreateE or TruncateE drops
+        the cached descriptor. Files changed behind the store's back
+        (removed, renamed over) must be dropped with invalidateCachedFile.
+    */
+    size_t cachecapacity;
 };
 
 struct Utf8OpenCommandBase;
@@ -257,6 +282,15 @@ struct Utf8Controller {
         shared::StoreBase::Accessor& _rsbacc, CreateTempCommandBase& _rcmd,
         FilePointerT& _rptr, size_t& _rflags, ErrorCodeT& _rerr);
 
+    //! Close the cached descriptor of a file, if any
+    void invalidateCachedFile(std::string const& _path);
+
+    //! True if the file was released and its descriptor is kept in the cache
+    bool isFileCached(std::string const& _path) const;
+
+    size_t cachedFileCount() const;
+    size_t cacheHitCount() const;
+
 private:
     friend struct CreateTempCommandBase;
     friend struct Utf8OpenCommandBase;
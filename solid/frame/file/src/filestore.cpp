@@ -14,6 +14,10 @@
 #include "solid/system/log.hpp"
 #include <atomic>
 #include <functional>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "solid/utility/algorithm.hpp"
@@ -109,6 +113,23 @@ typedef std::unordered_set<const Utf8PathStub*, PathHash, PathEqual>   PathSetT;
 typedef std::unordered_set<const Utf8PathStub*, IndexHash, IndexEqual> IndexSetT;
 typedef Stack<Utf8PathStub*>                                           PathStubStackT;
 
+//a file kept open after its last release
+struct CacheStub {
+    CacheStub(std::string const& _path, FileDevice&& _rfd, const size_t _openflags)
+        : path(_path)
+        , fd(std::move(_rfd))
+        , openflags(_openflags)
+    {
+    }
+
+    std::string path; //local path
+    FileDevice  fd;
+    size_t      openflags;
+};
+
+typedef std::list<CacheStub>                                  CacheListT; //front is the most recently released
+typedef std::unordered_map<std::string, CacheListT::iterator> CacheMapT;
+
 struct SizePairCompare {
     bool operator()(SizePairT const& _a, SizePairT const& _b) const
     {
@@ -248,11 +269,20 @@ struct Utf8Controller::Data {
     TempWaitVectorT* pfilltempwaitvec;
     TempWaitVectorT* pconstempwaitvec;
 
+    //NOTE: the cache is accessed from openFile - without the Store's lock
+    const size_t cachecp;
+    std::mutex   cachemtx;
+    CacheListT   cachelst;
+    CacheMapT    cachemap;
+    size_t       cachehitcnt;
+
     Data(
         const Utf8Configuration& _rfilecfg,
         const TempConfiguration& _rtempcfg)
         : filecfg(_rfilecfg)
         , tempcfg(_rtempcfg)
+        , cachecp(_rfilecfg.cachecapacity)
+        , cachehitcnt(0)
     {
         pfilltempwaitvec = &tempwaitvec[0];
         pconstempwaitvec = &tempwaitvec[1];
@@ -262,6 +292,14 @@ struct Utf8Controller::Data {
     void prepareTemp();
 
     size_t findFileStorage(std::string const& _path);
+
+    void localPath(std::string& _rpath, Utf8PathStub const& _rps) const;
+
+    bool cacheTake(std::string const& _path, const size_t _openflags, FileDevice& _rfd);
+    void cachePut(std::string const& _path, FileDevice& _rfd, const size_t _openflags);
+    void cacheErase(std::string const& _path);
+    bool cacheFind(std::string const& _path);
+    bool cachePath(std::string const& _path, std::string& _rpath);
 };
 
 //---------------------------------------------------------------------------
@@ -317,6 +355,104 @@ size_t Utf8Controller::Data::findFileStorage(std::string const& _path)
     return InvalidIndex();
 }
 
+void Utf8Controller::Data::localPath(std::string& _rpath, Utf8PathStub const& _rps) const
+{
+    Utf8ConfigurationImpl::Storage const& rstrg = filecfg.storagevec[_rps.storeidx];
+
+    _rpath.reserve(rstrg.localprefix.size() + _rps.path.size());
+    _rpath.assign(rstrg.localprefix);
+    _rpath.append(_rps.path);
+}
+
+bool Utf8Controller::Data::cacheTake(std::string const& _path, const size_t _openflags, FileDevice& _rfd)
+{
+    FileDevice tmpfd; //closed outside the lock
+    {
+        std::lock_guard<std::mutex> lock(cachemtx);
+        CacheMapT::iterator         it = cachemap.find(_path);
+
+        if (it == cachemap.end()) {
+            return false;
+        }
+
+        CacheListT::iterator lstit = it->second;
+
+        cachemap.erase(it);
+
+        if (lstit->openflags == _openflags) {
+            _rfd = std::move(lstit->fd);
+            cachelst.erase(lstit);
+            ++cachehitcnt;
+            return true;
+        }
+        //opened with other flags - drop it
+        tmpfd = std::move(lstit->fd);
+        cachelst.erase(lstit);
+    }
+    return false;
+}
+
+void Utf8Controller::Data::cachePut(std::string const& _path, FileDevice& _rfd, const size_t _openflags)
+{
+    CacheListT tmplst; //replaced or evicted files are closed outside the lock
+    {
+        std::lock_guard<std::mutex> lock(cachemtx);
+        CacheMapT::iterator         it = cachemap.find(_path);
+
+        if (it != cachemap.end()) {
+            tmplst.splice(tmplst.end(), cachelst, it->second);
+            cachemap.erase(it);
+        }
+
+        cachelst.emplace_front(_path, std::move(_rfd), _openflags);
+        cachemap[_path] = cachelst.begin();
+
+        while (cachelst.size() > cachecp) {
+            cachemap.erase(cachelst.back().path);
+            tmplst.splice(tmplst.end(), cachelst, std::prev(cachelst.end()));
+        }
+    }
+    solid_dbg(logger, Verbose, "cached " << _path << " evicted " << tmplst.size());
+}
+
+void Utf8Controller::Data::cacheErase(std::string const& _path)
+{
+    CacheListT tmplst;
+    {
+        std::lock_guard<std::mutex> lock(cachemtx);
+        CacheMapT::iterator         it = cachemap.find(_path);
+
+        if (it != cachemap.end()) {
+            tmplst.splice(tmplst.end(), cachelst, it->second);
+            cachemap.erase(it);
+        }
+    }
+}
+
+bool Utf8Controller::Data::cacheFind(std::string const& _path)
+{
+    std::lock_guard<std::mutex> lock(cachemtx);
+    return cachemap.find(_path) != cachemap.end();
+}
+
+//the cache key (local path) of a global path
+bool Utf8Controller::Data::cachePath(std::string const& _path, std::string& _rpath)
+{
+    const size_t storeidx = findFileStorage(_path);
+
+    if (storeidx == InvalidIndex()) {
+        return false;
+    }
+
+    Utf8PathStub ps;
+
+    ps.storeidx = storeidx;
+    ps.path.assign(_path.c_str() + filecfg.storagevec[storeidx].globalsize);
+
+    localPath(_rpath, ps);
+    return true;
+}
+
 //---------------------------------------------------------------------------
 //      Utf8Controller
 //---------------------------------------------------------------------------
@@ -384,17 +520,61 @@ bool Utf8Controller::preparePointer(
 
 void Utf8Controller::openFile(Utf8OpenCommandBase& _rcmd, FilePointerT& _rptr, ErrorCodeT& _rerr)
 {
-    Utf8ConfigurationImpl::Storage const& rstrg = impl_->filecfg.storagevec[_rcmd.outpath.storeidx];
-    std::string                           path;
+    File&       rf       = *_rptr;
+    const bool  canreuse = (_rcmd.openflags & (FileDevice::CreateE | FileDevice::TruncateE)) == 0;
+    std::string path;
+
+    if (impl_->cachecp != 0 && canreuse && rf.fd && rf.openflags == _rcmd.openflags) {
+        //reopened before the Store got to clear it
+        return;
+    }
+
+    impl_->localPath(path, _rcmd.outpath);
+
+    if (impl_->cachecp != 0) {
+        if (!canreuse) {
+            impl_->cacheErase(path);
+        } else if (impl_->cacheTake(path, _rcmd.openflags, rf.fd)) {
+            rf.openflags = _rcmd.openflags;
+            return;
+        }
+    }
 
-    path.reserve(rstrg.localprefix.size() + _rcmd.outpath.path.size());
-    path.assign(rstrg.localprefix);
-    path.append(_rcmd.outpath.path);
-    if (!_rptr->open(path.c_str(), static_cast<int>(_rcmd.openflags))) {
+    if (rf.open(path.c_str(), static_cast<int>(_rcmd.openflags))) {
+        rf.openflags = _rcmd.openflags;
+    } else {
         _rerr = last_system_error();
     }
 }
 
+void Utf8Controller::invalidateCachedFile(std::string const& _path)
+{
+    std::string path;
+
+    if (impl_->cachecp != 0 && impl_->cachePath(_path, path)) {
+        impl_->cacheErase(path);
+    }
+}
+
+bool Utf8Controller::isFileCached(std::string const& _path) const
+{
+    std::string path;
+
+    return impl_->cachecp != 0 && impl_->cachePath(_path, path) && impl_->cacheFind(path);
+}
+
+size_t Utf8Controller::cachedFileCount() const
+{
+    std::lock_guard<std::mutex> lock(impl_->cachemtx);
+    return impl_->cachelst.size();
+}
+
+size_t Utf8Controller::cacheHitCount() const
+{
+    std::lock_guard<std::mutex> lock(impl_->cachemtx);
+    return impl_->cachehitcnt;
+}
+
 bool Utf8Controller::prepareIndex(
     shared::StoreBase::Accessor& /*_rsbacc*/, CreateTempCommandBase& /*_rcmd*/,
     size_t& /*_ridx*/, size_t& /*_rflags*/, ErrorCodeT& /*_rerr*/)
@@ -483,16 +663,21 @@ bool Utf8Controller::clear(shared::StoreBase::Accessor& /*_rsbacc*/, File& _rf,
     //We're under Store's mutex lock
     //We're under File's mutex lock
     if (!_rf.isTemp()) {
-        _rf.clear();
         Utf8PathStub path;
         path.idx               = _idx;
         IndexSetT::iterator it = impl_->indexset.find(&path);
         if (it != impl_->indexset.end()) {
             Utf8PathStub* ps = const_cast<Utf8PathStub*>(*it);
+            if (impl_->cachecp != 0 && _rf.fd) {
+                //keep the file open for the next user
+                impl_->localPath(path.path, *ps);
+                impl_->cachePut(path.path, _rf.fd, _rf.openflags);
+            }
             impl_->pathset.erase(ps);
             impl_->indexset.erase(it);
             impl_->pathcache.push(ps);
         }
+        _rf.clear();
     } else {
         TempBase&                       temp    = *_rf.temp();
         const size_t                    strgidx = temp.tempstorageid;
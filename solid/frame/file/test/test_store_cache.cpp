@@ -0,0 +1,172 @@
+#include "solid/frame/file/filestore.hpp"
+#include "solid/frame/manager.hpp"
+#include "solid/frame/reactor.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+using SchedulerT = frame::Scheduler<frame::Reactor>;
+using FileStoreT = frame::file::Store<>;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+const size_t cache_capacity = 4;
+const size_t file_count     = 8;
+
+struct Context {
+    mutex              mtx_;
+    condition_variable cnd_;
+    bool               done_ = false;
+    int64_t            size_ = -1;
+};
+
+//opens the file, waits for the completion and returns its size
+int64_t open_file(FileStoreT& _rstore, string const& _path, const size_t _flags)
+{
+    Context ctx;
+
+    _rstore.requestOpenFile(
+        [&ctx](FileStoreT&, frame::file::FilePointerT& _rptr, ErrorCodeT const& _rerr) {
+            solid_check(!_rerr && !_rptr.empty(), "open failed: " << _rerr.message());
+            lock_guard<mutex> lock(ctx.mtx_);
+            ctx.size_ = _rptr->size();
+            ctx.done_ = true;
+            ctx.cnd_.notify_one();
+            //the file is released when _rptr is destroyed
+        },
+        _path, _flags);
+
+    unique_lock<mutex> lock(ctx.mtx_);
+    solid_check(ctx.cnd_.wait_for(lock, chrono::seconds(10), [&ctx]() { return ctx.done_; }), "open took too long " << _path);
+    return ctx.size_;
+}
+
+//the Store releases the files asynchronously - wait for the released file to reach the cache
+void wait_cached(FileStoreT& _rstore, string const& _path, const size_t _count)
+{
+    for (size_t i = 0; i < 1000 && !_rstore.isFileCached(_path); ++i) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    solid_check(_rstore.isFileCached(_path), "not cached " << _path);
+    solid_check(_rstore.cachedFileCount() == _count, "cached count " << _rstore.cachedFileCount() << " expected " << _count);
+}
+
+void write_file(string const& _path, string const& _data)
+{
+    FileDevice fd;
+    solid_check(fd.create(_path.c_str(), FileDevice::WriteOnlyE), "create " << _path);
+    solid_check(fd.write(_data.data(), _data.size()) == static_cast<ssize_t>(_data.size()));
+}
+
+} //namespace
+
+int test_store_cache(int /*argc*/, char* /*argv*/[])
+{
+    solid::log_start(std::cerr, {"test:EW", "solid::frame::file.*:EW"});
+
+    string dir_path;
+    {
+        ostringstream oss;
+        oss << "/tmp/solid_test_store_cache_" << getpid() << '/';
+        dir_path = oss.str();
+        solid_check(::mkdir(dir_path.c_str(), 0755) == 0, "cannot create " << dir_path);
+    }
+
+    vector<string> path_vec;
+
+    for (size_t i = 0; i < file_count; ++i) {
+        ostringstream oss;
+        oss << dir_path << "file_" << i << ".txt";
+        path_vec.emplace_back(oss.str());
+        write_file(path_vec.back(), string(i + 1, 'a'));
+    }
+
+    {
+        SchedulerT      sch;
+        frame::Manager  m;
+        frame::ServiceT svc(m);
+        ErrorConditionT err;
+
+        sch.start(1);
+
+        frame::file::Utf8Configuration utf8cfg;
+        frame::file::TempConfiguration tempcfg;
+
+        utf8cfg.storagevec.push_back(frame::file::Utf8Configuration::Storage("/", "/"));
+        utf8cfg.cachecapacity = cache_capacity;
+
+        DynamicPointer<FileStoreT> storeptr = make_dynamic<FileStoreT>(m, utf8cfg, tempcfg);
+        FileStoreT&                rstore   = *storeptr;
+
+        {
+            SchedulerT::ActorPointerT actptr(storeptr);
+            sch.startActor(std::move(actptr), svc, make_event(GenericEvents::Start), err);
+            solid_check(!err, "start store: " << err.message());
+        }
+
+        //released files are kept open up to the capacity - older ones evicted
+        for (size_t i = 0; i < file_count; ++i) {
+            solid_check(open_file(rstore, path_vec[i], FileDevice::ReadOnlyE) == static_cast<int64_t>(i + 1));
+            wait_cached(rstore, path_vec[i], std::min(i + 1, cache_capacity));
+        }
+        solid_check(rstore.cacheHitCount() == 0);
+
+        //the most recently released files are served from the cache
+        for (size_t i = file_count - cache_capacity; i < file_count; ++i) {
+            solid_check(open_file(rstore, path_vec[i], FileDevice::ReadOnlyE) == static_cast<int64_t>(i + 1));
+            wait_cached(rstore, path_vec[i], cache_capacity);
+        }
+        solid_check(rstore.cacheHitCount() == cache_capacity, "hit count " << rstore.cacheHitCount());
+
+        //evicted files are opened again
+        solid_check(open_file(rstore, path_vec[0], FileDevice::ReadOnlyE) == 1);
+        wait_cached(rstore, path_vec[0], cache_capacity);
+        solid_check(rstore.cacheHitCount() == cache_capacity);
+
+        //truncating drops the cached descriptor, then the flags must match
+        const size_t last = file_count - 1;
+        solid_check(open_file(rstore, path_vec[last], FileDevice::WriteOnlyE | FileDevice::TruncateE) == 0);
+        wait_cached(rstore, path_vec[last], cache_capacity);
+        solid_check(open_file(rstore, path_vec[last], FileDevice::ReadOnlyE) == 0);
+        wait_cached(rstore, path_vec[last], cache_capacity);
+        solid_check(rstore.cacheHitCount() == cache_capacity);
+
+        //the file replaced behind the store's back
+        solid_check(open_file(rstore, path_vec[1], FileDevice::ReadOnlyE) == 2);
+        wait_cached(rstore, path_vec[1], cache_capacity);
+        solid_check(::unlink(path_vec[1].c_str()) == 0);
+        write_file(path_vec[1], "12345");
+        rstore.invalidateCachedFile(path_vec[1]);
+        solid_check(!rstore.isFileCached(path_vec[1]));
+        solid_check(rstore.cachedFileCount() == cache_capacity - 1);
+        solid_check(open_file(rstore, path_vec[1], FileDevice::ReadOnlyE) == 5);
+        solid_check(rstore.cacheHitCount() == cache_capacity);
+
+        m.stop();
+    }
+
+    for (auto const& path : path_vec) {
+        solid_check(::unlink(path.c_str()) == 0, "unlink " << path);
+    }
+    solid_check(::rmdir(dir_path.c_str()) == 0, "rmdir " << dir_path);
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include "solid/frame/file/filestore.hpp"
+#include "solid/frame/manager.hpp"
+#include "solid/frame/reactor.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/system/exception.hpp"
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+#include "solid/utility/string.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+using SchedulerT  = frame::Scheduler<frame::Reactor>;
+using FileStoreT  = frame::file::Store<>;
+using AtomicSizeT = atomic<size_t>;
+
+namespace {
+
+const solid::LoggerT logger("test");
+
+struct Context {
+    vector<string>                    path_vec_;
+    vector<frame::UniqueId>           uid_vec_;
+    vector<frame::file::FilePointerT> anchor_vec_;
+    mutex                             mtx_;
+    condition_variable                cnd_;
+    size_t                            opened_count_ = 0;
+};
+
+struct OpenCommand {
+    Context* pctx_;
+    size_t   index_;
+
+    void operator()(FileStoreT& _rstore, frame::file::FilePointerT& _rptr, ErrorCodeT const& _rerr)
+    {
+        solid_check(!_rerr && !_rptr.empty(), "open " << pctx_->path_vec_[index_] << " failed: " << _rerr.message());
+        solid_check(_rstore.uniqueToShared(_rptr));
+
+        lock_guard<mutex> lock(pctx_->mtx_);
+        pctx_->uid_vec_[index_]    = _rptr.id();
+        pctx_->anchor_vec_[index_] = _rptr;
+        ++pctx_->opened_count_;
+        pctx_->cnd_.notify_one();
+    }
+};
+
+template <class F>
+uint64_t run_threads(const size_t _thread_count, F _f)
+{
+    const auto     start_time = chrono::steady_clock::now();
+    vector<thread> thread_vec;
+
+    for (size_t i = 0; i < _thread_count; ++i) {
+        thread_vec.emplace_back(_f, i);
+    }
+    for (auto& t : thread_vec) {
+        t.join();
+    }
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time).count();
+}
+
+} //namespace
+
+int test_store_shared(int argc, char* argv[])
+{
+    size_t file_count   = 64;
+    size_t thread_count = 4;
+    size_t repeat_count = 100000;
+
+    if (argc > 1) {
+        file_count = make_number(argv[1]);
+    }
+
+    if (argc > 2) {
+        thread_count = make_number(argv[2]);
+    }
+
+    if (argc > 3) {
+        repeat_count = make_number(argv[3]);
+    }
+
+    solid::log_start(std::cerr, {"test:EW", "solid::frame::file.*:EW"});
+
+    string dir_path;
+    {
+        ostringstream oss;
+        oss << "/tmp/solid_test_store_shared_" << getpid() << '/';
+        dir_path = oss.str();
+        solid_check(system(("mkdir -p " + dir_path).c_str()) == 0, "cannot create " << dir_path);
+    }
+
+    Context ctx;
+
+    ctx.uid_vec_.resize(file_count);
+    ctx.anchor_vec_.resize(file_count);
+
+    for (size_t i = 0; i < file_count; ++i) {
+        ostringstream oss;
+        oss << dir_path << "file_" << i << ".txt";
+        ctx.path_vec_.emplace_back(oss.str());
+
+        FileDevice fd;
+        solid_check(fd.create(ctx.path_vec_.back().c_str(), FileDevice::WriteOnlyE), "create " << ctx.path_vec_.back());
+        const char c = 'a' + (i % 26);
+        solid_check(fd.write(&c, 1) == 1);
+    }
+
+    {
+        SchedulerT      sch;
+        frame::Manager  m;
+        frame::ServiceT svc(m);
+        ErrorConditionT err;
+
+        sch.start(1);
+
+        frame::file::Utf8Configuration utf8cfg;
+        frame::file::TempConfiguration tempcfg;
+
+        utf8cfg.storagevec.push_back(frame::file::Utf8Configuration::Storage("/", "/"));
+
+        DynamicPointer<FileStoreT> storeptr = make_dynamic<FileStoreT>(m, utf8cfg, tempcfg);
+        FileStoreT&                rstore   = *storeptr;
+
+        {
+            SchedulerT::ActorPointerT actptr(storeptr);
+            sch.startActor(std::move(actptr), svc, make_event(GenericEvents::Start), err);
+            solid_check(!err, "start store: " << err.message());
+        }
+
+        //open: each thread opens its share of the files
+        const uint64_t open_usecs = run_threads(thread_count, [&](const size_t _tid) {
+            for (size_t i = _tid; i < file_count; i += thread_count) {
+                rstore.requestOpenFile(OpenCommand{&ctx, i}, ctx.path_vec_[i], FileDevice::ReadOnlyE);
+            }
+        });
+
+        {
+            unique_lock<mutex> lock(ctx.mtx_);
+            solid_check(ctx.cnd_.wait_for(lock, chrono::seconds(60), [&]() { return ctx.opened_count_ == file_count; }), "open took too long");
+        }
+
+        //reuse/release: all threads access all the already shared files
+        AtomicSizeT    sync_count{0};
+        const uint64_t reuse_usecs = run_threads(thread_count, [&](const size_t _tid) {
+            size_t local_sync_count = 0;
+            for (size_t i = 0; i < repeat_count; ++i) {
+                const size_t idx = (i + _tid * 7) % file_count;
+                const bool   rv  = rstore.requestShared(
+                    [idx](FileStoreT&, frame::file::FilePointerT& _rptr, ErrorCodeT const& _rerr) {
+                        solid_check(!_rerr && !_rptr.empty(), "shared " << idx << " failed");
+                        char c = 0;
+                        solid_check(_rptr->read(&c, 1, 0) == 1 && c == static_cast<char>('a' + (idx % 26)), "bad content " << idx);
+                    },
+                    ctx.uid_vec_[idx]);
+                if (rv) {
+                    ++local_sync_count;
+                }
+            }
+            sync_count += local_sync_count;
+        });
+
+        solid_check(sync_count == thread_count * repeat_count, "not all shared requests completed synchronously: " << sync_count);
+
+        //release the anchors so the store closes the files
+        const uint64_t release_usecs = run_threads(thread_count, [&](const size_t _tid) {
+            for (size_t i = _tid; i < file_count; i += thread_count) {
+                ctx.anchor_vec_[i].clear();
+            }
+        });
+
+        const size_t reuse_count = thread_count * repeat_count;
+
+        cout << "file_count = " << file_count << " thread_count = " << thread_count
+             << " open = " << open_usecs << "us reuse/release = " << reuse_usecs << "us ("
+             << (reuse_usecs != 0 ? (reuse_count * 1000000ULL) / reuse_usecs : 0) << " ops/s) release = " << release_usecs << "us" << endl;
+
+        m.stop();
+    }
+
+    solid_check(system(("rm -rf " + dir_path).c_str()) == 0);
+    return 0;
+}
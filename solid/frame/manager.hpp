@@ -126,6 +126,9 @@ private:
 
     void unregisterActor(ActorBase& _ractor);
     bool disableActorVisits(ActorBase& _ractor);
+    bool notifyGracePeriodPassed(const ActorBase& _ractor);
+
+    static void waitNotifyGracePeriod();
 
     ActorIdT unsafeId(const ActorBase& _ractor) const;
 
@@ -32,6 +32,7 @@ namespace frame {
 
 namespace aio {
 class Resolver;
+class DnsResolver;
 struct ActorProxy;
 } // namespace aio
 
@@ -349,6 +350,7 @@ using ConnectionSendRawDataCompleteFunctionT    = solid_function_t(void(Connecti
 using ConnectionRecvRawDataCompleteFunctionT    = solid_function_t(void(ConnectionContext&, const char*, size_t&, ErrorConditionT const&));
 using ConnectionOnEventFunctionT                = solid_function_t(void(ConnectionContext&, Event&));
 using PoolOnEventFunctionT                      = solid_function_t(void(ConnectionContext&, Event&&, const ErrorConditionT&));
+using MessageSizeFunctionT                      = solid_function_t(size_t(const Message&));
 
 enum struct ConnectionState {
     Raw,
@@ -365,6 +367,11 @@ struct ReaderConfiguration {
 
     size_t              max_message_count_multiplex;
     UncompressFunctionT decompress_fnc;
+    //when the rest of a partially received, uncompressed packet belongs to a
+    //single std::string, std::vector<char> or blob field and is at least this
+    //many bytes long, it is received directly into the field's memory
+    //instead of through the connection receive buffer - 0 disables it.
+    size_t direct_receive_min_size;
 };
 
 struct WriterConfiguration {
@@ -373,6 +380,11 @@ struct WriterConfiguration {
     size_t max_message_count_multiplex;
     size_t max_message_count_response_wait;
     size_t max_message_continuous_packet_count;
+    //byte budget (as given by Configuration::message_size_fnc) for the
+    //messages being multiplexed on a connection - 0 means no limit.
+    //Messages larger than the budget are multiplexed one at a time, beside
+    //the messages within the budget.
+    size_t max_message_bytes_multiplex;
 
     size_t   string_size_limit;
     size_t   container_size_limit;
@@ -438,7 +450,7 @@ public:
 
     bool isServer() const
     {
-        return server.listener_address_str.size() != 0;
+        return server.listener_address_str.size() != 0 || server.listener_local_path.size() != 0;
     }
 
     bool isClient() const
@@ -492,9 +504,18 @@ public:
     size_t pool_max_active_connection_count;
     size_t pool_max_pending_connection_count;
     size_t pool_max_message_queue_size;
+    //byte budget (as given by message_size_fnc) for the messages waiting in
+    //a pool's queue - 0 means no limit.
+    //When exceeded, sendMessage fails with error_service_pool_full and, once
+    //the queue drains under half the budget, the pool's event function is
+    //called with pool_event_pool_credit.
+    size_t pool_max_message_queue_bytes;
 
     size_t pools_mutex_count;
     bool   relay_enabled;
+    //also keep the ServiceStatistic latency histograms per message type
+    //(for the first ServiceStatistic::latency_message_type_capacity types)
+    bool   latency_per_message_type;
 
     ReaderConfiguration reader;
     WriterConfiguration writer;
@@ -521,6 +542,7 @@ public:
         ServerSetupSocketDeviceFunctionT   socket_device_setup_fnc;
         std::string                        listener_address_str;
         std::string                        listener_service_str;
+        std::string                        listener_local_path; //listen on a unix domain socket instead - see mprpcsocketstub_local.hpp
         Any<>                              secure_any;
 
         int listenerPort() const
@@ -564,9 +586,11 @@ public:
     uint8_t                       connection_send_buffer_start_capacity_kb;
     uint8_t                       connection_send_buffer_max_capacity_kb;
     uint16_t                      connection_relay_buffer_count;
+    uint32_t                      connection_recv_window_kb; //socket receive buffer i.e. advertised TCP receive window, set before connect and on the listener - 0 means system default
     ExtractRecipientNameFunctionT extract_recipient_name_fnc;
     ConnectionStopFunctionT       connection_stop_fnc;
     ConnectionOnEventFunctionT    connection_on_event_fnc;
+    MessageSizeFunctionT          message_size_fnc; //used for byte budgets - default returns 0
     RecvAllocateBufferFunctionT   connection_recv_buffer_allocate_fnc;
     SendAllocateBufferFunctionT   connection_send_buffer_allocate_fnc;
     Protocol::PointerT            protocol_ptr;
@@ -618,6 +642,28 @@ struct InternetResolverF {
     void operator()(const std::string&, ResolveCompleteFunctionT&);
 };
 
+//! Resolve "host:port" names with the non-blocking aio::DnsResolver
+/*!
+    Only numeric services are supported.
+*/
+struct InternetDnsResolverF {
+    aio::DnsResolver&  rresolver;
+    std::string        default_service;
+    SocketInfo::Family family;
+
+    InternetDnsResolverF(
+        aio::DnsResolver&  _rresolver,
+        const char*        _default_service,
+        SocketInfo::Family _family = SocketInfo::AnyFamily)
+        : rresolver(_rresolver)
+        , default_service(_default_service)
+        , family(_family)
+    {
+    }
+
+    void operator()(const std::string&, ResolveCompleteFunctionT&);
+};
+
 } //namespace mprpc
 } //namespace frame
 } //namespace solid
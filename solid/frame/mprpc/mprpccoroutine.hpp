@@ -0,0 +1,160 @@
+// solid/frame/mprpc/mprpccoroutine.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/frame/aio/aiocoroutine.hpp"
+
+#ifdef SOLID_HAS_COROUTINE
+
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+namespace solid {
+namespace frame {
+namespace mprpc {
+namespace co {
+
+//! Standalone fire-and-forget coroutine awaiting mprpc requests
+/*!
+    Unlike aio::co::Task it is not bound to an actor: it starts eagerly on
+    the calling thread and, after every co_await sendRequest, continues on
+    the thread of the reactor running the connection that completed the
+    request. So it must not touch the state of an actor and its frame comes
+    from the heap, not from the aio::co::impl::FramePool of a reactor.
+    sendRequest can only be awaited from this Task.
+*/
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object() noexcept
+        {
+            return Task{};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept
+        {
+            //there is no one to report to
+            std::terminate();
+        }
+    };
+};
+
+//! The outcome of an awaited request
+template <class Res>
+struct Result {
+    std::shared_ptr<Res> response_ptr;
+    ErrorConditionT      error;
+
+    explicit operator bool() const
+    {
+        return !error && response_ptr;
+    }
+};
+
+//! Awaiter for Service::sendRequest
+/*!
+    The Task is resumed from the request's completion callback, on the
+    thread of the reactor running the connection that got the response
+    (or the error). Unlike the aio awaiters, the completion is not owned:
+    mprpc always calls the completion of an accepted request, at the
+    latest with error_service_stopping.
+*/
+template <class Req, class Res>
+class RequestAwaiter {
+    using ThisT   = RequestAwaiter<Req, Res>;
+    using HandleT = std::coroutine_handle<Task::promise_type>;
+
+    struct Resume {
+        ThisT*  pawaiter_;
+        HandleT handle_;
+
+        void operator()(
+            ConnectionContext& /*_rctx*/,
+            std::shared_ptr<Req>& /*_rsent_msg_ptr*/,
+            std::shared_ptr<Res>&  _rrecv_msg_ptr,
+            ErrorConditionT const& _rerror)
+        {
+            pawaiter_->result_.response_ptr = std::move(_rrecv_msg_ptr);
+            pawaiter_->result_.error        = _rerror;
+            handle_.resume();
+        }
+    };
+
+    Service&             rservice_;
+    const char*          recipient_url_;
+    std::shared_ptr<Req> request_ptr_;
+    MessageFlagsT        flags_;
+    Result<Res>          result_;
+
+public:
+    RequestAwaiter(
+        Service&                    _rservice,
+        const char*                 _recipient_url,
+        std::shared_ptr<Req> const& _rrequest_ptr,
+        const MessageFlagsT&        _flags)
+        : rservice_(_rservice)
+        , recipient_url_(_recipient_url)
+        , request_ptr_(_rrequest_ptr)
+        , flags_(_flags)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(HandleT _handle)
+    {
+        //the completion may resume the coroutine on another thread before
+        //sendRequest returns - so do not touch this on success
+        const ErrorConditionT err = rservice_.sendRequest(recipient_url_, request_ptr_, Resume{this, _handle}, flags_);
+        if (err) {
+            result_.error = err;
+            return false;
+        }
+        return true;
+    }
+
+    Result<Res> await_resume()
+    {
+        return std::move(result_);
+    }
+};
+
+//! co_await sendRequest<Response>(service, "recipient", request_ptr)
+template <class Res, class Req>
+RequestAwaiter<Req, Res> sendRequest(
+    Service&                    _rservice,
+    const char*                 _recipient_url,
+    std::shared_ptr<Req> const& _rrequest_ptr,
+    const MessageFlagsT&        _flags = 0)
+{
+    return RequestAwaiter<Req, Res>{_rservice, _recipient_url, _rrequest_ptr, _flags};
+}
+
+} //namespace co
+} //namespace mprpc
+} //namespace frame
+} //namespace solid
+
+#endif //SOLID_HAS_COROUTINE
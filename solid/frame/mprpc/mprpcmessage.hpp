@@ -227,6 +227,16 @@ struct Message : std::enable_shared_from_this<Message> {
         return _flags.has(MessageFlagsE::Relayed);
     }
 
+    static MessagePriorityE priority(const MessageFlagsT& _flags)
+    {
+        if (_flags.has(MessageFlagsE::ControlPriority)) {
+            return MessagePriorityE::Control;
+        } else if (_flags.has(MessageFlagsE::BulkPriority)) {
+            return MessagePriorityE::Bulk;
+        }
+        return MessagePriorityE::Interactive;
+    }
+
     static MessageFlagsT clear_state_flags(MessageFlagsT _flags)
     {
         _flags.reset(MessageFlagsE::OnPeer).reset(MessageFlagsE::BackOnSender).reset(MessageFlagsE::Relayed);
@@ -388,7 +398,12 @@ private:
 
 using MessagePointerT = std::shared_ptr<Message>;
 
-using MessageCompleteFunctionT = solid_function_t(void(
+//! Room for completion lambdas capturing a shared_ptr and a few values
+#ifndef SOLID_MPRPC_FUNCTION_STORAGE
+#define SOLID_MPRPC_FUNCTION_STORAGE 48
+#endif
+
+using MessageCompleteFunctionT = solid_sized_function_t(SOLID_MPRPC_FUNCTION_STORAGE, void(
     ConnectionContext&, MessagePointerT&, MessagePointerT&, ErrorConditionT const&));
 
 } //namespace mprpc
@@ -32,11 +32,25 @@ enum struct MessageFlagsE : MessageFlagsValueT {
     OnPeer,
     BackOnSender,
     Relayed,
+    ControlPriority,
+    BulkPriority,
     LastFlag
 };
 
 using MessageFlagsT = Flags<MessageFlagsE>;
 
+//! Latency class of a message - lower value means more urgent
+/*!
+    Set on sendMessage through MessageFlagsE::ControlPriority or
+    MessageFlagsE::BulkPriority. Messages with neither flag are Interactive.
+*/
+enum struct MessagePriorityE : uint8_t {
+    Control,
+    Interactive,
+    Bulk,
+    Count
+};
+
 } //namespace mprpc
 } //namespace frame
 } //namespace solid
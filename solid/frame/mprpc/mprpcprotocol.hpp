@@ -109,6 +109,10 @@ public:
     virtual bool            empty() const                                                                            = 0;
     virtual void            clear()                                                                                  = 0;
 
+    //memory the message body still expects for its current binary field - see MessageReader::directBuffer
+    virtual size_t binaryDestination(char*& _rpbuf) const;
+    virtual void   binaryDestinationFilled(const size_t _sz);
+
     void link(PointerT& _ptr)
     {
         next_ = std::move(_ptr);
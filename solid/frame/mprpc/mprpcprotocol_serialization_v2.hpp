@@ -124,6 +124,14 @@ private:
     {
         return des_.clear();
     }
+    size_t binaryDestination(char*& _rpbuf) const override
+    {
+        return des_.binaryDestination(_rpbuf);
+    }
+    void binaryDestinationFilled(const size_t _sz) override
+    {
+        des_.binaryDestinationFilled(_sz);
+    }
 };
 
 template <typename TypeId>
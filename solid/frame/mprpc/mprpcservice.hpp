@@ -22,6 +22,10 @@
 #include "solid/frame/mprpc/mprpcprotocol.hpp"
 #include "solid/system/log.hpp"
 #include "solid/system/pimpl.hpp"
+#include "solid/system/statistic.hpp"
+#include "solid/utility/histogram.hpp"
+
+#include <chrono>
 
 namespace solid {
 namespace frame {
@@ -34,12 +38,138 @@ namespace mprpc {
 
 extern const Event pool_event_connect;
 extern const Event pool_event_disconnect;
+extern const Event pool_event_pool_credit; //sent to the pool event function when a pool rejected with error_service_pool_full accepts messages again
 
 struct Message;
 struct Configuration;
 class Connection;
 struct MessageBundle;
 
+//! Stages of a message's life, measured by ServiceStatistic::latency
+enum struct LatencyStageE : uint8_t {
+    SendToPool, //sendMessage called - message in the pool queue
+    PoolToWriter, //pool queue - connection writer started serializing the message
+    WriterToSent, //writer started - last packet of the message written into the send buffer
+    SentToResponse, //request sent - first packet of the response read
+    ReceiveToComplete, //first packet of a message read - complete callback called
+    Count
+};
+
+//! Per latency class (MessagePriorityE) message statistics
+/*!
+    Queue time is measured from the moment sendMessage accepted the message
+    until the connection writer started serializing it.
+    The queue counters stay zero unless built with SOLID_HAS_STATISTICS.
+
+    Latency histograms (in nanoseconds) are kept per LatencyStageE and,
+    with Configuration::latency_per_message_type, per message type too.
+    They are recorded only when built with SOLID_HAS_STATISTICS.
+    sendMessage records into shard 0, under the service mutex; every
+    reactor records into the shard of its index. A shard is allocated on its
+    first record and the shards are merged on read.
+
+    Direct receive bytes count the message payload received straight into
+    the deserializer destination, bypassing the connection receive buffer
+    (see ReaderConfiguration::direct_receive_min_size).
+    The counter stays zero unless built with SOLID_HAS_STATISTICS.
+*/
+struct ServiceStatistic : solid::Statistic {
+    using TimePointT = std::chrono::steady_clock::time_point;
+
+    static constexpr size_t priority_count                = static_cast<size_t>(MessagePriorityE::Count);
+    static constexpr size_t latency_stage_count           = static_cast<size_t>(LatencyStageE::Count);
+    static constexpr size_t latency_shard_count           = 8;
+    static constexpr size_t latency_message_type_capacity = 64;
+
+    std::atomic<uint64_t> queue_count_[priority_count];
+    std::atomic<uint64_t> queue_time_total_us_[priority_count];
+    std::atomic<uint64_t> queue_time_max_us_[priority_count];
+    std::atomic<uint64_t> direct_receive_bytes_;
+
+    ServiceStatistic();
+    ~ServiceStatistic();
+
+    ServiceStatistic(const ServiceStatistic&) = delete;
+    ServiceStatistic& operator=(const ServiceStatistic&) = delete;
+
+    void queueTime(const MessagePriorityE _priority, const uint64_t _us);
+
+    uint64_t queueCount(const MessagePriorityE _priority) const
+    {
+        return queue_count_[static_cast<size_t>(_priority)];
+    }
+
+    uint64_t queueTimeMaximum(const MessagePriorityE _priority) const
+    {
+        return queue_time_max_us_[static_cast<size_t>(_priority)];
+    }
+
+    uint64_t queueTimeAverage(const MessagePriorityE _priority) const;
+
+    void directReceive(const uint64_t _sz)
+    {
+        solid_statistic_add(direct_receive_bytes_, _sz);
+    }
+
+    uint64_t directReceiveBytes() const
+    {
+        return direct_receive_bytes_;
+    }
+
+    void latencyPerMessageType(const bool _enable)
+    {
+        latency_per_message_type_ = _enable;
+    }
+
+    //! steady_clock::now() - or a constant when built without SOLID_HAS_STATISTICS
+    static TimePointT now()
+    {
+#ifdef SOLID_HAS_STATISTICS
+        return std::chrono::steady_clock::now();
+#else
+        return TimePointT();
+#endif
+    }
+
+    static size_t latencyShard(const size_t _reactor_index)
+    {
+        return 1 + _reactor_index % (latency_shard_count - 1);
+    }
+
+    //! Record _to - _from for _stage of a message of protocol type _msg_type_id
+    void latency(const LatencyStageE _stage, const size_t _shard, const size_t _msg_type_id, TimePointT const& _from, TimePointT const& _to)
+    {
+#ifdef SOLID_HAS_STATISTICS
+        doRecordLatency(_stage, _shard, _msg_type_id, _from, _to);
+#else
+        (void)_stage;
+        (void)_shard;
+        (void)_msg_type_id;
+        (void)_from;
+        (void)_to;
+#endif
+    }
+
+    //! Merge the histogram of _stage into _rh
+    void latency(const LatencyStageE _stage, Histogram& _rh) const;
+
+    //! Merge the histogram of _stage for messages of type _msg_type_id into _rh
+    /*!
+        Returns false if there is no data for _msg_type_id.
+    */
+    bool latency(const LatencyStageE _stage, const size_t _msg_type_id, Histogram& _rh) const;
+
+    std::ostream& print(std::ostream& _ros) const override;
+
+private:
+    void doRecordLatency(const LatencyStageE _stage, const size_t _shard, const size_t _msg_type_id, TimePointT const& _from, TimePointT const& _to);
+
+private:
+    std::atomic<Histogram*> latency_[latency_shard_count]; //lazily allocated latency_stage_count arrays
+    std::atomic<Histogram*> message_type_latency_[latency_message_type_capacity]; //lazily allocated latency_stage_count arrays
+    std::atomic<bool>       latency_per_message_type_;
+};
+
 //! Message Passing Remote Procedure Call Service
 /*!
     Allows exchanging ipc::Messages between processes.
@@ -72,6 +202,21 @@ struct MessageBundle;
         or
         m3_10MB, m4_1MB, m1_500MB, m2_100MB
 
+    Message priorities
+        * sendMessage(..., MessageFlagsE::ControlPriority) or
+            sendMessage(..., MessageFlagsE::BulkPriority) - default is Interactive.
+        * a message overtakes the less urgent messages waiting in the pool
+            queue and, once on the connection, its packets are written before
+            those of the less urgent messages.
+        * the order of the synchronous messages is preserved only within
+            the same priority class.
+        * per priority queue times are available through Service::statistic().
+
+    Message latency
+        * Service::statistic().latency(LatencyStageE, Histogram&) gives the
+            distribution of the time messages spend in every stage, from
+            sendMessage to the complete callback (needs SOLID_HAS_STATISTICS).
+
 */
 
 class Service : public frame::Service {
@@ -91,6 +236,8 @@ public:
 
     Configuration const& configuration() const;
 
+    ServiceStatistic const& statistic() const;
+
     ErrorConditionT createConnectionPool(const char* _recipient_url, const size_t _persistent_connection_count = 1);
 
     template <class F>
@@ -289,6 +436,13 @@ public:
 
     bool closeConnection(RecipientId const& _rrecipient_id);
 
+    //! Start a server connection on an already connected socket
+    /*!
+        Used for in-process clients (see mprpcsocketstub_local.hpp), which
+        do not go through the listener.
+    */
+    ErrorConditionT acceptConnection(SocketDevice&& _usd);
+
 protected:
     void doStart(Configuration&& _ucfg);
     void doStart();
@@ -336,6 +490,8 @@ private:
 
     //void doStop();
 
+    ServiceStatistic& wstatistic();
+
     void doFinalizeStart(Configuration&& _ucfg, SocketDevice&& _usd);
     void doFinalizeStart();
 
@@ -414,9 +570,15 @@ private:
     void onOutgoingConnectionStart(ConnectionContext& _rconctx);
 
     ErrorConditionT pollPoolForUpdates(
+        ConnectionContext& _rconctx,
+        ActorIdT const&    _ractuid,
+        MessageId const&   _rmsgid);
+
+    ErrorConditionT doPollPoolForUpdates(
         Connection&      _rcon,
         ActorIdT const&  _ractuid,
-        MessageId const& _rmsgid);
+        MessageId const& _rmsgid,
+        const size_t     _pool_index);
 
     void rejectNewPoolMessage(Connection const& _rcon);
 
@@ -453,23 +615,25 @@ private:
         const MessageFlagsT&      _flags);
 
     ErrorConditionT doSendMessageToNewPool(
-        const char*               _recipient_url,
-        MessagePointerT&          _rmsgptr,
-        const size_t              _msg_type_idx,
-        MessageCompleteFunctionT& _rcomplete_fnc,
-        RecipientId*              _precipient_id_out,
-        MessageId*                _pmsguid_out,
-        const MessageFlagsT&      _flags,
-        std::string&              _msg_url);
+        const char*                         _recipient_url,
+        MessagePointerT&                    _rmsgptr,
+        const size_t                        _msg_type_idx,
+        MessageCompleteFunctionT&           _rcomplete_fnc,
+        RecipientId*                        _precipient_id_out,
+        MessageId*                          _pmsguid_out,
+        const MessageFlagsT&                _flags,
+        std::string&                        _msg_url,
+        ServiceStatistic::TimePointT const& _rsend_time);
 
     ErrorConditionT doSendMessageToConnection(
-        const RecipientId&        _rrecipient_id_in,
-        MessagePointerT&          _rmsgptr,
-        const size_t              _msg_type_idx,
-        MessageCompleteFunctionT& _rcomplete_fnc,
-        MessageId*                _pmsg_id_out,
-        MessageFlagsT             _flags,
-        std::string&              _msg_url);
+        const RecipientId&                  _rrecipient_id_in,
+        MessagePointerT&                    _rmsgptr,
+        const size_t                        _msg_type_idx,
+        MessageCompleteFunctionT&           _rcomplete_fnc,
+        MessageId*                          _pmsg_id_out,
+        MessageFlagsT                       _flags,
+        std::string&                        _msg_url,
+        ServiceStatistic::TimePointT const& _rsend_time);
 
     bool doTryCreateNewConnectionForPool(const size_t _pool_index, ErrorConditionT& _rerror);
 
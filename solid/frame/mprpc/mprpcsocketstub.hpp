@@ -41,6 +41,15 @@ public:
         delete _pss;
     }
 
+    //SO_RCVBUF must be set before connect/listen for the TCP window scale to use it
+    static void setupRecvWindow(SocketDevice& _rsd, const uint32_t _recv_window_kb)
+    {
+        if (_recv_window_kb != 0) {
+            int recv_buffer_size = static_cast<int>(_recv_window_kb * 1024);
+            _rsd.recvBufferSize(recv_buffer_size);
+        }
+    }
+
     virtual ~SocketStub()
     {
     }
@@ -62,8 +71,9 @@ public:
 
     virtual bool hasValidSocket() const = 0;
 
+    //_recv_window_kb - Configuration::connection_recv_window_kb, applied before connect
     virtual bool connect(
-        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddressInet& _raddr)
+        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddressInet& _raddr, const uint32_t _recv_window_kb)
         = 0;
 
     virtual bool recvSome(
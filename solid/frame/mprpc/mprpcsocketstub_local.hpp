@@ -0,0 +1,241 @@
+// solid/frame/mprpc/mprpcsocketstub_local.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/system/socketdevice.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+#include "solid/frame/mprpc/mprpcsocketstub.hpp"
+
+#include <memory>
+#include <system_error>
+
+namespace solid {
+namespace frame {
+namespace mprpc {
+namespace local {
+
+//! Where the client connections of a service go
+/*!
+    Either a server Service in the same process - each connection is a
+    socket pair with one end handed directly to the server (no listener,
+    no TCP) - or the unix domain socket a server on the same host listens
+    on (see Configuration::Server::listener_local_path).
+*/
+struct ClientConfiguration {
+    Service*    pserver = nullptr;
+    std::string path;
+};
+
+using ClientConfigurationPointerT = std::shared_ptr<const ClientConfiguration>;
+
+class SocketStub final : public mprpc::SocketStub {
+public:
+    SocketStub(frame::aio::ActorProxy const& _rproxy, ClientConfigurationPointerT const& _rconfig_ptr)
+        : config_ptr(_rconfig_ptr)
+        , sock(_rproxy)
+    {
+    }
+
+private:
+    ~SocketStub()
+    {
+    }
+
+    SocketDevice const& device() const override final
+    {
+        return sock.device();
+    }
+
+    SocketDevice& device() override final
+    {
+        return sock.device();
+    }
+
+    bool postSendAll(
+        frame::aio::ReactorContext& _rctx, OnSendAllRawF _pf, const char* _pbuf, size_t _bufcp, Event& _revent) override final
+    {
+        struct Closure {
+            OnSendAllRawF pf;
+            Event         event;
+
+            Closure(OnSendAllRawF _pf, Event const& _revent)
+                : pf(_pf)
+                , event(_revent)
+            {
+            }
+
+            void operator()(frame::aio::ReactorContext& _rctx)
+            {
+                (*pf)(_rctx, event);
+            }
+
+        } lambda(_pf, _revent);
+
+        return sock.postSendAll(_rctx, _pbuf, _bufcp, lambda);
+    }
+
+    bool postRecvSome(
+        frame::aio::ReactorContext& _rctx, OnRecvF _pf, char* _pbuf, size_t _bufcp) override final
+    {
+        return sock.postRecvSome(_rctx, _pbuf, _bufcp, _pf);
+    }
+
+    bool postRecvSome(
+        frame::aio::ReactorContext& _rctx, OnRecvSomeRawF _pf, char* _pbuf, size_t _bufcp, Event& _revent) override final
+    {
+        struct Closure {
+            OnRecvSomeRawF pf;
+            Event          event;
+
+            Closure(OnRecvSomeRawF _pf, Event const& _revent)
+                : pf(_pf)
+                , event(_revent)
+            {
+            }
+
+            void operator()(frame::aio::ReactorContext& _rctx, size_t _sz)
+            {
+                (*pf)(_rctx, _sz, event);
+            }
+
+        } lambda(_pf, _revent);
+
+        return sock.postRecvSome(_rctx, _pbuf, _bufcp, lambda);
+    }
+
+    bool hasValidSocket() const override final
+    {
+        return static_cast<bool>(sock.device());
+    }
+
+    //the resolved address is only a placeholder - see ResolverF
+    bool connect(
+        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddressInet& /*_raddr*/, const uint32_t /*_recv_window_kb*/) override final
+    {
+        if (config_ptr->pserver != nullptr) {
+            SocketDevice sd;
+            SocketDevice peer_sd;
+            ErrorCodeT   err = sd.createPair(peer_sd);
+
+            if (!err && config_ptr->pserver->acceptConnection(std::move(peer_sd))) {
+                err = std::make_error_code(std::errc::connection_refused);
+            }
+            if (err) {
+                sd.close();
+            }
+            return sock.connect(_rctx, std::move(sd), err);
+        } else {
+            const SocketAddressLocal addr(config_ptr->path.c_str());
+            return sock.connect(_rctx, addr, _pf);
+        }
+    }
+
+    bool recvSome(
+        frame::aio::ReactorContext& _rctx, OnRecvF _pf, char* _buf, size_t _bufcp, size_t& _sz) override final
+    {
+        return sock.recvSome(_rctx, _buf, _bufcp, _pf, _sz);
+    }
+
+    bool hasPendingSend() const override final
+    {
+        return sock.hasPendingSend();
+    }
+
+    bool sendAll(
+        frame::aio::ReactorContext& _rctx, OnSendF _pf, char* _buf, size_t _bufcp) override final
+    {
+        return sock.sendAll(_rctx, _buf, _bufcp, _pf);
+    }
+
+    void prepareSocket(
+        frame::aio::ReactorContext& _rctx) override final
+    {
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+    ClientConfigurationPointerT config_ptr;
+    StreamSocketT               sock;
+};
+
+struct CreateClientSocketF {
+    ClientConfigurationPointerT config_ptr;
+
+    SocketStubPtrT operator()(Configuration const& /*_rcfg*/, frame::aio::ActorProxy const& _rproxy, char* _emplace_buf) const
+    {
+        if (sizeof(SocketStub) > static_cast<size_t>(ConnectionValues::SocketEmplacementSize)) {
+            return SocketStubPtrT(new SocketStub(_rproxy, config_ptr), SocketStub::delete_deleter);
+        } else {
+            return SocketStubPtrT(new (_emplace_buf) SocketStub(_rproxy, config_ptr), SocketStub::emplace_deleter);
+        }
+    }
+};
+
+//! Every recipient name resolves to one placeholder address
+/*!
+    The local SocketStub connects to its ClientConfiguration target.
+*/
+struct ResolverF {
+    void operator()(const std::string& /*_name*/, ResolveCompleteFunctionT& _cbk) const
+    {
+        AddressVectorT addrvec;
+        addrvec.emplace_back();
+        _cbk(std::move(addrvec));
+    }
+};
+
+inline void setup_client(mprpc::Configuration& _rcfg, ClientConfiguration&& _uconfig)
+{
+    auto config_ptr = std::make_shared<ClientConfiguration>(std::move(_uconfig));
+
+    _rcfg.client.connection_create_socket_fnc = CreateClientSocketF{std::move(config_ptr)};
+    _rcfg.client.name_resolve_fnc             = ResolverF();
+}
+
+//! Client connections go to _rserver, in the same process
+/*!
+    _rserver must be started and it must be stopped after the client service.
+*/
+inline void setup_client(mprpc::Configuration& _rcfg, Service& _rserver)
+{
+    ClientConfiguration config;
+    config.pserver = &_rserver;
+    setup_client(_rcfg, std::move(config));
+}
+
+//! Client connections go to the server listening on the unix domain socket _path
+inline void setup_client(mprpc::Configuration& _rcfg, const std::string& _path)
+{
+    ClientConfiguration config;
+    config.path = _path;
+    setup_client(_rcfg, std::move(config));
+}
+
+//! Listen on the unix domain socket _path
+/*!
+    Incoming connections use the plain server socket, so nothing else
+    changes on the server side.
+*/
+inline void setup_server(mprpc::Configuration& _rcfg, const std::string& _path)
+{
+    _rcfg.server.listener_local_path = _path;
+}
+
+} //namespace local
+} //namespace mprpc
+} //namespace frame
+} //namespace solid
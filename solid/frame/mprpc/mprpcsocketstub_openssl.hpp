@@ -17,6 +17,7 @@
 #include "solid/frame/aio/openssl/aiosecuresocket.hpp"
 
 #include "solid/system/socketdevice.hpp"
+#include "solid/system/statistic.hpp"
 #include "solid/utility/function.hpp"
 
 #include "solid/utility/any.hpp"
@@ -28,12 +29,18 @@
 
 #include "solid/frame/mprpc/mprpcservice.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 namespace solid {
 namespace frame {
 namespace mprpc {
 namespace openssl {
 
 using ContextT      = frame::aio::openssl::Context;
+using SessionT      = frame::aio::openssl::Session;
 using StreamSocketT = frame::aio::Stream<frame::aio::openssl::Socket>;
 
 using ConnectionPrepareServerFunctionT = solid_function_t(unsigned long(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, ErrorConditionT&));
@@ -41,9 +48,83 @@ using ConnectionPrepareClientFunctionT = solid_function_t(unsigned long(frame::a
 using ConnectionServerVerifyFunctionT  = solid_function_t(bool(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, bool, frame::aio::openssl::VerifyContext&));
 using ConnectionClientVerifyFunctionT  = solid_function_t(bool(frame::aio::ReactorContext&, ConnectionContext&, StreamSocketT&, bool, frame::aio::openssl::VerifyContext&));
 
+struct HandshakeStatistic : solid::Statistic {
+    std::atomic<uint64_t> full_count_;
+    std::atomic<uint64_t> resumed_count_;
+
+    HandshakeStatistic()
+        : full_count_(0)
+        , resumed_count_(0)
+    {
+    }
+
+    std::ostream& print(std::ostream& _ros) const override
+    {
+        _ros << " full_count_ = " << full_count_;
+        _ros << " resumed_count_ = " << resumed_count_;
+        return _ros;
+    }
+};
+
+//! Client side TLS sessions - one per connection pool (i.e. recipient name)
+class SessionCache {
+    using MapT = std::unordered_map<std::string, SessionT>;
+
+public:
+    SessionCache(const size_t _capacity = 1024)
+        : capacity_(_capacity)
+    {
+    }
+
+    SessionT load(const std::string& _name) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto                  it = map_.find(_name);
+        if (it != map_.end()) {
+            return it->second;
+        }
+        return SessionT();
+    }
+
+    void store(const std::string& _name, SessionT&& _rsession)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto                  it = map_.find(_name);
+        if (it != map_.end()) {
+            it->second = std::move(_rsession);
+        } else {
+            if (map_.size() >= capacity_ && !map_.empty()) {
+                map_.erase(map_.begin());
+            }
+            map_.emplace(_name, std::move(_rsession));
+        }
+    }
+
+    void erase(const std::string& _name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_.erase(_name);
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return map_.size();
+    }
+
+private:
+    const size_t       capacity_;
+    mutable std::mutex mutex_;
+    MapT               map_;
+};
+
+using SessionCachePointerT       = std::shared_ptr<SessionCache>;
+using HandshakeStatisticPointerT = std::shared_ptr<HandshakeStatistic>;
+
 struct ClientConfiguration {
     ClientConfiguration()
         : context{ContextT::create()}
+        , statistic_ptr{std::make_shared<HandshakeStatistic>()}
     {
     }
 
@@ -51,11 +132,15 @@ struct ClientConfiguration {
 
     ConnectionPrepareClientFunctionT connection_prepare_secure_fnc;
     ConnectionClientVerifyFunctionT  connection_verify_fnc;
+    //empty means no session resumption - see setup_client_session_resumption
+    SessionCachePointerT       session_cache_ptr;
+    HandshakeStatisticPointerT statistic_ptr;
 };
 
 struct ServerConfiguration {
     ServerConfiguration()
         : context{ContextT::create()}
+        , statistic_ptr{std::make_shared<HandshakeStatistic>()}
     {
     }
 
@@ -63,6 +148,7 @@ struct ServerConfiguration {
 
     ConnectionPrepareServerFunctionT connection_prepare_secure_fnc;
     ConnectionServerVerifyFunctionT  connection_verify_fnc;
+    HandshakeStatisticPointerT       statistic_ptr;
 };
 
 class SocketStub final : public mprpc::SocketStub {
@@ -155,9 +241,9 @@ private:
     }
 
     bool connect(
-        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddressInet& _raddr) override final
+        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddressInet& _raddr, const uint32_t _recv_window_kb) override final
     {
-        return sock.connect(_rctx, _raddr, _pf);
+        return sock.connect(_rctx, _raddr, _pf, [_recv_window_kb](SocketDevice& _rsd) { setupRecvWindow(_rsd, _recv_window_kb); });
     }
 
     bool recvSome(
@@ -200,7 +286,22 @@ private:
 
         sock.secureSetVerifyCallback(_rctx, verify_mode, lambda);
 
-        return sock.secureAccept(_rctx, _pf);
+        struct Closure {
+            SocketStub&     rthis;
+            OnSecureAcceptF pf;
+
+            void operator()(frame::aio::ReactorContext& _rctx)
+            {
+                rthis.onSecureAccept(_rctx);
+                (*pf)(_rctx);
+            }
+        };
+
+        if (sock.secureAccept(_rctx, Closure{*this, _pf})) {
+            onSecureAccept(_rctx);
+            return true;
+        }
+        return false;
     }
 
     bool secureConnect(
@@ -221,7 +322,68 @@ private:
 
         sock.secureSetVerifyCallback(_rctx, verify_mode, lambda);
 
-        return sock.secureConnect(_rctx, _pf);
+        if (rconfig.session_cache_ptr) {
+            const SessionT session = rconfig.session_cache_ptr->load(_rconctx.recipientName());
+
+            if (session.isResumable()) {
+                sock.secureSetSession(_rctx, session);
+            }
+
+            auto session_lambda = [this](frame::aio::ReactorContext& _rctx, SessionT&& _rsession) {
+                Service&                   rservice = static_cast<Service&>(_rctx.service());
+                const ClientConfiguration& rconfig  = *rservice.configuration().client.secure_any.cast<ClientConfiguration>();
+                ConnectionContext          conctx(_rctx, connectionProxy());
+
+                rconfig.session_cache_ptr->store(conctx.recipientName(), std::move(_rsession));
+            };
+
+            sock.secureSetSessionCallback(_rctx, session_lambda);
+        }
+
+        struct Closure {
+            SocketStub&      rthis;
+            OnSecureConnectF pf;
+
+            void operator()(frame::aio::ReactorContext& _rctx)
+            {
+                rthis.onSecureConnect(_rctx);
+                (*pf)(_rctx);
+            }
+        };
+
+        if (sock.secureConnect(_rctx, Closure{*this, _pf})) {
+            onSecureConnect(_rctx);
+            return true;
+        }
+        return false;
+    }
+
+    void onSecureConnect(frame::aio::ReactorContext& _rctx)
+    {
+        if (!_rctx.error()) {
+            Service&                   rservice = static_cast<Service&>(_rctx.service());
+            const ClientConfiguration& rconfig  = *rservice.configuration().client.secure_any.cast<ClientConfiguration>();
+
+            if (sock.secureIsSessionReused()) {
+                ++rconfig.statistic_ptr->resumed_count_;
+            } else {
+                ++rconfig.statistic_ptr->full_count_;
+            }
+        }
+    }
+
+    void onSecureAccept(frame::aio::ReactorContext& _rctx)
+    {
+        if (!_rctx.error()) {
+            Service&                   rservice = static_cast<Service&>(_rctx.service());
+            const ServerConfiguration& rconfig  = *rservice.configuration().server.secure_any.cast<ServerConfiguration>();
+
+            if (sock.secureIsSessionReused()) {
+                ++rconfig.statistic_ptr->resumed_count_;
+            } else {
+                ++rconfig.statistic_ptr->full_count_;
+            }
+        }
     }
 
     StreamSocketT& socket()
@@ -357,6 +519,30 @@ inline void setup_server(
     rsecure_cfg.connection_verify_fnc         = std::move(_verify_fnc);
 }
 
+//! Enable client side session resumption, with sessions cached per connection pool
+/*!
+ * Must be called after setup_client.
+ */
+inline void setup_client_session_resumption(
+    mprpc::Configuration& _rcfg,
+    const size_t          _capacity = 1024)
+{
+    ClientConfiguration& rsecure_cfg = *_rcfg.client.secure_any.cast<ClientConfiguration>();
+
+    rsecure_cfg.context.enableClientSessionResumption();
+    rsecure_cfg.session_cache_ptr = std::make_shared<SessionCache>(_capacity);
+}
+
+inline const HandshakeStatistic& client_handshake_statistic(mprpc::Configuration const& _rcfg)
+{
+    return *_rcfg.client.secure_any.constCast<ClientConfiguration>()->statistic_ptr;
+}
+
+inline const HandshakeStatistic& server_handshake_statistic(mprpc::Configuration const& _rcfg)
+{
+    return *_rcfg.server.secure_any.constCast<ServerConfiguration>()->statistic_ptr;
+}
+
 } //namespace openssl
 } //namespace mprpc
 } //namespace frame
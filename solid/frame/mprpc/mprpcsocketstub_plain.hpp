@@ -111,9 +111,9 @@ private:
     }
 
     bool connect(
-        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddressInet& _raddr) override final
+        frame::aio::ReactorContext& _rctx, OnConnectF _pf, const SocketAddressInet& _raddr, const uint32_t _recv_window_kb) override final
     {
-        return sock.connect(_rctx, _raddr, _pf);
+        return sock.connect(_rctx, _raddr, _pf, [_recv_window_kb](SocketDevice& _rsd) { setupRecvWindow(_rsd, _recv_window_kb); });
     }
 
     bool recvSome(
@@ -0,0 +1,483 @@
+// solid/frame/mprpc/mprpcstripe.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v2.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+#include "solid/system/socketaddress.hpp"
+
+namespace solid {
+namespace frame {
+namespace mprpc {
+namespace stripe {
+
+//! One part of a striped payload
+struct Message final : mprpc::Message {
+    uint64_t    stripe_id;
+    uint64_t    total_size;
+    uint64_t    offset;
+    uint32_t    part_index;
+    uint32_t    part_count;
+    std::string data;
+
+    Message()
+        : stripe_id(0)
+        , total_size(0)
+        , offset(0)
+        , part_index(0)
+        , part_count(0)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.stripe_id, _rctx, "stripe_id").add(_rthis.total_size, _rctx, "total_size").add(_rthis.offset, _rctx, "offset");
+        _s.add(_rthis.part_index, _rctx, "part_index").add(_rthis.part_count, _rctx, "part_count").add(_rthis.data, _rctx, "data");
+    }
+};
+
+//! Splits a large payload into parts sent on as many active connections of a pool as possible
+//! and reassembles the parts on the receiving side.
+/*!
+    The parts are asynchronous messages, so the connections of a pool
+    (see Configuration::pool_max_active_connection_count) fetch them in
+    parallel from the pool's queue. On the sending side, setupMultiplex()
+    limits the bytes a connection multiplexes
+    (WriterConfiguration::max_message_bytes_multiplex) to the part size so that
+    one connection cannot take all the parts - the byte budget needs the part
+    sizes, given by setupMessageSize() or by the application's own
+    Configuration::message_size_fnc. Both are opt-in, setup() only registers
+    the part message.
+
+    On the receiving side the parts are gathered by peer host and stripe id,
+    regardless of the connection they arrived on, and the complete function is
+    called, on the connection thread that received the last part, with the
+    whole payload. Both sides must use the same part size: a part larger than
+    it, more parts than the payload needs, empty or overlapping parts are
+    dropped, and a stripe completes only when its parts cover the payload.
+    The parts are kept as they arrive and joined on completion, while the
+    Limits bound - per peer host and overall - the number of incomplete
+    stripes and the sum of their declared sizes: the first part of a stripe
+    that would go over them is dropped.
+
+    An incomplete stripe - e.g. with a part lost with its connection - is
+    dropped after timeout without new parts. If send() fails partway it
+    cancels the parts already queued. The Engine must outlive the Services it
+    was setup on.
+*/
+class Engine {
+public:
+    using CompleteFunctionT = solid_function_t(void(ConnectionContext&, const uint64_t, std::string&&));
+
+    static constexpr size_t default_part_size      = 1024 * 1024;
+    static constexpr size_t default_max_total_size = 256 * 1024 * 1024;
+
+    //! Bounds for the incomplete stripes on the receiving side
+    /*!
+        The size limits should be at least the Engine's max total size,
+        otherwise the largest stripes are always dropped.
+    */
+    struct Limits {
+        size_t   max_pending_count; //incomplete stripes from all the peers
+        uint64_t max_pending_size; //sum of the declared payload sizes of the incomplete stripes from all the peers
+        size_t   max_peer_pending_count; //incomplete stripes from a peer host
+        uint64_t max_peer_pending_size; //sum of the declared payload sizes of the incomplete stripes from a peer host
+
+        Limits()
+            : max_pending_count(256)
+            , max_pending_size(1024ULL * 1024 * 1024)
+            , max_peer_pending_count(32)
+            , max_peer_pending_size(default_max_total_size)
+        {
+        }
+    };
+
+    template <class F>
+    Engine(
+        F                               _complete_fnc,
+        const size_t                    _part_size      = default_part_size,
+        const size_t                    _max_total_size = default_max_total_size,
+        const std::chrono::milliseconds _timeout        = std::chrono::seconds(60),
+        const Limits&                   _limits         = Limits())
+        : part_size_(_part_size != 0 ? _part_size : static_cast<size_t>(default_part_size))
+        , max_total_size_(_max_total_size != 0 ? _max_total_size : static_cast<size_t>(default_max_total_size))
+        , timeout_(_timeout)
+        , limits_(_limits)
+        , complete_fnc_(std::move(_complete_fnc))
+        , next_id_(static_cast<uint64_t>(std::random_device()()) << 32)
+        , rejected_count_(0)
+    {
+    }
+
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    size_t partSize() const
+    {
+        return part_size_;
+    }
+
+    //! Register the part message
+    template <class Proto>
+    void setup(Proto& _rproto, const typename Proto::TypeIdT& _rtype_id)
+    {
+        _rproto.template registerMessage<Message>(
+            [this](
+                ConnectionContext&        _rctx,
+                std::shared_ptr<Message>& /*_rsent_msg_ptr*/,
+                std::shared_ptr<Message>& _rrecv_msg_ptr,
+                ErrorConditionT const& /*_rerror*/) {
+                if (_rrecv_msg_ptr) {
+                    receive(_rctx, *_rrecv_msg_ptr);
+                }
+            },
+            _rtype_id);
+    }
+
+    //! Opt-in: wrap Configuration::message_size_fnc to return the data size of the parts
+    /*!
+        Every message sent then pays a typeid comparison - skip it if the
+        application's message_size_fnc already knows the part sizes.
+    */
+    void setupMessageSize(Configuration& _rcfg) const
+    {
+        auto message_size_fnc  = std::move(_rcfg.message_size_fnc);
+        _rcfg.message_size_fnc = [message_size_fnc](const mprpc::Message& _rmsg) -> size_t {
+            if (typeid(_rmsg) == typeid(Message)) {
+                return static_cast<const Message&>(_rmsg).data.size();
+            }
+            return message_size_fnc(_rmsg);
+        };
+    }
+
+    //! Opt-in: limit the bytes multiplexed by a connection to the part size
+    void setupMultiplex(Configuration& _rcfg) const
+    {
+        _rcfg.writer.max_message_bytes_multiplex = part_size_;
+    }
+
+    template <class Recipient>
+    ErrorConditionT send(
+        Service&             _rsvc,
+        const Recipient&     _rrecipient,
+        const std::string&   _payload,
+        uint64_t*            _pstripe_id = nullptr,
+        const MessageFlagsT& _flags      = 0)
+    {
+        const uint64_t stripe_id  = next_id_.fetch_add(1);
+        const size_t   part_count = _payload.empty() ? 1 : (_payload.size() + part_size_ - 1) / part_size_;
+
+        if (_pstripe_id != nullptr) {
+            *_pstripe_id = stripe_id;
+        }
+
+        RecipientId            recipient_id;
+        std::vector<MessageId> msgid_vec;
+
+        msgid_vec.reserve(part_count);
+
+        for (size_t i = 0; i < part_count; ++i) {
+            auto         msgptr = std::make_shared<Message>();
+            const size_t offset = i * part_size_;
+
+            msgptr->stripe_id  = stripe_id;
+            msgptr->total_size = _payload.size();
+            msgptr->offset     = offset;
+            msgptr->part_index = static_cast<uint32_t>(i);
+            msgptr->part_count = static_cast<uint32_t>(part_count);
+            msgptr->data.assign(_payload, offset, part_size_);
+
+            MessageId       msgid;
+            ErrorConditionT err = sendPart(_rsvc, _rrecipient, msgptr, recipient_id, msgid, _flags);
+            if (err) {
+                //the receiver would only wait for the missing parts
+                for (const auto& rmsgid : msgid_vec) {
+                    _rsvc.cancelMessage(recipient_id, rmsgid);
+                }
+                return err;
+            }
+            msgid_vec.emplace_back(msgid);
+        }
+        return ErrorConditionT();
+    }
+
+    //! Drop an incomplete stripe
+    void erase(const uint64_t _stripe_id)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (auto it = stub_map_.begin(); it != stub_map_.end();) {
+            if (it->first.second == _stripe_id) {
+                it = doErase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    //! The number of incomplete stripes
+    size_t pendingCount() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return stub_map_.size();
+    }
+
+    //! The sum of the declared payload sizes of the incomplete stripes
+    uint64_t pendingSize() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return total_usage_.size;
+    }
+
+    //! The number of parts dropped as invalid or over the Limits
+    size_t rejectedCount() const
+    {
+        return rejected_count_.load();
+    }
+
+private:
+    using TimePointT = std::chrono::steady_clock::time_point;
+    using KeyT       = std::pair<std::string, uint64_t>; //peer host, stripe id
+    using PartMapT   = std::map<uint64_t, std::string>; //offset -> data of the received parts
+
+    struct Stub {
+        uint64_t          total_size = 0;
+        std::vector<bool> received_vec;
+        size_t            received_count = 0;
+        uint64_t          received_size  = 0;
+        PartMapT          part_map;
+        TimePointT        expire_time;
+
+        bool insertPart(const uint64_t _offset, std::string&& _rdata)
+        {
+            const uint64_t end = _offset + _rdata.size();
+            const auto     it  = part_map.lower_bound(_offset);
+            if (it != part_map.end() && it->first < end) {
+                return false;
+            }
+            if (it != part_map.begin() && (std::prev(it)->first + std::prev(it)->second.size()) > _offset) {
+                return false;
+            }
+            part_map.emplace_hint(it, _offset, std::move(_rdata));
+            return true;
+        }
+    };
+
+    struct Usage {
+        size_t   count = 0;
+        uint64_t size  = 0;
+    };
+
+    using StubMapT = std::map<KeyT, Stub>;
+    using PeerMapT = std::map<std::string, Usage>; //per peer host usage
+
+    //the parts do not overlap and cover the payload
+    static std::string join(PartMapT& _rpart_map, const uint64_t _size)
+    {
+        if (_rpart_map.size() == 1) {
+            return std::move(_rpart_map.begin()->second);
+        }
+        std::string data;
+        data.reserve(static_cast<size_t>(_size));
+        for (auto& part : _rpart_map) {
+            data.append(part.second);
+            std::string().swap(part.second); //release the part as soon as it is copied
+        }
+        return data;
+    }
+
+    template <class T>
+    static ErrorConditionT sendPart(
+        Service& _rsvc, const char* _recipient_url, std::shared_ptr<T> const& _rmsgptr,
+        RecipientId& _rrecipient_id, MessageId& _rmsg_id, const MessageFlagsT& _flags)
+    {
+        return _rsvc.sendMessage(_recipient_url, _rmsgptr, _rrecipient_id, _rmsg_id, _flags);
+    }
+
+    template <class T>
+    static ErrorConditionT sendPart(
+        Service& _rsvc, RecipientId const& _rrecipient, std::shared_ptr<T> const& _rmsgptr,
+        RecipientId& _rrecipient_id, MessageId& _rmsg_id, const MessageFlagsT& _flags)
+    {
+        _rrecipient_id = _rrecipient;
+        return _rsvc.sendMessage(_rrecipient, _rmsgptr, _rmsg_id, _flags);
+    }
+
+    //the parts of a stripe come on different connections from the same host
+    static std::string peerHost(ConnectionContext& _rctx)
+    {
+        SocketAddress addr;
+        std::string   host;
+
+        if (!_rctx.device().remoteAddress(addr)) {
+            const SocketAddressInet inaddr{SocketAddressStub(addr)};
+            if (addr.isInet4()) {
+                host.assign(reinterpret_cast<const char*>(&inaddr.address4()), sizeof(in_addr));
+            } else if (addr.isInet6()) {
+                host.assign(reinterpret_cast<const char*>(&inaddr.address6()), sizeof(in6_addr));
+            }
+        }
+        return host;
+    }
+
+    bool isValid(const Message& _rmsg) const
+    {
+        const uint64_t max_part_count = _rmsg.total_size == 0 ? 1 : (_rmsg.total_size + part_size_ - 1) / part_size_;
+
+        return _rmsg.total_size <= max_total_size_ && _rmsg.part_count != 0 && _rmsg.part_count <= max_part_count && _rmsg.part_index < _rmsg.part_count && _rmsg.data.size() <= part_size_ && _rmsg.offset <= _rmsg.total_size && _rmsg.data.size() <= (_rmsg.total_size - _rmsg.offset) && (!_rmsg.data.empty() || _rmsg.total_size == 0);
+    }
+
+    //mutex must be locked
+    void doExpire(const TimePointT& _rnow)
+    {
+        if (_rnow < next_sweep_time_) {
+            return;
+        }
+        next_sweep_time_ = _rnow + timeout_;
+
+        for (auto it = stub_map_.begin(); it != stub_map_.end();) {
+            if (it->second.expire_time <= _rnow) {
+                it = doErase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    //mutex must be locked - accounts a new stripe if it fits the Limits
+    bool doReserve(const std::string& _host, const uint64_t _size)
+    {
+        if (total_usage_.count >= limits_.max_pending_count || _size > limits_.max_pending_size - total_usage_.size) {
+            return false;
+        }
+
+        Usage& rpeer_usage = peer_map_[_host];
+
+        if (rpeer_usage.count >= limits_.max_peer_pending_count || _size > limits_.max_peer_pending_size - rpeer_usage.size) {
+            if (rpeer_usage.count == 0) {
+                peer_map_.erase(_host);
+            }
+            return false;
+        }
+        ++rpeer_usage.count;
+        rpeer_usage.size += _size;
+        ++total_usage_.count;
+        total_usage_.size += _size;
+        return true;
+    }
+
+    //mutex must be locked
+    StubMapT::iterator doErase(StubMapT::iterator _it)
+    {
+        const auto peer_it = peer_map_.find(_it->first.first);
+
+        --peer_it->second.count;
+        peer_it->second.size -= _it->second.total_size;
+        if (peer_it->second.count == 0) {
+            peer_map_.erase(peer_it);
+        }
+        --total_usage_.count;
+        total_usage_.size -= _it->second.total_size;
+        return stub_map_.erase(_it);
+    }
+
+    void receive(ConnectionContext& _rctx, Message& _rmsg)
+    {
+        const TimePointT now = std::chrono::steady_clock::now();
+        KeyT             key(peerHost(_rctx), _rmsg.stripe_id);
+        PartMapT         part_map;
+        uint64_t         total_size = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+
+            doExpire(now);
+
+            if (!isValid(_rmsg)) {
+                ++rejected_count_;
+                return;
+            }
+
+            auto it = stub_map_.find(key);
+
+            if (it == stub_map_.end()) {
+                if (!doReserve(key.first, _rmsg.total_size)) {
+                    ++rejected_count_;
+                    return; //over the Limits
+                }
+                it                    = stub_map_.emplace(std::move(key), Stub()).first;
+                it->second.total_size = _rmsg.total_size;
+                it->second.received_vec.resize(_rmsg.part_count, false);
+            } else if (it->second.received_vec.size() != _rmsg.part_count || it->second.total_size != _rmsg.total_size) {
+                ++rejected_count_;
+                return; //inconsistent part
+            }
+
+            Stub&          rstub     = it->second;
+            const uint64_t part_size = _rmsg.data.size();
+
+            if (rstub.received_vec[_rmsg.part_index] || !rstub.insertPart(_rmsg.offset, std::move(_rmsg.data))) {
+                ++rejected_count_;
+                return; //duplicate or overlapping part
+            }
+
+            rstub.received_vec[_rmsg.part_index] = true;
+            ++rstub.received_count;
+            rstub.received_size += part_size;
+            rstub.expire_time = now + timeout_;
+
+            if (rstub.received_count != rstub.received_vec.size()) {
+                return;
+            }
+
+            if (rstub.received_size != rstub.total_size) {
+                //the parts do not cover the payload
+                ++rejected_count_;
+                doErase(it);
+                return;
+            }
+
+            part_map   = std::move(rstub.part_map);
+            total_size = rstub.total_size;
+            doErase(it);
+        }
+        complete_fnc_(_rctx, _rmsg.stripe_id, join(part_map, total_size));
+    }
+
+private:
+    const size_t                              part_size_;
+    const size_t                              max_total_size_;
+    const std::chrono::steady_clock::duration timeout_;
+    const Limits                              limits_;
+    CompleteFunctionT                         complete_fnc_;
+    std::atomic<uint64_t>                     next_id_;
+    std::atomic<size_t>                       rejected_count_;
+    mutable std::mutex                        mtx_;
+    StubMapT                                  stub_map_;
+    PeerMapT                                  peer_map_;
+    Usage                                     total_usage_;
+    TimePointT                                next_sweep_time_;
+};
+
+} //namespace stripe
+} //namespace mprpc
+} //namespace frame
+} //namespace solid
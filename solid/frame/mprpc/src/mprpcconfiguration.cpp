@@ -17,6 +17,9 @@
 #include "solid/system/memory.hpp"
 
 #include <cstring>
+#ifndef SOLID_ON_WINDOWS
+#include <unistd.h>
+#endif
 
 namespace solid {
 namespace frame {
@@ -86,6 +89,11 @@ void empty_connection_start(ConnectionContext&) {}
 
 void empty_connection_on_event(ConnectionContext&, Event&) {}
 
+size_t empty_message_size(const Message&)
+{
+    return 0;
+}
+
 size_t default_compress(char*, size_t, ErrorConditionT&)
 {
     return 0;
@@ -146,6 +154,7 @@ ReaderConfiguration::ReaderConfiguration()
     string_size_limit           = InvalidSize();
     stream_size_limit           = InvalidSize();
     container_size_limit        = InvalidSize();
+    direct_receive_min_size     = 2 * 1024;
 
     decompress_fnc = &default_decompress;
 }
@@ -156,6 +165,7 @@ WriterConfiguration::WriterConfiguration()
 
     max_message_continuous_packet_count = 4;
     max_message_count_response_wait     = 128;
+    max_message_bytes_multiplex         = 0;
 
     string_size_limit    = InvalidSize();
     stream_size_limit    = InvalidSize();
@@ -257,6 +267,7 @@ void Configuration::init()
     connection_reconnect_timeout_seconds  = 10;
 
     connection_relay_buffer_count = 8;
+    connection_recv_window_kb     = 0;
 
     connection_inactivity_keepalive_count = 2;
 
@@ -276,6 +287,8 @@ void Configuration::init()
 
     connection_on_event_fnc = &empty_connection_on_event;
 
+    message_size_fnc = &empty_message_size;
+
     client.connection_create_socket_fnc = &default_create_client_socket;
     server.connection_create_socket_fnc = &default_create_server_socket;
 
@@ -287,7 +300,9 @@ void Configuration::init()
     pool_max_active_connection_count  = 1;
     pool_max_pending_connection_count = 1;
     pool_max_message_queue_size       = 1024;
+    pool_max_message_queue_bytes      = 0;
     relay_enabled                     = false;
+    latency_per_message_type          = false;
 }
 //-----------------------------------------------------------------------------
 size_t Configuration::connectionReconnectTimeoutSeconds(
@@ -358,6 +373,25 @@ void Configuration::prepare(SocketDevice& _rsd)
 
     prepare();
 
+#ifndef SOLID_ON_WINDOWS
+    if (!server.listener_local_path.empty()) {
+        const SocketAddressLocal addr(server.listener_local_path.c_str());
+        SocketDevice             sd;
+
+        ::unlink(server.listener_local_path.c_str()); //left by a previous run, it would fail the bind
+
+        ErrorCodeT err = sd.create(SocketInfo::Local);
+        if (!err) {
+            err = sd.prepareAccept(addr, SocketInfo::max_listen_backlog_size());
+        }
+        if (!err) {
+            _rsd = std::move(sd);
+            return; //SUCCESS
+        }
+        solid_throw("failed to create local listener socket device: " << err.message());
+    }
+#endif
+
     if (!server.listener_address_str.empty()) {
         std::string tmp;
         const char* hst_name;
@@ -381,6 +415,8 @@ void Configuration::prepare(SocketDevice& _rsd)
         for (auto it = rd.begin(); it != rd.end(); ++it) {
             SocketDevice sd;
             sd.create(it);
+            //the accepted sockets inherit the receive buffer - and with it the TCP window scale
+            SocketStub::setupRecvWindow(sd, connection_recv_window_kb);
             const auto err = sd.prepareAccept(it, SocketInfo::max_listen_backlog_size());
             if (!err) {
                 _rsd = std::move(sd);
@@ -82,6 +82,11 @@ const EventCategory<ConnectionEvents> connection_event_category{
         }
     }};
 
+inline size_t latency_shard(frame::aio::ReactorContext& _rctx)
+{
+    return ServiceStatistic::latencyShard(_rctx.reactorIndex());
+}
+
 } //namespace
 
 //-----------------------------------------------------------------------------
@@ -573,7 +578,7 @@ struct Connection::Sender : MessageWriter::Sender {
     ErrorConditionT completeMessage(MessageBundle& _rmsg_bundle, MessageId const& _rpool_msg_id) override
     {
         rcon_.doCompleteMessage(rctx_, _rpool_msg_id, _rmsg_bundle, err_);
-        return rcon_.service(rctx_).pollPoolForUpdates(rcon_, rcon_.uid(rctx_), _rpool_msg_id);
+        return rcon_.service(rctx_).pollPoolForUpdates(context(), rcon_.uid(rctx_), _rpool_msg_id);
     }
     void completeRelayed(RelayData* _prelay_data, MessageId const& _rmsgid) override
     {
@@ -589,6 +594,26 @@ struct Connection::Sender : MessageWriter::Sender {
     {
         rcon_.doCancelRelayed(rctx_, _prelay_data, _rmsgid);
     }
+
+    void startMessage(MessageBundle& _rmsg_bundle) override
+    {
+        const auto now   = ServiceStatistic::now();
+        auto&      rstat = rcon_.service(rctx_).wstatistic();
+#ifdef SOLID_HAS_STATISTICS
+        rstat.queueTime(
+            Message::priority(_rmsg_bundle.message_flags),
+            std::chrono::duration_cast<std::chrono::microseconds>(now - _rmsg_bundle.enqueue_time).count());
+#endif
+        rstat.latency(LatencyStageE::PoolToWriter, latency_shard(rctx_), _rmsg_bundle.message_type_id, _rmsg_bundle.enqueue_time, now);
+        _rmsg_bundle.stage_time = now;
+    }
+
+    void sentMessage(MessageBundle& _rmsg_bundle) override
+    {
+        const auto now = ServiceStatistic::now();
+        rcon_.service(rctx_).wstatistic().latency(LatencyStageE::WriterToSent, latency_shard(rctx_), _rmsg_bundle.message_type_id, _rmsg_bundle.stage_time, now);
+        _rmsg_bundle.stage_time = now;
+    }
 };
 
 void Connection::doCompleteAllMessages(
@@ -1500,7 +1525,7 @@ struct Connection::Receiver : MessageReader::Receiver {
 
     void receiveMessage(MessagePointerT& _rmsg_ptr, const size_t _msg_type_id) override
     {
-        rcon_.doCompleteMessage(rctx_, _rmsg_ptr, _msg_type_id);
+        rcon_.doCompleteMessage(rctx_, _rmsg_ptr, _msg_type_id, receive_time_);
         rcon_.flags_.set(FlagsE::PollPool); //reset flag
         rcon_.post(
             rctx_,
@@ -1589,7 +1614,12 @@ struct Connection::Receiver : MessageReader::Receiver {
     do {
         solid_dbg(logger, Verbose, &rthis << " received size " << _sz);
 
-        if (!_rctx.error()) {
+        if (rthis.flags_.has(FlagsE::RecvDirect) && !_rctx.error()) {
+            recv_something = true;
+            rthis.flags_.reset(FlagsE::RecvDirect);
+            rthis.msg_reader_.directBufferFilled(_sz);
+            rthis.service(_rctx).wstatistic().directReceive(_sz);
+        } else if (!_rctx.error()) {
             recv_something = true;
             rthis.recv_buf_off_ += _sz;
             pbuf  = rthis.recv_buf_->data() + rthis.cons_buf_off_;
@@ -1629,6 +1659,16 @@ struct Connection::Receiver : MessageReader::Receiver {
 
         bufsz = recvbufcp - rthis.recv_buf_off_;
         //solid_dbg(logger, Info, &rthis<<" buffer size "<<bufsz);
+
+        if (rthis.recv_buf_off_ == rthis.cons_buf_off_) {
+            size_t direct_sz   = 0;
+            char*  pdirect_buf = rthis.msg_reader_.directBuffer(direct_sz);
+            if (pdirect_buf != nullptr) {
+                rthis.flags_.set(FlagsE::RecvDirect);
+                pbuf  = pdirect_buf;
+                bufsz = direct_sz;
+            }
+        }
     } while (repeatcnt != 0u && rthis.recvSome(_rctx, pbuf, bufsz, _sz));
 
     if (recv_something) {
@@ -1658,7 +1698,7 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
         //receive a force pool close, even though we are waiting for send.
         if (shouldPollPool()) {
             flags_.reset(FlagsE::PollPool); //reset flag
-            if ((error = service(_rctx).pollPoolForUpdates(*this, uid(_rctx), MessageId()))) {
+            if ((error = service(_rctx).pollPoolForUpdates(conctx, uid(_rctx), MessageId()))) {
                 doStop(_rctx, error);
                 return;
             }
@@ -1684,7 +1724,7 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
 
                 if (shouldPollPool()) {
                     flags_.reset(FlagsE::PollPool); //reset flag
-                    if ((error = service(_rctx).pollPoolForUpdates(*this, uid(_rctx), MessageId()))) {
+                    if ((error = service(_rctx).pollPoolForUpdates(conctx, uid(_rctx), MessageId()))) {
                         doStop(_rctx, error);
                         sent_something = false; //prevent calling doResetTimerSend after doStop
                         break;
@@ -1793,19 +1833,22 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
 //-----------------------------------------------------------------------------
 
 struct Connection::SenderResponse : Connection::Sender {
-    MessagePointerT& rresponse_ptr_;
+    MessagePointerT&                 rresponse_ptr_;
+    MessageReader::TimePointT const& rreceive_time_;
 
     bool request_found_;
 
     SenderResponse(
-        Connection&                 _rcon,
-        frame::aio::ReactorContext& _rctx,
-        WriterConfiguration const&  _rconfig,
-        Protocol const&             _rproto,
-        ConnectionContext&          _rconctx,
-        MessagePointerT&            _rresponse_ptr)
+        Connection&                      _rcon,
+        frame::aio::ReactorContext&      _rctx,
+        WriterConfiguration const&       _rconfig,
+        Protocol const&                  _rproto,
+        ConnectionContext&               _rconctx,
+        MessagePointerT&                 _rresponse_ptr,
+        MessageReader::TimePointT const& _rreceive_time)
         : Connection::Sender(_rcon, _rctx, _rconfig, _rproto, _rconctx)
         , rresponse_ptr_(_rresponse_ptr)
+        , rreceive_time_(_rreceive_time)
         , request_found_(false)
     {
     }
@@ -1819,6 +1862,12 @@ struct Connection::SenderResponse : Connection::Sender {
 
         bool must_clear_request = !rresponse_ptr_->isResponsePart(); //do not clear the request if the response is a partial one
 
+        if (Message::is_done_send(_rmsg_bundle.message_flags)) {
+            auto& rstat = rcon_.service(rctx_).wstatistic();
+            rstat.latency(LatencyStageE::SentToResponse, latency_shard(rctx_), _rmsg_bundle.message_type_id, _rmsg_bundle.stage_time, rreceive_time_);
+            rstat.latency(LatencyStageE::ReceiveToComplete, latency_shard(rctx_), _rmsg_bundle.message_type_id, rreceive_time_, ServiceStatistic::now());
+        }
+
         if (!solid_function_empty(_rmsg_bundle.complete_fnc)) {
             solid_dbg(logger, Info, this);
             _rmsg_bundle.complete_fnc(context(), _rmsg_bundle.message_ptr, rresponse_ptr_, err_);
@@ -1833,7 +1882,7 @@ struct Connection::SenderResponse : Connection::Sender {
     }
 };
 
-void Connection::doCompleteMessage(frame::aio::ReactorContext& _rctx, MessagePointerT& _rresponse_ptr, const size_t _response_type_id)
+void Connection::doCompleteMessage(frame::aio::ReactorContext& _rctx, MessagePointerT& _rresponse_ptr, const size_t _response_type_id, MessageReader::TimePointT const& _rreceive_time)
 {
     ConnectionContext    conctx(service(_rctx), *this);
     const Configuration& rconfig = service(_rctx).configuration();
@@ -1842,7 +1891,7 @@ void Connection::doCompleteMessage(frame::aio::ReactorContext& _rctx, MessagePoi
 
     if (_rresponse_ptr->isBackOnSender() || _rresponse_ptr->isBackOnPeer()) {
         solid_dbg(logger, Info, this << ' ' << "Completing back on sender message: " << _rresponse_ptr->requestId());
-        SenderResponse sender(*this, _rctx, rconfig.writer, rproto, conctx, _rresponse_ptr);
+        SenderResponse sender(*this, _rctx, rconfig.writer, rproto, conctx, _rresponse_ptr, _rreceive_time);
 
         msg_writer_.cancel(_rresponse_ptr->requestId(), sender, true /*force*/);
 
@@ -1853,6 +1902,7 @@ void Connection::doCompleteMessage(frame::aio::ReactorContext& _rctx, MessagePoi
     MessageBundle empty_msg_bundle; //request message
 
     solid_dbg(logger, Info, this << " " << _response_type_id);
+    service(_rctx).wstatistic().latency(LatencyStageE::ReceiveToComplete, latency_shard(_rctx), _response_type_id, _rreceive_time, ServiceStatistic::now());
     rproto.complete(_response_type_id, conctx, empty_msg_bundle.message_ptr, _rresponse_ptr, error);
 }
 //-----------------------------------------------------------------------------
@@ -2091,7 +2141,7 @@ ResponseStateE Connection::doCheckResponseState(frame::aio::ReactorContext& _rct
 //-----------------------------------------------------------------------------
 /*virtual*/ bool Connection::connect(frame::aio::ReactorContext& _rctx, const SocketAddressInet& _raddr)
 {
-    return sock_ptr_->connect(_rctx, Connection::onConnect, _raddr);
+    return sock_ptr_->connect(_rctx, Connection::onConnect, _raddr, service(_rctx).configuration().connection_recv_window_kb);
 }
 //-----------------------------------------------------------------------------
 /*virtual*/ bool Connection::recvSome(frame::aio::ReactorContext& _rctx, char* _buf, size_t _bufcp, size_t& _sz)
@@ -256,7 +256,7 @@ private:
     ResponseStateE doCheckResponseState(frame::aio::ReactorContext& _rctx, const MessageHeader& _rmsghdr, MessageId& _rrelay_id, const bool _erase_request);
 
     void doCompleteMessage(
-        frame::aio::ReactorContext& _rctx, MessagePointerT& _rresponse_ptr, const size_t _response_type_id);
+        frame::aio::ReactorContext& _rctx, MessagePointerT& _rresponse_ptr, const size_t _response_type_id, MessageReader::TimePointT const& _rreceive_time);
 
     void doCompleteMessage(
         solid::frame::aio::ReactorContext& _rctx,
@@ -366,6 +366,7 @@ private:
         Raw,
         InPoolWaitQueue,
         Connected, //once set - the flag should not be reset. Is used by pool for restarting
+        RecvDirect, //the pending receive goes into MessageReader::directBuffer
         LastFlag,
     };
 
@@ -15,6 +15,7 @@
 #include "solid/frame/mprpc/mprpcmessage.hpp"
 #include "solid/system/exception.hpp"
 #include "solid/system/log.hpp"
+#include <cstring>
 
 namespace solid {
 namespace frame {
@@ -26,6 +27,8 @@ const LoggerT logger("solid::frame::mprpc::reader");
 MessageReader::MessageReader()
     : current_message_type_id_(InvalidIndex())
     , state_(StateE::ReadPacketHead)
+    , direct_msgidx_(0)
+    , direct_size_(0)
 {
 }
 //-----------------------------------------------------------------------------
@@ -53,6 +56,19 @@ size_t MessageReader::read(
     PacketHeader packet_header;
 
     while (pbufpos != pbufend) {
+        if (state_ == StateE::ReadPacketDirect) {
+            //part of the direct region ended up in the connection buffer
+            size_t      sz    = 0;
+            char* const pdest = directBuffer(sz);
+            if (sz > static_cast<size_t>(pbufend - pbufpos)) {
+                sz = pbufend - pbufpos;
+            }
+            memcpy(pdest, pbufpos, sz);
+            directBufferFilled(sz);
+            pbufpos += sz;
+            continue;
+        }
+
         if (state_ == StateE::ReadPacketHead) {
             //try read the header
             if ((pbufend - pbufpos) >= PacketHeader::SizeOfE) {
@@ -68,6 +84,9 @@ size_t MessageReader::read(
             if (static_cast<size_t>(pbufend - tmpbufpos) >= packet_header.size()) {
                 pbufpos = tmpbufpos;
             } else {
+                if (packet_header.isOk() && doTryReadDirect(tmpbufpos, pbufend, packet_header, _receiver)) {
+                    pbufpos = pbufend;
+                }
                 break;
             }
         }
@@ -97,6 +116,90 @@ size_t MessageReader::read(
     return pbufpos - _pbuf;
 }
 //-----------------------------------------------------------------------------
+// Only the simple, common case of a large binary field spanning many packets
+// is received directly: the incomplete packet must be uncompressed and made of
+// a single Message chunk whose bytes all go into the binary field the message
+// deserializer currently waits on.
+bool MessageReader::doTryReadDirect(
+    const char*         _pbufpos,
+    const char* const   _pbufend,
+    PacketHeader const& _packet_header,
+    Receiver&           _receiver)
+{
+    const size_t      min_size   = _receiver.configuration().direct_receive_min_size;
+    const char* const ppacketend = _pbufpos + _packet_header.size();
+
+    if (
+        min_size == 0 || _packet_header.isCompressed() || _packet_header.isTypeKeepAlive() || static_cast<size_t>(ppacketend - _pbufend) < min_size || _pbufpos == _pbufend) {
+        return false;
+    }
+
+    uint8_t  cmd          = 0;
+    uint32_t message_idx  = 0;
+    uint16_t message_size = 0;
+
+    _pbufpos = _receiver.protocol().loadValue(_pbufpos, cmd);
+
+    if (cmd != static_cast<uint8_t>(PacketHeader::CommandE::Message)) {
+        return false;
+    }
+
+    _pbufpos = _receiver.protocol().loadCrossValue(_pbufpos, _pbufend - _pbufpos, message_idx);
+
+    if (_pbufpos == nullptr || message_idx >= message_vec_.size() || static_cast<size_t>(_pbufend - _pbufpos) < sizeof(uint16_t)) {
+        return false;
+    }
+
+    _pbufpos = _receiver.protocol().loadValue(_pbufpos, message_size);
+
+    MessageStub& rmsgstub = message_vec_[message_idx];
+    char*        pdest    = nullptr;
+
+    //the response cancel check is done on every 16th packet - leave those to doConsumeMessage
+    if (
+        (_pbufpos + message_size) != ppacketend || rmsgstub.state_ != MessageStub::StateE::ReadBodyContinue || (rmsgstub.packet_count_ & 15) == 0 || rmsgstub.deserializer_ptr_->binaryDestination(pdest) <= message_size) {
+        return false;
+    }
+
+    if ((_packet_header.flags() & static_cast<uint8_t>(PacketHeader::FlagE::AckRequest)) != 0u) {
+        ++_receiver.request_buffer_ack_count_;
+    }
+
+    ++rmsgstub.packet_count_;
+
+    const size_t sz = _pbufend - _pbufpos;
+
+    memcpy(pdest, _pbufpos, sz);
+    rmsgstub.deserializer_ptr_->binaryDestinationFilled(sz);
+
+    direct_msgidx_ = message_idx;
+    direct_size_   = message_size - sz;
+    state_         = StateE::ReadPacketDirect;
+
+    solid_dbg(logger, Verbose, "msgidx = " << message_idx << " direct receive " << direct_size_ << " of " << message_size);
+    return true;
+}
+//-----------------------------------------------------------------------------
+char* MessageReader::directBuffer(size_t& _rsz) const
+{
+    char* pbuf = nullptr;
+    if (state_ == StateE::ReadPacketDirect) {
+        message_vec_[direct_msgidx_].deserializer_ptr_->binaryDestination(pbuf);
+        _rsz = direct_size_;
+    }
+    return pbuf;
+}
+//-----------------------------------------------------------------------------
+void MessageReader::directBufferFilled(const size_t _sz)
+{
+    solid_assert(state_ == StateE::ReadPacketDirect && _sz <= direct_size_);
+    message_vec_[direct_msgidx_].deserializer_ptr_->binaryDestinationFilled(_sz);
+    direct_size_ -= _sz;
+    if (direct_size_ == 0) {
+        state_ = StateE::ReadPacketHead;
+    }
+}
+//-----------------------------------------------------------------------------
 //TODO: change the CHECKs below to propper protocol errors.
 void MessageReader::doConsumePacket(
     const char*         _pbuf,
@@ -226,6 +329,7 @@ const char* MessageReader::doConsumeMessage(
         solid_dbg(logger, Verbose, "NotStarted msgidx = " << _msgidx);
         rmsgstub.deserializer_ptr_ = createDeserializer(_receiver);
         rmsgstub.state_            = MessageStub::StateE::ReadHeadStart;
+        rmsgstub.receive_time_     = ServiceStatistic::now();
     case MessageStub::StateE::ReadHeadStart:
     case MessageStub::StateE::ReadHeadContinue:
         solid_dbg(logger, Verbose, "ReadHead " << _msgidx);
@@ -313,6 +417,7 @@ const char* MessageReader::doConsumeMessage(
                                 if (rmsgstub.deserializer_ptr_->empty()) {
                                     //done parsing the message body
                                     MessagePointerT msgptr{std::move(rmsgstub.message_ptr_)};
+                                    _receiver.receive_time_ = rmsgstub.receive_time_;
                                     cache(rmsgstub.deserializer_ptr_);
                                     rmsgstub.clear();
                                     const size_t message_type_id = msgptr ? _receiver.protocol().typeIndex(msgptr.get()) : InvalidIndex();
@@ -13,6 +13,7 @@
 #include "solid/frame/mprpc/mprpcprotocol.hpp"
 #include "solid/system/common.hpp"
 #include "solid/system/error.hpp"
+#include <chrono>
 #include <deque>
 
 namespace solid {
@@ -25,11 +26,14 @@ struct PacketHeader;
 
 class MessageReader {
 public:
+    using TimePointT = std::chrono::steady_clock::time_point;
+
     struct Receiver {
         uint8_t                    request_buffer_ack_count_;
         ReaderConfiguration const& rconfig_;
         Protocol const&            rproto_;
         ConnectionContext&         rconctx_;
+        TimePointT                 receive_time_; //when the first packet of the message given to receiveMessage was read
 
         Receiver(
             ReaderConfiguration const& _rconfig,
@@ -74,7 +78,22 @@ public:
     void prepare(ReaderConfiguration const& _rconfig);
     void unprepare();
 
+    //! Memory where the next _rsz bytes from the wire should be received, or nullptr
+    /*!
+     * Not null while the rest of the current packet goes directly into a
+     * binary field of a message - the connection should receive into it and
+     * call directBufferFilled instead of read.
+     */
+    char* directBuffer(size_t& _rsz) const;
+    void  directBufferFilled(const size_t _sz);
+
 private:
+    bool doTryReadDirect(
+        const char*         _pbufpos,
+        const char* const   _pbufend,
+        PacketHeader const& _packet_header,
+        Receiver&           _receiver);
+
     void doConsumePacket(
         const char*         _pbuf,
         PacketHeader const& _packet_header,
@@ -96,6 +115,7 @@ private:
     enum struct StateE {
         ReadPacketHead = 1,
         ReadPacketBody,
+        ReadPacketDirect,
     };
 
     struct MessageStub {
@@ -118,6 +138,7 @@ private:
         size_t                 packet_count_;
         MessageId              relay_id;
         StateE                 state_;
+        TimePointT             receive_time_;
 
         MessageStub()
             : packet_count_(0)
@@ -140,6 +161,8 @@ private:
     uint64_t               current_message_type_id_;
     StateE                 state_;
     Deserializer::PointerT des_top_;
+    uint32_t               direct_msgidx_;
+    size_t                 direct_size_;
 };
 
 } //namespace mprpc
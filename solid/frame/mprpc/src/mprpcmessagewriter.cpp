@@ -26,9 +26,13 @@ const LoggerT logger("solid::frame::mprpc::writer");
 MessageWriter::MessageWriter()
     : current_message_type_id_(InvalidIndex())
     , write_queue_sync_index_(InvalidIndex())
+    , write_queue_bulk_index_(InvalidIndex())
     , write_queue_back_index_(InvalidIndex())
     , write_queue_async_count_(0)
     , write_queue_direct_count_(0)
+    , write_queue_priority_count_()
+    , write_queue_priority_async_count_()
+    , write_queue_bytes_(0)
     , order_inner_list_(message_vec_)
     , write_inner_list_(message_vec_)
     , cache_inner_list_(message_vec_)
@@ -77,6 +81,11 @@ void MessageWriter::doWriteQueuePushBack(const size_t _msgidx, const int _line)
     }
     if (!rmsgstub.isSynchronous()) {
         ++write_queue_async_count_;
+        ++write_queue_priority_async_count_[static_cast<size_t>(rmsgstub.priority())];
+    }
+    ++write_queue_priority_count_[static_cast<size_t>(rmsgstub.priority())];
+    if (_msgidx != write_queue_bulk_index_) {
+        write_queue_bytes_ += rmsgstub.msgbundle_.message_size;
     }
 }
 //-----------------------------------------------------------------------------
@@ -89,6 +98,13 @@ void MessageWriter::doWriteQueueErase(const size_t _msgidx, const int _line)
     }
     if (!rmsgstub.isSynchronous()) {
         --write_queue_async_count_;
+        --write_queue_priority_async_count_[static_cast<size_t>(rmsgstub.priority())];
+    }
+    --write_queue_priority_count_[static_cast<size_t>(rmsgstub.priority())];
+    if (_msgidx == write_queue_bulk_index_) {
+        write_queue_bulk_index_ = InvalidIndex();
+    } else {
+        write_queue_bytes_ -= rmsgstub.msgbundle_.message_size;
     }
 
     if (_msgidx == write_queue_sync_index_) {
@@ -115,6 +131,19 @@ bool MessageWriter::enqueue(
         return false;
     }
 
+    //see if the message fits the byte budget - a message larger than the whole budget
+    //is multiplexed alone, beside the messages within the budget, so it cannot starve them
+    const bool is_bulk = _rconfig.max_message_bytes_multiplex != 0 && _rmsgbundle.message_size > _rconfig.max_message_bytes_multiplex;
+
+    if (is_bulk) {
+        if (write_queue_bulk_index_ != InvalidIndex()) {
+            return false;
+        }
+    } else if (
+        _rconfig.max_message_bytes_multiplex != 0 && (write_queue_bytes_ + _rmsgbundle.message_size) > _rconfig.max_message_bytes_multiplex) {
+        return false;
+    }
+
     //see if we have too many messages waiting for responses
     if (
         Message::is_awaiting_response(_rmsgbundle.message_flags) && ((order_inner_list_.size() - write_inner_list_.size()) >= _rconfig.max_message_count_response_wait)) {
@@ -135,6 +164,10 @@ bool MessageWriter::enqueue(
 
     _rconn_msg_id = MessageId(idx, rmsgstub.unique_);
 
+    if (is_bulk) {
+        write_queue_bulk_index_ = idx;
+    }
+
     order_inner_list_.pushBack(idx);
     doWriteQueuePushBack(idx, __LINE__);
     solid_dbg(logger, Verbose, "is_relayed = " << Message::is_relayed(rmsgstub.msgbundle_.message_ptr->flags()) << ' ' << MessageWriterPrintPairT(*this, PrintInnerListsE));
@@ -467,11 +500,20 @@ ErrorConditionT MessageWriter::write(
     return error;
 }
 //-----------------------------------------------------------------------------
+MessagePriorityE MessageWriter::doWriteQueueTopPriority() const
+{
+    size_t i = 0;
+    for (; i < (static_cast<size_t>(MessagePriorityE::Count) - 1) && write_queue_priority_count_[i] == 0; ++i) {
+    }
+    return static_cast<MessagePriorityE>(i);
+}
+//-----------------------------------------------------------------------------
 //NOTE:
 // Objectives for doFindEligibleMessage:
 // - be fast
 // - try to fill up the package
 // - be fair with all messages
+// - be fair within a priority class but let the more urgent classes go first
 bool MessageWriter::doFindEligibleMessage(Sender& _rsender, const bool _can_send_relay, const size_t /*_size*/)
 {
     solid_dbg(logger, Verbose, "wq_back_index_ = " << write_queue_back_index_ << " wq_sync_index_ = " << write_queue_sync_index_ << " wq_async_count_ = " << write_queue_async_count_ << " wq_direct_count_ = " << write_queue_direct_count_ << " wq.size = " << write_inner_list_.size() << " _can_send_relay = " << _can_send_relay);
@@ -479,6 +521,24 @@ bool MessageWriter::doFindEligibleMessage(Sender& _rsender, const bool _can_send
     if (!_can_send_relay && write_queue_direct_count_ == 0) {
         return false;
     }
+
+    const MessagePriorityE top_priority = doWriteQueueTopPriority();
+
+    if (top_priority != MessagePriorityE::Bulk && write_queue_priority_count_[static_cast<size_t>(top_priority)] != write_inner_list_.size()) {
+        //less urgent messages are queued too - first look only
+        //for the most urgent ones, passing only their async count so
+        //that a synchronous urgent message does not count as one.
+        if (doFindEligibleMessage(_rsender, _can_send_relay, top_priority, write_queue_priority_async_count_[static_cast<size_t>(top_priority)])) {
+            return true;
+        }
+        //no urgent message can be sent right now (e.g. relay buffers are full)
+        //fallback to the rest of the messages.
+    }
+    return doFindEligibleMessage(_rsender, _can_send_relay, MessagePriorityE::Bulk, write_queue_async_count_);
+}
+//-----------------------------------------------------------------------------
+bool MessageWriter::doFindEligibleMessage(Sender& _rsender, const bool _can_send_relay, const MessagePriorityE _max_priority, const size_t _async_count)
+{
     size_t qsz             = write_inner_list_.size();
     size_t async_postponed = 0;
     while (qsz != 0u) {
@@ -492,6 +552,11 @@ bool MessageWriter::doFindEligibleMessage(Sender& _rsender, const bool _can_send
             return true; //prevent splitting the header
         }
 
+        if (rmsgstub.priority() > _max_priority) {
+            write_inner_list_.pushBack(write_inner_list_.popFront());
+            continue;
+        }
+
         if (rmsgstub.isSynchronous()) {
             if (write_queue_sync_index_ == InvalidIndex()) {
                 write_queue_sync_index_ = msgidx;
@@ -515,9 +580,9 @@ bool MessageWriter::doFindEligibleMessage(Sender& _rsender, const bool _can_send
 
         } else {
             rmsgstub.packet_count_ = 0;
-            if (rmsgstub.isSynchronous() && write_queue_async_count_ == 0) {
+            if (rmsgstub.isSynchronous() && _async_count == 0) {
                 //no async message in queue - continue with the current synchronous message
-            } else if (write_queue_async_count_ > (async_postponed + 1)) { //we do not want to postpone all async messages
+            } else if (_async_count > (async_postponed + 1)) { //we do not want to postpone all async messages
                 write_inner_list_.pushBack(write_inner_list_.popFront());
                 ++async_postponed;
                 continue;
@@ -527,7 +592,7 @@ bool MessageWriter::doFindEligibleMessage(Sender& _rsender, const bool _can_send
         return true;
     }
 
-    solid_dbg(logger, Info, this << " NO eligible message in a queue of " << write_inner_list_.size() << " wq_back_index_ = " << write_queue_back_index_ << " wq_sync_index_ = " << write_queue_sync_index_ << " wq_async_count_ = " << write_queue_async_count_ << " wq_direct_count_ = " << write_queue_direct_count_ << " wq.size = " << write_inner_list_.size() << " _can_send_relay = " << _can_send_relay);
+    solid_dbg(logger, Info, this << " NO eligible message in a queue of " << write_inner_list_.size() << " wq_back_index_ = " << write_queue_back_index_ << " wq_sync_index_ = " << write_queue_sync_index_ << " wq_async_count_ = " << write_queue_async_count_ << " wq_direct_count_ = " << write_queue_direct_count_ << " wq.size = " << write_inner_list_.size() << " _can_send_relay = " << _can_send_relay << " _max_priority = " << static_cast<int>(_max_priority));
     return false;
 }
 //-----------------------------------------------------------------------------
@@ -583,6 +648,8 @@ size_t MessageWriter::doWritePacketData(
 
             rmsgstub.msgbundle_.message_flags.set(MessageFlagsE::StartedSend);
 
+            _rsender.startMessage(rmsgstub.msgbundle_);
+
             rmsgstub.state_ = MessageStub::StateE::WriteHeadStart;
 
             solid_dbg(logger, Info, this << " message header url: " << rmsgstub.msgbundle_.message_url << " isRelay = " << rmsgstub.isRelay());
@@ -970,6 +1037,8 @@ void MessageWriter::doTryCompleteMessageAfterSerialization(
     rmsgstub.serializer_ptr_ = nullptr;
     rmsgstub.state_          = MessageStub::StateE::WriteStart;
 
+    _rsender.sentMessage(rmsgstub.msgbundle_);
+
     solid_dbg(logger, Verbose, MessageWriterPrintPairT(*this, PrintInnerListsE));
 
     if (!Message::is_awaiting_response(rmsgstub.msgbundle_.message_flags)) {
@@ -1094,6 +1163,13 @@ Serializer::PointerT MessageWriter::createSerializer(Sender& _sender)
 {
 }
 //-----------------------------------------------------------------------------
+/*virtual*/ void MessageWriter::Sender::startMessage(MessageBundle& /*_rmsgbundle*/)
+{
+}
+/*virtual*/ void MessageWriter::Sender::sentMessage(MessageBundle& /*_rmsgbundle*/)
+{
+}
+//-----------------------------------------------------------------------------
 
 std::ostream& operator<<(std::ostream& _ros, std::pair<MessageWriter const&, MessageWriter::PrintWhat> const& _msgwriterpair)
 {
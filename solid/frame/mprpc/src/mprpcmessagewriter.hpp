@@ -79,6 +79,8 @@ public:
         virtual void            completeRelayed(RelayData* _relay_data, MessageId const& _rmsgid);
         virtual bool            cancelMessage(MessageBundle& /*_rmsgbundle*/, MessageId const& /*_rmsgid*/);
         virtual void            cancelRelayed(RelayData* _relay_data, MessageId const& _rmsgid);
+        virtual void            startMessage(MessageBundle& /*_rmsgbundle*/);
+        virtual void            sentMessage(MessageBundle& /*_rmsgbundle*/);
     };
 
     using VisitFunctionT = solid_function_t(void(
@@ -268,6 +270,11 @@ private:
         {
             return Message::is_synchronous(msgbundle_.message_flags);
         }
+
+        MessagePriorityE priority() const noexcept
+        {
+            return Message::priority(msgbundle_.message_flags);
+        }
     };
 
     using MessageVectorT          = std::vector<MessageStub>;
@@ -302,6 +309,9 @@ private:
     bool isDelayedCloseInPendingQueue() const;
 
     bool doFindEligibleMessage(Sender& _rsender, const bool _can_send_relay, const size_t _size);
+    bool doFindEligibleMessage(Sender& _rsender, const bool _can_send_relay, const MessagePriorityE _max_priority, const size_t _async_count);
+
+    MessagePriorityE doWriteQueueTopPriority() const;
 
     void doTryMoveMessageFromPendingToWriteQueue(mprpc::Configuration const& _rconfig);
 
@@ -376,9 +386,13 @@ private:
     MessageVectorT          message_vec_;
     uint32_t                current_message_type_id_;
     size_t                  write_queue_sync_index_;
+    size_t                  write_queue_bulk_index_; //the message larger than WriterConfiguration::max_message_bytes_multiplex
     size_t                  write_queue_back_index_;
     size_t                  write_queue_async_count_;
     size_t                  write_queue_direct_count_;
+    size_t                  write_queue_priority_count_[static_cast<size_t>(MessagePriorityE::Count)];
+    size_t                  write_queue_priority_async_count_[static_cast<size_t>(MessagePriorityE::Count)];
+    size_t                  write_queue_bytes_; //sum of message_size for the messages in write_inner_list_ but the bulk one
     MessageOrderInnerListT  order_inner_list_;
     MessageStatusInnerListT write_inner_list_;
     MessageStatusInnerListT cache_inner_list_;
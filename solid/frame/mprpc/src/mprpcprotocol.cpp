@@ -17,6 +17,16 @@ namespace mprpc {
 //-----------------------------------------------------------------------------
 /*virtual*/ Deserializer::~Deserializer() {}
 //-----------------------------------------------------------------------------
+/*virtual*/ size_t Deserializer::binaryDestination(char*& /*_rpbuf*/) const
+{
+    return 0;
+}
+//-----------------------------------------------------------------------------
+/*virtual*/ void Deserializer::binaryDestinationFilled(const size_t /*_sz*/)
+{
+    solid_assert(false);
+}
+//-----------------------------------------------------------------------------
 /*virtual*/ Serializer::~Serializer() {}
 //-----------------------------------------------------------------------------
 /*virtual*/ Protocol::~Protocol() {}
@@ -27,6 +27,7 @@
 #include "solid/frame/common.hpp"
 #include "solid/frame/manager.hpp"
 
+#include "solid/frame/aio/aiodnsresolver.hpp"
 #include "solid/frame/aio/aioresolver.hpp"
 
 #include "solid/frame/mprpc/mprpcconfiguration.hpp"
@@ -59,6 +60,7 @@ enum class PoolEvents {
     ConnectionStop,
     PoolDisconnect,
     PoolStop,
+    PoolCredit,
 };
 
 const EventCategory<PoolEvents> pool_event_category{
@@ -75,6 +77,8 @@ const EventCategory<PoolEvents> pool_event_category{
             return "PoolDisconnect";
         case PoolEvents::PoolStop:
             return "PoolStop";
+        case PoolEvents::PoolCredit:
+            return "PoolCredit";
         default:
             return "unknown";
         }
@@ -89,6 +93,7 @@ using ActorIdQueueT = Queue<ActorIdT>;
 /*extern*/ const Event pool_event_connection_stop     = pool_event_category.event(PoolEvents::ConnectionStop);
 /*extern*/ const Event pool_event_pool_disconnect     = pool_event_category.event(PoolEvents::PoolDisconnect);
 /*extern*/ const Event pool_event_pool_stop           = pool_event_category.event(PoolEvents::PoolStop);
+/*extern*/ const Event pool_event_pool_credit         = pool_event_category.event(PoolEvents::PoolCredit);
 
 enum {
     InnerLinkOrder = 0,
@@ -113,6 +118,7 @@ struct MessageStub : inner::Node<InnerLinkCount> {
         : msgbundle(_rmsgptr, _msg_type_idx, _msgflags, _rcomplete_fnc, _rmsg_url)
         , unique(0)
         , flags(0)
+        , size(0)
     {
     }
 
@@ -124,12 +130,14 @@ struct MessageStub : inner::Node<InnerLinkCount> {
         , actid(_rmsg.actid)
         , unique(_rmsg.unique)
         , flags(_rmsg.flags)
+        , size(_rmsg.size)
     {
     }
 
     MessageStub()
         : unique(0)
         , flags(0)
+        , size(0)
     {
     }
 
@@ -150,6 +158,7 @@ struct MessageStub : inner::Node<InnerLinkCount> {
         actid = ActorIdT();
         ++unique;
         flags = 0;
+        size  = 0;
     }
 
     MessageBundle msgbundle;
@@ -157,6 +166,7 @@ struct MessageStub : inner::Node<InnerLinkCount> {
     ActorIdT      actid;
     uint32_t      unique;
     uint          flags;
+    size_t        size; //kept here because msgbundle is moved to the connection
 };
 
 //-----------------------------------------------------------------------------
@@ -204,6 +214,7 @@ struct ConnectionPoolStub {
         RestartFlag                = 32,
         MainConnectionActiveFlag   = 64,
         DisconnectedFlag           = 128,
+        BackpressureFlag           = 256,
     };
 
     uint32_t               unique;
@@ -218,7 +229,8 @@ struct ConnectionPoolStub {
     MessageCacheInnerListT msgcache_inner_list;
     MessageAsyncInnerListT msgasync_inner_list;
     ActorIdQueueT          conn_waitingq;
-    uint8_t                flags;
+    size_t                 msgorder_bytes; //sum of MessageStub::size for the messages in msgorder_inner_list
+    uint16_t               flags;
     uint8_t                retry_connect_count;
     AddressVectorT         connect_addr_vec;
     PoolOnEventFunctionT   on_event_fnc;
@@ -232,6 +244,7 @@ struct ConnectionPoolStub {
         , msgorder_inner_list(msgvec)
         , msgcache_inner_list(msgvec)
         , msgasync_inner_list(msgvec)
+        , msgorder_bytes(0)
         , flags(0)
         , retry_connect_count(0)
     {
@@ -251,6 +264,7 @@ struct ConnectionPoolStub {
         , msgcache_inner_list(msgvec, _rpool.msgcache_inner_list)
         , msgasync_inner_list(msgvec, _rpool.msgasync_inner_list)
         , conn_waitingq(std::move(_rpool.conn_waitingq))
+        , msgorder_bytes(_rpool.msgorder_bytes)
         , flags(_rpool.flags)
         , retry_connect_count(_rpool.retry_connect_count)
         , connect_addr_vec(std::move(_rpool.connect_addr_vec))
@@ -281,6 +295,7 @@ struct ConnectionPoolStub {
         msgasync_inner_list.clear();
         msgvec.clear();
         msgvec.shrink_to_fit();
+        msgorder_bytes      = 0;
         flags               = 0;
         retry_connect_count = 0;
         connect_addr_vec.clear();
@@ -293,7 +308,8 @@ struct ConnectionPoolStub {
         const size_t              _msg_type_idx,
         MessageCompleteFunctionT& _rcomplete_fnc,
         const MessageFlagsT&      _flags,
-        std::string&              _msg_url)
+        std::string&              _msg_url,
+        const size_t              _msg_size)
     {
         size_t idx;
 
@@ -307,28 +323,56 @@ struct ConnectionPoolStub {
 
         MessageStub& rmsgstub(msgvec[idx]);
 
-        rmsgstub.msgbundle = MessageBundle(_rmsgptr, _msg_type_idx, _flags, _rcomplete_fnc, _msg_url);
+        rmsgstub.msgbundle              = MessageBundle(_rmsgptr, _msg_type_idx, _flags, _rcomplete_fnc, _msg_url);
+        rmsgstub.msgbundle.message_size = _msg_size;
+        rmsgstub.size                   = _msg_size;
 
         //solid_assert(rmsgstub.msgbundle.message_ptr.get());
 
         return MessageId(idx, rmsgstub.unique);
     }
 
+    //A new message overtakes the queued messages of less urgent priority
+    //classes (see MessagePriorityE) but never a message of the same or
+    //a more urgent class. Pool close stubs (stubs without message) neither
+    //overtake nor are overtaken.
+    //Only Control messages or Interactive messages queued behind Bulk ones
+    //need to walk the list.
+    template <class List>
+    void pushBackByPriority(List& _rlist, const size_t _msg_idx, const MessageFlagsT& _flags)
+    {
+        const MessagePriorityE priority = msgvec[_msg_idx].msgbundle.message_ptr ? Message::priority(_flags) : MessagePriorityE::Bulk;
+        size_t                 pos      = _rlist.empty() ? InvalidIndex() : _rlist.backIndex();
+
+        while (pos != InvalidIndex() && msgvec[pos].msgbundle.message_ptr && Message::priority(msgvec[pos].msgbundle.message_flags) > priority) {
+            pos = _rlist.previousIndex(pos);
+        }
+
+        if (pos == InvalidIndex()) {
+            _rlist.pushFront(_msg_idx);
+        } else {
+            _rlist.insertAfter(pos, _msg_idx);
+        }
+    }
+
     MessageId pushBackMessage(
         MessagePointerT&          _rmsgptr,
         const size_t              _msg_type_idx,
         MessageCompleteFunctionT& _rcomplete_fnc,
         const MessageFlagsT&      _flags,
-        std::string&              _msg_url)
+        std::string&              _msg_url,
+        const size_t              _msg_size)
     {
-        const MessageId msgid = insertMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url);
+        const MessageId msgid = insertMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url, _msg_size);
 
-        msgorder_inner_list.pushBack(msgid.index);
+        msgorder_bytes += _msg_size;
+
+        pushBackByPriority(msgorder_inner_list, msgid.index, _flags);
 
         solid_dbg(logger, Info, "msgorder_inner_list " << msgorder_inner_list);
 
         if (Message::is_asynchronous(_flags)) {
-            msgasync_inner_list.pushBack(msgid.index);
+            pushBackByPriority(msgasync_inner_list, msgid.index, _flags);
             solid_dbg(logger, Info, "msgasync_inner_list " << msgasync_inner_list);
         }
 
@@ -342,9 +386,12 @@ struct ConnectionPoolStub {
         const size_t              _msg_type_idx,
         MessageCompleteFunctionT& _rcomplete_fnc,
         const MessageFlagsT&      _flags,
-        std::string&              _msg_url)
+        std::string&              _msg_url,
+        const size_t              _msg_size)
     {
-        const MessageId msgid = insertMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url);
+        const MessageId msgid = insertMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url, _msg_size);
+
+        msgorder_bytes += _msg_size;
 
         msgorder_inner_list.pushFront(msgid.index);
 
@@ -366,14 +413,18 @@ struct ConnectionPoolStub {
         const size_t              _msg_type_idx,
         MessageCompleteFunctionT& _rcomplete_fnc,
         const MessageFlagsT&      _flags,
-        std::string&              _msg_url)
+        std::string&              _msg_url,
+        const size_t              _msg_size)
     {
         MessageStub& rmsgstub(msgvec[_rmsgid.index]);
 
         solid_assert(!rmsgstub.msgbundle.message_ptr && rmsgstub.unique == _rmsgid.unique);
 
-        rmsgstub.msgbundle = MessageBundle(_rmsgptr, _msg_type_idx, _flags, _rcomplete_fnc, _msg_url);
+        rmsgstub.msgbundle              = MessageBundle(_rmsgptr, _msg_type_idx, _flags, _rcomplete_fnc, _msg_url);
+        rmsgstub.msgbundle.message_size = _msg_size;
+        rmsgstub.size                   = _msg_size;
 
+        msgorder_bytes += _msg_size;
         msgorder_inner_list.pushFront(_rmsgid.index);
 
         solid_dbg(logger, Info, "msgorder_inner_list " << msgorder_inner_list);
@@ -397,6 +448,7 @@ struct ConnectionPoolStub {
     void cacheFrontMessage()
     {
         solid_dbg(logger, Info, "msgorder_inner_list " << msgorder_inner_list);
+        msgorder_bytes -= msgorder_inner_list.front().size;
         msgcache_inner_list.pushBack(msgorder_inner_list.popFront());
 
         solid_assert(msgorder_inner_list.check());
@@ -405,6 +457,7 @@ struct ConnectionPoolStub {
     void popFrontMessage()
     {
         solid_dbg(logger, Info, "msgorder_inner_list " << msgorder_inner_list);
+        msgorder_bytes -= msgorder_inner_list.front().size;
         msgorder_inner_list.popFront();
 
         solid_assert(msgorder_inner_list.check());
@@ -413,6 +466,7 @@ struct ConnectionPoolStub {
     void eraseMessageOrder(const size_t _msg_idx)
     {
         solid_dbg(logger, Info, "msgorder_inner_list " << msgorder_inner_list);
+        msgorder_bytes -= msgvec[_msg_idx].size;
         msgorder_inner_list.erase(_msg_idx);
         solid_assert(msgorder_inner_list.check());
     }
@@ -420,6 +474,7 @@ struct ConnectionPoolStub {
     void eraseMessageOrderAsync(const size_t _msg_idx)
     {
         solid_dbg(logger, Info, "msgorder_inner_list " << msgorder_inner_list);
+        msgorder_bytes -= msgvec[_msg_idx].size;
         msgorder_inner_list.erase(_msg_idx);
         const MessageStub& rmsgstub(msgvec[_msg_idx]);
         if (Message::is_asynchronous(rmsgstub.msgbundle.message_flags)) {
@@ -434,6 +489,7 @@ struct ConnectionPoolStub {
         solid_dbg(logger, Info, "msgorder_inner_list " << msgorder_inner_list);
         MessageStub& rmsgstub(msgvec[_msg_idx]);
 
+        msgorder_bytes -= rmsgstub.size;
         msgorder_inner_list.erase(_msg_idx);
 
         if (Message::is_asynchronous(rmsgstub.msgbundle.message_flags)) {
@@ -586,6 +642,35 @@ struct ConnectionPoolStub {
         return msgcache_inner_list.empty() && msgvec.size() >= _max_message_queue_size;
     }
 
+    //An empty queue always accepts a message so that a message larger than
+    //the budget can still be sent.
+    bool isFullBytes(const size_t _max_message_queue_bytes, const size_t _msg_size) const
+    {
+        return _max_message_queue_bytes != 0 && msgorder_bytes != 0 && (msgorder_bytes + _msg_size) > _max_message_queue_bytes;
+    }
+
+    //Credit is given back when the queue drains under half of the byte budget
+    //to avoid notifying the user for every sent message.
+    bool hasCredit(const size_t _max_message_queue_size, const size_t _max_message_queue_bytes) const
+    {
+        return !isFull(_max_message_queue_size) && (_max_message_queue_bytes == 0 || msgorder_bytes <= (_max_message_queue_bytes / 2));
+    }
+
+    bool isBackpressure() const
+    {
+        return (flags & BackpressureFlag) != 0u;
+    }
+
+    void setBackpressure()
+    {
+        flags |= BackpressureFlag;
+    }
+
+    void resetBackpressure()
+    {
+        flags &= ~BackpressureFlag;
+    }
+
     bool shouldClose() const
     {
         return isClosing() && hasNoMessage();
@@ -655,8 +740,137 @@ struct Service::Data {
     SizeStackT           conpoolcachestk;
     Configuration        config;
     std::string          tmp_str;
+    ServiceStatistic     statistic;
 };
 //=============================================================================
+//  ServiceStatistic
+//=============================================================================
+namespace {
+Histogram* latency_array(std::atomic<Histogram*>& _rptr)
+{
+    Histogram* parr = _rptr.load(std::memory_order_acquire);
+    if (parr == nullptr) {
+        Histogram* pnew_arr = new Histogram[ServiceStatistic::latency_stage_count];
+        if (_rptr.compare_exchange_strong(parr, pnew_arr, std::memory_order_acq_rel)) {
+            parr = pnew_arr;
+        } else {
+            delete[] pnew_arr;
+        }
+    }
+    return parr;
+}
+
+const char* latency_stage_name(const size_t _idx)
+{
+    static const char* names[ServiceStatistic::latency_stage_count] = {"send_to_pool", "pool_to_writer", "writer_to_sent", "sent_to_response", "receive_to_complete"};
+    return names[_idx];
+}
+} //namespace
+
+ServiceStatistic::ServiceStatistic()
+    : direct_receive_bytes_(0)
+    , latency_per_message_type_(false)
+{
+    for (size_t i = 0; i < priority_count; ++i) {
+        queue_count_[i]         = 0;
+        queue_time_total_us_[i] = 0;
+        queue_time_max_us_[i]   = 0;
+    }
+    for (auto& rptr : latency_) {
+        rptr = nullptr;
+    }
+    for (auto& rptr : message_type_latency_) {
+        rptr = nullptr;
+    }
+}
+//-----------------------------------------------------------------------------
+ServiceStatistic::~ServiceStatistic()
+{
+    for (auto& rptr : latency_) {
+        delete[] rptr.load();
+    }
+    for (auto& rptr : message_type_latency_) {
+        delete[] rptr.load();
+    }
+}
+//-----------------------------------------------------------------------------
+void ServiceStatistic::queueTime(const MessagePriorityE _priority, const uint64_t _us)
+{
+    solid_statistic_inc(queue_count_[static_cast<size_t>(_priority)]);
+    solid_statistic_add(queue_time_total_us_[static_cast<size_t>(_priority)], _us);
+    solid_statistic_max(queue_time_max_us_[static_cast<size_t>(_priority)], _us);
+}
+//-----------------------------------------------------------------------------
+uint64_t ServiceStatistic::queueTimeAverage(const MessagePriorityE _priority) const
+{
+    const size_t   idx   = static_cast<size_t>(_priority);
+    const uint64_t count = queue_count_[idx];
+    return count != 0 ? queue_time_total_us_[idx] / count : 0;
+}
+//-----------------------------------------------------------------------------
+void ServiceStatistic::doRecordLatency(const LatencyStageE _stage, const size_t _shard, const size_t _msg_type_id, TimePointT const& _from, TimePointT const& _to)
+{
+    const size_t   stage_idx = static_cast<size_t>(_stage);
+    const uint64_t ns        = _to > _from ? std::chrono::duration_cast<std::chrono::nanoseconds>(_to - _from).count() : 0;
+
+    solid_assert(_shard < latency_shard_count);
+    latency_array(latency_[_shard])[stage_idx].record(ns);
+
+    if (latency_per_message_type_.load(std::memory_order_relaxed) && _msg_type_id < latency_message_type_capacity) {
+        latency_array(message_type_latency_[_msg_type_id])[stage_idx].record(ns);
+    }
+}
+//-----------------------------------------------------------------------------
+void ServiceStatistic::latency(const LatencyStageE _stage, Histogram& _rh) const
+{
+    const size_t stage_idx = static_cast<size_t>(_stage);
+    for (size_t i = 0; i < latency_shard_count; ++i) {
+        const Histogram* parr = latency_[i].load(std::memory_order_acquire);
+        if (parr != nullptr) {
+            _rh.merge(parr[stage_idx]);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+bool ServiceStatistic::latency(const LatencyStageE _stage, const size_t _msg_type_id, Histogram& _rh) const
+{
+    if (_msg_type_id < latency_message_type_capacity) {
+        const Histogram* parr = message_type_latency_[_msg_type_id].load(std::memory_order_acquire);
+        if (parr != nullptr) {
+            _rh.merge(parr[static_cast<size_t>(_stage)]);
+            return true;
+        }
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+std::ostream& ServiceStatistic::print(std::ostream& _ros) const
+{
+    static const char* names[priority_count] = {"control", "interactive", "bulk"};
+    for (size_t i = 0; i < priority_count; ++i) {
+        const MessagePriorityE priority = static_cast<MessagePriorityE>(i);
+        _ros << ' ' << names[i] << ": count = " << queueCount(priority);
+        _ros << " avg_queue_us = " << queueTimeAverage(priority);
+        _ros << " max_queue_us = " << queueTimeMaximum(priority);
+    }
+    _ros << " direct_receive_bytes = " << directReceiveBytes();
+    for (size_t i = 0; i < latency_stage_count; ++i) {
+        Histogram h;
+        latency(static_cast<LatencyStageE>(i), h);
+        _ros << ' ' << latency_stage_name(i) << "_ns: " << h;
+    }
+    for (size_t t = 0; t < latency_message_type_capacity; ++t) {
+        const Histogram* parr = message_type_latency_[t].load(std::memory_order_acquire);
+        if (parr != nullptr) {
+            _ros << " type " << t << ':';
+            for (size_t i = 0; i < latency_stage_count; ++i) {
+                _ros << ' ' << latency_stage_name(i) << "_ns: " << parr[i];
+            }
+        }
+    }
+    return _ros;
+}
+//=============================================================================
 
 Service::Service(
     UseServiceShell _force_shell)
@@ -676,6 +890,16 @@ Configuration const& Service::configuration() const
     return impl_->config;
 }
 //-----------------------------------------------------------------------------
+ServiceStatistic const& Service::statistic() const
+{
+    return impl_->statistic;
+}
+//-----------------------------------------------------------------------------
+ServiceStatistic& Service::wstatistic()
+{
+    return impl_->statistic;
+}
+//-----------------------------------------------------------------------------
 void Service::doStart(Configuration&& _ucfg)
 {
     Configuration cfg;
@@ -725,6 +949,8 @@ void Service::doFinalizeStart(Configuration&& _ucfg, SocketDevice&& _usd)
         impl_->config.reset(std::move(_ucfg));
     }
 
+    impl_->statistic.latencyPerMessageType(configuration().latency_per_message_type);
+
     if (configuration().pools_mutex_count > impl_->mtxsarrcp) {
         delete[] impl_->pmtxarr;
         impl_->pmtxarr   = new std::mutex[configuration().pools_mutex_count];
@@ -738,6 +964,7 @@ void Service::doFinalizeStart()
     SocketDevice           sd;
 
     impl_->config.prepare(sd);
+    impl_->statistic.latencyPerMessageType(configuration().latency_per_message_type);
 
     if (sd) {
         SocketAddress local_address;
@@ -865,6 +1092,7 @@ ErrorConditionT Service::doSendMessage(
 
     solid_dbg(logger, Verbose, this);
 
+    const auto             send_time = ServiceStatistic::now();
     solid::ErrorConditionT error;
     size_t                 pool_index;
     uint32_t               unique    = -1;
@@ -909,7 +1137,8 @@ ErrorConditionT Service::doSendMessage(
             _rcomplete_fnc,
             _pmsgid_out,
             _flags,
-            message_url);
+            message_url,
+            send_time);
     }
 
     if (recipient_name != nullptr) {
@@ -926,7 +1155,7 @@ ErrorConditionT Service::doSendMessage(
 
             return this->doSendMessageToNewPool(
                 recipient_name, _rmsgptr, msg_type_idx,
-                _rcomplete_fnc, _precipient_id_out, _pmsgid_out, _flags, message_url);
+                _rcomplete_fnc, _precipient_id_out, _pmsgid_out, _flags, message_url, send_time);
         }
     } else if (
         static_cast<size_t>(_rrecipient_id_in.poolid.index) < impl_->pooldq.size()) {
@@ -956,8 +1185,12 @@ ErrorConditionT Service::doSendMessage(
         return error;
     }
 
-    if (rpool.isFull(configuration().pool_max_message_queue_size)) {
-        solid_dbg(logger, Error, this << " connection pool is full");
+    const size_t msg_size = configuration().message_size_fnc(*_rmsgptr);
+
+    if (rpool.isFull(configuration().pool_max_message_queue_size) || rpool.isFullBytes(configuration().pool_max_message_queue_bytes, msg_size)) {
+        solid_dbg(logger, Error, this << " connection pool is full: bytes = " << rpool.msgorder_bytes << " message size = " << msg_size);
+        //pool_event_pool_credit will be sent to pool's on_event_fnc when there is room again
+        rpool.setBackpressure();
         error = error_service_pool_full;
         return error;
     }
@@ -968,7 +1201,9 @@ ErrorConditionT Service::doSendMessage(
 
     //At this point we can fetch the message from user's pointer
     //because from now on we can call complete on the message
-    const MessageId msgid = rpool.pushBackMessage(_rmsgptr, msg_type_idx, _rcomplete_fnc, _flags, message_url);
+    const MessageId msgid = rpool.pushBackMessage(_rmsgptr, msg_type_idx, _rcomplete_fnc, _flags, message_url, msg_size);
+
+    impl_->statistic.latency(LatencyStageE::SendToPool, 0, msg_type_idx, send_time, rpool.msgvec[msgid.index].msgbundle.enqueue_time);
 
     if (_pmsgid_out != nullptr) {
 
@@ -1028,13 +1263,14 @@ ErrorConditionT Service::doSendMessage(
 //-----------------------------------------------------------------------------
 
 ErrorConditionT Service::doSendMessageToConnection(
-    const RecipientId&        _rrecipient_id_in,
-    MessagePointerT&          _rmsgptr,
-    const size_t              _msg_type_idx,
-    MessageCompleteFunctionT& _rcomplete_fnc,
-    MessageId*                _pmsgid_out,
-    MessageFlagsT             _flags,
-    std::string&              _msg_url)
+    const RecipientId&                  _rrecipient_id_in,
+    MessagePointerT&                    _rmsgptr,
+    const size_t                        _msg_type_idx,
+    MessageCompleteFunctionT&           _rcomplete_fnc,
+    MessageId*                          _pmsgid_out,
+    MessageFlagsT                       _flags,
+    std::string&                        _msg_url,
+    ServiceStatistic::TimePointT const& _rsend_time)
 {
     //d.mtx must be locked
 
@@ -1062,6 +1298,8 @@ ErrorConditionT Service::doSendMessageToConnection(
     solid::ErrorConditionT error;
     const bool             is_server_side_pool = rpool.isServerSide(); //unnamed pool has a single connection
 
+    const size_t           msg_size            = configuration().message_size_fnc(*_rmsgptr);
+
     MessageId msgid;
 
     bool success = false;
@@ -1069,18 +1307,20 @@ ErrorConditionT Service::doSendMessageToConnection(
     if (is_server_side_pool) {
         //for a server pool we want to enque messages in the pool
         //
-        msgid   = rpool.pushBackMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url);
+        msgid   = rpool.pushBackMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url, msg_size);
         success = manager().notify(
             _rrecipient_id_in.connectionId(),
             Connection::eventNewMessage());
     } else {
-        msgid   = rpool.insertMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url);
+        msgid   = rpool.insertMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url, msg_size);
         success = manager().notify(
             _rrecipient_id_in.connectionId(),
             Connection::eventNewMessage(msgid));
     }
 
     if (success) {
+        impl_->statistic.latency(LatencyStageE::SendToPool, 0, _msg_type_idx, _rsend_time, rpool.msgvec[msgid.index].msgbundle.enqueue_time);
+
         if (_pmsgid_out != nullptr) {
             *_pmsgid_out          = msgid;
             MessageStub& rmsgstub = rpool.msgvec[msgid.index];
@@ -1100,14 +1340,15 @@ ErrorConditionT Service::doSendMessageToConnection(
 //-----------------------------------------------------------------------------
 
 ErrorConditionT Service::doSendMessageToNewPool(
-    const char*               _recipient_name,
-    MessagePointerT&          _rmsgptr,
-    const size_t              _msg_type_idx,
-    MessageCompleteFunctionT& _rcomplete_fnc,
-    RecipientId*              _precipient_id_out,
-    MessageId*                _pmsgid_out,
-    const MessageFlagsT&      _flags,
-    std::string&              _msg_url)
+    const char*                         _recipient_name,
+    MessagePointerT&                    _rmsgptr,
+    const size_t                        _msg_type_idx,
+    MessageCompleteFunctionT&           _rcomplete_fnc,
+    RecipientId*                        _precipient_id_out,
+    MessageId*                          _pmsgid_out,
+    const MessageFlagsT&                _flags,
+    std::string&                        _msg_url,
+    ServiceStatistic::TimePointT const& _rsend_time)
 {
 
     solid_dbg(logger, Verbose, this);
@@ -1127,7 +1368,7 @@ ErrorConditionT Service::doSendMessageToNewPool(
 
     rpool.name = _recipient_name;
 
-    MessageId msgid = rpool.pushBackMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url);
+    MessageId msgid = rpool.pushBackMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url, configuration().message_size_fnc(*_rmsgptr));
 
     if (!doTryCreateNewConnectionForPool(pool_index, error)) {
         solid_dbg(logger, Error, this << " Starting Session: " << error.message());
@@ -1139,6 +1380,8 @@ ErrorConditionT Service::doSendMessageToNewPool(
 
     impl_->namemap[rpool.name.c_str()] = pool_index;
 
+    impl_->statistic.latency(LatencyStageE::SendToPool, 0, _msg_type_idx, _rsend_time, rpool.msgvec[msgid.index].msgbundle.enqueue_time);
+
     if (_precipient_id_out != nullptr) {
         _precipient_id_out->poolid = ConnectionPoolId(pool_index, rpool.unique);
     }
@@ -1250,16 +1493,48 @@ bool Service::doTryPushMessageToConnection(
 }
 //-----------------------------------------------------------------------------
 ErrorConditionT Service::pollPoolForUpdates(
+    ConnectionContext& _rconctx,
+    ActorIdT const&    _ractuid,
+    MessageId const&   _rcompleted_msgid)
+{
+    Connection&         rcon  = _rconctx.connection();
+    ConnectionPoolStub* ppool = nullptr;
+    ErrorConditionT     error;
+    {
+        const size_t           pool_index = static_cast<size_t>(rcon.poolId().index);
+        lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
+        ConnectionPoolStub&    rpool(impl_->pooldq[pool_index]);
+
+        error = doPollPoolForUpdates(rcon, _ractuid, _rcompleted_msgid, pool_index);
+
+        if (!error && rpool.isBackpressure() && rpool.hasCredit(configuration().pool_max_message_queue_size, configuration().pool_max_message_queue_bytes)) {
+            rpool.resetBackpressure();
+            if (!solid_function_empty(rpool.on_event_fnc)) {
+                ppool = &rpool;
+            }
+        }
+    }
+    if (ppool != nullptr) {
+        //the call is safe because the current method is called from within a connection and
+        // the connection pool entry is released when the last connection calls
+        // Service::connectionStop
+        ppool->on_event_fnc(_rconctx, pool_event_category.event(PoolEvents::PoolCredit), ErrorConditionT());
+    }
+    return error;
+}
+//-----------------------------------------------------------------------------
+ErrorConditionT Service::doPollPoolForUpdates(
     Connection&      _rconnection,
     ActorIdT const&  _ractuid,
-    MessageId const& _rcompleted_msgid)
+    MessageId const& _rcompleted_msgid,
+    const size_t     _pool_index)
 {
+    //the pool's mutex must be locked
 
     solid_dbg(logger, Verbose, this << " " << &_rconnection);
 
-    const size_t           pool_index = static_cast<size_t>(_rconnection.poolId().index);
-    lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
-    ConnectionPoolStub&    rpool(impl_->pooldq[pool_index]);
+    const size_t        pool_index = _pool_index;
+    ConnectionPoolStub& rpool(impl_->pooldq[pool_index]);
 
     ErrorConditionT error;
 
@@ -1427,7 +1702,7 @@ ErrorConditionT Service::doDelayCloseConnectionPool(
     MessagePointerT empty_msg_ptr;
     std::string     empty_str;
 
-    const MessageId msgid = rpool.pushBackMessage(empty_msg_ptr, 0, _rcomplete_fnc, 0, empty_str);
+    const MessageId msgid = rpool.pushBackMessage(empty_msg_ptr, 0, _rcomplete_fnc, 0, empty_str, 0);
     (void)msgid;
 
     //notify all waiting connections about the new message
@@ -1473,7 +1748,7 @@ ErrorConditionT Service::doForceCloseConnectionPool(
     MessagePointerT empty_msg_ptr;
     string          empty_str;
 
-    const MessageId msgid = rpool.pushBackMessage(empty_msg_ptr, 0, _rcomplete_fnc, {MessageFlagsE::Synchronous}, empty_str);
+    const MessageId msgid = rpool.pushBackMessage(empty_msg_ptr, 0, _rcomplete_fnc, {MessageFlagsE::Synchronous}, empty_str, 0);
     (void)msgid;
 
     //no reason to cancel all messages - they'll be handled on connection stop.
@@ -2280,7 +2555,8 @@ void Service::doPushFrontMessageToPool(
                 _rmsgbundle.message_type_id,
                 _rmsgbundle.complete_fnc,
                 _rmsgbundle.message_flags,
-                _rmsgbundle.message_url);
+                _rmsgbundle.message_url,
+                _rmsgbundle.message_size);
         } else {
             rpool.reinsertFrontMessage(
                 _rmsgid,
@@ -2288,7 +2564,8 @@ void Service::doPushFrontMessageToPool(
                 _rmsgbundle.message_type_id,
                 _rmsgbundle.complete_fnc,
                 _rmsgbundle.message_flags,
-                _rmsgbundle.message_url);
+                _rmsgbundle.message_url,
+                _rmsgbundle.message_size);
         }
     }
 }
@@ -2362,11 +2639,29 @@ ErrorConditionT Service::activateConnection(ConnectionContext& _rconctx, ActorId
     return error;
 }
 //-----------------------------------------------------------------------------
+ErrorConditionT Service::acceptConnection(SocketDevice&& _usd)
+{
+    {
+        lock_guard<std::mutex> lock(impl_->mtx);
+
+        if (!running()) {
+            solid_dbg(logger, Error, this << " service stopping");
+            return error_service_stopping;
+        }
+    }
+
+    SocketDevice sd(std::move(_usd));
+
+    acceptIncomingConnection(sd);
+    return ErrorConditionT();
+}
+//-----------------------------------------------------------------------------
 void Service::acceptIncomingConnection(SocketDevice& _rsd)
 {
 
     solid_dbg(logger, Verbose, this);
 
+    //connection_recv_window_kb is inherited from the listener - see Configuration::prepare
     configuration().server.socket_device_setup_fnc(_rsd);
 
     size_t                 pool_index;
@@ -2505,6 +2800,48 @@ void InternetResolverF::operator()(const std::string& _name, ResolveCompleteFunc
 
     rresolver.requestResolve(fnc, hst_name, svc_name, 0, this->family, SocketInfo::Stream);
 }
+//-----------------------------------------------------------------------------
+void InternetDnsResolverF::operator()(const std::string& _name, ResolveCompleteFunctionT& _cbk)
+{
+    std::string hst_name;
+    std::string svc_name;
+
+    size_t off = _name.rfind(':');
+    if (off != std::string::npos) {
+        hst_name = _name.substr(0, off);
+        svc_name = _name.substr(off + 1);
+    } else {
+        hst_name = _name;
+    }
+
+    if (svc_name.empty()) {
+        svc_name = default_service;
+    }
+
+    if (svc_name.empty() || svc_name.find_first_not_of("0123456789") != std::string::npos) {
+        solid_log(logger, Error, "only numeric services are supported: " << _name);
+        _cbk(AddressVectorT());
+        return;
+    }
+
+    const int port = static_cast<int>(make_number(svc_name));
+
+    rresolver.requestResolve(
+        [cbk = std::move(_cbk), port](aio::DnsAddressVectorPointerT const& _raddr_ptr, ErrorConditionT const& _rerror) mutable {
+            AddressVectorT addrvec;
+            if (!_rerror) {
+                for (auto it = _raddr_ptr->rbegin(); it != _raddr_ptr->rend(); ++it) {
+                    addrvec.push_back(*it);
+                    addrvec.back().port(port);
+                    solid_dbg(logger, Info, "add resolved endpoint: " << addrvec.back() << ':' << addrvec.back().port());
+                }
+            } else {
+                solid_log(logger, Warning, "resolve failed: " << _rerror.message());
+            }
+            cbk(std::move(addrvec));
+        },
+        hst_name, this->family);
+}
 //=============================================================================
 
 std::ostream& operator<<(std::ostream& _ros, RecipientId const& _con_id)
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "solid/system/cassert.hpp"
 #include "solid/system/log.hpp"
 #include "solid/system/socketaddress.hpp"
@@ -156,15 +158,21 @@ private:
 };
 
 struct MessageBundle {
+    using TimePointT = std::chrono::steady_clock::time_point;
+
     size_t                   message_type_id;
     MessageFlagsT            message_flags;
     MessagePointerT          message_ptr;
     MessageCompleteFunctionT complete_fnc;
     std::string              message_url;
+    TimePointT               enqueue_time; //when sendMessage queued the message - used for queue time statistics
+    TimePointT               stage_time; //when the message entered its current LatencyStageE on the connection
+    size_t                   message_size; //as given by Configuration::message_size_fnc - used for byte budgets
 
     MessageBundle()
         : message_type_id(InvalidIndex())
         , message_flags(0)
+        , message_size(0)
     {
     }
 
@@ -178,6 +186,10 @@ struct MessageBundle {
         , message_flags(_flags)
         , message_ptr(std::move(_rmsgptr))
         , message_url(std::move(_rmessage_url))
+#ifdef SOLID_HAS_STATISTICS
+        , enqueue_time(std::chrono::steady_clock::now())
+#endif
+        , message_size(0)
     {
         std::swap(complete_fnc, _complete_fnc);
     }
@@ -188,6 +200,9 @@ struct MessageBundle {
         , message_flags(_rmsgbundle.message_flags)
         , message_ptr(std::move(_rmsgbundle.message_ptr))
         , message_url(std::move(_rmsgbundle.message_url))
+        , enqueue_time(_rmsgbundle.enqueue_time)
+        , stage_time(_rmsgbundle.stage_time)
+        , message_size(_rmsgbundle.message_size)
     {
         std::swap(complete_fnc, _rmsgbundle.complete_fnc);
     }
@@ -198,6 +213,9 @@ struct MessageBundle {
         message_flags   = _rmsgbundle.message_flags;
         message_ptr     = std::move(_rmsgbundle.message_ptr);
         message_url     = std::move(_rmsgbundle.message_url);
+        enqueue_time    = _rmsgbundle.enqueue_time;
+        stage_time      = _rmsgbundle.stage_time;
+        message_size    = _rmsgbundle.message_size;
         solid_function_clear(complete_fnc);
         std::swap(complete_fnc, _rmsgbundle.complete_fnc);
         return *this;
@@ -209,6 +227,7 @@ struct MessageBundle {
         message_flags.reset();
         message_ptr.reset();
         message_url.clear();
+        message_size = 0;
         solid_function_clear(complete_fnc);
     }
 };
@@ -0,0 +1,354 @@
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v2.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mprpc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+mutex                     mtx;
+condition_variable        cnd;
+size_t                    message_size  = 16 * 1024;
+size_t                    message_count = 4; //how many messages fit the pool byte budget
+size_t                    recv_count    = 0;
+bool                      credit_event  = false;
+frame::mprpc::RecipientId client_connection_id;
+vector<uint32_t>          recv_idx_vec;
+const uint32_t            bulk_idx          = 1000;
+const size_t              bulk_size         = 256 * message_size; //much larger than the multiplex budget
+const uint32_t            recv_window_kb    = 24;
+int                       server_recv_buffer_size = 0;
+int                       client_recv_buffer_size = 0;
+
+struct Message : frame::mprpc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Message(uint32_t _idx, const size_t _size)
+        : idx(_idx)
+        , str(_size, 'a' + (_idx % 26))
+    {
+    }
+
+    Message()
+        : idx(-1)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.idx, _rctx, "idx").add(_rthis.str, _rctx, "str");
+    }
+};
+
+size_t message_size_of(const frame::mprpc::Message& _rmsg)
+{
+    return static_cast<const Message&>(_rmsg).str.size();
+}
+
+void server_connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId());
+    {
+        lock_guard<mutex> lock(mtx);
+        _rctx.device().recvBufferSize(server_recv_buffer_size);
+        cnd.notify_one();
+    }
+    auto lambda = [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        solid_dbg(generic_logger, Info, "enter active error: " << _rerror.message());
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+//the client connection is activated later by the test so that
+//the messages are kept in the pool's queue
+void client_connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId());
+    lock_guard<mutex> lock(mtx);
+    _rctx.device().recvBufferSize(client_recv_buffer_size);
+    client_connection_id = _rctx.recipientId();
+    cnd.notify_one();
+}
+
+void client_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& /*_rsent_msg_ptr*/, std::shared_ptr<Message>& /*_rrecv_msg_ptr*/,
+    ErrorConditionT const& _rerror)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId() << " error: " << _rerror.message());
+    solid_check(!_rerror, "message error: " << _rerror.message());
+}
+
+void server_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& /*_rsent_msg_ptr*/, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& /*_rerror*/)
+{
+    if (!_rrecv_msg_ptr) {
+        return;
+    }
+    solid_check(_rrecv_msg_ptr->str.size() == (_rrecv_msg_ptr->idx == bulk_idx ? bulk_size : message_size), "invalid message size");
+
+    lock_guard<mutex> lock(mtx);
+    ++recv_count;
+    recv_idx_vec.emplace_back(_rrecv_msg_ptr->idx);
+    cnd.notify_one();
+}
+
+//connection_recv_window_kb sets SO_RCVBUF on the client socket before connect and on the listener,
+//inherited by the accepted socket - the kernel doubles the value for its bookkeeping
+void check_recv_window()
+{
+    const int          window_size = static_cast<int>(recv_window_kb * 1024);
+    unique_lock<mutex> lock(mtx);
+
+    solid_check(cnd.wait_for(lock, std::chrono::seconds(20), []() { return server_recv_buffer_size != 0; }), "Waiting for server connection took too long");
+    solid_check(server_recv_buffer_size >= window_size && server_recv_buffer_size <= 2 * window_size, "server SO_RCVBUF " << server_recv_buffer_size);
+    solid_check(client_recv_buffer_size >= window_size && client_recv_buffer_size <= 2 * window_size, "client SO_RCVBUF " << client_recv_buffer_size);
+}
+
+} //namespace
+
+int test_clientserver_backpressure(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW"});
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]);
+        if (message_count < 2) {
+            message_count = 2;
+        }
+    }
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        ErrorConditionT        err;
+        CallPool<void()>       cwp{WorkPoolConfiguration(), 1};
+        frame::aio::Resolver   resolver(cwp);
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { //mprpc server initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(server_complete_message, 1);
+
+            cfg.server.connection_start_fnc = &server_connection_start;
+            cfg.server.listener_address_str = "0.0.0.0:0";
+            cfg.connection_recv_window_kb   = recv_window_kb;
+
+            mprpcserver.start(std::move(cfg));
+
+            {
+                std::ostringstream oss;
+                oss << mprpcserver.configuration().server.listenerPort();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on port: " << server_port);
+            }
+        }
+
+        { //mprpc client initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(client_complete_message, 1);
+
+            cfg.message_size_fnc                   = &message_size_of;
+            cfg.pool_max_message_queue_bytes       = message_count * message_size;
+            cfg.writer.max_message_bytes_multiplex = 2 * message_size;
+            cfg.connection_recv_window_kb          = recv_window_kb;
+
+            cfg.client.connection_start_fnc = &client_connection_start;
+            cfg.client.name_resolve_fnc     = frame::mprpc::InternetResolverF(resolver, server_port.c_str() /*, SocketInfo::Inet4*/);
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        frame::mprpc::RecipientId pool_id;
+
+        err = mprpcclient.createConnectionPool(
+            "localhost", pool_id,
+            [](frame::mprpc::ConnectionContext& _rctx, Event&& _revent, const ErrorConditionT& _rerr) {
+                solid_dbg(generic_logger, Info, "client pool event: " << _revent << " error: " << _rerr.message());
+                if (_revent == frame::mprpc::pool_event_pool_credit) {
+                    lock_guard<mutex> lock(mtx);
+                    credit_event = true;
+                    cnd.notify_one();
+                }
+            });
+        solid_check(!err, "createConnectionPool: " << err.message());
+
+        for (size_t i = 0; i < message_count; ++i) {
+            err = mprpcclient.sendMessage(pool_id, std::make_shared<Message>(i, message_size));
+            solid_check(!err, "sendMessage: " << err.message());
+        }
+
+        auto msgptr = std::make_shared<Message>(message_count, message_size);
+
+        err = mprpcclient.sendMessage(pool_id, msgptr);
+        solid_check(err == frame::mprpc::error_service_pool_full, "sendMessage should fail with pool full: " << err.message());
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(20), []() { return !client_connection_id.isInvalidConnection(); }), "Waiting for client connection took too long");
+            solid_check(recv_count == 0, "messages should wait for the connection to become active");
+        }
+
+        check_recv_window();
+
+        err = mprpcclient.connectionNotifyEnterActiveState(
+            client_connection_id,
+            [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+                solid_dbg(generic_logger, Info, "enter active error: " << _rerror.message());
+            });
+        solid_check(!err, "connectionNotifyEnterActiveState: " << err.message());
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(20), []() { return credit_event; }), "Waiting for credit event took too long");
+        }
+
+        err = mprpcclient.sendMessage(pool_id, msgptr);
+        solid_check(!err, "sendMessage after credit: " << err.message());
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(20), []() { return recv_count == (message_count + 1); }), "Waiting for messages took too long");
+        }
+
+        //m.stop();
+    }
+
+    //a message larger than the multiplex budget must not starve the small ones queued after it
+    recv_count = 0;
+    recv_idx_vec.clear();
+    client_connection_id    = frame::mprpc::RecipientId();
+    server_recv_buffer_size = 0;
+    client_recv_buffer_size = 0;
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        ErrorConditionT        err;
+        CallPool<void()>       cwp{WorkPoolConfiguration(), 1};
+        frame::aio::Resolver   resolver(cwp);
+        const size_t           small_count = 8;
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { //mprpc server initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(server_complete_message, 1);
+
+            cfg.server.connection_start_fnc = &server_connection_start;
+            cfg.server.listener_address_str = "0.0.0.0:0";
+
+            mprpcserver.start(std::move(cfg));
+
+            {
+                std::ostringstream oss;
+                oss << mprpcserver.configuration().server.listenerPort();
+                server_port = oss.str();
+            }
+        }
+
+        { //mprpc client initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(client_complete_message, 1);
+
+            cfg.message_size_fnc                   = &message_size_of;
+            cfg.writer.max_message_bytes_multiplex = 4 * message_size;
+
+            cfg.client.connection_start_fnc = &client_connection_start;
+            cfg.client.name_resolve_fnc     = frame::mprpc::InternetResolverF(resolver, server_port.c_str() /*, SocketInfo::Inet4*/);
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        frame::mprpc::RecipientId pool_id;
+
+        err = mprpcclient.createConnectionPool(
+            "localhost", pool_id,
+            [](frame::mprpc::ConnectionContext& _rctx, Event&& _revent, const ErrorConditionT& _rerr) {
+                solid_dbg(generic_logger, Info, "client pool event: " << _revent << " error: " << _rerr.message());
+            });
+        solid_check(!err, "createConnectionPool: " << err.message());
+
+        err = mprpcclient.sendMessage(pool_id, std::make_shared<Message>(bulk_idx, bulk_size));
+        solid_check(!err, "sendMessage: " << err.message());
+
+        for (size_t i = 0; i < small_count; ++i) {
+            err = mprpcclient.sendMessage(pool_id, std::make_shared<Message>(i, message_size));
+            solid_check(!err, "sendMessage: " << err.message());
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(20), []() { return !client_connection_id.isInvalidConnection(); }), "Waiting for client connection took too long");
+        }
+
+        err = mprpcclient.connectionNotifyEnterActiveState(
+            client_connection_id,
+            [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+                solid_dbg(generic_logger, Info, "enter active error: " << _rerror.message());
+            });
+        solid_check(!err, "connectionNotifyEnterActiveState: " << err.message());
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(20), [small_count]() { return recv_count == (small_count + 1); }), "Waiting for messages took too long");
+            solid_check(recv_idx_vec.back() == bulk_idx, "the small messages should not wait for the large one");
+        }
+    }
+
+    return 0;
+}
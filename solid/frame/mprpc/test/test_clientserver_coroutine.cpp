@@ -0,0 +1,222 @@
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpccoroutine.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v2.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include <future>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mprpc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+#ifdef SOLID_HAS_COROUTINE
+
+uint32_t request_count = 100;
+
+std::string make_string(const uint32_t _idx)
+{
+    return std::string(1 + _idx % 1024, 'a' + (_idx % 26));
+}
+
+struct Request : frame::mprpc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Request(uint32_t _idx)
+        : idx(_idx)
+        , str(make_string(_idx))
+    {
+    }
+
+    Request()
+        : idx(-1)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.idx, _rctx, "idx").add(_rthis.str, _rctx, "str");
+    }
+};
+
+struct Response : frame::mprpc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Response(const Request& _rreq)
+        : frame::mprpc::Message(_rreq)
+        , idx(_rreq.idx)
+        , str(_rreq.str)
+    {
+    }
+
+    Response()
+        : idx(-1)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.idx, _rctx, "idx").add(_rthis.str, _rctx, "str");
+    }
+};
+
+void connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId());
+    auto lambda = [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        solid_dbg(generic_logger, Info, "enter active error: " << _rerror.message());
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+void client_complete_request(
+    frame::mprpc::ConnectionContext& /*_rctx*/,
+    std::shared_ptr<Request>& /*_rsent_msg_ptr*/, std::shared_ptr<Request>& /*_rrecv_msg_ptr*/,
+    ErrorConditionT const& /*_rerror*/)
+{
+}
+
+void client_complete_response(
+    frame::mprpc::ConnectionContext& /*_rctx*/,
+    std::shared_ptr<Response>& /*_rsent_msg_ptr*/, std::shared_ptr<Response>& /*_rrecv_msg_ptr*/,
+    ErrorConditionT const& /*_rerror*/)
+{
+    solid_throw("the response should go to the awaiting coroutine");
+}
+
+void server_complete_request(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Request>& /*_rsent_msg_ptr*/, std::shared_ptr<Request>& _rrecv_msg_ptr,
+    ErrorConditionT const& /*_rerror*/)
+{
+    if (!_rrecv_msg_ptr) {
+        return;
+    }
+    frame::mprpc::MessagePointerT msgptr(new Response(*_rrecv_msg_ptr));
+    _rctx.service().sendResponse(_rctx.recipientId(), msgptr);
+}
+
+void server_complete_response(
+    frame::mprpc::ConnectionContext& /*_rctx*/,
+    std::shared_ptr<Response>& /*_rsent_msg_ptr*/, std::shared_ptr<Response>& /*_rrecv_msg_ptr*/,
+    ErrorConditionT const& /*_rerror*/)
+{
+}
+
+frame::mprpc::co::Task run_requests(frame::mprpc::Service& _rsvc, const std::thread::id _caller_id, promise<size_t>& _rprom)
+{
+    size_t count = 0;
+
+    for (uint32_t i = 0; i < request_count; ++i) {
+        auto result = co_await frame::mprpc::co::sendRequest<Response>(_rsvc, "localhost", std::make_shared<Request>(i));
+
+        solid_check(result, "request " << i << " failed: " << result.error.message());
+        solid_check(result.response_ptr->idx == i && result.response_ptr->str == make_string(i), "invalid response " << i);
+        solid_check(std::this_thread::get_id() != _caller_id, "the task should continue on the connection's reactor");
+        ++count;
+    }
+
+    //an invalid recipient fails without suspending
+    auto result = co_await frame::mprpc::co::sendRequest<Response>(_rsvc, "", std::make_shared<Request>(0));
+
+    solid_check(!result && result.error, "the request to an invalid recipient should fail");
+
+    _rprom.set_value(count);
+}
+
+#endif //SOLID_HAS_COROUTINE
+
+} //namespace
+
+int test_clientserver_coroutine(int argc, char* argv[])
+{
+#ifdef SOLID_HAS_COROUTINE
+    solid::log_start(std::cerr, {".*:EW"});
+
+    if (argc > 1) {
+        request_count = atoi(argv[1]);
+        if (request_count == 0) {
+            request_count = 1;
+        }
+    }
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        CallPool<void()>       cwp{WorkPoolConfiguration(), 1};
+        frame::aio::Resolver   resolver(cwp);
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { //mprpc server initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            proto->null(0);
+            proto->registerMessage<Request>(server_complete_request, 1);
+            proto->registerMessage<Response>(server_complete_response, 2);
+
+            cfg.server.connection_start_fnc = &connection_start;
+            cfg.server.listener_address_str = "0.0.0.0:0";
+
+            mprpcserver.start(std::move(cfg));
+
+            {
+                std::ostringstream oss;
+                oss << mprpcserver.configuration().server.listenerPort();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on port: " << server_port);
+            }
+        }
+
+        { //mprpc client initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            proto->null(0);
+            proto->registerMessage<Request>(client_complete_request, 1);
+            proto->registerMessage<Response>(client_complete_response, 2);
+
+            cfg.client.connection_start_fnc = &connection_start;
+            cfg.client.name_resolve_fnc     = frame::mprpc::InternetResolverF(resolver, server_port.c_str() /*, SocketInfo::Inet4*/);
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        promise<size_t> prom;
+        auto            fut = prom.get_future();
+
+        run_requests(mprpcclient, std::this_thread::get_id(), prom);
+
+        solid_check(fut.wait_for(std::chrono::seconds(60)) == future_status::ready, "Waiting for the requests took too long");
+        solid_check(fut.get() == request_count, "not all the requests completed");
+    }
+#endif
+    return 0;
+}
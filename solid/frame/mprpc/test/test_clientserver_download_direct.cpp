@@ -0,0 +1,549 @@
+#include "solid/frame/mprpc/mprpcsocketstub_openssl.hpp"
+
+#include "solid/frame/mprpc/mprpccompression_snappy.hpp"
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v2.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/utility/string.hpp"
+
+#include "solid/system/directory.hpp"
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT  = frame::Scheduler<frame::aio::Reactor>;
+using SecureContextT = frame::aio::openssl::Context;
+using ProtocolT      = frame::mprpc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+LoggerT logger("test");
+
+atomic<size_t> expect_count(0);
+promise<void>  prom;
+
+struct Response;
+
+struct Request : frame::mprpc::Message {
+    string   name_;
+    ofstream ofs_;
+    bool     send_request_;
+
+    Request(Response& _rmsg);
+
+    Request()
+        : send_request_(true)
+    {
+    }
+
+    Request(const string& _name)
+        : name_(_name)
+        , send_request_(true)
+    {
+    }
+
+    ~Request() override
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.name_, _rctx, "name");
+    }
+};
+
+//The file is sent in chunks held by a std::string field, so that the client
+//receives them through the direct receive path (ReaderConfiguration::direct_receive_min_size)
+struct Response : frame::mprpc::Message {
+    static constexpr size_t chunk_size = 100 * 1024;
+
+    uint32_t             error_;
+    string               data_;
+    shared_ptr<ifstream> ifs_ptr_; //on server - the file shared by all the chunks
+
+    Response()
+        : error_(0)
+    {
+    }
+
+    Response(Request& _rmsg)
+        : frame::mprpc::Message(_rmsg)
+        , error_(0)
+    {
+    }
+
+    ~Response() override
+    {
+    }
+
+    //read the next chunk from file - returns false on end of file
+    bool readChunk()
+    {
+        data_.resize(chunk_size);
+        ifs_ptr_->read(&data_[0], chunk_size);
+        data_.resize(ifs_ptr_->gcount());
+        return !ifs_ptr_->eof();
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.error_, _rctx, "error").add(_rthis.data_, _rctx, "data");
+    }
+};
+
+Request::Request(Response& _rmsg)
+    : frame::mprpc::Message(_rmsg)
+    , send_request_(true)
+{
+}
+
+void on_client_request(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Request>&        _rsent_msg_ptr,
+    std::shared_ptr<Request>&        _rrecv_msg_ptr,
+    ErrorConditionT const&           _rerror)
+{
+    solid_log(logger, Verbose, "on message");
+}
+
+void on_client_response(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Response>&       _rsent_msg_ptr,
+    std::shared_ptr<Response>&       _rrecv_msg_ptr,
+    ErrorConditionT const&           _rerror)
+{
+    solid_log(logger, Verbose, "on message");
+}
+
+void on_client_receive_response(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Request>&        _rsent_msg_ptr,
+    std::shared_ptr<Response>&       _rrecv_msg_ptr,
+    ErrorConditionT const&           _rerror);
+
+void on_server_receive_first_request(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Request>&        _rsent_msg_ptr,
+    std::shared_ptr<Request>&        _rrecv_msg_ptr,
+    ErrorConditionT const&           _rerror);
+
+void on_server_response(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Response>&       _rsent_msg_ptr,
+    std::shared_ptr<Response>&       _rrecv_msg_ptr,
+    ErrorConditionT const&           _rerror)
+{
+    solid_log(logger, Verbose, "on message");
+}
+
+void create_files(vector<string>& _file_vec, const char* _path_prefix, uint64_t _count, uint64_t _start_size, uint64_t _increment_size);
+void check_files(const vector<string>& _file_vec, const char* _path_prefix_client, const char* _path_prefix_server);
+
+} //namespace
+
+int test_clientserver_download_direct(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW", "test:IEW", "solid::frame::mprpc::.*:EW"});
+
+    size_t   max_per_pool_connection_count = 1;
+    bool     secure                        = false;
+    bool     compress                      = false;
+    uint64_t count                         = 2;
+    uint64_t start_size                    = make_number("20M");
+    uint64_t increment_size                = make_number("10M");
+
+    if (argc > 1) {
+        max_per_pool_connection_count = atoi(argv[1]);
+        if (max_per_pool_connection_count == 0) {
+            max_per_pool_connection_count = 1;
+        }
+        if (max_per_pool_connection_count > 100) {
+            max_per_pool_connection_count = 100;
+        }
+    }
+
+    if (argc > 2) {
+        if (*argv[2] == 's' || *argv[2] == 'S') {
+            secure = true;
+        }
+        if (*argv[2] == 'c' || *argv[2] == 'C') {
+            compress = true;
+        }
+        if (*argv[2] == 'b' || *argv[2] == 'B') {
+            secure   = true;
+            compress = true;
+        }
+    }
+
+    if (argc > 3) {
+        count = atoi(argv[3]);
+    }
+    if (argc > 4) {
+        start_size = make_number(argv[4]);
+    }
+    if (argc > 5) {
+        increment_size = make_number(argv[5]);
+    }
+
+    system("rm -rf client_storage_direct");
+    system("rm -rf server_storage_direct");
+
+    Directory::create("client_storage_direct");
+    Directory::create("server_storage_direct");
+
+    vector<string> file_vec;
+    create_files(file_vec, "server_storage_direct", count, start_size, increment_size);
+    solid_log(logger, Info, "Done creating files");
+
+    {
+        AioSchedulerT          sch_client;
+        AioSchedulerT          sch_server;
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpc_client(m);
+        frame::mprpc::ServiceT mprpc_server(m);
+        ErrorConditionT        err;
+        CallPool<void()>       cwp{WorkPoolConfiguration(), 1};
+        frame::aio::Resolver   resolver(cwp);
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { //mprpc back_server initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            proto->null(0);
+            proto->registerMessage<Request>(on_server_receive_first_request, 1);
+            proto->registerMessage<Response>(on_server_response, 2);
+
+            //cfg.recv_buffer_capacity = 1024;
+            //cfg.send_buffer_capacity = 1024;
+
+            //packets big enough for the client to receive the file chunks directly
+            cfg.connection_send_buffer_start_capacity_kb = 64;
+
+            cfg.server.listener_address_str   = "0.0.0.0:0";
+            cfg.server.connection_start_state = frame::mprpc::ConnectionState::Active;
+
+            if (secure) {
+                solid_dbg(logger, Info, "Configure SSL server -------------------------------------");
+                frame::mprpc::openssl::setup_server(
+                    cfg,
+                    [](frame::aio::openssl::Context& _rctx) -> ErrorCodeT {
+                        _rctx.loadVerifyFile("echo-ca-cert.pem" /*"/etc/pki/tls/certs/ca-bundle.crt"*/);
+                        _rctx.loadCertificateFile("echo-server-cert.pem");
+                        _rctx.loadPrivateKeyFile("echo-server-key.pem");
+                        return ErrorCodeT();
+                    },
+                    frame::mprpc::openssl::NameCheckSecureStart{"echo-client"});
+            }
+
+            if (compress) {
+                frame::mprpc::snappy::setup(cfg);
+            }
+
+            mprpc_server.start(std::move(cfg));
+
+            solid_check(!err, "starting back_server mprpcservice: " << err.message());
+
+            {
+                std::ostringstream oss;
+                oss << mprpc_server.configuration().server.listenerPort();
+                server_port = oss.str();
+                solid_dbg(logger, Verbose, "back listens on port: " << server_port);
+            }
+        }
+
+        { //mprpc front_client initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            proto->null(0);
+            proto->registerMessage<Request>(on_client_request, 1);
+            proto->registerMessage<Response>(on_client_response, 2);
+
+            cfg.pool_max_active_connection_count = max_per_pool_connection_count;
+            cfg.reader.direct_receive_min_size   = 4 * 1024;
+
+            //a socket receive window smaller than a packet makes sure the client
+            //sees incomplete packets, which are then received directly
+            cfg.connection_recv_buffer_start_capacity_kb = 64;
+            cfg.connection_recv_window_kb                = 16;
+
+            cfg.client.name_resolve_fnc       = frame::mprpc::InternetResolverF(resolver, server_port.c_str() /*, SocketInfo::Inet4*/);
+            cfg.client.connection_start_state = frame::mprpc::ConnectionState::Active;
+
+            if (secure) {
+                solid_dbg(generic_logger, Info, "Configure SSL client ------------------------------------");
+                frame::mprpc::openssl::setup_client(
+                    cfg,
+                    [](frame::aio::openssl::Context& _rctx) -> ErrorCodeT {
+                        _rctx.loadVerifyFile("echo-ca-cert.pem" /*"/etc/pki/tls/certs/ca-bundle.crt"*/);
+                        _rctx.loadCertificateFile("echo-client-cert.pem");
+                        _rctx.loadPrivateKeyFile("echo-client-key.pem");
+                        return ErrorCodeT();
+                    },
+                    frame::mprpc::openssl::NameCheckSecureStart{"echo-server"});
+            }
+
+            if (compress) {
+                frame::mprpc::snappy::setup(cfg);
+            }
+
+            mprpc_client.start(std::move(cfg));
+        }
+
+        expect_count = file_vec.size();
+        for (const auto& f : file_vec) {
+            auto msg_ptr = make_shared<Request>(f);
+            msg_ptr->ofs_.open(string("client_storage_direct/") + f);
+
+            mprpc_client.sendRequest("localhost", msg_ptr, on_client_receive_response);
+        }
+
+        solid_check(prom.get_future().wait_for(chrono::seconds(150)) == future_status::ready, "Taking too long - waited 150 secs");
+        solid_log(logger, Info, "Done upload");
+        check_files(file_vec, "client_storage_direct", "server_storage_direct");
+        solid_log(logger, Info, "Done file checking - exiting");
+
+        solid_log(logger, Statistic, "client statistic:" << mprpc_client.statistic());
+#ifdef SOLID_HAS_STATISTICS
+        //compressed packets are never received directly
+        solid_check(compress || mprpc_client.statistic().directReceiveBytes() > 0, "file chunks not received directly: " << mprpc_client.statistic());
+#endif
+    }
+    return 0;
+}
+
+namespace {
+
+size_t real_size(size_t _sz)
+{
+    //offset + (align - (offset mod align)) mod align
+    return _sz + ((sizeof(uint64_t) - (_sz % sizeof(uint64_t))) % sizeof(uint64_t));
+}
+
+void create_files(vector<string>& _file_vec, const char* _path_prefix, uint64_t _count, uint64_t _start_size, uint64_t _increment_size)
+{
+    string pattern;
+    for (int j = 0; j < 1; ++j) {
+        for (int i = 0; i < 127; ++i) {
+            int c = (i + j) % 127;
+            if (isprint(c) != 0 && isblank(c) == 0) {
+                pattern += static_cast<char>(c);
+            }
+        }
+    }
+
+    size_t sz = real_size(pattern.size());
+
+    if (sz > pattern.size()) {
+        pattern.resize(sz - sizeof(uint64_t));
+    } else if (sz < pattern.size()) {
+        pattern.resize(sz);
+    }
+
+    string   fname;
+    uint64_t crtsz = _start_size;
+
+    for (size_t i = 0; i < _count; ++i) {
+        {
+            ostringstream oss;
+            oss << "test_file_" << i << "_" << crtsz << ".txt";
+            _file_vec.emplace_back(oss.str());
+        }
+
+        fname = string(_path_prefix) + '/' + _file_vec.back();
+        ofstream ofs(fname);
+        solid_check(ofs, "failed open file: " << fname);
+
+        int64_t sz   = crtsz;
+        int64_t line = 0;
+        do {
+            ofs << hex << setw(8) << setfill('0') << line << ' ';
+
+            ofs.write(pattern.data(), pattern.size());
+            ofs << "\r\n";
+            sz -= pattern.size();
+            sz -= 11;
+            ++line;
+        } while (sz > 0);
+        crtsz += _increment_size;
+    }
+}
+
+void compare_streams(istream& _is1, istream& _is2)
+{
+    constexpr size_t bufsz = 4 * 1024;
+    char             buf1[bufsz];
+    char             buf2[bufsz];
+    uint64_t         off = 0;
+
+    do {
+        _is1.read(buf1, bufsz);
+        _is2.read(buf2, bufsz);
+
+        size_t r1 = _is1.gcount();
+        size_t r2 = _is2.gcount();
+
+        solid_check(r1 == r2, "failed read at offset: " << off);
+
+        solid_check(memcmp(buf1, buf2, r1) == 0, "failed chec at offset: " << off);
+        off += r1;
+
+    } while (!_is1.eof() || !_is2.eof());
+
+    solid_check(_is1.eof() && _is2.eof(), "not both streams eof");
+}
+
+void check_files(const vector<string>& _file_vec, const char* _path_prefix_client, const char* _path_prefix_server)
+{
+    for (auto& f : _file_vec) {
+        string   clientpath = string(_path_prefix_client) + '/' + f;
+        string   serverpath = string(_path_prefix_server) + '/' + f;
+        ifstream ifsc(clientpath);
+        ifstream ifss(serverpath);
+        solid_check(ifsc, "Failed open: " << clientpath);
+        solid_check(ifss, "Failed open: " << serverpath);
+        compare_streams(ifsc, ifss);
+    }
+}
+//-----------------------------------------------------------------------------
+// client
+//-----------------------------------------------------------------------------
+
+void on_client_receive_response(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Request>&        _rsent_msg_ptr,
+    std::shared_ptr<Response>&       _rrecv_msg_ptr,
+    ErrorConditionT const&           _rerror)
+{
+    solid_check(_rrecv_msg_ptr);
+
+    solid_check(_rrecv_msg_ptr->error_ == 0);
+
+    const string& s = _rrecv_msg_ptr->data_;
+    _rsent_msg_ptr->ofs_.write(s.data(), s.size());
+
+    solid_log(logger, Verbose, "received response data of size: " << s.size());
+
+    frame::mprpc::MessageFlagsT flags;
+
+    if (!_rrecv_msg_ptr->isResponseLast()) {
+        if (_rsent_msg_ptr->send_request_) {
+            _rsent_msg_ptr->send_request_ = false;
+            auto res_ptr                  = make_shared<Request>(*_rrecv_msg_ptr);
+            auto err                      = _rctx.service().sendMessage(_rctx.recipientId(), res_ptr, {frame::mprpc::MessageFlagsE::Response});
+            solid_log(logger, Verbose, "send response to: " << _rctx.recipientId() << " err: " << err.message());
+        } else {
+            _rsent_msg_ptr->send_request_ = true;
+        }
+    } else {
+        _rsent_msg_ptr->ofs_.flush();
+        if (expect_count.fetch_sub(1) == 1) {
+            prom.set_value();
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+// server
+//-----------------------------------------------------------------------------
+
+void on_server_receive_request(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Response>&       _rsent_msg_ptr,
+    std::shared_ptr<Request>&        _rrecv_msg_ptr,
+    ErrorConditionT const&           _rerror);
+
+//send the next two chunks of the file - the first one awaits the client's request for more
+void send_chunks(
+    frame::mprpc::ConnectionContext& _rctx,
+    Response&                        _rprev_msg)
+{
+    auto res_ptr = make_shared<Response>();
+    res_ptr->header(_rprev_msg.header());
+    res_ptr->ifs_ptr_ = _rprev_msg.ifs_ptr_;
+
+    if (res_ptr->readChunk()) {
+        solid_log(logger, Verbose, "Sending to " << _rctx.recipientId());
+        frame::mprpc::MessageFlagsT flags{frame::mprpc::MessageFlagsE::ResponsePart, frame::mprpc::MessageFlagsE::AwaitResponse};
+        auto                        error = _rctx.service().sendMessage(_rctx.recipientId(), res_ptr, on_server_receive_request, flags);
+        solid_check(!error, "failed send message: " << error.message());
+
+        auto next_ptr = make_shared<Response>();
+        next_ptr->header(res_ptr->header());
+        next_ptr->ifs_ptr_ = res_ptr->ifs_ptr_;
+
+        if (next_ptr->readChunk()) {
+            flags.reset(frame::mprpc::MessageFlagsE::AwaitResponse);
+        } else {
+            solid_log(logger, Verbose, "Sending to " << _rctx.recipientId() << " last");
+            flags = frame::mprpc::MessageFlagsT{frame::mprpc::MessageFlagsE::ResponseLast};
+        }
+        error = _rctx.service().sendMessage(_rctx.recipientId(), next_ptr, flags);
+        solid_check(!error, "failed send message: " << error.message());
+    } else {
+        solid_log(logger, Verbose, "Sending to " << _rctx.recipientId() << " last");
+        frame::mprpc::MessageFlagsT flags{frame::mprpc::MessageFlagsE::ResponseLast};
+        auto                        error = _rctx.service().sendMessage(_rctx.recipientId(), res_ptr, flags);
+        solid_check(!error, "failed send message: " << error.message());
+    }
+}
+
+void on_server_receive_request(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Response>&       _rsent_msg_ptr,
+    std::shared_ptr<Request>&        _rrecv_msg_ptr,
+    ErrorConditionT const&           _rerror)
+{
+    solid_check(_rrecv_msg_ptr);
+
+    if (!_rsent_msg_ptr->ifs_ptr_->eof()) {
+        send_chunks(_rctx, *_rsent_msg_ptr);
+    }
+}
+
+void on_server_receive_first_request(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Request>&        _rsent_msg_ptr,
+    std::shared_ptr<Request>&        _rrecv_msg_ptr,
+    ErrorConditionT const&           _rerror)
+{
+    string path = string("server_storage_direct") + '/' + _rrecv_msg_ptr->name_;
+
+    Response res(*_rrecv_msg_ptr);
+
+    res.ifs_ptr_ = make_shared<ifstream>(path);
+
+    solid_check(*res.ifs_ptr_, "failed open file: " << path);
+
+    solid_log(logger, Verbose, "Sending " << _rrecv_msg_ptr->name_ << " to " << _rctx.recipientId());
+    send_chunks(_rctx, res);
+}
+
+} //namespace
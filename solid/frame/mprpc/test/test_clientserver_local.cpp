@@ -0,0 +1,250 @@
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v2.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+#include "solid/frame/mprpc/mprpcsocketstub_local.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioreactor.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <unistd.h>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mprpc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             message_count           = 64;
+size_t             response_count          = 0;
+size_t             server_connection_count = 0;
+size_t             direct_receive_min_size = InvalidSize();
+size_t             buffer_capacity_kb      = 0;
+
+size_t message_size(const size_t _idx)
+{
+    //from a few bytes up to more than a recv buffer
+    return 1 + ((_idx * 7919) % (256 * 1024));
+}
+
+struct Message : frame::mprpc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+        , str(message_size(_idx), 'a' + (_idx % 26))
+    {
+    }
+
+    Message()
+        : idx(-1)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.idx, _rctx, "idx").add(_rthis.str, _rctx, "str");
+    }
+
+    bool check() const
+    {
+        return str.size() == message_size(idx) && str == std::string(str.size(), 'a' + (idx % 26));
+    }
+};
+
+void server_connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId());
+    {
+        lock_guard<mutex> lock(mtx);
+        ++server_connection_count;
+    }
+    auto lambda = [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        solid_dbg(generic_logger, Info, "enter active error: " << _rerror.message());
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+void client_connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId());
+    auto lambda = [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        solid_dbg(generic_logger, Info, "enter active error: " << _rerror.message());
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+void client_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId() << " error: " << _rerror.message());
+    solid_check(!_rerror, "message error: " << _rerror.message());
+    solid_check(_rsent_msg_ptr && _rrecv_msg_ptr, "expected a response");
+    solid_check(_rrecv_msg_ptr->idx == _rsent_msg_ptr->idx && _rrecv_msg_ptr->check(), "invalid response");
+
+    lock_guard<mutex> lock(mtx);
+    ++response_count;
+    cnd.notify_one();
+}
+
+void server_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& /*_rsent_msg_ptr*/, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& /*_rerror*/)
+{
+    if (!_rrecv_msg_ptr) {
+        return;
+    }
+    solid_check(_rrecv_msg_ptr->check(), "invalid request");
+
+    ErrorConditionT err = _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+    solid_check(!err, "sendResponse: " << err.message());
+}
+
+} //namespace
+
+//p - in process, through socket pairs (default), u - unix domain socket
+//optional: message count, ReaderConfiguration::direct_receive_min_size (0 disables direct receive)
+//and the starting connection buffer capacity in KB - larger buffers mean larger packets
+int test_clientserver_local(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW"});
+
+    char transport = 'p';
+
+    if (argc > 1) {
+        transport = argv[1][0];
+    }
+    if (argc > 2) {
+        message_count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        direct_receive_min_size = atoi(argv[3]);
+    }
+    if (argc > 4) {
+        buffer_capacity_kb = atoi(argv[4]);
+    }
+
+    std::string local_path;
+
+    if (transport == 'u') {
+        std::ostringstream oss;
+        oss << "/tmp/solid_test_clientserver_local_" << ::getpid() << ".sock";
+        local_path = oss.str();
+    }
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        ErrorConditionT        err;
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        { //mprpc server initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(server_complete_message, 1);
+
+            cfg.server.connection_start_fnc = &server_connection_start;
+
+            if (direct_receive_min_size != InvalidSize()) {
+                cfg.reader.direct_receive_min_size = direct_receive_min_size;
+            }
+            if (buffer_capacity_kb != 0) {
+                cfg.connection_recv_buffer_start_capacity_kb = static_cast<uint8_t>(buffer_capacity_kb);
+                cfg.connection_send_buffer_start_capacity_kb = static_cast<uint8_t>(buffer_capacity_kb);
+            }
+
+            if (!local_path.empty()) {
+                frame::mprpc::local::setup_server(cfg, local_path);
+            }
+
+            mprpcserver.start(std::move(cfg));
+
+            solid_check(mprpcserver.configuration().server.listenerPort() == -1, "no inet listener expected");
+        }
+
+        { //mprpc client initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(client_complete_message, 1);
+
+            cfg.client.connection_start_fnc = &client_connection_start;
+
+            if (direct_receive_min_size != InvalidSize()) {
+                cfg.reader.direct_receive_min_size = direct_receive_min_size;
+            }
+            if (buffer_capacity_kb != 0) {
+                cfg.connection_recv_buffer_start_capacity_kb = static_cast<uint8_t>(buffer_capacity_kb);
+                cfg.connection_send_buffer_start_capacity_kb = static_cast<uint8_t>(buffer_capacity_kb);
+            }
+
+            if (local_path.empty()) {
+                frame::mprpc::local::setup_client(cfg, mprpcserver);
+            } else {
+                frame::mprpc::local::setup_client(cfg, local_path);
+            }
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        for (size_t i = 0; i < message_count; ++i) {
+            err = mprpcclient.sendRequest("server", std::make_shared<Message>(i), client_complete_message);
+            solid_check(!err, "sendRequest: " << err.message());
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(60), []() { return response_count == message_count; }), "Waiting for responses took too long");
+            solid_check(server_connection_count == 1, "expected one server connection, got " << server_connection_count);
+        }
+
+        solid_log(generic_logger, Statistic, "server statistic:" << mprpcserver.statistic() << " client statistic:" << mprpcclient.statistic());
+#ifdef SOLID_HAS_STATISTICS
+        if (direct_receive_min_size == 0) {
+            solid_check(mprpcserver.statistic().directReceiveBytes() == 0, "unexpected direct receive on server");
+            solid_check(mprpcclient.statistic().directReceiveBytes() == 0, "unexpected direct receive on client");
+        } else if (direct_receive_min_size != InvalidSize()) {
+            solid_check(mprpcserver.statistic().directReceiveBytes() > 0, "no direct receive on server");
+            solid_check(mprpcclient.statistic().directReceiveBytes() > 0, "no direct receive on client");
+        }
+#endif
+
+        m.stop();
+    }
+
+    if (!local_path.empty()) {
+        ::remove(local_path.c_str());
+    }
+
+    return 0;
+}
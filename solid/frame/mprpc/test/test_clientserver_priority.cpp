@@ -0,0 +1,271 @@
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v2.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mprpc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+const uint32_t warmup_idx = 0xffff;
+
+mutex              mtx;
+condition_variable cnd;
+bool               warmup_done          = false;
+size_t             bulk_count           = 16;
+size_t             control_count        = 16;
+size_t             bulk_size            = 1024 * 1024;
+size_t             recv_bulk_count      = 0;
+size_t             recv_control_count   = 0;
+size_t             bulk_before_controls = -1; //bulk messages received before the last control message
+
+struct Message : frame::mprpc::Message {
+    uint32_t    idx;
+    bool        control;
+    std::string str;
+
+    Message(uint32_t _idx, const bool _control, const size_t _size)
+        : idx(_idx)
+        , control(_control)
+        , str(_size, 'a' + (_idx % 26))
+    {
+    }
+
+    Message()
+        : idx(-1)
+        , control(false)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.idx, _rctx, "idx").add(_rthis.control, _rctx, "control").add(_rthis.str, _rctx, "str");
+    }
+};
+
+void connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId());
+    auto lambda = [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        solid_dbg(generic_logger, Info, "enter active error: " << _rerror.message());
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+void client_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId() << " error: " << _rerror.message());
+    solid_check(!_rerror, "message error: " << _rerror.message());
+
+    if (_rrecv_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+        warmup_done = true;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& /*_rsent_msg_ptr*/, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& /*_rerror*/)
+{
+    if (!_rrecv_msg_ptr) {
+        return;
+    }
+
+    if (_rrecv_msg_ptr->idx == warmup_idx) {
+        ErrorConditionT err = _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+        solid_check(!err, "sendResponse: " << err.message());
+        return;
+    }
+
+    lock_guard<mutex> lock(mtx);
+
+    if (_rrecv_msg_ptr->control) {
+        solid_check(_rrecv_msg_ptr->idx == recv_control_count, "control messages out of order");
+        ++recv_control_count;
+        if (recv_control_count == control_count) {
+            bulk_before_controls = recv_bulk_count;
+        }
+    } else {
+        ++recv_bulk_count;
+    }
+    cnd.notify_one();
+}
+
+} //namespace
+
+int test_clientserver_priority(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW"});
+
+    if (argc > 1) {
+        bulk_count = atoi(argv[1]);
+        if (bulk_count < 4) {
+            bulk_count = 4;
+        }
+    }
+
+    if (argc > 2) {
+        control_count = atoi(argv[2]);
+    }
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        ErrorConditionT        err;
+        CallPool<void()>       cwp{WorkPoolConfiguration(), 1};
+        frame::aio::Resolver   resolver(cwp);
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { //mprpc server initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(server_complete_message, 1);
+
+            cfg.server.connection_start_fnc = &connection_start;
+            cfg.server.listener_address_str = "0.0.0.0:0";
+
+            mprpcserver.start(std::move(cfg));
+
+            {
+                std::ostringstream oss;
+                oss << mprpcserver.configuration().server.listenerPort();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on port: " << server_port);
+            }
+        }
+
+        { //mprpc client initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(client_complete_message, 1);
+
+            //keep most of the bulk messages waiting in the pool queue
+            cfg.writer.max_message_count_multiplex = 4;
+            cfg.latency_per_message_type           = true;
+
+            cfg.client.connection_start_fnc = &connection_start;
+            cfg.client.name_resolve_fnc     = frame::mprpc::InternetResolverF(resolver, server_port.c_str() /*, SocketInfo::Inet4*/);
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        { //make sure the connection is active
+            err = mprpcclient.sendMessage(
+                "localhost", std::make_shared<Message>(warmup_idx, false, 16),
+                {frame::mprpc::MessageFlagsE::AwaitResponse});
+            solid_check(!err, "sendMessage: " << err.message());
+
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(20), []() { return warmup_done; }), "Waiting for warmup took too long");
+        }
+
+        std::vector<std::shared_ptr<Message>> bulk_vec;
+        std::vector<std::shared_ptr<Message>> control_vec;
+
+        //create the messages upfront so that the control messages
+        //are sent right after the bulk ones
+        for (size_t i = 0; i < bulk_count; ++i) {
+            bulk_vec.emplace_back(std::make_shared<Message>(i, false, bulk_size));
+        }
+
+        for (size_t i = 0; i < control_count; ++i) {
+            control_vec.emplace_back(std::make_shared<Message>(i, true, 32));
+        }
+
+        for (auto& rmsgptr : bulk_vec) {
+            err = mprpcclient.sendMessage("localhost", rmsgptr, {frame::mprpc::MessageFlagsE::BulkPriority});
+            solid_check(!err, "sendMessage: " << err.message());
+        }
+
+        for (auto& rmsgptr : control_vec) {
+            err = mprpcclient.sendMessage("localhost", rmsgptr, {frame::mprpc::MessageFlagsE::ControlPriority});
+            solid_check(!err, "sendMessage: " << err.message());
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(60), []() { return recv_bulk_count == bulk_count && recv_control_count == control_count; }), "Waiting for messages took too long");
+        }
+
+        const frame::mprpc::ServiceStatistic& rstat = mprpcclient.statistic();
+
+        solid_log(generic_logger, Statistic, "bulk messages before last control message: " << bulk_before_controls << " client statistic:" << rstat);
+
+        solid_check(bulk_before_controls <= bulk_count / 2, "control messages did not overtake bulk messages: " << bulk_before_controls);
+#ifdef SOLID_HAS_STATISTICS
+        solid_check(rstat.queueCount(frame::mprpc::MessagePriorityE::Control) == control_count, "client statistic:" << rstat);
+        solid_check(rstat.queueCount(frame::mprpc::MessagePriorityE::Bulk) == bulk_count, "client statistic:" << rstat);
+        solid_check(rstat.queueCount(frame::mprpc::MessagePriorityE::Interactive) == 1, "client statistic:" << rstat);
+
+        {
+            using frame::mprpc::LatencyStageE;
+
+            const size_t message_count = bulk_count + control_count + 1;
+
+            for (const auto stage : {LatencyStageE::SendToPool, LatencyStageE::PoolToWriter, LatencyStageE::WriterToSent}) {
+                Histogram h;
+                rstat.latency(stage, h);
+                solid_check(h.count() == message_count, "stage " << static_cast<int>(stage) << ": " << h);
+            }
+
+            //only the warmup message waits for a response
+            Histogram h;
+            rstat.latency(LatencyStageE::SentToResponse, h);
+            solid_check(h.count() == 1 && h.maximum() != 0, "sent to response: " << h);
+
+            h.clear();
+            solid_check(rstat.latency(LatencyStageE::PoolToWriter, mprpcclient.configuration().protocol().typeIndex(bulk_vec.front().get()), h));
+            solid_check(h.count() == message_count, "per message type: " << h);
+
+            Histogram hserver;
+            mprpcserver.statistic().latency(LatencyStageE::ReceiveToComplete, hserver);
+            solid_check(hserver.count() == message_count, "server receive to complete: " << hserver);
+        }
+#endif
+
+        m.stop();
+    }
+
+    return 0;
+}
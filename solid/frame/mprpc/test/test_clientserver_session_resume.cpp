@@ -0,0 +1,240 @@
+#include "solid/frame/mprpc/mprpcsocketstub_openssl.hpp"
+
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v2.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT  = frame::Scheduler<frame::aio::Reactor>;
+using SecureContextT = frame::aio::openssl::Context;
+using ProtocolT      = frame::mprpc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+mutex                     mtx;
+condition_variable        cnd;
+size_t                    response_count = 0;
+size_t                    stop_count     = 0;
+frame::mprpc::RecipientId connection_id;
+
+struct Message : frame::mprpc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+        , str("session resumption")
+    {
+    }
+
+    Message()
+        : idx(-1)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, /*_name*/)
+    {
+        _s.add(_rthis.idx, _rctx, "idx").add(_rthis.str, _rctx, "str");
+    }
+};
+
+void client_connection_stop(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+    lock_guard<mutex> lock(mtx);
+    ++stop_count;
+    cnd.notify_one();
+}
+
+void client_connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId());
+    auto lambda = [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        solid_dbg(generic_logger, Info, "enter active error: " << _rerror.message());
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+void server_connection_stop(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId() << " error: " << _rctx.error().message());
+}
+
+void server_connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId());
+    auto lambda = [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        solid_dbg(generic_logger, Info, "enter active error: " << _rerror.message());
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+void client_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId() << " error: " << _rerror.message());
+
+    if (_rrecv_msg_ptr) {
+        solid_check(_rsent_msg_ptr && _rsent_msg_ptr->idx == _rrecv_msg_ptr->idx);
+
+        lock_guard<mutex> lock(mtx);
+        connection_id = _rctx.recipientId();
+        ++response_count;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mprpc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& /*_rsent_msg_ptr*/, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& /*_rerror*/)
+{
+    if (_rrecv_msg_ptr) {
+        ErrorConditionT err = _rctx.service().sendResponse(_rctx.recipientId(), _rrecv_msg_ptr);
+        solid_check(!err, "sendResponse: " << err.message());
+    }
+}
+
+} //namespace
+
+int test_clientserver_session_resume(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW"});
+
+    size_t round_count = 4;
+
+    if (argc > 1) {
+        round_count = atoi(argv[1]);
+        if (round_count < 2) {
+            round_count = 2;
+        }
+    }
+
+    {
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        ErrorConditionT        err;
+        CallPool<void()>       cwp{WorkPoolConfiguration(), 1};
+        frame::aio::Resolver   resolver(cwp);
+
+        sch_client.start(1);
+        sch_server.start(1);
+
+        std::string server_port;
+
+        { //mprpc server initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(server_complete_message, 1);
+
+            cfg.connection_stop_fnc         = &server_connection_stop;
+            cfg.server.connection_start_fnc = &server_connection_start;
+
+            cfg.server.listener_address_str = "0.0.0.0:0";
+
+            frame::mprpc::openssl::setup_server(
+                cfg,
+                [](frame::aio::openssl::Context& _rctx) -> ErrorCodeT {
+                    _rctx.loadVerifyFile("echo-ca-cert.pem");
+                    _rctx.loadCertificateFile("echo-server-cert.pem");
+                    _rctx.loadPrivateKeyFile("echo-server-key.pem");
+                    return _rctx.enableServerSessionResumption("test_session_resume");
+                },
+                frame::mprpc::openssl::NameCheckSecureStart{"echo-client"});
+
+            mprpcserver.start(std::move(cfg));
+
+            {
+                std::ostringstream oss;
+                oss << mprpcserver.configuration().server.listenerPort();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on port: " << server_port);
+            }
+        }
+
+        { //mprpc client initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            proto->null(0);
+            proto->registerMessage<Message>(client_complete_message, 1);
+
+            cfg.connection_stop_fnc         = &client_connection_stop;
+            cfg.client.connection_start_fnc = &client_connection_start;
+
+            cfg.client.name_resolve_fnc = frame::mprpc::InternetResolverF(resolver, server_port.c_str() /*, SocketInfo::Inet4*/);
+
+            frame::mprpc::openssl::setup_client(
+                cfg,
+                [](frame::aio::openssl::Context& _rctx) -> ErrorCodeT {
+                    _rctx.loadVerifyFile("echo-ca-cert.pem");
+                    _rctx.loadCertificateFile("echo-client-cert.pem");
+                    _rctx.loadPrivateKeyFile("echo-client-key.pem");
+                    return ErrorCodeT();
+                },
+                frame::mprpc::openssl::NameCheckSecureStart{"echo-server"});
+
+            frame::mprpc::openssl::setup_client_session_resumption(cfg);
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        for (size_t i = 0; i < round_count; ++i) {
+            err = mprpcclient.sendMessage(
+                "localhost", std::make_shared<Message>(i),
+                {frame::mprpc::MessageFlagsE::AwaitResponse});
+            solid_check(!err, "sendMessage: " << err.message());
+
+            unique_lock<mutex> lock(mtx);
+
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(20), [i]() { return response_count == (i + 1); }), "Waiting for response took too long");
+
+            //force a reconnect for the next message
+            mprpcclient.closeConnection(connection_id);
+
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(20), [i]() { return stop_count == (i + 1); }), "Waiting for connection stop took too long");
+        }
+
+        const frame::mprpc::openssl::HandshakeStatistic& rclient_stat = frame::mprpc::openssl::client_handshake_statistic(mprpcclient.configuration());
+        const frame::mprpc::openssl::HandshakeStatistic& rserver_stat = frame::mprpc::openssl::server_handshake_statistic(mprpcserver.configuration());
+
+        solid_log(generic_logger, Statistic, "client:" << rclient_stat << " server:" << rserver_stat);
+
+        solid_check(rclient_stat.full_count_ == 1 && rclient_stat.resumed_count_ == (round_count - 1), "client:" << rclient_stat);
+        solid_check(rserver_stat.full_count_ == 1 && rserver_stat.resumed_count_ == (round_count - 1), "server:" << rserver_stat);
+
+        m.stop();
+    }
+
+    return 0;
+}
@@ -0,0 +1,247 @@
+#include "solid/frame/mprpc/mprpcconfiguration.hpp"
+#include "solid/frame/mprpc/mprpcprotocol_serialization_v2.hpp"
+#include "solid/frame/mprpc/mprpcservice.hpp"
+#include "solid/frame/mprpc/mprpcstripe.hpp"
+
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioactor.hpp"
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mprpc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             payload_size          = 8 * 1024 * 1024;
+size_t             part_size             = 256 * 1024;
+size_t             connection_count      = 4;
+size_t             server_connection_cnt = 0;
+size_t             completed_count       = 0;
+bool               received              = false;
+uint64_t           received_stripe_id    = 0;
+std::string        received_payload;
+
+void connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId());
+    auto lambda = [](frame::mprpc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        solid_dbg(generic_logger, Info, "enter active error: " << _rerror.message());
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+void server_connection_start(frame::mprpc::ConnectionContext& _rctx)
+{
+    {
+        lock_guard<mutex> lock(mtx);
+        ++server_connection_cnt;
+    }
+    connection_start(_rctx);
+}
+
+void server_stripe_complete(frame::mprpc::ConnectionContext& _rctx, const uint64_t _stripe_id, std::string&& _payload)
+{
+    solid_dbg(generic_logger, Info, _rctx.recipientId() << " stripe " << _stripe_id << " size " << _payload.size());
+    lock_guard<mutex> lock(mtx);
+    received_stripe_id = _stripe_id;
+    received_payload   = std::move(_payload);
+    received           = true;
+    ++completed_count;
+    cnd.notify_one();
+}
+
+std::shared_ptr<frame::mprpc::stripe::Message> make_part(
+    const uint64_t _stripe_id, const uint64_t _total_size, const uint64_t _offset,
+    const uint32_t _part_index, const uint32_t _part_count, const size_t _size)
+{
+    auto msgptr = std::make_shared<frame::mprpc::stripe::Message>();
+
+    msgptr->stripe_id  = _stripe_id;
+    msgptr->total_size = _total_size;
+    msgptr->offset     = _offset;
+    msgptr->part_index = _part_index;
+    msgptr->part_count = _part_count;
+    msgptr->data.assign(_size, 'x');
+    return msgptr;
+}
+
+} //namespace
+
+int test_clientserver_stripe(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {".*:EW"});
+
+    if (argc > 1) {
+        connection_count = atoi(argv[1]);
+        if (connection_count < 1) {
+            connection_count = 1;
+        }
+    }
+
+    std::string payload(payload_size, '\0');
+
+    for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<char>('a' + ((i / 7) % 26));
+    }
+
+    {
+        //the engines must outlive the services
+        frame::mprpc::stripe::Engine client_stripe([](frame::mprpc::ConnectionContext&, const uint64_t, std::string&&) {}, part_size);
+        const auto                   stripe_timeout = std::chrono::milliseconds(1000);
+
+        frame::mprpc::stripe::Engine::Limits stripe_limits;
+
+        //room for the valid payload but not for a second stripe next to it
+        stripe_limits.max_peer_pending_count = 2;
+        stripe_limits.max_peer_pending_size  = payload_size;
+
+        frame::mprpc::stripe::Engine server_stripe(server_stripe_complete, part_size, payload_size, stripe_timeout, stripe_limits);
+
+        AioSchedulerT sch_client;
+        AioSchedulerT sch_server;
+
+        frame::Manager         m;
+        frame::mprpc::ServiceT mprpcserver(m);
+        frame::mprpc::ServiceT mprpcclient(m);
+        ErrorConditionT        err;
+        CallPool<void()>       cwp{WorkPoolConfiguration(), 1};
+        frame::aio::Resolver   resolver(cwp);
+
+        sch_client.start(1);
+        sch_server.start(2);
+
+        std::string server_port;
+
+        { //mprpc server initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_server, proto);
+
+            proto->null(0);
+            server_stripe.setup(*proto, 1);
+
+            cfg.server.connection_start_fnc = &server_connection_start;
+            cfg.server.listener_address_str = "0.0.0.0:0";
+
+            mprpcserver.start(std::move(cfg));
+
+            {
+                std::ostringstream oss;
+                oss << mprpcserver.configuration().server.listenerPort();
+                server_port = oss.str();
+                solid_dbg(generic_logger, Info, "server listens on port: " << server_port);
+            }
+        }
+
+        { //mprpc client initialization
+            auto                        proto = ProtocolT::create();
+            frame::mprpc::Configuration cfg(sch_client, proto);
+
+            proto->null(0);
+            client_stripe.setup(*proto, 1);
+            client_stripe.setupMessageSize(cfg);
+            client_stripe.setupMultiplex(cfg);
+
+            cfg.pool_max_active_connection_count  = connection_count;
+            cfg.pool_max_pending_connection_count = connection_count;
+
+            cfg.client.connection_start_fnc = &connection_start;
+            cfg.client.name_resolve_fnc     = frame::mprpc::InternetResolverF(resolver, server_port.c_str() /*, SocketInfo::Inet4*/);
+
+            solid_check(cfg.writer.max_message_bytes_multiplex == part_size, "stripe setup should limit the writer byte budget");
+
+            mprpcclient.start(std::move(cfg));
+        }
+
+        //invalid parts are dropped and the incomplete stripes expire
+        {
+            //overlapping parts - the second one to arrive is dropped
+            err = mprpcclient.sendMessage("localhost", make_part(1, 2 * part_size, 0, 0, 2, part_size));
+            solid_check(!err, "sendMessage: " << err.message());
+            err = mprpcclient.sendMessage("localhost", make_part(1, 2 * part_size, part_size / 2, 1, 2, part_size));
+            solid_check(!err, "sendMessage: " << err.message());
+            //an empty part of a non empty payload
+            err = mprpcclient.sendMessage("localhost", make_part(2, part_size, 0, 0, 1, 0));
+            solid_check(!err, "sendMessage: " << err.message());
+            //more parts than the payload needs
+            err = mprpcclient.sendMessage("localhost", make_part(3, 10, 0, 0, 1000, 10));
+            solid_check(!err, "sendMessage: " << err.message());
+
+            const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+
+            while (server_stripe.rejectedCount() != 3 && std::chrono::steady_clock::now() < end_time) {
+                this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            solid_check(server_stripe.rejectedCount() == 3, "rejected parts: " << server_stripe.rejectedCount());
+            solid_check(server_stripe.pendingCount() == 1, "pending stripes: " << server_stripe.pendingCount());
+            solid_check(server_stripe.pendingSize() == 2 * part_size, "pending size: " << server_stripe.pendingSize());
+        }
+
+        //the stripes over the limits are dropped
+        {
+            //over max_peer_pending_size next to the pending stripe 1
+            err = mprpcclient.sendMessage("localhost", make_part(4, payload_size, 0, 0, payload_size / part_size, part_size));
+            solid_check(!err, "sendMessage: " << err.message());
+            //one of them is over max_peer_pending_count
+            err = mprpcclient.sendMessage("localhost", make_part(5, 2 * part_size, 0, 0, 2, part_size));
+            solid_check(!err, "sendMessage: " << err.message());
+            err = mprpcclient.sendMessage("localhost", make_part(6, 2 * part_size, 0, 0, 2, part_size));
+            solid_check(!err, "sendMessage: " << err.message());
+
+            const auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+
+            while (server_stripe.rejectedCount() != 5 && std::chrono::steady_clock::now() < end_time) {
+                this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            solid_check(server_stripe.rejectedCount() == 5, "rejected parts: " << server_stripe.rejectedCount());
+            solid_check(server_stripe.pendingCount() == 2, "pending stripes: " << server_stripe.pendingCount());
+            solid_check(server_stripe.pendingSize() == 4 * part_size, "pending size: " << server_stripe.pendingSize());
+
+            //the next received part drops the expired stripe
+            this_thread::sleep_for(2 * stripe_timeout);
+        }
+
+        uint64_t stripe_id = 0;
+
+        err = client_stripe.send(mprpcclient, "localhost", payload, &stripe_id);
+        solid_check(!err, "stripe send: " << err.message());
+
+        {
+            unique_lock<mutex> lock(mtx);
+            solid_check(cnd.wait_for(lock, std::chrono::seconds(60), []() { return received; }), "Waiting for the striped payload took too long");
+
+            solid_check(received_stripe_id == stripe_id, "invalid stripe id");
+            solid_check(completed_count == 1, "only the valid stripe should complete");
+            solid_check(received_payload == payload, "the reassembled payload differs");
+            solid_check(connection_count == 1 || server_connection_cnt > 1, "the payload was not striped over multiple connections: " << server_connection_cnt);
+        }
+        solid_check(server_stripe.pendingCount() == 0 && server_stripe.pendingSize() == 0, "incomplete stripes left behind");
+        solid_check(server_stripe.rejectedCount() == 5, "valid parts were dropped");
+
+        //m.stop();
+    }
+
+    return 0;
+}
@@ -34,21 +34,27 @@ typedef DynamicPointer<Actor> ActorPointerT;
 
 */
 class Reactor : public frame::ReactorBase {
-    typedef solid_function_t(void(ReactorContext&, Event&&)) EventFunctionT;
+    typedef solid_move_only_function_t(SOLID_FRAME_FUNCTION_STORAGE, void(ReactorContext&, Event&&)) EventFunctionT;
     template <class Function>
     struct StopActorF {
         Function function;
+        bool     wait;
         bool     repost;
 
         explicit StopActorF(Function&& _function)
-            : repost(true)
-            , function{std::forward<Function>(_function)}
+            : function{std::forward<Function>(_function)}
+            , wait(true)
+            , repost(true)
         {
         }
 
         void operator()(ReactorContext& _rctx, Event&& _revent)
         {
-            if (repost) { //skip one round - to guarantee that all remaining posts were delivered
+            if (wait) { //wait, without blocking, for the notifications started before disabling visits
+                wait = false;
+                EventFunctionT eventfnc(*this);
+                _rctx.reactor().doPostAfterGracePeriod(_rctx, std::move(eventfnc), std::move(_revent));
+            } else if (repost) { //skip one round - to guarantee that all remaining posts were delivered
                 repost = false;
                 EventFunctionT eventfnc(*this);
                 _rctx.reactor().doPost(_rctx, std::move(eventfnc), std::move(_revent));
@@ -98,6 +104,7 @@ public:
 
     bool raise(UniqueId const& _ractuid, Event const& _revt) override;
     bool raise(UniqueId const& _ractuid, Event&& _uevt) override;
+    bool raise(UniqueIdVectorT&& _uuid_vec, Event const& _revt) override;
     void stop() override;
 
     void registerCompletionHandler(CompletionHandler& _rch, Actor const& _ract);
@@ -125,6 +132,7 @@ private:
     bool doWaitEvent(NanoTime const& _rcrttime);
 
     void doCompleteTimer(NanoTime const& _rcrttime);
+    void doCompleteGracePeriod(NanoTime const& _rcrttime);
     void doCompleteExec(NanoTime const& _rcrttime);
     void doCompleteEvents(NanoTime const& _rcrttime);
     void doStoreSpecific();
@@ -133,11 +141,14 @@ private:
 
     void doPost(ReactorContext& _rctx, EventFunctionT&& _revfn, Event&& _uev);
     void doPost(ReactorContext& _rctx, EventFunctionT&& _revfn, Event&& _uev, CompletionHandler const& _rch);
+    void doPostAfterGracePeriod(ReactorContext& _rctx, EventFunctionT&& _revfn, Event&& _uev);
 
     void doStopActor(ReactorContext& _rctx);
+    bool notifyGracePeriodPassed(const size_t _actidx);
 
     void        onTimer(ReactorContext& _rctx, const size_t _tidx, const size_t _chidx);
     static void call_actor_on_event(ReactorContext& _rctx, Event&& _uevent);
+    static void stop_actor_wait(ReactorContext& _rctx, Event&& _uevent);
     static void stop_actor_repost(ReactorContext& _rctx, Event&& _uevent);
     static void stop_actor(ReactorContext& _rctx, Event&& _uevent);
 
@@ -10,7 +10,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "solid/frame/actorbase.hpp"
+#include "solid/system/statistic.hpp"
 #include "solid/utility/stack.hpp"
 
 namespace solid {
@@ -20,21 +23,83 @@ namespace frame {
 class Manager;
 class SchedulerBase;
 
+using UniqueIdVectorT = std::vector<UniqueId>;
+
+//! Snapshot of the event loop statistics of a reactor
+/*!
+    Only load_ and index_ are filled unless built with SOLID_HAS_STATISTICS.
+    Times are in nanoseconds.
+    Bucket i of exec_depth_histogram_ counts the exec queue depths in
+    [2^(i-1), 2^i) seen before every exec call, bucket 0 an empty queue,
+    the last bucket all the larger depths.
+    actor_type_vec_ has the time spent in the I/O completions and exec calls of
+    each actor type, the types over actor_type_capacity are summed
+    in a last entry with no name.
+*/
+struct ReactorStatistic : solid::Statistic {
+    static constexpr size_t exec_depth_bucket_count = 16;
+    static constexpr size_t actor_type_capacity     = 32;
+
+    struct ActorType {
+        const char* name_       = nullptr; //typeid name
+        uint64_t    call_count_ = 0;
+        uint64_t    time_ns_    = 0;
+    };
+
+    using ActorTypeVectorT = std::vector<ActorType>;
+
+    size_t           index_                  = 0; //within the scheduler
+    size_t           load_                   = 0;
+    uint64_t         loop_count_             = 0;
+    uint64_t         io_event_count_         = 0;
+    uint64_t         io_event_max_           = 0; //returned by a single wait
+    uint64_t         io_time_ns_             = 0;
+    uint64_t         timer_time_ns_          = 0;
+    uint64_t         event_time_ns_          = 0;
+    uint64_t         exec_time_ns_           = 0;
+    uint64_t         raise_count_            = 0;
+    uint64_t         raise_latency_total_ns_ = 0; //from raise to the actor's onEvent
+    uint64_t         raise_latency_max_ns_   = 0;
+    uint64_t         exec_depth_histogram_[exec_depth_bucket_count] = {};
+    ActorTypeVectorT actor_type_vec_;
+
+    double ioEventsPerLoop() const
+    {
+        return loop_count_ != 0 ? static_cast<double>(io_event_count_) / loop_count_ : 0;
+    }
+
+    uint64_t raiseLatencyAverageNs() const
+    {
+        return raise_count_ != 0 ? raise_latency_total_ns_ / raise_count_ : 0;
+    }
+
+    std::ostream& print(std::ostream& _ros) const override;
+};
+
+using ReactorStatisticVectorT = std::vector<ReactorStatistic>;
+
 //! The base for every selector
 /*!
  * The manager will call raise when an actor needs processor
  * time, e.g. because of an event.
+ * The UniqueIdVectorT overload raises the same event on all
+ * the given actors with a single wake-up of the reactor - the
+ * event is copied for every actor on the reactor's thread.
  */
 class ReactorBase : NonCopyable {
 public:
     virtual ~ReactorBase();
-    virtual bool raise(UniqueId const& _ractuid, Event const& _re) = 0;
-    virtual bool raise(UniqueId const& _ractuid, Event&& _ue)      = 0;
-    virtual void stop()                                            = 0;
+    virtual bool raise(UniqueId const& _ractuid, Event const& _re)    = 0;
+    virtual bool raise(UniqueId const& _ractuid, Event&& _ue)         = 0;
+    virtual bool raise(UniqueIdVectorT&& _uuid_vec, Event const& _re) = 0;
+    virtual void stop()                                               = 0;
+    //! Thread safe - fill _rstat with the current values
+    virtual void statistic(ReactorStatistic& _rstat) const;
 
     bool   prepareThread(const bool _success);
     void   unprepareThread();
     size_t load() const;
+    size_t idInScheduler() const;
 
 protected:
     typedef std::atomic<size_t> AtomicSizeT;
@@ -49,6 +114,7 @@ protected:
     }
 
     void           stopActor(ActorBase& _ract, Manager& _rm);
+    bool           notifyGracePeriodPassed(ActorBase& _ract, Manager& _rm);
     SchedulerBase& scheduler();
     UniqueId       popUid(ActorBase& _ract);
     void           pushUid(UniqueId const& _ruid);
@@ -59,7 +125,6 @@ protected:
 
 private:
     friend class SchedulerBase;
-    size_t idInScheduler() const;
 
 private:
     typedef Stack<UniqueId> UidStackT;
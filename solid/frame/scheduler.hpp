@@ -71,6 +71,8 @@ private:
     };
 
 public:
+    using SchedulerBase::statistic;
+
     Scheduler() {}
 
     void start(const size_t _reactorcnt = 1)
@@ -15,6 +15,7 @@
 #include "solid/system/pimpl.hpp"
 #include "solid/utility/function.hpp"
 #include <thread>
+#include <vector>
 
 namespace solid {
 
@@ -23,6 +24,7 @@ namespace frame {
 class Service;
 class ReactorBase;
 class ActorBase;
+struct ReactorStatistic;
 
 //typedef FunctorReference<bool, ReactorBase&>  ScheduleFunctorT;
 typedef solid_function_t(bool(ReactorBase&)) ScheduleFunctionT;
@@ -30,6 +32,9 @@ typedef solid_function_t(bool(ReactorBase&)) ScheduleFunctionT;
 //! A base class for all schedulers
 class SchedulerBase : NonCopyable {
 public:
+    //! Thread safe - a statistic snapshot for every running reactor
+    void statistic(std::vector<ReactorStatistic>& _rstat_vec) const;
+
 protected:
     typedef bool (*CreateWorkerF)(SchedulerBase& _rsch, const size_t, std::thread& _rthr);
 
@@ -81,7 +81,7 @@ public:
 
     bool registered() const;
 
-    void notifyAll(Event const& _e);
+    size_t notifyAll(Event const& _e);
 
     template <class F>
     bool forEach(F& _rf);
@@ -222,9 +222,9 @@ inline void Service::statusSetRunning()
     status_.store(StatusE::Running);
 }
 
-inline void Service::notifyAll(Event const& _revt)
+inline size_t Service::notifyAll(Event const& _revt)
 {
-    rm_.notifyAll(*this, _revt);
+    return rm_.notifyAll(*this, _revt);
 }
 
 inline void Service::doStart()
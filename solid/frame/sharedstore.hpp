@@ -16,7 +16,9 @@
 #include "solid/system/pimpl.hpp"
 #include "solid/utility/dynamictype.hpp"
 #include "solid/utility/function.hpp"
+#include <atomic>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -120,6 +122,7 @@ protected:
 private:
     friend struct PointerBase;
     void         erasePointer(UniqueId const& _ruid, const bool _isalive);
+    virtual bool doTryReleaseShared(UniqueId const& _uid)                            = 0;
     virtual bool doDecrementActorUseCount(UniqueId const& _uid, const bool _isalive) = 0;
     virtual bool doExecute()                                                         = 0;
     virtual void doResizeActorVector(const size_t _newsz)                            = 0;
@@ -279,7 +282,7 @@ public:
         PointerT                    ptr;
         {
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
-            Stub&                       rs = stubvec[idx];
+            Stub&                       rs = stub(idx);
             rs.act                         = _rt;
             ptr                            = doTryGetAlive(idx);
         }
@@ -293,7 +296,7 @@ public:
         PointerT                    ptr;
         {
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
-            Stub&                       rs = stubvec[idx];
+            Stub&                       rs = stub(idx);
             rs.act                         = _rt;
             ptr                            = doTryGetShared(idx);
         }
@@ -307,7 +310,7 @@ public:
         PointerT                    ptr;
         {
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
-            Stub&                       rs = stubvec[idx];
+            Stub&                       rs = stub(idx);
             rs.act                         = _rt;
             ptr                            = doTryGetUnique(idx);
         }
@@ -357,7 +360,7 @@ public:
         const size_t idx = _ruid.index;
         if (idx < this->atomicMaxCount()) {
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
-            Stub&                       rs = stubvec[idx];
+            Stub&                       rs = stub(idx);
             if (rs.uid == _ruid.unique) {
                 ptr = doTryGetAlive(idx);
             }
@@ -372,7 +375,7 @@ public:
         const size_t idx = _ruid.index;
         if (idx < this->atomicMaxCount()) {
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
-            Stub&                       rs = stubvec[idx];
+            Stub&                       rs = stub(idx);
             if (rs.uid == _ruid.unique) {
                 ptr = doTryGetUnique(idx);
             }
@@ -386,8 +389,12 @@ public:
         PointerT     ptr;
         const size_t idx = _ruid.index;
         if (idx < this->atomicMaxCount()) {
+            ptr = doTryFastGetShared(_ruid);
+            if (!ptr.empty()) {
+                return ptr;
+            }
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
-            Stub&                       rs = stubvec[idx];
+            Stub&                       rs = stub(idx);
             if (rs.uid == _ruid.unique) {
                 ptr = doTryGetShared(idx);
             }
@@ -403,7 +410,7 @@ public:
             const size_t idx = _rptr.id().index;
             if (idx < this->atomicMaxCount()) {
                 std::lock_guard<std::mutex> lock2(this->mutex(idx));
-                Stub&                       rs = stubvec[idx];
+                Stub&                       rs = stub(idx);
                 if (rs.uid == _rptr.id().unique) {
                     if (doSwitchUniqueToShared(idx)) {
                         if (rs.pwaitfirst && rs.pwaitfirst->kind == StoreBase::SharedWaitE) {
@@ -461,8 +468,13 @@ public:
         ErrorCodeT   err;
         const size_t idx = _ruid.index;
         if (idx < this->atomicMaxCount()) {
+            ptr = doTryFastGetShared(_ruid);
+            if (!ptr.empty()) {
+                _f(controller(), ptr, err);
+                return true;
+            }
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
-            Stub&                       rs = stubvec[idx];
+            Stub&                       rs = stub(idx);
             if (rs.uid == _ruid.unique) {
                 ptr = doTryGetShared(idx);
                 if (ptr.empty()) {
@@ -489,7 +501,7 @@ public:
         const size_t idx = _ruid.index;
         if (idx < this->atomicMaxCount()) {
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
-            Stub&                       rs = stubvec[idx];
+            Stub&                       rs = stub(idx);
             if (rs.uid == _ruid.unique) {
                 ptr = doTryGetUnique(idx);
                 if (ptr.empty()) {
@@ -517,7 +529,7 @@ public:
         const size_t idx = _ruid.index;
         if (idx < this->atomicMaxCount()) {
             std::lock_guard<std::mutex> lock2(this->mutex(idx));
-            Stub&                       rs = stubvec[idx];
+            Stub&                       rs = stub(idx);
             if (rs.uid == _ruid.unique) {
                 ptr = doTryGetReinit(idx);
                 if (ptr.empty()) {
@@ -554,11 +566,24 @@ private:
         WaitStub*           pnext;
         FunctionT           fnc;
     };
+    //! Per item state
+    /*!
+        usestate keeps the use count (in steps of UseStep) and the
+        SharedFlag, set while the item is shared and nobody waits for it.
+        While SharedFlag is set, shared pointers are acquired and released
+        (unless the last) without the item's mutex.
+        All other changes are made under the item's mutex.
+    */
     struct Stub {
+        enum : size_t {
+            SharedFlag = 1,
+            UseStep    = 2,
+        };
+
         Stub()
             : uid(0)
             , alivecnt(0)
-            , usecnt(0)
+            , usestate(0)
             , state(StoreBase::UnlockedStateE)
             , pwaitfirst(nullptr)
             , pwaitlast(nullptr)
@@ -572,39 +597,153 @@ private:
         }
         bool canClear() const
         {
-            return usecnt == 0 && alivecnt == 0 && pwaitfirst == nullptr;
+            return useCount() == 0 && alivecnt == 0 && pwaitfirst == nullptr;
+        }
+        size_t useCount() const
+        {
+            return usestate.load() / UseStep;
+        }
+        void acquireUse()
+        {
+            usestate.fetch_add(UseStep);
+        }
+        //! Returns true if it was the last use
+        bool releaseUse()
+        {
+            return usestate.fetch_sub(UseStep) / UseStep == 1;
+        }
+        //! Take the first use - closes the shared fast path
+        bool tryAcquireFirstUse()
+        {
+            size_t v = usestate.load();
+            return v / UseStep == 0 && usestate.compare_exchange_strong(v, UseStep);
+        }
+        //! Closes the shared fast path if not used
+        bool tryCloseUse()
+        {
+            size_t v = usestate.load();
+            return v / UseStep == 0 && usestate.compare_exchange_strong(v, 0);
+        }
+        void openShared()
+        {
+            usestate.fetch_or(SharedFlag);
+        }
+        void closeShared()
+        {
+            usestate.fetch_and(~static_cast<size_t>(SharedFlag));
+        }
+        bool tryFastAcquireShared()
+        {
+            size_t v = usestate.load();
+            while ((v & SharedFlag) != 0) {
+                if (usestate.compare_exchange_weak(v, v + UseStep)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        //! The last use is never released here - someone must be notified
+        bool tryFastReleaseShared()
+        {
+            size_t v = usestate.load();
+            while ((v & SharedFlag) != 0 && v / UseStep > 1) {
+                if (usestate.compare_exchange_weak(v, v - UseStep)) {
+                    return true;
+                }
+            }
+            return false;
         }
 
-        T         act;
-        uint32_t  uid;
-        size_t    alivecnt;
-        size_t    usecnt;
-        uint8_t   state;
-        WaitStub* pwaitfirst;
-        WaitStub* pwaitlast;
+        T                   act;
+        uint32_t            uid;
+        size_t              alivecnt;
+        std::atomic<size_t> usestate;
+        uint8_t             state;
+        WaitStub*           pwaitfirst;
+        WaitStub*           pwaitlast;
     };
 
-    typedef std::deque<Stub>     StubVectorT;
+    enum : size_t {
+        StubChunkBits = 10,
+        StubChunkSize = 1 << StubChunkBits,
+        StubChunkMask = StubChunkSize - 1,
+    };
+
+    using StubChunkPointerT = std::unique_ptr<Stub[]>;
+    using StubTablePointerT = std::unique_ptr<Stub*[]>;
+    using StubChunkVectorT  = std::vector<StubChunkPointerT>;
+    using StubTableVectorT  = std::vector<StubTablePointerT>;
+
     typedef std::deque<WaitStub> WaitDequeT;
 
+    //! Stubs are never moved so that they can be reached without locks
+    Stub& stub(const size_t _idx) const
+    {
+        Stub* const* ptable = pstubtable.load(std::memory_order_acquire);
+        return ptable[_idx >> StubChunkBits][_idx & StubChunkMask];
+    }
+
     /*virtual*/ void doResizeActorVector(const size_t _newsz)
     {
-        stubvec.resize(_newsz);
+        //all the index mutexes are locked
+        const size_t chunkcnt = (_newsz + StubChunkMask) >> StubChunkBits;
+        Stub**       ptable   = pstubtable.load(std::memory_order_relaxed);
+
+        if (chunkcnt > stubtablecp) {
+            //readers may still use the previous table so it is kept until destruction
+            size_t newcp = stubtablecp != 0 ? stubtablecp : 8;
+            while (newcp < chunkcnt) {
+                newcp <<= 1;
+            }
+            StubTablePointerT newtable(new Stub*[newcp]);
+            for (size_t i = 0; i < stubchunkvec.size(); ++i) {
+                newtable[i] = ptable[i];
+            }
+            ptable      = newtable.get();
+            stubtablecp = newcp;
+            stubtablevec.emplace_back(std::move(newtable));
+        }
+
+        while (stubchunkvec.size() < chunkcnt) {
+            stubchunkvec.emplace_back(new Stub[StubChunkSize]);
+            ptable[stubchunkvec.size() - 1] = stubchunkvec.back().get();
+        }
+        pstubtable.store(ptable, std::memory_order_release);
+    }
+
+    //! Wait-free shared pointer for an item that is already shared
+    PointerT doTryFastGetShared(UniqueId const& _ruid)
+    {
+        Stub& rs = stub(_ruid.index);
+        if (rs.tryFastAcquireShared()) {
+            //holding a use, the uid cannot change
+            PointerT ptr(&rs.act, this, UniqueId(_ruid.index, rs.uid));
+            if (rs.uid == _ruid.unique) {
+                return ptr;
+            }
+        }
+        return PointerT();
+    }
+
+    /*virtual*/ bool doTryReleaseShared(UniqueId const& _uid)
+    {
+        return stub(_uid.index).tryFastReleaseShared();
     }
 
     PointerT doTryGetAlive(const size_t _idx)
     {
-        Stub& rs = stubvec[_idx];
+        Stub& rs = stub(_idx);
         ++rs.alivecnt;
+        rs.closeShared();
         rs.state = StoreBase::UniqueLockStateE;
         return PointerT(nullptr, this, UniqueId(_idx, rs.uid));
     }
 
     PointerT doTryGetShared(const size_t _idx)
     {
-        Stub& rs = stubvec[_idx];
+        Stub& rs = stub(_idx);
         if (rs.state == StoreBase::SharedLockStateE && rs.pwaitfirst == nullptr) {
-            ++rs.usecnt;
+            rs.acquireUse();
             return PointerT(&rs.act, this, UniqueId(_idx, rs.uid));
         }
         return PointerT();
@@ -612,10 +751,9 @@ private:
 
     PointerT doTryGetUnique(const size_t _idx)
     {
-        Stub& rs = stubvec[_idx];
-        if (rs.usecnt == 0) {
+        Stub& rs = stub(_idx);
+        if (rs.tryAcquireFirstUse()) {
             solid_assert(rs.pwaitfirst == nullptr);
-            ++rs.usecnt;
             rs.state = StoreBase::UniqueLockStateE;
             return PointerT(&rs.act, this, UniqueId(_idx, rs.uid));
         }
@@ -623,9 +761,8 @@ private:
     }
     PointerT doTryGetReinit(const size_t _idx)
     {
-        Stub& rs = stubvec[_idx];
-        if (rs.usecnt == 0 && rs.alivecnt == 0 && rs.pwaitfirst == nullptr) {
-            ++rs.usecnt;
+        Stub& rs = stub(_idx);
+        if (rs.alivecnt == 0 && rs.pwaitfirst == nullptr && rs.tryAcquireFirstUse()) {
             rs.state = StoreBase::UniqueLockStateE;
             return PointerT(&rs.act, this, UniqueId(_idx, rs.uid));
         }
@@ -633,11 +770,14 @@ private:
     }
     bool doSwitchUniqueToShared(const size_t _idx)
     {
-        Stub& rs = stubvec[_idx];
+        Stub& rs = stub(_idx);
 
         if (rs.state == StoreBase::UniqueLockStateE) {
-            solid_assert(rs.usecnt == 1);
+            solid_assert(rs.useCount() == 1);
             rs.state = StoreBase::SharedLockStateE;
+            if (rs.pwaitfirst == nullptr) {
+                rs.openShared();
+            }
             return true;
         }
         return false;
@@ -645,7 +785,7 @@ private:
     template <typename F>
     void doPushWait(const size_t _idx, F& _f, const StoreBase::WaitKind _k)
     {
-        Stub&     rs    = stubvec[_idx];
+        Stub&     rs    = stub(_idx);
         WaitStub* pwait = reinterpret_cast<WaitStub*>(this->doTryAllocateWait());
         if (pwait == nullptr) {
             waitdq.push_back(WaitStub());
@@ -655,6 +795,8 @@ private:
         pwait->fnc   = std::move(_f);
         pwait->pnext = nullptr;
 
+        rs.closeShared();
+
         if (rs.pwaitlast == nullptr) {
             rs.pwaitfirst = rs.pwaitlast = pwait;
         } else {
@@ -666,14 +808,13 @@ private:
     /*virtual*/ bool doDecrementActorUseCount(UniqueId const& _uid, const bool _isalive)
     {
         //the coresponding mutex is already locked
-        Stub& rs = stubvec[_uid.index];
+        Stub& rs = stub(_uid.index);
         if (rs.uid == _uid.unique) {
             if (_isalive) {
                 --rs.alivecnt;
-                return rs.usecnt == 0 && rs.alivecnt == 0;
+                return rs.useCount() == 0 && rs.alivecnt == 0;
             } else {
-                --rs.usecnt;
-                return rs.usecnt == 0;
+                return rs.releaseUse();
             }
         }
         return false;
@@ -706,11 +847,11 @@ private:
                 pmtx = ptmpmtx;
                 pmtx->lock();
             }
-            Stub& rs = stubvec[it->index];
+            Stub& rs = stub(it->index);
             if (it->unique == rs.uid) {
                 if (static_cast<size_t>(it - reraseuidvec.begin()) >= eraseuidvecsize) {
                     //its an uid added by executeBeforeErase
-                    --rs.usecnt;
+                    rs.releaseUse();
                 }
                 if (rs.canClear()) {
                     rcacheidxvec.push_back(it->index);
@@ -740,8 +881,8 @@ private:
                         pmtx = ptmpmtx;
                         pmtx->lock();
                     }
-                    Stub& rs = stubvec[*it];
-                    if (rs.canClear()) {
+                    Stub& rs = stub(*it);
+                    if (rs.canClear() && rs.tryCloseUse()) {
                         rs.clear();
                         must_reschedule = controller().clear(acc, rs.act, *it) || must_reschedule;
                         StoreBase::doCacheActorIndex(*it);
@@ -756,13 +897,13 @@ private:
 
     void doExecuteErase(const size_t _idx)
     {
-        Stub&                       rs          = stubvec[_idx];
+        Stub&                       rs          = stub(_idx);
         WaitStub*                   pwait       = rs.pwaitfirst;
         StoreBase::ExecWaitVectorT& rexewaitvec = StoreBase::executeWaitVector();
         while (pwait) {
             switch (pwait->kind) {
             case StoreBase::UniqueWaitE:
-                if (rs.usecnt == 0) {
+                if (rs.useCount() == 0) {
                     //We can deliver
                     rs.state = StoreBase::UniqueLockStateE;
                 } else {
@@ -771,7 +912,7 @@ private:
                 }
                 break;
             case StoreBase::SharedWaitE:
-                if (rs.usecnt == 0 || rs.state == StoreBase::SharedLockStateE) {
+                if (rs.useCount() == 0 || rs.state == StoreBase::SharedLockStateE) {
                     rs.state = StoreBase::SharedLockStateE;
                 } else {
                     //cannot deliver right now - keep waiting
@@ -779,7 +920,7 @@ private:
                 }
                 break;
             case StoreBase::ReinitWaitE:
-                if (rs.usecnt == 0 && rs.alivecnt == 0) {
+                if (rs.useCount() == 0 && rs.alivecnt == 0) {
                     rs.state = StoreBase::UniqueLockStateE;
                 } else {
                     //cannot deliver right now - keep waiting
@@ -790,7 +931,7 @@ private:
                 solid_assert(false);
                 return;
             }
-            ++rs.usecnt;
+            rs.acquireUse();
             rexewaitvec.push_back(StoreBase::ExecWaitStub(UniqueId(_idx, rs.uid), &rs.act, pwait));
             if (pwait != rs.pwaitlast) {
                 rs.pwaitfirst = pwait->pnext;
@@ -799,11 +940,17 @@ private:
             }
             pwait = pwait->pnext;
         }
+        if (rs.state == StoreBase::SharedLockStateE) {
+            rs.openShared();
+        }
     }
 
 private:
-    StubVectorT stubvec;
-    WaitDequeT  waitdq;
+    std::atomic<Stub**> pstubtable{nullptr};
+    size_t              stubtablecp = 0;
+    StubTableVectorT    stubtablevec;
+    StubChunkVectorT    stubchunkvec;
+    WaitDequeT          waitdq;
 };
 
 inline void StoreBase::pointerId(PointerBase& _rpb, UniqueId const& _ruid)
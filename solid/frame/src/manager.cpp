@@ -8,6 +8,7 @@
 // See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
 //
 #include <deque>
+#include <functional>
 #include <vector>
 
 #include <climits>
@@ -20,6 +21,7 @@
 #include "solid/system/exception.hpp"
 #include "solid/system/memory.hpp"
 #include <atomic>
+#include <chrono>
 
 #include "solid/frame/actorbase.hpp"
 #include "solid/frame/manager.hpp"
@@ -173,6 +175,122 @@ public:
     }
 };
 
+//! Read epoch for the lock-free actor lookup
+/*!
+ * Readers announce themselves on a striped counter of the current epoch
+ * (wait-free, no shared cache line among threads on different stripes).
+ * Writers never wait on the readers: retire() returns a ticket for a state
+ * change and passed(ticket) tells, without blocking, whether every reader
+ * that might have seen the old state has left - i.e. the epoch moved two
+ * steps past the ticket. The epoch only advances when no reader remains
+ * on the parity it is about to reuse.
+ * The epoch is shared by all the managers, so a reactor can wait for the
+ * readers of any manager before going away (see synchronize).
+ */
+class ReadEpoch {
+    static constexpr size_t stripe_count = 32;
+
+    struct Stripe {
+        std::atomic<size_t> count_[2];
+        char                padding_[64 - 2 * sizeof(std::atomic<size_t>)];
+
+        Stripe()
+        {
+            count_[0] = 0;
+            count_[1] = 0;
+        }
+    };
+
+    std::atomic<uint64_t> epoch_;
+    Stripe                stripes_[stripe_count];
+
+    static size_t stripeIndex()
+    {
+        static thread_local const size_t idx = std::hash<std::thread::id>()(std::this_thread::get_id()) % stripe_count;
+        return idx;
+    }
+
+    ReadEpoch()
+        : epoch_(0)
+    {
+    }
+
+    bool tryAdvance()
+    {
+        uint64_t     epoch = epoch_.load();
+        const size_t idx   = (epoch + 1) & 1;
+
+        for (size_t i = 0; i < stripe_count; ++i) {
+            if (stripes_[i].count_[idx].load() != 0) {
+                return false;
+            }
+        }
+        //on failure, someone else advanced the epoch
+        epoch_.compare_exchange_strong(epoch, epoch + 1);
+        return true;
+    }
+
+public:
+    class Guard : NonCopyable {
+        std::atomic<size_t>& rcount_;
+
+    public:
+        Guard(ReadEpoch& _repoch)
+            : rcount_(_repoch.stripes_[stripeIndex()].count_[_repoch.epoch_.load() & 1])
+        {
+            rcount_.fetch_add(1);
+        }
+        ~Guard()
+        {
+            rcount_.fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    static ReadEpoch& instance()
+    {
+        static ReadEpoch epoch;
+        return epoch;
+    }
+
+    //must be called after the state change is visible to the readers
+    uint64_t retire()
+    {
+        return epoch_.load();
+    }
+
+    bool passed(const uint64_t _ticket)
+    {
+        while (epoch_.load() < _ticket + 2) {
+            if (!tryAdvance()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //blocking - only for rare events like a reactor going away
+    //yields a few times then sleeps with exponential backoff so that a long
+    //reader does not keep a core busy
+    void synchronize()
+    {
+        const uint64_t            ticket = retire();
+        size_t                    spins  = 0;
+        std::chrono::microseconds backoff(50);
+
+        while (!passed(ticket)) {
+            if (spins < 16) {
+                ++spins;
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(backoff);
+                if (backoff < std::chrono::milliseconds(8)) {
+                    backoff *= 2;
+                }
+            }
+        }
+    }
+};
+
 } //namespace
 //-----------------------------------------------------------------------------
 
@@ -186,31 +304,74 @@ using SizeStackT    = Stack<size_t>;
 using AtomicStatusT = std::atomic<StatusE>;
 
 //-----------------------------------------------------------------------------
-//POD structure
+//NOTE:
+//  All fields are modified under the chunk mutex.
+//  state_ holds the unique counter shifted by one and, on the lowest bit,
+//  whether the actor can be notified. While the bit is set, preactor_ and
+//  run_index_/run_unique_ do not change, so a lock-free reader can take a
+//  consistent snapshot by checking that state_ did not change while reading them.
+//  retire_epoch_ is the read epoch ticket taken when the visits were disabled.
 struct ActorStub {
-    ActorBase*   pactor_;
-    ReactorBase* preactor_;
-    UniqueT      unique_;
+    std::atomic<uint64_t>     state_;
+    std::atomic<ActorBase*>   pactor_;
+    std::atomic<ReactorBase*> preactor_;
+    std::atomic<IndexT>       run_index_;
+    std::atomic<UniqueT>      run_unique_;
+    uint64_t                  retire_epoch_;
+
+    ActorStub()
+        : state_(0)
+        , pactor_(nullptr)
+        , preactor_(nullptr)
+        , run_index_(static_cast<IndexT>(InvalidIndex()))
+        , run_unique_(0)
+        , retire_epoch_(0)
+    {
+    }
+
+    UniqueT unique() const
+    {
+        return static_cast<UniqueT>(state_.load() >> 1);
+    }
+
+    void enableVisits(const UniqueT _unique)
+    {
+        state_.store((static_cast<uint64_t>(_unique) << 1) | 1);
+    }
+
+    //returns true if the visits were enabled
+    bool disableVisits()
+    {
+        return (state_.fetch_and(~static_cast<uint64_t>(1)) & 1) != 0;
+    }
+
+    //returns true if the visits were enabled
+    bool nextUnique()
+    {
+        const uint64_t state = state_.load();
+        state_.store(((state >> 1) + 1) << 1);
+        return (state & 1) != 0;
+    }
 };
 
 struct ActorChunk {
-    std::mutex& rmutex_;
-    size_t      service_index_;
-    size_t      next_chunk_;
-    size_t      actor_count_;
+    std::mutex&         rmutex_;
+    std::atomic<size_t> service_index_;
+    std::atomic<size_t> next_chunk_;
+    size_t              actor_count_;
 
     ActorChunk(std::mutex& _rmutex)
         : rmutex_(_rmutex)
-        , service_index_(InvalidIndex())
-        , next_chunk_(InvalidIndex())
+        , service_index_(static_cast<size_t>(InvalidIndex()))
+        , next_chunk_(static_cast<size_t>(InvalidIndex()))
         , actor_count_(0)
     {
     }
 
     void clear()
     {
-        service_index_ = InvalidIndex();
-        next_chunk_    = InvalidIndex();
+        service_index_ = static_cast<size_t>(InvalidIndex());
+        next_chunk_    = static_cast<size_t>(InvalidIndex());
         actor_count_   = 0;
     }
 
@@ -335,6 +496,14 @@ struct ServiceStub {
 
 //---------------------------------------------------------
 struct Manager::Data {
+    using AtomicActorChunkPointerT = std::atomic<ActorChunk*>;
+    using AtomicChunkSegmentT      = std::atomic<AtomicActorChunkPointerT*>;
+
+    static constexpr size_t chunk_segment_bits = 10;
+    static constexpr size_t chunk_segment_size = 1 << chunk_segment_bits;
+    static constexpr size_t chunk_segment_mask = chunk_segment_size - 1;
+    static constexpr size_t chunk_segment_count = 1024;
+
     const size_t            service_mutex_count_;
     const size_t            actor_mutex_count_;
     const size_t            actor_chunk_size_;
@@ -346,6 +515,9 @@ struct Manager::Data {
     Cache<ActorChunkStub>   actor_chunk_cache_;
     std::mutex              mutex_;
     std::condition_variable condition_;
+    ReadEpoch&              read_epoch_;
+    //lock-free chunk index -> chunk table, filled under actor_chunk_cache_ lock
+    AtomicChunkSegmentT chunk_segment_array_[chunk_segment_count];
 
     Data(
         const size_t _service_mutex_count,
@@ -359,33 +531,156 @@ struct Manager::Data {
         char*       pdata        = new char[sizeof(ActorChunk) + actor_chunk_size_ * sizeof(ActorStub)];
         ActorChunk* pactor_chunk = new (pdata) ActorChunk(_rmtx);
         for (size_t i = 0; i < actor_chunk_size_; ++i) {
-            ActorStub& ras(pactor_chunk->actor(i));
-            ras.pactor_   = nullptr;
-            ras.preactor_ = nullptr;
-            ras.unique_   = 0;
+            new (&pactor_chunk->actor(i)) ActorStub;
         }
         return pactor_chunk;
     }
 
-    inline ActorChunkStub& chunk(const size_t _actor_index, std::unique_lock<std::mutex>& _rlock)
+    //called under actor_chunk_cache_ lock
+    void publishChunk(const size_t _chunk_index, ActorChunk* _pchunk)
     {
-        return actor_chunk_cache_.aquire(
-            _actor_index / actor_chunk_size_,
-            [&_rlock](const size_t, ActorChunkStub& _racs) {
-                _rlock = std::unique_lock<std::mutex>(_racs.chunk().mutex());
-            });
+        const size_t segment_index = _chunk_index >> chunk_segment_bits;
+
+        solid_check(segment_index < chunk_segment_count, "Too many actor chunks: " << _chunk_index);
+
+        AtomicActorChunkPointerT* psegment = chunk_segment_array_[segment_index].load(std::memory_order_relaxed);
+
+        if (psegment == nullptr) {
+            psegment = new AtomicActorChunkPointerT[chunk_segment_size];
+            for (size_t i = 0; i < chunk_segment_size; ++i) {
+                psegment[i].store(nullptr, std::memory_order_relaxed);
+            }
+            chunk_segment_array_[segment_index].store(psegment, std::memory_order_release);
+        }
+        psegment[_chunk_index & chunk_segment_mask].store(_pchunk, std::memory_order_release);
     }
 
-    inline ActorChunkStub* chunkPointer(const size_t _actor_index, std::unique_lock<std::mutex>& _rlock)
+    //lock-free: chunks are never freed before the manager
+    inline ActorChunk* chunkPointer(const size_t _actor_index) const
     {
-        return actor_chunk_cache_.aquirePointer(
-            _actor_index / actor_chunk_size_,
-            [&_rlock](const size_t, ActorChunkStub& _racs) {
-                _rlock = std::unique_lock<std::mutex>(_racs.chunk().mutex());
-            });
+        const size_t chunk_index   = _actor_index / actor_chunk_size_;
+        const size_t segment_index = chunk_index >> chunk_segment_bits;
+
+        if (segment_index < chunk_segment_count) {
+            AtomicActorChunkPointerT* psegment = chunk_segment_array_[segment_index].load(std::memory_order_acquire);
+            if (psegment != nullptr) {
+                return psegment[chunk_index & chunk_segment_mask].load(std::memory_order_acquire);
+            }
+        }
+        return nullptr;
+    }
+
+    inline ActorChunk& chunk(const size_t _actor_index) const
+    {
+        ActorChunk* pchunk = chunkPointer(_actor_index);
+        solid_assert(pchunk != nullptr);
+        return *pchunk;
+    }
+
+    inline ActorChunk& chunk(const size_t _actor_index, std::unique_lock<std::mutex>& _rlock) const
+    {
+        ActorChunk& rchunk = chunk(_actor_index);
+        _rlock             = std::unique_lock<std::mutex>(rchunk.mutex());
+        return rchunk;
+    }
+
+    inline ActorChunk* chunkPointer(const size_t _actor_index, std::unique_lock<std::mutex>& _rlock) const
+    {
+        ActorChunk* pchunk = chunkPointer(_actor_index);
+        if (pchunk != nullptr) {
+            _rlock = std::unique_lock<std::mutex>(pchunk->mutex());
+        }
+        return pchunk;
+    }
+
+    //lock-free snapshot of the reactor and run id of a notifiable actor
+    //must be called with a ReadEpoch::Guard
+    static bool snapshot(const ActorStub& _ras, const UniqueT _unique, ReactorBase*& _rpreactor, UniqueId& _rrun_id)
+    {
+        const uint64_t state = _ras.state_.load();
+
+        if ((state & 1) == 0 || static_cast<UniqueT>(state >> 1) != _unique) {
+            return false;
+        }
+
+        _rpreactor      = _ras.preactor_.load();
+        _rrun_id.index  = _ras.run_index_.load();
+        _rrun_id.unique = _ras.run_unique_.load();
+
+        return _rpreactor != nullptr && _ras.state_.load() == state;
     }
+
+    size_t broadcast(size_t _chunk_index, const size_t _service_index, Event const& _revent);
 };
 
+//! Raise an event on all the actors of a service, batched per reactor
+/*!
+ * Walks the service's chunk list without locking the chunks, groups the
+ * run ids of the notifiable actors by reactor and raises one batch per
+ * reactor for every window of broadcast_window_size actors.
+ * The read epoch is held for one window at a time so that stopping
+ * actors are not delayed by the whole walk.
+ */
+size_t Manager::Data::broadcast(size_t _chunk_index, const size_t _service_index, Event const& _revent)
+{
+    static constexpr size_t broadcast_window_size = 4096;
+
+    using ReactorUidVectorPairT = std::pair<ReactorBase*, UniqueIdVectorT>;
+    using ReactorUidVectorT     = std::vector<ReactorUidVectorPairT>;
+
+    ReactorUidVectorT reactor_vec;
+    size_t            notify_count = 0;
+
+    while (_chunk_index != InvalidIndex()) {
+        ReadEpoch::Guard guard(read_epoch_);
+        size_t           pending_count = 0;
+        size_t           reactor_index = 0;
+
+        do {
+            const ActorChunk& rchunk = chunk(_chunk_index * actor_chunk_size_);
+
+            if (rchunk.service_index_.load() != _service_index) {
+                //the chunk was released and maybe reused by another service
+                _chunk_index = InvalidIndex();
+                break;
+            }
+
+            for (size_t i = 0; i < actor_chunk_size_; ++i) {
+                const ActorStub& ras = rchunk.actor(i);
+                ReactorBase*     preactor;
+                UniqueId         run_id;
+
+                if (!snapshot(ras, ras.unique(), preactor, run_id)) {
+                    continue;
+                }
+
+                if (reactor_index >= reactor_vec.size() || reactor_vec[reactor_index].first != preactor) {
+                    for (reactor_index = 0; reactor_index < reactor_vec.size() && reactor_vec[reactor_index].first != preactor; ++reactor_index) {
+                    }
+                    if (reactor_index == reactor_vec.size()) {
+                        reactor_vec.emplace_back(preactor, UniqueIdVectorT());
+                    }
+                }
+                reactor_vec[reactor_index].second.emplace_back(run_id);
+                ++pending_count;
+            }
+
+            _chunk_index = rchunk.next_chunk_.load();
+        } while (_chunk_index != InvalidIndex() && pending_count < broadcast_window_size);
+
+        for (auto& rreactor_pair : reactor_vec) {
+            if (!rreactor_pair.second.empty()) {
+                const size_t count = rreactor_pair.second.size();
+                if (rreactor_pair.first->raise(std::move(rreactor_pair.second), _revent)) {
+                    notify_count += count;
+                }
+                rreactor_pair.second.clear();
+            }
+        }
+    }
+    return notify_count;
+}
+
 Manager::Data::Data(
     const size_t _service_mutex_count,
     const size_t _actor_mutex_count,
@@ -395,16 +690,24 @@ Manager::Data::Data(
     , actor_chunk_size_(_actor_chunk_size)
     , status_(StatusE::Running)
     , service_count_(0)
+    , read_epoch_(ReadEpoch::instance())
 {
     pactor_mutex_array_ = new std::mutex[actor_mutex_count_];
 
     pservice_mutex_array_ = new std::mutex[service_mutex_count_];
+
+    for (size_t i = 0; i < chunk_segment_count; ++i) {
+        chunk_segment_array_[i].store(nullptr, std::memory_order_relaxed);
+    }
 }
 
 Manager::Data::~Data()
 {
     delete[] pactor_mutex_array_; //TODO: get rid of delete
     delete[] pservice_mutex_array_;
+    for (size_t i = 0; i < chunk_segment_count; ++i) {
+        delete[] chunk_segment_array_[i].load(std::memory_order_relaxed);
+    }
 }
 
 Manager::Manager(
@@ -552,6 +855,7 @@ ActorIdT Manager::registerActor(
             [this](const size_t _index, ActorChunkStub& _racs) {
                 if (_racs.empty()) {
                     _racs.chunk(impl_->allocateChunk(impl_->pactor_mutex_array_[_index % impl_->actor_mutex_count_]));
+                    impl_->publishChunk(_index, &_racs.chunk());
                 }
             });
 
@@ -565,27 +869,22 @@ ActorIdT Manager::registerActor(
         } else {
             {
                 std::unique_lock<std::mutex> lock;
-                ActorChunkStub&              rlast_chunk = impl_->actor_chunk_cache_.aquire(
-                    rss.last_actor_chunk_,
-                    [&lock](const size_t, ActorChunkStub& _racs) {
-                        lock = std::unique_lock<std::mutex>(_racs.chunk().mutex());
-                    });
+                ActorChunk&                  rlast_chunk = impl_->chunk(rss.last_actor_chunk_ * impl_->actor_chunk_size_, lock);
 
-                rlast_chunk.chunk().next_chunk_ = actor_chunk_index;
+                rlast_chunk.next_chunk_ = actor_chunk_index;
             }
             rss.last_actor_chunk_ = actor_chunk_index;
         }
     }
     {
         std::unique_lock<std::mutex> lock;
-        ActorChunkStub&              racs   = impl_->chunk(actor_index, lock);
-        ActorChunk&                  rchunk = racs.chunk();
+        ActorChunk&                  rchunk = impl_->chunk(actor_index, lock);
 
-        if (rchunk.service_index_ == InvalidIndex()) {
+        if (rchunk.service_index_.load() == InvalidIndex()) {
             rchunk.service_index_ = _rservice.index();
         }
 
-        solid_assert(rchunk.service_index_ == _rservice.index());
+        solid_assert(rchunk.service_index_.load() == _rservice.index());
 
         _ractor.id(actor_index);
 
@@ -597,10 +896,13 @@ ActorIdT Manager::registerActor(
 
             ActorStub& ras = rchunk.actor(actor_index % impl_->actor_chunk_size_);
 
-            ras.pactor_   = &_ractor;
-            ras.preactor_ = &_rreactor;
-            retval.index  = actor_index;
-            retval.unique = ras.unique_;
+            ras.pactor_     = &_ractor;
+            ras.preactor_   = &_rreactor;
+            ras.run_index_  = _ractor.runId().index;
+            ras.run_unique_ = _ractor.runId().unique;
+            retval.index    = actor_index;
+            retval.unique   = ras.unique();
+            ras.enableVisits(retval.unique);
             ++rchunk.actor_count_;
             ++rss.actor_count_;
         } else {
@@ -619,14 +921,15 @@ void Manager::unregisterActor(ActorBase& _ractor)
     size_t actor_index   = static_cast<size_t>(_ractor.id());
     {
         std::unique_lock<std::mutex> lock;
-        ActorChunkStub&              racs   = impl_->chunk(actor_index, lock);
-        ActorChunk&                  rchunk = racs.chunk();
+        ActorChunk&                  rchunk = impl_->chunk(actor_index, lock);
 
         ActorStub& ras = rchunk.actor(actor_index % impl_->actor_chunk_size_);
 
+        //a lock-free reader that still raises on the old run id is harmless:
+        //the reactor drops events for stale run ids and waits for the readers before going away
+        ras.nextUnique();
         ras.pactor_   = nullptr;
         ras.preactor_ = nullptr;
-        ++ras.unique_;
 
         _ractor.id(InvalidIndex());
 
@@ -653,38 +956,85 @@ void Manager::unregisterActor(ActorBase& _ractor)
     }
 }
 
+//NOTE: does not wait for the notifications started before disabling visits
+// the reactor polls notifyGracePeriodPassed before stopping the actor
+// see the NOTE on ActorBase::disableVisits
 bool Manager::disableActorVisits(ActorBase& _ractor)
 {
     bool retval = false;
 
     if (_ractor.isRegistered()) {
-        size_t                       actor_index = static_cast<size_t>(_ractor.id());
+        size_t actor_index = static_cast<size_t>(_ractor.id());
+
         std::unique_lock<std::mutex> lock;
-        ActorChunkStub&              racs   = impl_->chunk(actor_index, lock);
-        ActorChunk&                  rchunk = racs.chunk();
+        ActorChunk&                  rchunk = impl_->chunk(actor_index, lock);
 
         ActorStub& ras = rchunk.actor(actor_index % impl_->actor_chunk_size_);
         retval         = (ras.preactor_ != nullptr);
-        ras.preactor_  = nullptr;
+        ras.disableVisits();
+        ras.preactor_     = nullptr;
+        ras.retire_epoch_ = impl_->read_epoch_.retire();
     }
     return retval;
 }
 
+bool Manager::notifyGracePeriodPassed(const ActorBase& _ractor)
+{
+    if (!_ractor.isRegistered()) {
+        return true;
+    }
+    const size_t actor_index = static_cast<size_t>(_ractor.id());
+    uint64_t     retire_epoch;
+    {
+        std::unique_lock<std::mutex> lock;
+        ActorChunk&                  rchunk = impl_->chunk(actor_index, lock);
+
+        retire_epoch = rchunk.actor(actor_index % impl_->actor_chunk_size_).retire_epoch_;
+    }
+    return impl_->read_epoch_.passed(retire_epoch);
+}
+
+/*static*/ void Manager::waitNotifyGracePeriod()
+{
+    ReadEpoch::instance().synchronize();
+}
+
+//NOTE: notify does not lock - the actor's reactor and run id are read from
+// the actor stub, under the read epoch.
 bool Manager::notify(ActorIdT const& _ruid, Event&& _uevt)
 {
-    const auto do_notify_fnc = [&_uevt](VisitContext& _rctx) {
-        return _rctx.raiseActor(std::move(_uevt));
-    };
+    const ActorChunk* pchunk = impl_->chunkPointer(_ruid.index);
+
+    if (pchunk != nullptr) {
+        ReadEpoch::Guard guard(impl_->read_epoch_);
+        ReactorBase*     preactor;
+        UniqueId         run_id;
 
-    return doVisit(_ruid, ActorVisitFunctionT{do_notify_fnc});
+        if (Data::snapshot(pchunk->actor(_ruid.index % impl_->actor_chunk_size_), _ruid.unique, preactor, run_id)) {
+            return preactor->raise(run_id, std::move(_uevt));
+        }
+    }
+    return false;
 }
 
-size_t Manager::notifyAll(const Service& _rsvc, Event const& _revt)
+size_t Manager::notifyAll(const Service& _rservice, Event const& _revt)
 {
-    const auto do_notify_fnc = [_revt](VisitContext& _rctx) {
-        return _rctx.raiseActor(_revt);
-    };
-    return doForEachServiceActor(_rsvc, ActorVisitFunctionT{do_notify_fnc});
+    if (!_rservice.registered()) {
+        return 0u;
+    }
+    const size_t service_index = _rservice.index();
+    size_t       chunk_index   = InvalidIndex();
+    {
+        std::unique_lock<std::mutex> lock;
+        ServiceStub&                 rss = impl_->service_cache_.aquire(
+            service_index,
+            [&lock](const size_t _index, ServiceStub& _rss) {
+                lock = std::unique_lock<std::mutex>(_rss.mutex());
+            });
+        chunk_index = rss.first_actor_chunk_;
+    }
+
+    return impl_->broadcast(chunk_index, service_index, _revt);
 }
 
 bool Manager::doVisit(ActorIdT const& _actor_id, const ActorVisitFunctionT _rfct)
@@ -693,13 +1043,14 @@ bool Manager::doVisit(ActorIdT const& _actor_id, const ActorVisitFunctionT _rfct
     bool retval = false;
 
     std::unique_lock<std::mutex> lock;
-    ActorChunkStub*              pacs = impl_->chunkPointer(_actor_id.index, lock);
-    if (pacs != nullptr) {
-        ActorChunk& rchunk = pacs->chunk();
-        ActorStub&  ras    = rchunk.actor(_actor_id.index % impl_->actor_chunk_size_);
-
-        if (ras.unique_ == _actor_id.unique && ras.pactor_ != nullptr && ras.preactor_ != nullptr) {
-            VisitContext ctx(*this, *ras.preactor_, *ras.pactor_);
+    ActorChunk*                  pchunk = impl_->chunkPointer(_actor_id.index, lock);
+    if (pchunk != nullptr) {
+        ActorStub&   ras      = pchunk->actor(_actor_id.index % impl_->actor_chunk_size_);
+        ActorBase*   pactor   = ras.pactor_.load();
+        ReactorBase* preactor = ras.preactor_.load();
+
+        if (ras.unique() == _actor_id.unique && pactor != nullptr && preactor != nullptr) {
+            VisitContext ctx(*this, *preactor, *pactor);
             retval = _rfct(ctx);
         }
     }
@@ -708,28 +1059,20 @@ bool Manager::doVisit(ActorIdT const& _actor_id, const ActorVisitFunctionT _rfct
 
 std::mutex& Manager::mutex(const ActorBase& _ractor) const
 {
-    size_t                       actor_index = static_cast<size_t>(_ractor.id());
-    std::unique_lock<std::mutex> lock;
-    ActorChunkStub&              racs   = impl_->chunk(actor_index, lock);
-    ActorChunk&                  rchunk = racs.chunk();
-
-    return rchunk.mutex();
+    return impl_->chunk(static_cast<size_t>(_ractor.id())).mutex();
 }
 
+//NOTE: lock-free - the unique of a registered actor changes only on its unregistration
 ActorIdT Manager::id(const ActorBase& _ractor) const
 {
     const IndexT actor_index = _ractor.id();
     ActorIdT     retval;
 
     if (actor_index != InvalidIndex()) {
-        std::unique_lock<std::mutex> lock;
-        ActorChunkStub&              racs   = impl_->chunk(actor_index, lock);
-        ActorChunk&                  rchunk = racs.chunk();
-        ActorStub&                   ras    = rchunk.actor(actor_index % impl_->actor_chunk_size_);
+        const ActorStub& ras = impl_->chunk(actor_index).actor(actor_index % impl_->actor_chunk_size_);
 
-        ActorBase* pactor = ras.pactor_;
-        solid_assert(pactor == &_ractor);
-        retval = ActorIdT(actor_index, ras.unique_);
+        solid_assert(ras.pactor_.load() == &_ractor);
+        retval = ActorIdT(actor_index, ras.unique());
     }
     return retval;
 }
@@ -777,14 +1120,15 @@ size_t Manager::doForEachServiceActor(const size_t _first_actor_chunk, const Act
     while (chunk_index != InvalidIndex()) {
 
         std::unique_lock<std::mutex> lock;
-        ActorChunkStub&              racs    = impl_->chunk(chunk_index * impl_->actor_chunk_size_, lock);
-        ActorChunk&                  rchunk  = racs.chunk();
+        ActorChunk&                  rchunk  = impl_->chunk(chunk_index * impl_->actor_chunk_size_, lock);
         ActorStub*                   pactors = rchunk.actors();
 
         for (size_t i(0), cnt(0); i < impl_->actor_chunk_size_ && cnt < rchunk.actor_count_; ++i) {
-            ActorStub& ractor = pactors[i];
-            if (ractor.pactor_ != nullptr && ractor.preactor_ != nullptr) {
-                VisitContext ctx(*this, *ractor.preactor_, *ractor.pactor_);
+            ActorStub&   ractor   = pactors[i];
+            ActorBase*   pactor   = ractor.pactor_.load();
+            ReactorBase* preactor = ractor.preactor_.load();
+            if (pactor != nullptr && preactor != nullptr) {
+                VisitContext ctx(*this, *preactor, *pactor);
                 _rvisit_fnc(ctx);
                 ++visited_count;
                 ++cnt;
@@ -802,15 +1146,7 @@ Service& Manager::service(const ActorBase& _ractor) const
 
     Service* pservice = nullptr;
 
-    size_t service_index = InvalidIndex();
-    {
-        size_t                       actor_index = static_cast<size_t>(_ractor.id());
-        std::unique_lock<std::mutex> lock;
-        ActorChunkStub&              racs   = impl_->chunk(actor_index, lock);
-        ActorChunk&                  rchunk = racs.chunk();
-
-        service_index = rchunk.service_index_;
-    }
+    const size_t service_index = impl_->chunk(static_cast<size_t>(_ractor.id())).service_index_.load();
 
     {
         std::unique_lock<std::mutex> lock;
@@ -875,11 +1211,8 @@ void Manager::stopService(Service& _rservice, const bool _wait)
     _rservice.statusSetStopping();
 
     if (rss.status_ == StatusE::Running) {
-        rss.status_             = StatusE::Stopping;
-        const auto raise_lambda = [](VisitContext& _rctx) {
-            return _rctx.raiseActor(make_event(GenericEvents::Kill));
-        };
-        const size_t cnt = doForEachServiceActor(rss.first_actor_chunk_, ActorVisitFunctionT{raise_lambda});
+        rss.status_      = StatusE::Stopping;
+        const size_t cnt = impl_->broadcast(rss.first_actor_chunk_, service_index, make_event(GenericEvents::Kill));
 
         if (cnt == 0 && rss.actor_count_ == 0) {
             solid_dbg(logger, Verbose, "StateStoppedE on " << service_index);
@@ -946,9 +1279,7 @@ void Manager::stop()
         }
     }
 
-    const auto raise_lambda = [](VisitContext& _rctx) {
-        return _rctx.raiseActor(make_event(GenericEvents::Kill));
-    };
+    const Event kill_event = make_event(GenericEvents::Kill);
 
     //broadcast to all actors to stop
     for (size_t service_index = 0; true; ++service_index) {
@@ -963,7 +1294,7 @@ void Manager::stop()
 
             if (pss->pservice_ != nullptr && pss->status_ == StatusE::Running) {
                 pss->status_     = StatusE::Stopping;
-                const size_t cnt = doForEachServiceActor(pss->first_actor_chunk_, ActorVisitFunctionT{raise_lambda});
+                const size_t cnt = impl_->broadcast(pss->first_actor_chunk_, service_index, kill_event);
                 (void)cnt;
 
                 if (pss->actor_count_ == 0) {
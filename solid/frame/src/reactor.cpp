@@ -121,6 +121,31 @@ struct RaiseEventStub {
     Event    event;
 };
 
+//NOTE: raise_index is the position within the raise vector
+//at the moment of the broadcast - used to keep the order of the events
+struct RaiseBroadcastStub {
+    RaiseBroadcastStub(
+        const size_t _raise_index, UniqueIdVectorT&& _uuid_vec, Event const& _revent)
+        : raise_index(_raise_index)
+        , uid_vec(std::move(_uuid_vec))
+        , event(_revent)
+    {
+    }
+
+    RaiseBroadcastStub(const RaiseBroadcastStub&) = delete;
+    RaiseBroadcastStub(
+        RaiseBroadcastStub&& _ubs) noexcept
+        : raise_index(_ubs.raise_index)
+        , uid_vec(std::move(_ubs.uid_vec))
+        , event(std::move(_ubs.event))
+    {
+    }
+
+    size_t          raise_index;
+    UniqueIdVectorT uid_vec;
+    Event           event;
+};
+
 struct CompletionHandlerStub {
     CompletionHandlerStub(
         CompletionHandler* _pch    = nullptr,
@@ -153,6 +178,10 @@ enum {
     MaxEventCapacity = 1024 * 64
 };
 
+//backoff for rechecking the grace period of the stopping actors
+constexpr std::chrono::microseconds grace_backoff_min{1000};
+constexpr std::chrono::microseconds grace_backoff_max{64 * 1000};
+
 struct ExecStub {
     template <class F>
     ExecStub(
@@ -204,12 +233,14 @@ struct ExecStub {
 
 typedef std::vector<NewTaskStub>          NewTaskVectorT;
 typedef std::vector<RaiseEventStub>       RaiseEventVectorT;
+typedef std::vector<RaiseBroadcastStub>   RaiseBroadcastVectorT;
 typedef std::deque<CompletionHandlerStub> CompletionHandlerDequeT;
 typedef std::vector<UniqueId>             UidVectorT;
 typedef std::deque<ActorStub>             ActorDequeT;
 typedef Queue<ExecStub>                   ExecQueueT;
 typedef Stack<size_t>                     SizeStackT;
 typedef TimeStore<size_t>                 TimeStoreT;
+typedef std::chrono::microseconds         MicrosecondsT;
 
 struct Reactor::Data {
     Data(
@@ -223,19 +254,30 @@ struct Reactor::Data {
         , crtraisevecsz(0)
         , actcnt(0)
         , timestore(MinEventCapacity)
+        , grace_backoff(grace_backoff_min)
     {
         pcrtpushtskvec = &pushtskvec[1];
         pcrtraisevec   = &raisevec[1];
+        pcrtbcastvec   = &bcastvec[1];
+    }
+
+    size_t raiseSize() const
+    {
+        return raisevec[crtraisevecidx].size() + bcastvec[crtraisevecidx].size();
     }
 
+    void pushRaiseEvents(RaiseEventVectorT& _rraise_vec, RaiseBroadcastVectorT& _rbcast_vec);
+
     int computeWaitTimeMilliseconds(NanoTime const& _rcrt) const
     {
+        NanoTime next;
+
         if (!exeq.empty()) {
             return 0;
         }
 
-        if (timestore.size() != 0u) {
-            if (_rcrt < timestore.next()) {
+        if (nextWakeTime(next)) {
+            if (_rcrt < next) {
                 const int64_t maxwait = 1000 * 60; //1 minute
                 int64_t       diff    = 0;
                 //                 NanoTime    delta = timestore.next();
@@ -243,7 +285,7 @@ struct Reactor::Data {
                 //                 diff = (delta.seconds() * 1000);
                 //                 diff += (delta.nanoSeconds() / 1000000);
                 const auto crt_tp  = _rcrt.timePointCast<std::chrono::steady_clock::time_point>();
-                const auto next_tp = timestore.next().timePointCast<std::chrono::steady_clock::time_point>();
+                const auto next_tp = next.timePointCast<std::chrono::steady_clock::time_point>();
                 diff               = std::chrono::duration_cast<std::chrono::milliseconds>(next_tp - crt_tp).count();
                 if (diff > maxwait) {
                     return maxwait;
@@ -256,6 +298,27 @@ struct Reactor::Data {
         return -1;
     }
 
+    //earliest of the next timer and the next grace period check
+    bool nextWakeTime(NanoTime& _rnext) const
+    {
+        bool rv = false;
+        if (timestore.size() != 0u) {
+            _rnext = timestore.next();
+            rv     = true;
+        }
+        if (!graceq.empty() && (!rv || grace_next < _rnext)) {
+            _rnext = grace_next;
+            rv     = true;
+        }
+        return rv;
+    }
+
+    void scheduleGraceCheck(NanoTime const& _rcrt, const MicrosecondsT _backoff)
+    {
+        grace_backoff = _backoff;
+        grace_next    = _rcrt.timePointCast<std::chrono::steady_clock::time_point>() + _backoff;
+    }
+
     UniqueId dummyCompletionHandlerUid() const
     {
         const size_t idx = eventact.dummyhandler.idxreactor;
@@ -272,18 +335,42 @@ struct Reactor::Data {
     TimeStoreT              timestore;
     NewTaskVectorT*         pcrtpushtskvec;
     RaiseEventVectorT*      pcrtraisevec;
+    RaiseBroadcastVectorT*  pcrtbcastvec;
     mutex                   mtx;
     condition_variable      cnd;
     NewTaskVectorT          pushtskvec[2];
     RaiseEventVectorT       raisevec[2];
+    RaiseBroadcastVectorT   bcastvec[2];
     EventActor              eventact;
     CompletionHandlerDequeT chdq;
     UidVectorT              freeuidvec;
     ActorDequeT             actdq;
     ExecQueueT              exeq;
+    ExecQueueT              graceq;
+    NanoTime                grace_next;
+    MicrosecondsT           grace_backoff;
     SizeStackT              chposcache;
 };
 
+//the broadcasts are fanned out in the order they were raised relative to single events
+void Reactor::Data::pushRaiseEvents(RaiseEventVectorT& _rraise_vec, RaiseBroadcastVectorT& _rbcast_vec)
+{
+    auto bcast_it = _rbcast_vec.begin();
+
+    for (size_t i = 0; i <= _rraise_vec.size(); ++i) {
+        for (; bcast_it != _rbcast_vec.end() && bcast_it->raise_index == i; ++bcast_it) {
+            for (const auto& ruid : bcast_it->uid_vec) {
+                exeq.push(ExecStub(ruid, &call_actor_on_event, dummyCompletionHandlerUid(), Event(bcast_it->event)));
+            }
+        }
+        if (i < _rraise_vec.size()) {
+            exeq.push(ExecStub(_rraise_vec[i].uid, &call_actor_on_event, dummyCompletionHandlerUid(), std::move(_rraise_vec[i].event)));
+        }
+    }
+    _rraise_vec.clear();
+    _rbcast_vec.clear();
+}
+
 Reactor::Reactor(
     SchedulerBase& _rsched,
     const size_t   _idx)
@@ -324,7 +411,7 @@ bool Reactor::start()
         lock_guard<mutex> lock(impl_->mtx);
 
         impl_->raisevec[impl_->crtraisevecidx].push_back(RaiseEventStub(_ractuid, _revent));
-        raisevecsz           = impl_->raisevec[impl_->crtraisevecidx].size();
+        raisevecsz           = impl_->raiseSize();
         impl_->crtraisevecsz = raisevecsz;
         if (raisevecsz == 1) {
             impl_->cnd.notify_one();
@@ -342,7 +429,28 @@ bool Reactor::start()
         lock_guard<mutex> lock(impl_->mtx);
 
         impl_->raisevec[impl_->crtraisevecidx].push_back(RaiseEventStub(_ractuid, std::move(_uevent)));
-        raisevecsz           = impl_->raisevec[impl_->crtraisevecidx].size();
+        raisevecsz           = impl_->raiseSize();
+        impl_->crtraisevecsz = raisevecsz;
+        if (raisevecsz == 1) {
+            impl_->cnd.notify_one();
+        }
+    }
+    return rv;
+}
+
+/*virtual*/ bool Reactor::raise(UniqueIdVectorT&& _uuid_vec, Event const& _revent)
+{
+    solid_dbg(logger, Verbose, (void*)this << " uid_count = " << _uuid_vec.size() << " event = " << _revent);
+    bool   rv         = true;
+    size_t raisevecsz = 0;
+    if (_uuid_vec.empty()) {
+        return rv;
+    }
+    {
+        lock_guard<mutex> lock(impl_->mtx);
+
+        impl_->bcastvec[impl_->crtraisevecidx].emplace_back(impl_->raisevec[impl_->crtraisevecidx].size(), std::move(_uuid_vec), _revent);
+        raisevecsz           = impl_->raiseSize();
         impl_->crtraisevecsz = raisevecsz;
         if (raisevecsz == 1) {
             impl_->cnd.notify_one();
@@ -398,6 +506,7 @@ void Reactor::run()
         }
         crttime = std::chrono::steady_clock::now();
         doCompleteTimer(crttime);
+        doCompleteGracePeriod(crttime);
 
         crttime = std::chrono::steady_clock::now();
         doCompleteExec(crttime);
@@ -443,6 +552,13 @@ void Reactor::doPost(ReactorContext& _rctx, EventFunctionT&& _revfn, Event&& _ue
     impl_->exeq.back().chnuid = UniqueId(_rch.idxreactor, impl_->chdq[_rch.idxreactor].unique);
 }
 
+/*static*/ void Reactor::stop_actor_wait(ReactorContext& _rctx, Event&&)
+{
+    Reactor& rthis = _rctx.reactor();
+
+    rthis.doPostAfterGracePeriod(_rctx, &stop_actor_repost, Event());
+}
+
 /*static*/ void Reactor::stop_actor_repost(ReactorContext& _rctx, Event&& /*_uevent*/)
 {
     Reactor& rthis = _rctx.reactor();
@@ -459,15 +575,82 @@ void Reactor::doPost(ReactorContext& _rctx, EventFunctionT&& _revfn, Event&& _ue
 
 /*NOTE:
     We do not stop the actor rightaway - we make sure that any
-    pending Events are delivered to the actor before we stop
+    pending Events are delivered to the actor before we stop:
+    first we wait, rechecking with backoff, until the notifications started
+    before disabling visits are done, then we repost once more so that the
+    events they raised are fetched before the stop.
 */
 void Reactor::postActorStop(ReactorContext& _rctx)
 {
     impl_->exeq.push(ExecStub(_rctx.actorUid()));
-    impl_->exeq.back().exefnc = &stop_actor_repost;
+    impl_->exeq.back().exefnc = &stop_actor_wait;
     impl_->exeq.back().chnuid = impl_->dummyCompletionHandlerUid();
 }
 
+bool Reactor::notifyGracePeriodPassed(const size_t _actidx)
+{
+    ActorStub& ros = this->impl_->actdq[_actidx];
+
+    return ReactorBase::notifyGracePeriodPassed(*ros.actptr, ros.psvc->manager());
+}
+
+//NOTE: instead of reposting on exeq until the grace period passes - which
+// would keep the reactor from ever waiting - the execution is parked on
+// graceq and rechecked from the reactor loop with an exponential backoff.
+void Reactor::doPostAfterGracePeriod(ReactorContext& _rctx, EventFunctionT&& _revfn, Event&& _uev)
+{
+    if (notifyGracePeriodPassed(_rctx.actidx)) {
+        doPost(_rctx, std::move(_revfn), std::move(_uev));
+        return;
+    }
+
+    //a new waiter restarts the backoff but does not delay an earlier check
+    const NanoTime next = impl_->grace_next;
+    impl_->scheduleGraceCheck(_rctx.nanoTime(), grace_backoff_min);
+    if (!impl_->graceq.empty() && next < impl_->grace_next) {
+        impl_->grace_next = next;
+    }
+
+    impl_->graceq.push(ExecStub(_rctx.actorUid(), std::move(_uev)));
+    impl_->graceq.back().exefnc = std::move(_revfn);
+    impl_->graceq.back().chnuid = impl_->dummyCompletionHandlerUid();
+}
+
+void Reactor::doCompleteGracePeriod(NanoTime const& _rcrttime)
+{
+    if (impl_->graceq.empty() || _rcrttime < impl_->grace_next) {
+        return;
+    }
+
+    size_t sz     = impl_->graceq.size();
+    bool   passed = false;
+
+    while ((sz--) != 0) {
+        ExecStub&    rexe(impl_->graceq.front());
+        const size_t actidx = static_cast<size_t>(rexe.actuid.index);
+
+        if (impl_->actdq[actidx].unique != rexe.actuid.unique) {
+            //the actor is gone - drop the execution
+        } else if (notifyGracePeriodPassed(actidx)) {
+            impl_->exeq.push(std::move(rexe));
+            passed = true;
+        } else {
+            impl_->graceq.push(std::move(rexe));
+        }
+        impl_->graceq.pop();
+    }
+
+    if (!impl_->graceq.empty()) {
+        MicrosecondsT backoff = impl_->grace_backoff;
+        if (passed) {
+            backoff = grace_backoff_min;
+        } else if (backoff < grace_backoff_max) {
+            backoff *= 2;
+        }
+        impl_->scheduleGraceCheck(_rcrttime, backoff);
+    }
+}
+
 void Reactor::doStopActor(ReactorContext& _rctx)
 {
     ActorStub& ros = this->impl_->actdq[_rctx.actidx];
@@ -582,6 +765,7 @@ bool Reactor::doWaitEvent(NanoTime const& _rcrttime)
         const size_t crtraisevecidx = impl_->crtraisevecidx;
         impl_->crtraisevecidx       = ((crtraisevecidx + 1) & 1);
         impl_->pcrtraisevec         = &impl_->raisevec[crtraisevecidx];
+        impl_->pcrtbcastvec         = &impl_->bcastvec[crtraisevecidx];
         rv                          = true;
     }
     return rv;
@@ -592,8 +776,9 @@ void Reactor::doCompleteEvents(NanoTime const& _rcrttime)
     solid_dbg(logger, Verbose, "");
 
     NewTaskVectorT&    crtpushvec  = *impl_->pcrtpushtskvec;
-    RaiseEventVectorT& crtraisevec = *impl_->pcrtraisevec;
-    ReactorContext     ctx(*this, _rcrttime);
+    RaiseEventVectorT&     crtraisevec = *impl_->pcrtraisevec;
+    RaiseBroadcastVectorT& crtbcastvec = *impl_->pcrtbcastvec;
+    ReactorContext         ctx(*this, _rcrttime);
 
     if (!crtpushvec.empty()) {
 
@@ -629,11 +814,8 @@ void Reactor::doCompleteEvents(NanoTime const& _rcrttime)
         crtpushvec.clear();
     }
 
-    if (!crtraisevec.empty()) {
-        for (auto& revent : crtraisevec) {
-            impl_->exeq.push(ExecStub(revent.uid, &call_actor_on_event, impl_->dummyCompletionHandlerUid(), std::move(revent.event)));
-        }
-        crtraisevec.clear();
+    if (!crtraisevec.empty() || !crtbcastvec.empty()) {
+        impl_->pushRaiseEvents(crtraisevec, crtbcastvec);
     }
 }
 
@@ -801,10 +983,48 @@ bool ReactorBase::prepareThread(const bool _success)
 }
 void ReactorBase::unprepareThread()
 {
+    //lock-free notifiers might still use a pointer to this reactor
+    Manager::waitNotifyGracePeriod();
     scheduler().unprepareThread(idInScheduler(), *this);
 }
 
+bool ReactorBase::notifyGracePeriodPassed(ActorBase& _ract, Manager& _rm)
+{
+    return _rm.notifyGracePeriodPassed(_ract);
+}
+
 ReactorBase::~ReactorBase() {}
 
+/*virtual*/ void ReactorBase::statistic(ReactorStatistic& _rstat) const
+{
+    _rstat.index_ = schidx;
+    _rstat.load_  = crtload;
+}
+
+std::ostream& ReactorStatistic::print(std::ostream& _ros) const
+{
+    _ros << "reactor " << index_ << ": load = " << load_;
+    _ros << " loop_count = " << loop_count_;
+    _ros << " io_event_count = " << io_event_count_;
+    _ros << " io_events_per_loop = " << ioEventsPerLoop();
+    _ros << " io_event_max = " << io_event_max_;
+    _ros << " io_time_ns = " << io_time_ns_;
+    _ros << " timer_time_ns = " << timer_time_ns_;
+    _ros << " event_time_ns = " << event_time_ns_;
+    _ros << " exec_time_ns = " << exec_time_ns_;
+    _ros << " raise_count = " << raise_count_;
+    _ros << " raise_latency_avg_ns = " << raiseLatencyAverageNs();
+    _ros << " raise_latency_max_ns = " << raise_latency_max_ns_;
+    _ros << " exec_depth_histogram = [";
+    for (size_t i = 0; i < exec_depth_bucket_count; ++i) {
+        _ros << (i != 0 ? " " : "") << exec_depth_histogram_[i];
+    }
+    _ros << ']';
+    for (const auto& ratype : actor_type_vec_) {
+        _ros << " actor " << (ratype.name_ != nullptr ? ratype.name_ : "<other>") << ": calls = " << ratype.call_count_ << " time_ns = " << ratype.time_ns_;
+    }
+    return _ros;
+}
+
 } //namespace frame
 } //namespace solid
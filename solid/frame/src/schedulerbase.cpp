@@ -363,6 +363,21 @@ size_t SchedulerBase::doComputeScheduleReactorIndex()
     return cwi;
 }
 
+void SchedulerBase::statistic(std::vector<ReactorStatistic>& _rstat_vec) const
+{
+    lock_guard<mutex> lock(impl_->mtx);
+
+    _rstat_vec.clear();
+    _rstat_vec.reserve(impl_->reactorvec.size());
+
+    for (const auto& rrs : impl_->reactorvec) {
+        if (rrs.preactor != nullptr) {
+            _rstat_vec.emplace_back();
+            rrs.preactor->statistic(_rstat_vec.back());
+        }
+    }
+}
+
 bool SchedulerBase::prepareThread(const size_t _idx, ReactorBase& _rreactor, const bool _success)
 {
     const bool thrensuccess = impl_->threnfnc();
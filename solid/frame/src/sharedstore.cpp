@@ -175,13 +175,19 @@ size_t StoreBase::doAllocateIndex()
 void StoreBase::erasePointer(UniqueId const& _ruid, const bool _isalive)
 {
     if (_ruid.index < impl_->objmaxcnt.load()) {
+        if (!_isalive && doTryReleaseShared(_ruid)) {
+            //not the last user of a shared item nobody waits for
+            return;
+        }
         bool do_notify = true;
         {
             std::lock_guard<std::mutex> lock(mutex(static_cast<size_t>(_ruid.index)));
             do_notify = doDecrementActorUseCount(_ruid, _isalive);
-            (void)do_notify;
         }
-        notifyActor(_ruid);
+        if (do_notify) {
+            //only the last user wakes the store - waiters and cleanup depend on it
+            notifyActor(_ruid);
+        }
     }
 }
 
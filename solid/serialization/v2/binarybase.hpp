@@ -20,6 +20,11 @@
 #include <utility>
 #include <vector>
 
+//! Inline storage for the functions scheduled by the serializer and deserializer
+#ifndef SOLID_SERIALIZATION_FUNCTION_STORAGE
+#define SOLID_SERIALIZATION_FUNCTION_STORAGE 48
+#endif
+
 namespace solid {
 namespace serialization {
 namespace v2 {
@@ -33,7 +33,7 @@ class DeserializerBase : public Base {
 
     typedef ReturnE (*CallbackT)(DeserializerBase&, Runnable&, void*);
 
-    using FunctionT = solid_function_t(ReturnE(DeserializerBase&, Runnable&, void*));
+    using FunctionT = solid_move_only_function_t(SOLID_SERIALIZATION_FUNCTION_STORAGE, ReturnE(DeserializerBase&, Runnable&, void*));
 
     struct Runnable {
         Runnable(
@@ -126,6 +126,16 @@ public:
         return run_lst_.empty();
     }
 
+    //! Memory still expected by a pending std::string, std::vector<char> or blob field
+    /*!
+     * Returns the number of bytes the current field still waits for, and sets
+     * _rpbuf to where they go, or 0 if the deserializer does not wait on such a field.
+     * The caller may fill (part of) that memory itself and report it through
+     * binaryDestinationFilled, instead of passing the bytes to run.
+     */
+    size_t binaryDestination(char*& _rpbuf) const;
+    void   binaryDestinationFilled(const size_t _sz);
+
     inline void addBasic(bool& _rb, const char* _name)
     {
         solid_dbg(logger, Info, _name);
@@ -389,7 +399,7 @@ public:
     {
         solid_dbg(logger, Info, _name);
 
-        typename C::value_type value;
+        typename C::value_type value{};
         bool                   init          = true;
         bool                   parsing_value = false;
         auto                   lambda        = [value, parsing_value, init](DeserializerBase& _rd, Runnable& _rr, void* _pctx) mutable {
@@ -452,7 +462,7 @@ public:
     {
         solid_dbg(logger, Info, _name);
 
-        typename C::value_type value;
+        typename C::value_type value{};
         bool                   init          = true;
         bool                   parsing_value = false;
         auto                   lambda        = [value, parsing_value, init](DeserializerBase& _rd, Runnable& _rr, void* _pctx) mutable {
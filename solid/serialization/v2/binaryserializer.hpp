@@ -33,7 +33,7 @@ class SerializerBase : public Base {
 
     typedef ReturnE (*CallbackT)(SerializerBase&, Runnable&, void*);
 
-    using FunctionT = solid_function_t(ReturnE(SerializerBase&, Runnable&, void*));
+    using FunctionT = solid_move_only_function_t(SOLID_SERIALIZATION_FUNCTION_STORAGE, ReturnE(SerializerBase&, Runnable&, void*));
 
     struct Runnable {
         Runnable(
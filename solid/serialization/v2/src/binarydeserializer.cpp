@@ -87,6 +87,27 @@ void DeserializerBase::clear()
     limits_.clear();
 }
 
+size_t DeserializerBase::binaryDestination(char*& _rpbuf) const
+{
+    if (!error_ && !run_lst_.empty() && run_lst_.front().call_ == &load_binary) {
+        const Runnable& rr = run_lst_.front();
+        _rpbuf             = static_cast<char*>(rr.ptr_);
+        return static_cast<size_t>(rr.size_);
+    }
+    return 0;
+}
+
+void DeserializerBase::binaryDestinationFilled(const size_t _sz)
+{
+    Runnable& rr = run_lst_.front();
+    solid_assert(rr.call_ == &load_binary && _sz <= rr.size_);
+    rr.size_ -= _sz;
+    rr.ptr_ = static_cast<char*>(rr.ptr_) + _sz;
+    if (rr.size_ == 0) {
+        run_lst_.pop_front();
+    }
+}
+
 void DeserializerBase::tryRun(Runnable&& _ur, void* _pctx)
 {
     const RunListIteratorT it = schedule(std::move(_ur));
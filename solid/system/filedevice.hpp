@@ -11,9 +11,66 @@
 #pragma once
 #include "seekabledevice.hpp"
 #include <fcntl.h>
+#include <memory>
 
 namespace solid {
 
+//! A read only, memory mapped range of a file
+/*!
+    Copies share the mapping which is unmapped together with the last copy,
+    so a view remains valid after its FileDevice was closed.
+    The data can be handed directly to a serializer (addBinary) or to a
+    send call - no copy through an intermediate buffer.
+*/
+class FileView {
+public:
+    enum Advice {
+        NormalE,
+        SequentialE, //!< Aggressive read ahead
+        RandomE, //!< No read ahead
+        WillNeedE, //!< Start reading the range in
+        DontNeedE //!< The range can be dropped from memory
+    };
+
+    FileView()
+        : pdata_(nullptr)
+        , size_(0)
+    {
+    }
+
+    const char* data() const
+    {
+        return pdata_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    //! A sub range, sharing the mapping, clamped to the current view
+    FileView view(size_t _off, size_t _sz) const;
+
+    //! Give the kernel a hint about how the view will be accessed
+    bool advise(const Advice _advice) const;
+
+    void clear();
+
+private:
+    friend class FileDevice;
+    struct Mapping;
+    using MappingPointerT = std::shared_ptr<const Mapping>;
+
+    MappingPointerT mapping_ptr_;
+    const char*     pdata_;
+    size_t          size_;
+};
+
 //! Wrapper for a file descriptor
 class FileDevice : public SeekableDevice {
 public:
@@ -45,6 +102,16 @@ public:
         there were no available file descriptors or kernel memory.
     */
     bool canRetryOpen() const;
+    //! Map a range of an opened file into memory
+    /*!
+        \param _rview Receives the mapped range
+        \param _off The start of the range - it needs no alignment
+        \param _sz The size of the range - 0 means up to the end of the file
+        \param _advice Initial access hint for the range
+        On error, returns false and the reason is in last_system_error().
+        Mapping an empty range succeeds with an empty view.
+    */
+    bool map(FileView& _rview, int64_t _off = 0, size_t _sz = 0, const FileView::Advice _advice = FileView::NormalE) const;
 };
 
 } //namespace solid
@@ -19,4 +19,19 @@ size_t memory_size();
 void*  memory_allocate_aligned(size_t _align, size_t _size);
 void   memory_free_aligned(void* _pv);
 
+//! Allocate from the calling thread's slab cache
+/*!
+ * Blocks are grouped on size classes of memory_slab_class_size bytes
+ * (up to memory_slab_max_size). Freed blocks are kept on a per-thread
+ * free list and reused by the next allocation of the same class on
+ * that thread - no locking, no shared cache lines between threads.
+ * Bigger sizes go directly to the global allocator.
+ * A block may be freed on a different thread than the one it was allocated on.
+ */
+void* memory_slab_allocate(size_t _size);
+void  memory_slab_free(void* _pv, size_t _size);
+
+constexpr size_t memory_slab_class_size = 64;
+constexpr size_t memory_slab_max_size   = 4096;
+
 } //namespace solid
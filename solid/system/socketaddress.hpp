@@ -18,6 +18,8 @@
 #endif
 
 #include <array>
+#include <cstddef>
+#include <cstring>
 #include <ostream>
 
 #include "solid/system/socketinfo.hpp"
@@ -1151,14 +1151,21 @@ inline size_t in_addr_hash(const in6_addr& _inaddr)
 #ifndef SOLID_ON_WINDOWS
 inline SocketAddressLocal::SocketAddressLocal()
 {
+    clear();
 }
-inline SocketAddressLocal::SocketAddressLocal(const char* /*_path*/)
+inline SocketAddressLocal::SocketAddressLocal(const char* _path)
 {
-    //TODO:
+    path(_path);
 }
 
-inline SocketAddressLocal& SocketAddressLocal::operator=(const SocketAddressStub&)
+inline SocketAddressLocal& SocketAddressLocal::operator=(const SocketAddressStub& _rsas)
 {
+    if (_rsas.isLocal() && static_cast<size_t>(_rsas.size()) <= sizeof(d)) {
+        memcpy(&d.addr, _rsas.sockAddr(), _rsas.size());
+        sz = _rsas.size();
+    } else {
+        clear();
+    }
     return *this;
 }
 
@@ -1186,40 +1193,44 @@ inline SocketAddressLocal::operator const sockaddr*() const
     return sockAddr();
 }
 
-inline bool SocketAddressLocal::operator<(const SocketAddressLocal& /*_raddr*/) const
+inline bool SocketAddressLocal::operator<(const SocketAddressLocal& _raddr) const
 {
-    //TODO
-    return false;
+    return strncmp(path(), _raddr.path(), sizeof(d.localaddr.sun_path)) < 0;
 }
-inline bool SocketAddressLocal::operator==(const SocketAddressLocal& /*_raddr*/) const
+inline bool SocketAddressLocal::operator==(const SocketAddressLocal& _raddr) const
 {
-    //TODO
-    return false;
+    return strncmp(path(), _raddr.path(), sizeof(d.localaddr.sun_path)) == 0;
 }
 
 inline void SocketAddressLocal::clear()
 {
-    //TODO
+    memset(&d.localaddr, 0, sizeof(d.localaddr));
+    d.localaddr.sun_family = AF_UNIX;
+    sz                     = 0;
 }
 inline size_t SocketAddressLocal::hash() const
 {
-    //TODO
-    return 0;
+    return addressHash();
 }
 inline size_t SocketAddressLocal::addressHash() const
 {
-    //TODO
-    return 0;
+    size_t h = 0;
+    for (const char* pc = path(); *pc != 0; ++pc) {
+        h = h * 31 + static_cast<unsigned char>(*pc);
+    }
+    return h;
 }
 
-inline void SocketAddressLocal::path(const char* /*_pth*/)
+//! Paths longer than sun_path are truncated
+inline void SocketAddressLocal::path(const char* _pth)
 {
-    //TODO
+    clear();
+    strncpy(d.localaddr.sun_path, _pth, sizeof(d.localaddr.sun_path) - 1);
+    sz = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + strlen(d.localaddr.sun_path) + 1);
 }
 inline const char* SocketAddressLocal::path() const
 {
-    //TODO
-    return NULL;
+    return d.localaddr.sun_path;
 }
 inline SocketAddressLocal::operator sockaddr*()
 {
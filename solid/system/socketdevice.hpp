@@ -46,6 +46,10 @@ public:
         SocketInfo::Family      = SocketInfo::Inet4,
         SocketInfo::Type _type  = SocketInfo::Stream,
         int              _proto = 0);
+#ifndef SOLID_ON_WINDOWS
+    //! Create a pair of connected local sockets: this one and _rother
+    ErrorCodeT createPair(SocketDevice& _rother, SocketInfo::Type _type = SocketInfo::Stream);
+#endif
     //! Connect the socket
     ErrorCodeT connect(const SocketAddressStub& _rsas, bool& _can_wait);
     ErrorCodeT connect(const SocketAddressStub& _rsas);
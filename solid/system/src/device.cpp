@@ -22,6 +22,7 @@
 #else
 #define _FILE_OFFSET_BITS 64
 #include <netinet/tcp.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -36,6 +37,7 @@
 #include "solid/system/directory.hpp"
 #include "solid/system/exception.hpp"
 #include "solid/system/filedevice.hpp"
+#include "solid/system/memory.hpp"
 #include "solid/system/socketdevice.hpp"
 #include "solid/system/socketinfo.hpp"
 
@@ -315,6 +317,124 @@ bool FileDevice::canRetryOpen() const
     return st.st_size;
 #endif
 }
+
+struct FileView::Mapping {
+    void*  paddr;
+    size_t size;
+
+    Mapping(void* _paddr, const size_t _size)
+        : paddr(_paddr)
+        , size(_size)
+    {
+    }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    ~Mapping()
+    {
+#ifdef SOLID_ON_WINDOWS
+        UnmapViewOfFile(paddr);
+#else
+        munmap(paddr, size);
+#endif
+    }
+};
+
+bool FileDevice::map(FileView& _rview, int64_t _off, size_t _sz, const FileView::Advice _advice) const
+{
+    _rview.clear();
+
+    if (_sz == 0) {
+        const int64_t filesz = size();
+        if (filesz < 0) {
+            return false;
+        }
+        if (filesz <= _off) {
+            return true;
+        }
+        _sz = static_cast<size_t>(filesz - _off);
+    }
+#ifdef SOLID_ON_WINDOWS
+    SYSTEM_INFO sysinfo;
+    GetSystemInfo(&sysinfo);
+
+    const int64_t alignedoff = _off - (_off % sysinfo.dwAllocationGranularity);
+    const size_t  mapsz      = _sz + static_cast<size_t>(_off - alignedoff);
+    HANDLE        hmap       = CreateFileMapping(descriptor(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (hmap == nullptr) {
+        return false;
+    }
+
+    void* paddr = MapViewOfFile(hmap, FILE_MAP_READ, static_cast<DWORD>(alignedoff >> 32), static_cast<DWORD>(alignedoff & 0xffffffff), mapsz);
+
+    //the view keeps the mapping object alive
+    CloseHandle(hmap);
+
+    if (paddr == nullptr) {
+        return false;
+    }
+#else
+    const int64_t pagesz     = static_cast<int64_t>(memory_page_size());
+    const int64_t alignedoff = _off - (_off % pagesz);
+    const size_t  mapsz      = _sz + static_cast<size_t>(_off - alignedoff);
+    void*         paddr      = mmap(nullptr, mapsz, PROT_READ, MAP_SHARED, descriptor(), alignedoff);
+
+    if (paddr == MAP_FAILED) {
+        return false;
+    }
+#endif
+    _rview.mapping_ptr_ = std::make_shared<const FileView::Mapping>(paddr, mapsz);
+    _rview.pdata_       = static_cast<const char*>(paddr) + (_off - alignedoff);
+    _rview.size_        = _sz;
+
+    if (_advice != FileView::NormalE) {
+        _rview.advise(_advice);
+    }
+    return true;
+}
+
+FileView FileView::view(size_t _off, size_t _sz) const
+{
+    FileView v;
+
+    if (_off < size_) {
+        if (_sz > (size_ - _off)) {
+            _sz = size_ - _off;
+        }
+        v.mapping_ptr_ = mapping_ptr_;
+        v.pdata_       = pdata_ + _off;
+        v.size_        = _sz;
+    }
+    return v;
+}
+
+bool FileView::advise(const Advice _advice) const
+{
+    if (empty()) {
+        return true;
+    }
+#ifdef SOLID_ON_WINDOWS
+    (void)_advice;
+    return true;
+#else
+    static const int advicemap[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED, MADV_DONTNEED};
+
+    //madvise needs a page aligned address
+    const size_t pagesz = memory_page_size();
+    const size_t padsz  = reinterpret_cast<uintptr_t>(pdata_) % pagesz;
+
+    return madvise(const_cast<char*>(pdata_ - padsz), size_ + padsz, advicemap[_advice]) == 0;
+#endif
+}
+
+void FileView::clear()
+{
+    mapping_ptr_.reset();
+    pdata_ = nullptr;
+    size_  = 0;
+}
 //-- Directory -------------------------------------
 /*static*/ bool Directory::create(const char* _fname)
 {
@@ -509,6 +629,19 @@ ErrorCodeT SocketDevice::create(
     return ok() ? ErrorCodeT() : last_socket_error();
 }
 
+#ifndef SOLID_ON_WINDOWS
+ErrorCodeT SocketDevice::createPair(SocketDevice& _rother, SocketInfo::Type _type)
+{
+    int fds[2];
+    if (::socketpair(AF_UNIX, _type, 0, fds) < 0) {
+        return last_socket_error();
+    }
+    Device::descriptor(fds[0]);
+    _rother.Device::descriptor(fds[1]);
+    return ErrorCodeT();
+}
+#endif
+
 ErrorCodeT SocketDevice::connect(const SocketAddressStub& _rsas, bool& _rcan_wait)
 {
 #ifdef SOLID_ON_WINDOWS
@@ -9,6 +9,7 @@
 //
 #include "solid/system/memory.hpp"
 #include <cstdlib>
+#include <new>
 
 #ifdef SOLID_ON_WINDOWS
 #define NOMINMAX
@@ -24,6 +25,100 @@
 namespace {
 size_t getMemorySize();
 size_t getMemoryPageSize();
+
+//-----------------------------------------------------------------------------
+//  SlabCache
+//-----------------------------------------------------------------------------
+
+class SlabCache {
+    static constexpr size_t class_count     = solid::memory_slab_max_size / solid::memory_slab_class_size;
+    static constexpr size_t class_max_bytes = 256 * 1024;
+
+    struct Node {
+        Node* pnext_;
+    };
+
+    struct Class {
+        Node*  phead_ = nullptr;
+        size_t count_ = 0;
+    };
+
+    Class class_arr_[class_count];
+
+    static size_t classIndex(const size_t _size)
+    {
+        return (_size - 1) / solid::memory_slab_class_size;
+    }
+
+    static size_t classSize(const size_t _index)
+    {
+        return (_index + 1) * solid::memory_slab_class_size;
+    }
+
+    static size_t classCapacity(const size_t _index)
+    {
+        return class_max_bytes / classSize(_index);
+    }
+
+public:
+    static SlabCache* instance();
+
+    ~SlabCache();
+
+    void* allocate(const size_t _size)
+    {
+        const size_t idx = classIndex(_size);
+        Class&       rc  = class_arr_[idx];
+        if (rc.phead_ != nullptr) {
+            Node* pn  = rc.phead_;
+            rc.phead_ = pn->pnext_;
+            --rc.count_;
+            return pn;
+        }
+        return ::operator new(classSize(idx));
+    }
+
+    void free(void* _pv, const size_t _size)
+    {
+        const size_t idx = classIndex(_size);
+        Class&       rc  = class_arr_[idx];
+        if (rc.count_ < classCapacity(idx)) {
+            Node* pn   = static_cast<Node*>(_pv);
+            pn->pnext_ = rc.phead_;
+            rc.phead_  = pn;
+            ++rc.count_;
+        } else {
+            ::operator delete(_pv);
+        }
+    }
+};
+
+//NOTE: the state flag outlives the thread_local cache so that a block
+//freed while the thread exits goes directly to the global allocator
+thread_local bool slab_cache_destroyed = false;
+
+SlabCache* SlabCache::instance()
+{
+    if (!slab_cache_destroyed) {
+        static thread_local SlabCache cache;
+        return &cache;
+    }
+    return nullptr;
+}
+
+SlabCache::~SlabCache()
+{
+    slab_cache_destroyed = true;
+    for (auto& rc : class_arr_) {
+        while (rc.phead_ != nullptr) {
+            Node* pn  = rc.phead_;
+            rc.phead_ = pn->pnext_;
+            ::operator delete(pn);
+        }
+        rc.count_ = 0;
+    }
+}
+
 } //namespace
 
 namespace solid {
@@ -62,6 +157,33 @@ size_t memory_size()
     return getMemorySize();
 }
 
+void* memory_slab_allocate(size_t _size)
+{
+    if (_size != 0 && _size <= memory_slab_max_size) {
+        SlabCache* pcache = SlabCache::instance();
+        if (pcache != nullptr) {
+            return pcache->allocate(_size);
+        }
+        return ::operator new(((_size - 1) / memory_slab_class_size + 1) * memory_slab_class_size);
+    }
+    return ::operator new(_size);
+}
+
+void memory_slab_free(void* _pv, size_t _size)
+{
+    if (_pv == nullptr) {
+        return;
+    }
+    if (_size != 0 && _size <= memory_slab_max_size) {
+        SlabCache* pcache = SlabCache::instance();
+        if (pcache != nullptr) {
+            pcache->free(_pv, _size);
+            return;
+        }
+    }
+    ::operator delete(_pv);
+}
+
 } //namespace solid
 
 namespace {
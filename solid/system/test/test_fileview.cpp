@@ -0,0 +1,74 @@
+#include "solid/system/exception.hpp"
+#include "solid/system/filedevice.hpp"
+#include "solid/system/memory.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+using namespace solid;
+
+int test_fileview(int /*argc*/, char* /*argv*/[])
+{
+    std::string path;
+    {
+        std::ostringstream oss;
+        oss << "/tmp/solid_test_fileview_" << getpid() << ".bin";
+        path = oss.str();
+    }
+
+    const size_t file_size = 3 * memory_page_size() + 123;
+    std::string  data(file_size, '\0');
+
+    for (size_t i = 0; i < file_size; ++i) {
+        data[i] = static_cast<char>('a' + (i * 7) % 26);
+    }
+
+    FileView view;
+    {
+        FileDevice fd;
+        solid_check(fd.create(path.c_str(), FileDevice::ReadWriteE));
+        solid_check(fd.write(data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+
+        //the whole file
+        solid_check(fd.map(view, 0, 0, FileView::SequentialE));
+        solid_check(view.size() == file_size && memcmp(view.data(), data.data(), file_size) == 0);
+
+        //unaligned offset, explicit size
+        FileView v;
+        solid_check(fd.map(v, memory_page_size() + 11, 1000, FileView::WillNeedE));
+        solid_check(v.size() == 1000 && memcmp(v.data(), data.data() + memory_page_size() + 11, 1000) == 0);
+        solid_check(v.advise(FileView::RandomE));
+
+        //past the end
+        solid_check(fd.map(v, file_size + 10));
+        solid_check(v.empty() && v.data() == nullptr);
+    }
+    //the view outlives the device
+    {
+        FileView sub = view.view(file_size - 100, 1000);
+        solid_check(sub.size() == 100 && memcmp(sub.data(), data.data() + file_size - 100, 100) == 0);
+
+        view.clear();
+        solid_check(view.empty());
+        //the mapping is kept alive by the sub view
+        solid_check(memcmp(sub.data(), data.data() + file_size - 100, 100) == 0);
+        solid_check(view.view(0, 10).empty());
+    }
+    {
+        FileDevice fd;
+        solid_check(fd.open(path.c_str(), FileDevice::ReadWriteE));
+        solid_check(fd.truncate(0));
+        solid_check(fd.map(view));
+        solid_check(view.empty());
+    }
+    {
+        FileDevice fd;
+        solid_check(!fd.map(view));
+    }
+
+    remove(path.c_str());
+    return 0;
+}
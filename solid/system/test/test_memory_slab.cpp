@@ -0,0 +1,53 @@
+#include "solid/system/exception.hpp"
+#include "solid/system/memory.hpp"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace solid;
+
+int test_memory_slab(int /*argc*/, char* /*argv*/[])
+{
+    {
+        //a freed block is reused by the next allocation from the same size class
+        void* p1 = memory_slab_allocate(100);
+        memset(p1, 1, 100);
+        memory_slab_free(p1, 100);
+        void* p2 = memory_slab_allocate(128);
+        solid_check(p1 == p2);
+        memory_slab_free(p2, 128);
+
+        void* p3 = memory_slab_allocate(129);
+        solid_check(p3 != p1);
+        memory_slab_free(p3, 129);
+    }
+    {
+        //sizes outside the slab classes
+        void* p = memory_slab_allocate(memory_slab_max_size + 1);
+        memset(p, 1, memory_slab_max_size + 1);
+        memory_slab_free(p, memory_slab_max_size + 1);
+        memory_slab_free(nullptr, 10);
+    }
+    {
+        //blocks allocated on one thread, freed on another
+        std::vector<void*> ptr_vec;
+        for (size_t i = 1; i <= 10000; ++i) {
+            const size_t sz = i % memory_slab_max_size + 1;
+            void*        p  = memory_slab_allocate(sz);
+            memset(p, static_cast<int>(i), sz);
+            ptr_vec.emplace_back(p);
+        }
+        std::thread thr(
+            [&ptr_vec]() {
+                size_t i = 1;
+                for (auto p : ptr_vec) {
+                    memory_slab_free(p, i % memory_slab_max_size + 1);
+                    ++i;
+                }
+                //the blocks cached by the thread are released on thread exit
+            });
+        thr.join();
+    }
+    return 0;
+}
@@ -223,7 +223,7 @@ public:
         solid_check(_rany.empty() == this->empty(), "Copy Non Copyable");
     }
 
-    Any(ThisT&& _rany)
+    Any(ThisT&& _rany) noexcept
         : AnyBase(doMoveFrom(_rany, this->dataPtr(), DataSize, _rany.usesData()))
     {
         _rany.release(pvalue_);
@@ -316,7 +316,7 @@ public:
         return *this;
     }
 
-    Any& operator=(Any&& _rany)
+    Any& operator=(Any&& _rany) noexcept
     {
         if (static_cast<const void*>(this) != static_cast<const void*>(&_rany)) {
             clear();
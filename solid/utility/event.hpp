@@ -36,16 +36,32 @@ class EventHandlerBase;
 //-----------------------------------------------------------------------------
 
 struct Event {
-    static constexpr size_t any_size = any_min_data_size + max_size(sizeof(void*) + sizeof(uint64_t), sizeof(std::shared_ptr<uint64_t>));
+    //! Payload bytes stored inline, bigger payloads are heap allocated
+    /*!
+        Can be raised at build time with cmake -DSOLID_EVENT_INLINE_SIZE=<bytes>.
+    */
+#ifdef SOLID_EVENT_INLINE_SIZE
+    static constexpr size_t inline_size = max_size(SOLID_EVENT_INLINE_SIZE, max_size(sizeof(void*) + sizeof(uint64_t), sizeof(std::shared_ptr<uint64_t>)));
+#else
+    static constexpr size_t inline_size = max_size(sizeof(void*) + sizeof(uint64_t), sizeof(std::shared_ptr<uint64_t>));
+#endif
+    static constexpr size_t any_size = any_min_data_size + inline_size;
 
     using AnyT = Any<any_size>;
 
+    //! True if a T payload is stored without allocation
+    template <class T>
+    static constexpr bool fitsInline()
+    {
+        return any_data_size<typename std::decay<T>::type>() <= any_size;
+    }
+
     Event();
-    Event(Event&&);
+    Event(Event&&) noexcept;
     Event(const Event&);
 
     Event& operator=(const Event&);
-    Event& operator=(Event&&);
+    Event& operator=(Event&&) noexcept;
 
     std::ostream& print(std::ostream& _ros) const;
 
@@ -123,12 +139,27 @@ public:
         return name_;
     }
 
+    //! Small, dense index used by EventHandler for table dispatch
+    size_t index() const
+    {
+        return index_;
+    }
+
 protected:
     EventCategoryBase(const std::string& _name)
         : name_(_name)
+        , index_(next_index())
+    {
+    }
+
+    EventCategoryBase(const std::string& _name, const size_t _index)
+        : name_(_name)
+        , index_(_index)
     {
     }
 
+    static size_t next_index();
+
     virtual ~EventCategoryBase() {}
 
     Event event(const size_t _idx) const
@@ -158,7 +189,8 @@ private:
     virtual const char* name(const Event& _revt) const = 0;
 
 private:
-    std::string name_;
+    std::string  name_;
+    const size_t index_;
 };
 
 //-----------------------------------------------------------------------------
@@ -172,7 +204,7 @@ class EventCategory : public EventCategoryBase {
 public:
     template <typename F>
     EventCategory(const std::string& _name, F _f)
-        : EventCategoryBase(_name)
+        : EventCategoryBase(_name, type_index())
         , names_fnc_(std::move(_f))
     {
     }
@@ -195,6 +227,13 @@ public:
     }
 
 private:
+    //all the categories with the same EventIds share the index
+    static size_t type_index()
+    {
+        static const size_t idx = next_index();
+        return idx;
+    }
+
     virtual const char* name(const Event& _revt) const override
     {
         return names_fnc_(static_cast<EventIds>(eventId(_revt)));
@@ -243,7 +282,7 @@ inline Event::Event()
 {
 }
 
-inline Event::Event(Event&& _uevt)
+inline Event::Event(Event&& _uevt) noexcept
     : pcategory_(_uevt.pcategory_)
     , id_(_uevt.id_)
     , any_(std::move(_uevt.any_))
@@ -267,7 +306,7 @@ inline Event& Event::operator=(const Event& _revt)
     return *this;
 }
 
-inline Event& Event::operator=(Event&& _uevt)
+inline Event& Event::operator=(Event&& _uevt) noexcept
 {
     pcategory_       = _uevt.pcategory_;
     id_              = _uevt.id_;
@@ -334,9 +373,9 @@ public:
     using FunctionT = solid_function_t(RetVal(Event&, Args...));
 
 private:
-    using FunctionVectorT = std::vector<FunctionT>;
-    using SizeTPairT      = std::pair<size_t, size_t>;
-    using TypeIndexMapT   = std::unordered_map<std::type_index, SizeTPairT>;
+    using FunctionVectorT  = std::vector<FunctionT>;
+    using SizeTPairT       = std::pair<size_t, size_t>; //offset in function_vec_, id count
+    using SizeTPairVectorT = std::vector<SizeTPairT>; //indexed by EventCategoryBase::index()
 
 public:
     struct InitItem {
@@ -357,52 +396,39 @@ public:
         std::initializer_list<InitItem> init_lst)
         : invalid_event_fnc_(std::cref(_rf))
     {
-        {
-            size_t vec_size = 0;
-            for (const InitItem& it : init_lst) {
-                const std::type_index category_type_index{typeid(*eventCategory(it.evt))};
-                auto                  map_it = category_map_.find(category_type_index);
-
-                if (map_it != category_map_.end()) {
-                    if (map_it->second.second < eventId(it.evt)) {
-                        vec_size += (eventId(it.evt) - map_it->second.second);
-                        map_it->second.second = eventId(it.evt);
-                    }
-                } else {
-                    category_map_[category_type_index] = SizeTPairT(0, eventId(it.evt));
-                    vec_size += (eventId(it.evt) + 1);
-                }
+        for (const InitItem& it : init_lst) {
+            const size_t category_index = eventCategory(it.evt)->index();
+            if (category_index >= category_vec_.size()) {
+                category_vec_.resize(category_index + 1, SizeTPairT(0, 0));
+            }
+            SizeTPairT& categ_pair = category_vec_[category_index];
+            if (categ_pair.second <= eventId(it.evt)) {
+                categ_pair.second = eventId(it.evt) + 1;
             }
-
-            function_vec_.resize(vec_size);
         }
 
         {
             size_t crt_off = 0;
-            for (auto it = category_map_.begin(); it != category_map_.end(); ++it) {
-                size_t skip      = it->second.second + 1;
-                it->second.first = crt_off;
-                crt_off += skip;
+            for (auto& categ_pair : category_vec_) {
+                categ_pair.first = crt_off;
+                crt_off += categ_pair.second;
             }
+            function_vec_.resize(crt_off);
         }
 
         for (const InitItem& it : init_lst) {
-            const std::type_index category_type_index{typeid(*eventCategory(it.evt))};
-            SizeTPairT&           categ_pair = category_map_[category_type_index];
-
-            FunctionT& f = function_vec_[categ_pair.first + eventId(it.evt)];
+            const SizeTPairT& categ_pair = category_vec_[eventCategory(it.evt)->index()];
 
-            f = it.fnc;
+            function_vec_[categ_pair.first + eventId(it.evt)] = it.fnc;
         }
     }
 
     RetVal handle(Event& _revt, Args... args) const
     {
-        const std::type_index category_type_index{typeid(*eventCategory(_revt))};
-        auto                  map_it = category_map_.find(category_type_index);
-        if (map_it != category_map_.end()) {
-            const SizeTPairT& categ_pair = map_it->second;
-            if (eventId(_revt) <= categ_pair.second) {
+        const size_t category_index = eventCategory(_revt)->index();
+        if (category_index < category_vec_.size()) {
+            const SizeTPairT& categ_pair = category_vec_[category_index];
+            if (eventId(_revt) < categ_pair.second) {
                 const FunctionT& rfnc = function_vec_[categ_pair.first + eventId(_revt)];
                 if (rfnc) {
                     return rfnc(_revt, args...);
@@ -419,9 +445,9 @@ private:
     EventHandler& operator=(EventHandler&&) = delete;
 
 private:
-    FunctionT       invalid_event_fnc_;
-    TypeIndexMapT   category_map_;
-    FunctionVectorT function_vec_;
+    FunctionT        invalid_event_fnc_;
+    SizeTPairVectorT category_vec_;
+    FunctionVectorT  function_vec_;
 };
 
 } //namespace solid
@@ -148,13 +148,22 @@ struct FunctionValue<T, false, R, ArgTypes...> : FunctionValueInter<R, ArgTypes.
 
 } //namespace impl
 
-//constexpr size_t function_min_data_size = sizeof(impl::FunctionValue<void*, true, void>);
-
-// template <class T>
-// constexpr size_t function_data_size()
-// {
-//     return sizeof(impl::FunctionValue<T>);
-// }
+//! Called where a callable does not fit the inline storage of a Function
+/*!
+    Build with -DSOLID_FUNCTION_REPORT_HEAP to get a compiler warning,
+    with the instantiation chain, for every call site that spills to heap.
+*/
+#ifdef SOLID_FUNCTION_REPORT_HEAP
+template <class T, size_t DataSize>
+[[deprecated("the callable does not fit the inline storage of solid::Function - it is heap allocated")]] inline void function_report_heap()
+{
+}
+#else
+template <class T, size_t DataSize>
+inline void function_report_heap()
+{
+}
+#endif
 
 //-----------------------------------------------------------------------------
 //      FunctionBase
@@ -246,6 +255,13 @@ public:
     using FunctionValueT      = impl::FunctionValue<T, std::is_copy_constructible<T>::value, R, ArgTypes...>;
     using FunctionValueInterT = impl::FunctionValueInter<R, ArgTypes...>;
 
+    //! True if a T callable is stored without allocation
+    template <class T>
+    static constexpr bool fitsInline()
+    {
+        return sizeof(FunctionValueT<typename std::decay<T>::type>) <= DataSize;
+    }
+
     Function() {}
 
     explicit Function(std::nullptr_t) {}
@@ -403,6 +419,7 @@ private:
     template <class T>
     impl::FunctionValueBase* do_allocate(std::false_type /*_is_any*/, std::false_type /*_plain_new*/, T&& _arg)
     {
+        function_report_heap<T, DataSize>();
         return new FunctionValueT<T>(std::forward<T>(_arg));
     }
 
@@ -435,6 +452,210 @@ private:
     }
 };
 
+//-----------------------------------------------------------------------------
+//      MoveOnlyFunction<Size>
+//-----------------------------------------------------------------------------
+//! A Function for callables that are only moved
+/*!
+    No copy machinery: the callable needs not be copy constructible, the
+    inline storage holds the callable itself (no virtual table pointer) and
+    calls go through a plain table of function pointers.
+    Callables bigger than DataSize, or with throwing move constructors,
+    are heap allocated.
+*/
+template <class, size_t DataSize = SOLID_FUNCTION_STORAGE>
+class MoveOnlyFunction; // undefined
+
+template <class R, class... ArgTypes, size_t DataSize>
+class MoveOnlyFunction<R(ArgTypes...), DataSize> : protected FunctionData<DataSize> {
+    struct Operations {
+        R (*call)(void*, ArgTypes&&...);
+        void (*move)(void*, void*); //nullptr for heap allocated callables
+        void (*destroy)(void*);
+    };
+
+    template <class T>
+    struct InlineValue {
+        static R call(void* _pv, ArgTypes&&... _args)
+        {
+            return (*static_cast<T*>(_pv))(std::forward<ArgTypes>(_args)...);
+        }
+
+        static void move(void* _pfrom, void* _pto)
+        {
+            new (_pto) T(std::move(*static_cast<T*>(_pfrom)));
+            static_cast<T*>(_pfrom)->~T();
+        }
+
+        static void destroy(void* _pv)
+        {
+            static_cast<T*>(_pv)->~T();
+        }
+
+        static const Operations* operations()
+        {
+            static const Operations ops{&call, &move, &destroy};
+            return &ops;
+        }
+    };
+
+    template <class T>
+    struct HeapValue {
+        static R call(void* _pv, ArgTypes&&... _args)
+        {
+            return (*static_cast<T*>(_pv))(std::forward<ArgTypes>(_args)...);
+        }
+
+        static void destroy(void* _pv)
+        {
+            delete static_cast<T*>(_pv);
+        }
+
+        static const Operations* operations()
+        {
+            static const Operations ops{&call, nullptr, &destroy};
+            return &ops;
+        }
+    };
+
+    template <class T>
+    using IsFunctionT = std::is_same<MoveOnlyFunction, typename std::decay<T>::type>;
+
+public:
+    using ThisT = MoveOnlyFunction<R(ArgTypes...), DataSize>;
+
+    //! True if a T callable is stored without allocation
+    template <class T>
+    static constexpr bool fitsInline()
+    {
+        using RealT = typename std::decay<T>::type;
+        return sizeof(RealT) <= DataSize && alignof(RealT) <= alignof(uint64_t) && std::is_nothrow_move_constructible<RealT>::value;
+    }
+
+    MoveOnlyFunction() {}
+
+    explicit MoveOnlyFunction(std::nullptr_t) {}
+
+    MoveOnlyFunction(const MoveOnlyFunction&) = delete;
+
+    MoveOnlyFunction(MoveOnlyFunction&& _ufnc) noexcept
+    {
+        doMoveFrom(_ufnc);
+    }
+
+    template <class T, typename = typename std::enable_if<!IsFunctionT<T>::value, void>::type>
+    MoveOnlyFunction(T&& _ut)
+    {
+        doAllocate(std::forward<T>(_ut));
+    }
+
+    ~MoveOnlyFunction()
+    {
+        clear();
+    }
+
+    MoveOnlyFunction& operator=(const MoveOnlyFunction&) = delete;
+
+    MoveOnlyFunction& operator=(MoveOnlyFunction&& _ufnc) noexcept
+    {
+        if (this != &_ufnc) {
+            clear();
+            doMoveFrom(_ufnc);
+        }
+        return *this;
+    }
+
+    MoveOnlyFunction& operator=(std::nullptr_t)
+    {
+        clear();
+        return *this;
+    }
+
+    template <class T>
+    typename std::enable_if<!IsFunctionT<T>::value, ThisT&>::type
+    operator=(T&& _ut)
+    {
+        clear();
+        doAllocate(std::forward<T>(_ut));
+        return *this;
+    }
+
+    bool empty() const noexcept
+    {
+        return pops_ == nullptr;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return !empty();
+    }
+
+    void clear()
+    {
+        if (pops_) {
+            pops_->destroy(pvalue_);
+            pops_   = nullptr;
+            pvalue_ = nullptr;
+        }
+    }
+
+    bool usesData() const
+    {
+        return this->dataPtr() && pvalue_ == this->dataPtr();
+    }
+
+    R operator()(ArgTypes... args) const
+    {
+        if (!empty()) {
+            return pops_->call(pvalue_, std::forward<ArgTypes>(args)...);
+        } else {
+            throw std::bad_function_call();
+        }
+    }
+
+private:
+    void doMoveFrom(MoveOnlyFunction& _ufnc) noexcept
+    {
+        if (_ufnc.pops_) {
+            if (_ufnc.pops_->move) {
+                _ufnc.pops_->move(_ufnc.pvalue_, this->dataPtr());
+                pvalue_ = this->dataPtr();
+            } else {
+                pvalue_ = _ufnc.pvalue_;
+            }
+            pops_         = _ufnc.pops_;
+            _ufnc.pops_   = nullptr;
+            _ufnc.pvalue_ = nullptr;
+        }
+    }
+
+    template <class T>
+    void doAllocate(T&& _ut)
+    {
+        using RealT = typename std::decay<T>::type;
+        doAllocate<RealT>(std::integral_constant<bool, fitsInline<RealT>()>(), std::forward<T>(_ut));
+    }
+
+    template <class RealT, class T>
+    void doAllocate(std::true_type /*_inline*/, T&& _ut)
+    {
+        pvalue_ = new (this->dataPtr()) RealT(std::forward<T>(_ut));
+        pops_   = InlineValue<RealT>::operations();
+    }
+
+    template <class RealT, class T>
+    void doAllocate(std::false_type /*_inline*/, T&& _ut)
+    {
+        function_report_heap<RealT, DataSize>();
+        pvalue_ = new RealT(std::forward<T>(_ut));
+        pops_   = HeapValue<RealT>::operations();
+    }
+
+private:
+    void*             pvalue_ = nullptr;
+    const Operations* pops_   = nullptr;
+};
+
 //-----------------------------------------------------------------------------
 
 } //namespace solid
@@ -442,10 +663,15 @@ private:
 #ifdef SOLID_USE_STD_FUNCTION
 
 #define solid_function_t(...) std::function<__VA_ARGS__>
+#define solid_sized_function_t(_sz, ...) std::function<__VA_ARGS__>
+#define solid_move_only_function_t(_sz, ...) std::function<__VA_ARGS__>
 
 #else
 
 #define solid_function_t(...) solid::Function<__VA_ARGS__>
+//! A Function with inline storage for _sz bytes, for hot call sites with bigger captures
+#define solid_sized_function_t(_sz, ...) solid::Function<__VA_ARGS__, _sz>
+#define solid_move_only_function_t(_sz, ...) solid::MoveOnlyFunction<__VA_ARGS__, _sz>
 
 #endif
 
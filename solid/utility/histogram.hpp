@@ -0,0 +1,189 @@
+// solid/utility/histogram.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+#include "solid/system/statistic.hpp"
+
+namespace solid {
+
+//! High dynamic range histogram with lock-free recording
+/*!
+    Log-linear buckets: values under sub_bucket_count have their own bucket,
+    every power of two above is split in sub_bucket_count equal buckets,
+    so the relative error of a percentile is below 1/sub_bucket_count (~6%).
+    Values over 2^magnitude_count go to the last bucket.
+
+    record can be called concurrently with merge and the readers; to keep
+    the recording cheap, use one histogram per thread and merge on read.
+*/
+class Histogram : public Statistic {
+public:
+    static constexpr size_t sub_bucket_bits  = 4;
+    static constexpr size_t sub_bucket_count = 1 << sub_bucket_bits;
+    static constexpr size_t magnitude_count  = 40;
+    static constexpr size_t bucket_count     = sub_bucket_count + (magnitude_count - sub_bucket_bits) * sub_bucket_count;
+
+    Histogram()
+    {
+        clear();
+    }
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    static size_t bucketIndex(const uint64_t _v)
+    {
+        if (_v < sub_bucket_count) {
+            return static_cast<size_t>(_v);
+        }
+        const size_t magnitude = mostSignificantBit(_v);
+        if (magnitude >= magnitude_count) {
+            return bucket_count - 1;
+        }
+        const size_t shift = magnitude - sub_bucket_bits;
+        return sub_bucket_count + shift * sub_bucket_count + static_cast<size_t>((_v >> shift) - sub_bucket_count);
+    }
+
+    //! The greatest value that goes into bucket _idx
+    static uint64_t bucketUpperBound(const size_t _idx)
+    {
+        if (_idx < sub_bucket_count) {
+            return _idx;
+        }
+        if (_idx >= bucket_count - 1) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        const size_t   shift = (_idx - sub_bucket_count) / sub_bucket_count;
+        const uint64_t sub   = sub_bucket_count + (_idx - sub_bucket_count) % sub_bucket_count;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    void record(const uint64_t _v)
+    {
+        bucket_[bucketIndex(_v)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(_v, std::memory_order_relaxed);
+        store_min(min_, _v);
+        store_max(max_, _v);
+    }
+
+    void merge(const Histogram& _rh)
+    {
+        const uint64_t count = _rh.count();
+        if (count == 0) {
+            return;
+        }
+        for (size_t i = 0; i < bucket_count; ++i) {
+            const uint64_t v = _rh.bucket_[i].load(std::memory_order_relaxed);
+            if (v != 0) {
+                bucket_[i].fetch_add(v, std::memory_order_relaxed);
+            }
+        }
+        count_.fetch_add(count, std::memory_order_relaxed);
+        sum_.fetch_add(_rh.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        store_min(min_, _rh.min_.load(std::memory_order_relaxed));
+        store_max(max_, _rh.max_.load(std::memory_order_relaxed));
+    }
+
+    void clear()
+    {
+        for (auto& rb : bucket_) {
+            rb.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t minimum() const
+    {
+        return count() != 0 ? min_.load(std::memory_order_relaxed) : 0;
+    }
+
+    uint64_t maximum() const
+    {
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t mean() const
+    {
+        const uint64_t count = this->count();
+        return count != 0 ? sum_.load(std::memory_order_relaxed) / count : 0;
+    }
+
+    //! The value under which _percent of the records are - e.g. percentile(99.9)
+    uint64_t percentile(const double _percent) const
+    {
+        const uint64_t count = this->count();
+        if (count == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>((_percent / 100.0) * count + 0.5);
+        if (rank == 0) {
+            rank = 1;
+        } else if (rank > count) {
+            rank = count;
+        }
+        uint64_t total = 0;
+        for (size_t i = 0; i < bucket_count; ++i) {
+            total += bucket_[i].load(std::memory_order_relaxed);
+            if (total >= rank) {
+                const uint64_t upper = bucketUpperBound(i);
+                const uint64_t max   = maximum();
+                return upper < max ? upper : max;
+            }
+        }
+        return maximum();
+    }
+
+    std::ostream& print(std::ostream& _ros) const override
+    {
+        _ros << "count = " << count() << " min = " << minimum() << " avg = " << mean();
+        _ros << " p50 = " << percentile(50) << " p90 = " << percentile(90);
+        _ros << " p99 = " << percentile(99) << " p999 = " << percentile(99.9);
+        _ros << " max = " << maximum();
+        return _ros;
+    }
+
+private:
+    static size_t mostSignificantBit(uint64_t _v)
+    {
+#if defined(__GNUC__)
+        return static_cast<size_t>(63 - __builtin_clzll(_v));
+#else
+        size_t rv = 0;
+        while (_v >>= 1) {
+            ++rv;
+        }
+        return rv;
+#endif
+    }
+
+private:
+    std::atomic<uint64_t> bucket_[bucket_count];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+};
+
+} //namespace solid
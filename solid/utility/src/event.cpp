@@ -9,9 +9,17 @@
 //
 #include "solid/utility/event.hpp"
 #include "solid/system/cassert.hpp"
+#include <atomic>
 
 namespace solid {
 
+//-----------------------------------------------------------------------------
+/*static*/ size_t EventCategoryBase::next_index()
+{
+    static std::atomic<size_t> crt_index{0};
+    return crt_index.fetch_add(1);
+}
+
 //-----------------------------------------------------------------------------
 const EventCategory<GenericEvents> generic_event_category{
     "solid::generic_event_category",
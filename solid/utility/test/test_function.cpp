@@ -1,6 +1,7 @@
 #include "solid/utility/function.hpp"
 #include <fstream>
 #include <iostream>
+#include <memory>
 using namespace solid;
 using namespace std;
 
@@ -101,5 +102,45 @@ int test_function(int /*argc*/, char* /*argv*/[])
         t.call(&t, "ceva");
     }
 #endif
+    {
+        //move only callables, inline and on heap
+        size_t destroy_count = 0;
+        struct Tracker {
+            size_t* pcount_;
+            Tracker(size_t* _pcount)
+                : pcount_(_pcount)
+            {
+            }
+            Tracker(Tracker&& _utracker) noexcept
+                : pcount_(_utracker.pcount_)
+            {
+                _utracker.pcount_ = nullptr;
+            }
+            ~Tracker()
+            {
+                if (pcount_) {
+                    ++(*pcount_);
+                }
+            }
+        };
+        std::unique_ptr<size_t>                ptr{new size_t(11)};
+        MoveOnlyFunction<size_t(const size_t)> fnc{[ptr = std::move(ptr), t = Tracker(&destroy_count)](const size_t _v) { return *ptr + _v; }};
+        MoveOnlyFunction<size_t(const size_t)> fnc2{std::move(fnc)};
+        MoveOnlyFunction<size_t(const size_t)> fnc3{[ptr = std::unique_ptr<size_t>(new size_t(22)), t = Tracker(&destroy_count), s = std::string("big")](const size_t _v) { return *ptr + _v + s.size() - 3; }};
+
+        static_assert(MoveOnlyFunction<size_t(const size_t)>::fitsInline<std::unique_ptr<size_t>>(), "unique_ptr must fit");
+        static_assert(!Function<size_t(const size_t), 8>::fitsInline<std::unique_ptr<size_t>>(), "a Function with 8 bytes has only room for the vtable");
+
+        solid_check(fnc.empty() && !fnc2.empty() && fnc2.usesData() && !fnc3.usesData());
+        solid_check(fnc2(1) == 12 && fnc3(2) == 24);
+
+        fnc = std::move(fnc3);
+        solid_check(fnc3.empty() && fnc(2) == 24 && !fnc.usesData());
+        solid_check(destroy_count == 0);
+
+        fnc = nullptr;
+        fnc2.clear();
+        solid_check(destroy_count == 2);
+    }
     return 0;
 }
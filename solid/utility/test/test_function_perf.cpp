@@ -9,7 +9,31 @@ using namespace std;
 namespace {
 enum struct FunctionChoice {
     Standard,
-    Solid
+    Solid,
+    MoveOnly
+};
+
+const char* function_choice_name(const FunctionChoice _fnc_choice)
+{
+    switch (_fnc_choice) {
+    case FunctionChoice::Standard:
+        return "Standard";
+    case FunctionChoice::Solid:
+        return "Solid";
+    case FunctionChoice::MoveOnly:
+        return "MoveOnly";
+    }
+    return "Unknown";
+}
+
+template <class F, class Closure>
+struct FitsInline {
+    static constexpr bool value = F::template fitsInline<Closure>();
+};
+
+template <class Closure>
+struct FitsInline<std::function<uint64_t(const size_t)>, Closure> {
+    static constexpr bool value = false; //implementation defined
 };
 
 class TestBase {
@@ -21,9 +45,9 @@ public:
 };
 
 struct PrintSize {
-    PrintSize(const size_t _sz)
+    PrintSize(const size_t _sz, const bool _inline)
     {
-        cout << "sizeof(closure): " << _sz << endl;
+        cout << "sizeof(closure): " << _sz << " inline: " << (_inline ? "yes" : "no") << endl;
     }
 };
 
@@ -45,7 +69,7 @@ public:
     template <class Fnc>
     void push(Fnc _f)
     {
-        static const PrintSize ps(sizeof(_f));
+        static const PrintSize ps(sizeof(_f), FitsInline<F, Fnc>::value);
         fnc_dq.emplace_back(std::move(_f));
     }
 
@@ -112,6 +136,8 @@ TestBase* create_test(const FunctionChoice _fnc_choice, const size_t _closure_si
     switch (_fnc_choice) {
     case FunctionChoice::Solid:
         return create_test<solid::Function<uint64_t(const size_t), 24>>(_closure_size);
+    case FunctionChoice::MoveOnly:
+        return create_test<solid::MoveOnlyFunction<uint64_t(const size_t), 24>>(_closure_size);
     case FunctionChoice::Standard:
         return create_test<std::function<uint64_t(const size_t)>>(_closure_size);
     }
@@ -132,6 +158,9 @@ int test_function_perf(int argc, char* argv[])
         case 'S':
             fnc_choice = FunctionChoice::Standard;
             break;
+        case 'm':
+            fnc_choice = FunctionChoice::MoveOnly;
+            break;
         default:
             cout << "Unknown function choice!" << endl;
             return -1;
@@ -151,7 +180,7 @@ int test_function_perf(int argc, char* argv[])
     if (argc > 4) {
         repeat_count = atoi(argv[4]);
     }
-    cout << "Test " << (fnc_choice == FunctionChoice::Standard ? "Standard" : "Solid") << " function with closure_size = " << closure_size << " create_count = " << create_count << " repeat_count = " << repeat_count << endl;
+    cout << "Test " << function_choice_name(fnc_choice) << " function with closure_size = " << closure_size << " create_count = " << create_count << " repeat_count = " << repeat_count << endl;
 
     TestBase* pt = create_test(fnc_choice, closure_size);
 
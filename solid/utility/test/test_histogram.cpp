@@ -0,0 +1,69 @@
+#include "solid/system/exception.hpp"
+#include "solid/utility/histogram.hpp"
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solid;
+
+int test_histogram(int /*argc*/, char* /*argv*/[])
+{
+    //bucket bounds are continuous and every value is inside its bucket
+    for (size_t i = 1; i < Histogram::bucket_count - 1; ++i) {
+        solid_check(Histogram::bucketUpperBound(i - 1) + 1 <= Histogram::bucketUpperBound(i));
+        const uint64_t lower = Histogram::bucketUpperBound(i - 1) + 1;
+        solid_check(Histogram::bucketIndex(lower) == i, "bucket " << i);
+        solid_check(Histogram::bucketIndex(Histogram::bucketUpperBound(i)) == i, "bucket " << i);
+    }
+    solid_check(Histogram::bucketIndex(static_cast<uint64_t>(-1)) == Histogram::bucket_count - 1);
+
+    Histogram h;
+    solid_check(h.count() == 0 && h.percentile(99) == 0 && h.minimum() == 0);
+
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        h.record(v);
+    }
+    cout << h << endl;
+
+    solid_check(h.count() == 10000 && h.minimum() == 1 && h.maximum() == 10000);
+    solid_check(h.mean() == 5000);
+
+    const uint64_t p50 = h.percentile(50);
+    const uint64_t p99 = h.percentile(99);
+    solid_check(p50 >= 5000 && p50 <= 5000 + 5000 / Histogram::sub_bucket_count, "p50 = " << p50);
+    solid_check(p99 >= 9900 && p99 <= 10000, "p99 = " << p99);
+    solid_check(h.percentile(100) == 10000);
+
+    //concurrent recording, merged on read
+    const size_t thread_count = 4;
+    const size_t record_count = 100000;
+    Histogram    shards[thread_count];
+    {
+        vector<thread> thr_vec;
+        for (size_t i = 0; i < thread_count; ++i) {
+            thr_vec.emplace_back([&shards, i]() {
+                for (size_t j = 0; j < record_count; ++j) {
+                    shards[i].record(j * 1000);
+                }
+            });
+        }
+        for (auto& thr : thr_vec) {
+            thr.join();
+        }
+    }
+
+    Histogram merged;
+    for (const auto& rshard : shards) {
+        merged.merge(rshard);
+    }
+    cout << merged << endl;
+
+    solid_check(merged.count() == thread_count * record_count);
+    solid_check(merged.minimum() == 0 && merged.maximum() == (record_count - 1) * 1000);
+
+    merged.clear();
+    solid_check(merged.count() == 0 && merged.maximum() == 0);
+    return 0;
+}
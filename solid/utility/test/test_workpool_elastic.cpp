@@ -0,0 +1,178 @@
+#include "solid/system/crashhandler.hpp"
+#include "solid/system/exception.hpp"
+#include "solid/utility/workpool.hpp"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using namespace solid;
+using namespace std;
+namespace {
+const LoggerT logger("test_elastic");
+}
+
+int test_workpool_elastic(int argc, char* argv[])
+{
+    install_crash_handler();
+    solid::log_start(std::cerr, {".*:EWS", "test_elastic:VIEWS"});
+    using WorkPoolT = WorkPool<size_t>;
+
+    const int    wait_seconds = 100;
+    const size_t max_wkr_cnt  = 8;
+    const size_t min_wkr_cnt  = 1;
+    size_t       cnt          = 200;
+
+    if (argc > 1) {
+        cnt = atoi(argv[1]);
+    }
+
+    auto lambda = [&]() {
+        {
+            //burst of blocking jobs grows the pool, idle time shrinks it back
+            std::atomic<size_t> done{0};
+            WorkPoolT           wp{
+                WorkPoolConfiguration(max_wkr_cnt).idleShrink(chrono::milliseconds(100), min_wkr_cnt), 1,
+                [&done](const size_t _v) {
+                    this_thread::sleep_for(chrono::milliseconds(2));
+                    ++done;
+                }};
+
+            for (size_t i = 0; i < cnt; ++i) {
+                wp.push(i);
+            }
+            solid_log(logger, Verbose, "worker count after burst: " << wp.workerCount());
+            solid_check(wp.workerCount() > min_wkr_cnt, "worker count = " << wp.workerCount());
+
+            while (done != cnt) {
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+
+            for (int i = 0; i < 100 && wp.workerCount() > min_wkr_cnt; ++i) {
+                this_thread::sleep_for(chrono::milliseconds(50));
+            }
+            solid_check(wp.workerCount() == min_wkr_cnt, "worker count = " << wp.workerCount());
+
+            //the remaining workers must still handle new jobs
+            for (size_t i = 0; i < cnt; ++i) {
+                wp.push(i);
+            }
+            while (done != 2 * cnt) {
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+            wp.dumpStatistics();
+        }
+        {
+            //all workers retire - a new one must be spawned on push
+            std::atomic<size_t> done{0};
+            WorkPoolT           wp{
+                WorkPoolConfiguration(max_wkr_cnt).idleShrink(chrono::milliseconds(20)), 2,
+                [&done](const size_t _v) {
+                    ++done;
+                }};
+
+            for (int i = 0; i < 100 && wp.workerCount() != 0; ++i) {
+                this_thread::sleep_for(chrono::milliseconds(20));
+            }
+            solid_check(wp.workerCount() == 0, "worker count = " << wp.workerCount());
+
+            for (size_t i = 0; i < cnt; ++i) {
+                wp.push(i);
+            }
+            while (done != cnt) {
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+        }
+        {
+            //a steady producer outpaces the workers in both runs below, so spawning is
+            //limited only by the min_gain_percent backoff:
+            //jobs serialized on a shared mutex bring no throughput gain - growth stops early,
+            //independent jobs scale until the gain drops under 10% (around 11 workers)
+            const size_t max_spawn_wkr_cnt = 16;
+
+            auto run = [max_spawn_wkr_cnt](const bool _serialized) {
+                std::atomic<size_t> done{0};
+                std::mutex          mtx;
+                size_t              pushed = 0;
+                WorkPoolT           wp{
+                    WorkPoolConfiguration(max_spawn_wkr_cnt).spawnRate(chrono::milliseconds(20), 10), 1,
+                    [&done, &mtx, _serialized](const size_t _v) {
+                        if (_serialized) {
+                            lock_guard<mutex> lock(mtx);
+                            this_thread::sleep_for(chrono::milliseconds(1));
+                        } else {
+                            this_thread::sleep_for(chrono::milliseconds(5));
+                        }
+                        ++done;
+                    }};
+
+                const auto end_time = chrono::steady_clock::now() + chrono::milliseconds(600);
+                while (chrono::steady_clock::now() < end_time) {
+                    wp.push(pushed++);
+                    this_thread::sleep_for(chrono::microseconds(250));
+                }
+                const size_t worker_count = wp.workerCount();
+
+                while (done != pushed) {
+                    this_thread::sleep_for(chrono::milliseconds(10));
+                }
+                return worker_count;
+            };
+
+            const size_t serialized_wkr_cnt  = run(true);
+            const size_t independent_wkr_cnt = run(false);
+
+            solid_log(logger, Verbose, "worker count with throttled spawn: serialized " << serialized_wkr_cnt << " independent " << independent_wkr_cnt);
+            solid_check(serialized_wkr_cnt * 2 <= independent_wkr_cnt, "serialized jobs worker count = " << serialized_wkr_cnt << " independent jobs worker count = " << independent_wkr_cnt);
+            solid_check(independent_wkr_cnt >= 6, "independent jobs worker count = " << independent_wkr_cnt);
+        }
+        {
+            //queue latency drives both growth and shrink:
+            //jobs arriving faster than one worker handles them wait in queue - the pool grows,
+            //then a steady trickle of jobs which never wait retires the extra workers,
+            //although none of them is idle for a whole idle timeout
+            std::atomic<size_t> done{0};
+            size_t              pushed = 0;
+            WorkPoolT           wp{
+                WorkPoolConfiguration(max_wkr_cnt).idleShrink(chrono::milliseconds(300), min_wkr_cnt).queueLatency(chrono::milliseconds(2), chrono::microseconds(500)), 1,
+                [&done](const size_t _v) {
+                    this_thread::sleep_for(chrono::milliseconds(1));
+                    ++done;
+                }};
+
+            auto push_for = [&wp, &pushed](const chrono::milliseconds _duration, const chrono::microseconds _interval) {
+                const auto end_time = chrono::steady_clock::now() + _duration;
+                while (chrono::steady_clock::now() < end_time) {
+                    wp.push(pushed++);
+                    this_thread::sleep_for(_interval);
+                }
+            };
+
+            push_for(chrono::milliseconds(300), chrono::microseconds(250));
+
+            const size_t grown_wkr_cnt = wp.workerCount();
+
+            solid_log(logger, Verbose, "worker count on queue latency " << wp.queueLatency().count() << "us: " << grown_wkr_cnt);
+            solid_check(grown_wkr_cnt > 2, "worker count = " << grown_wkr_cnt);
+
+            push_for(chrono::milliseconds(1500), chrono::microseconds(2000));
+
+            solid_log(logger, Verbose, "worker count on queue latency " << wp.queueLatency().count() << "us: " << wp.workerCount());
+            solid_check(wp.workerCount() < grown_wkr_cnt && wp.workerCount() <= 2, "worker count = " << wp.workerCount());
+
+            while (done != pushed) {
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+            wp.dumpStatistics();
+        }
+    };
+    auto fut = async(launch::async, lambda);
+    if (fut.wait_for(chrono::seconds(wait_seconds)) != future_status::ready) {
+        solid_throw(" Test is taking too long - waited " << wait_seconds << " secs");
+    }
+    fut.get(); //rethrow a failed check
+
+    return 0;
+}
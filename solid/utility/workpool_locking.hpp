@@ -10,6 +10,7 @@
 
 #pragma once
 #define NOMINMAX
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
@@ -34,16 +35,60 @@ namespace locking {
 //-----------------------------------------------------------------------------
 
 struct WorkPoolConfiguration {
-    size_t max_worker_count_;
-    size_t max_job_queue_size_;
+    using DurationT        = std::chrono::milliseconds;
+    using LatencyDurationT = std::chrono::microseconds;
+
+    size_t           max_worker_count_;
+    size_t           max_job_queue_size_;
+    size_t           min_worker_count_;
+    DurationT        worker_idle_timeout_;
+    DurationT        worker_spawn_interval_;
+    size_t           worker_spawn_min_gain_percent_;
+    LatencyDurationT worker_grow_latency_;
+    LatencyDurationT worker_shrink_latency_;
 
     explicit WorkPoolConfiguration(
         const size_t _max_worker_count   = std::thread::hardware_concurrency(),
         const size_t _max_job_queue_size = std::numeric_limits<size_t>::max())
         : max_worker_count_(_max_worker_count)
         , max_job_queue_size_(_max_job_queue_size)
+        , min_worker_count_(0)
+        , worker_idle_timeout_(0)
+        , worker_spawn_interval_(0)
+        , worker_spawn_min_gain_percent_(10)
+        , worker_grow_latency_(0)
+        , worker_shrink_latency_(0)
     {
     }
+
+    //! Workers idle for more than _timeout retire until _min_worker_count remain.
+    WorkPoolConfiguration& idleShrink(const DurationT _timeout, const size_t _min_worker_count = 0)
+    {
+        worker_idle_timeout_ = _timeout;
+        min_worker_count_    = _min_worker_count;
+        return *this;
+    }
+
+    //! Spawn new workers at most once every _interval, backing off while they bring no throughput gain.
+    WorkPoolConfiguration& spawnRate(const DurationT _interval, const size_t _min_gain_percent = 10)
+    {
+        worker_spawn_interval_         = _interval;
+        worker_spawn_min_gain_percent_ = _min_gain_percent;
+        return *this;
+    }
+
+    //! Spawn only while jobs wait in queue more than _grow_latency; with idleShrink, retire workers whose jobs waited less than _shrink_latency.
+    WorkPoolConfiguration& queueLatency(const LatencyDurationT _grow_latency, const LatencyDurationT _shrink_latency)
+    {
+        worker_grow_latency_   = _grow_latency;
+        worker_shrink_latency_ = _shrink_latency;
+        return *this;
+    }
+
+    bool hasQueueLatency() const
+    {
+        return worker_grow_latency_.count() != 0;
+    }
 };
 //-----------------------------------------------------------------------------
 //! Pool of threads handling Jobs
@@ -73,31 +118,88 @@ class WorkPool : NonCopyable {
     using ThisT          = WorkPool<Job, QNBits>;
     using WorkerFactoryT = std::function<std::thread()>;
     using ThreadVectorT  = std::vector<std::thread>;
-    using JobQueueT      = Queue<Job, QNBits>;
+    using ClockT         = std::chrono::steady_clock;
+    using TimePointT     = ClockT::time_point;
     using AtomicBoolT    = std::atomic<bool>;
 
+    struct JobStub {
+        Job        job_;
+        TimePointT push_time_; //set only with queueLatency configured
+
+        JobStub() = default;
+
+        template <class JT>
+        JobStub(JT&& _jb, const TimePointT& _push_time)
+            : job_(std::forward<JT>(_jb))
+            , push_time_(_push_time)
+        {
+        }
+    };
+
+    using JobQueueT = Queue<JobStub, QNBits>;
+
+    static constexpr size_t max_spawn_backoff = 64;
+
     WorkPoolConfiguration   config_;
     AtomicBoolT             running_;
     std::atomic<size_t>     thr_cnt_;
+    std::atomic<uint64_t>   done_job_cnt_;
+    std::atomic<uint64_t>   queue_latency_us_; //moving average
+    std::atomic<uint64_t>   pop_time_us_; //since start_time_
     WorkerFactoryT          worker_factory_fnc_;
     JobQueueT               job_q_;
     ThreadVectorT           thr_vec_;
+    ThreadVectorT           exit_thr_vec_;
     std::mutex              mtx_;
     std::mutex              thr_mtx_;
     std::condition_variable sig_cnd_;
+    TimePointT              start_time_;
+    TimePointT              spawn_time_;
+    uint64_t                spawn_done_job_cnt_;
+    double                  spawn_job_rate_;
+    size_t                  spawn_backoff_;
 #ifdef SOLID_HAS_STATISTICS
     struct Statistic : solid::Statistic {
+        static constexpr size_t sample_capacity = 32;
+
+        struct WorkerCountSample {
+            uint64_t msecs_;
+            size_t   count_;
+        };
+
         std::atomic<size_t>   max_worker_count_;
         std::atomic<size_t>   max_jobs_in_queue_;
         std::atomic<uint64_t> max_jobs_on_thread_;
         std::atomic<uint64_t> min_jobs_on_thread_;
+        std::atomic<size_t>   spawn_count_;
+        std::atomic<size_t>   spawn_throttle_count_;
+        std::atomic<size_t>   retire_count_;
+        std::atomic<size_t>   latency_retire_count_;
+        std::atomic<uint64_t> max_queue_latency_us_;
+        //samples are written under thr_mtx_
+        WorkerCountSample worker_count_samples_[sample_capacity];
+        size_t            worker_count_sample_cnt_;
 
         Statistic()
             : max_worker_count_(0)
             , max_jobs_in_queue_(0)
             , max_jobs_on_thread_(0)
             , min_jobs_on_thread_(-1)
+            , spawn_count_(0)
+            , spawn_throttle_count_(0)
+            , retire_count_(0)
+            , latency_retire_count_(0)
+            , max_queue_latency_us_(0)
+            , worker_count_sample_cnt_(0)
+        {
+        }
+
+        void sampleWorkerCount(const uint64_t _msecs, const size_t _count)
         {
+            WorkerCountSample& rs = worker_count_samples_[worker_count_sample_cnt_ % sample_capacity];
+            rs.msecs_             = _msecs;
+            rs.count_             = _count;
+            ++worker_count_sample_cnt_;
         }
 
         std::ostream& print(std::ostream& _ros) const override
@@ -106,6 +208,17 @@ class WorkPool : NonCopyable {
             _ros << " max_jobs_in_queue_ = " << max_jobs_in_queue_;
             _ros << " max_jobs_on_thread_ = " << max_jobs_on_thread_;
             _ros << " min_jobs_on_thread_ = " << min_jobs_on_thread_;
+            _ros << " spawn_count_ = " << spawn_count_;
+            _ros << " spawn_throttle_count_ = " << spawn_throttle_count_;
+            _ros << " retire_count_ = " << retire_count_;
+            _ros << " latency_retire_count_ = " << latency_retire_count_;
+            _ros << " max_queue_latency_us_ = " << max_queue_latency_us_;
+            _ros << " worker_count_samples_(msecs:count) =";
+            const size_t first = worker_count_sample_cnt_ > sample_capacity ? worker_count_sample_cnt_ - sample_capacity : 0;
+            for (size_t i = first; i < worker_count_sample_cnt_; ++i) {
+                const WorkerCountSample& rs = worker_count_samples_[i % sample_capacity];
+                _ros << ' ' << rs.msecs_ << ':' << rs.count_;
+            }
             return _ros;
         }
     } statistic_;
@@ -115,6 +228,12 @@ public:
         : config_()
         , running_(false)
         , thr_cnt_(0)
+        , done_job_cnt_(0)
+        , queue_latency_us_(0)
+        , pop_time_us_(0)
+        , spawn_done_job_cnt_(0)
+        , spawn_job_rate_(0)
+        , spawn_backoff_(1)
     {
     }
 
@@ -127,6 +246,12 @@ public:
         : config_()
         , running_(false)
         , thr_cnt_(0)
+        , done_job_cnt_(0)
+        , queue_latency_us_(0)
+        , pop_time_us_(0)
+        , spawn_done_job_cnt_(0)
+        , spawn_job_rate_(0)
+        , spawn_backoff_(1)
     {
         doStart(
             _cfg,
@@ -161,6 +286,18 @@ public:
     template <class JT>
     void push(JT&& _jb);
 
+    //! The current number of workers
+    size_t workerCount() const
+    {
+        return thr_cnt_.load();
+    }
+
+    //! The average time jobs wait in queue - only with queueLatency configured
+    std::chrono::microseconds queueLatency() const
+    {
+        return std::chrono::microseconds(queue_latency_us_.load(std::memory_order_relaxed));
+    }
+
     void dumpStatistics() const;
 
     void stop()
@@ -171,7 +308,26 @@ public:
 private:
     bool doWaitJob(std::unique_lock<std::mutex>& _lock);
 
-    bool pop(Job& _rjob);
+    bool pop(JobStub& _rjob);
+
+    TimePointT pushTime() const
+    {
+        return config_.hasQueueLatency() ? ClockT::now() : TimePointT();
+    }
+
+    uint64_t doRecordQueueLatency(const JobStub& _rjob);
+
+    bool doIsQueueLatencyBelow(const std::chrono::microseconds _latency, const TimePointT& _now) const;
+
+    bool doTryRetireBusyWorker();
+
+    void doTrySpawnWorker(const size_t _qsz);
+
+    bool doTryRetireWorker();
+
+    bool doCanSpawnWorker(const TimePointT& _now);
+
+    void doJoinExitedWorkers(ThreadVectorT& _rthr_vec);
 
     void doStop();
 
@@ -200,22 +356,13 @@ void WorkPool<Job, QNBits>::push(const JT& _jb)
                 } while (job_q_.size() >= config_.max_job_queue_size_);
             }
 
-            job_q_.push(_jb);
+            job_q_.push(JobStub(_jb, pushTime()));
             qsz = job_q_.size();
         }
 
         sig_cnd_.notify_one();
 
-        const size_t thr_cnt = thr_cnt_.load();
-
-        if (thr_cnt < config_.max_worker_count_ && qsz > thr_cnt) {
-            std::lock_guard<std::mutex> lock(thr_mtx_);
-            if (qsz > thr_vec_.size() && thr_vec_.size() < config_.max_worker_count_) {
-                thr_vec_.emplace_back(worker_factory_fnc_());
-                ++thr_cnt_;
-                solid_statistic_max(statistic_.max_worker_count_, thr_vec_.size());
-            }
-        }
+        doTrySpawnWorker(qsz);
     }
     solid_statistic_max(statistic_.max_jobs_in_queue_, qsz);
 }
@@ -236,37 +383,182 @@ void WorkPool<Job, QNBits>::push(JT&& _jb)
                 } while (job_q_.size() >= config_.max_job_queue_size_);
             }
 
-            job_q_.push(std::move(_jb));
+            job_q_.push(JobStub(std::move(_jb), pushTime()));
             qsz = job_q_.size();
         }
 
         sig_cnd_.notify_one();
 
-        const size_t thr_cnt = thr_cnt_.load();
+        doTrySpawnWorker(qsz);
+    }
+    solid_statistic_max(statistic_.max_jobs_in_queue_, qsz);
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t QNBits>
+void WorkPool<Job, QNBits>::doTrySpawnWorker(const size_t _qsz)
+{
+    const size_t thr_cnt = thr_cnt_.load();
 
-        if (thr_cnt < config_.max_worker_count_ && qsz > thr_cnt) {
-            std::lock_guard<std::mutex> lock(thr_mtx_);
-            if (qsz > thr_vec_.size() && thr_vec_.size() < config_.max_worker_count_) {
-                thr_vec_.emplace_back(worker_factory_fnc_());
-                ++thr_cnt_;
-                solid_statistic_max(statistic_.max_worker_count_, thr_vec_.size());
+    if (thr_cnt < config_.max_worker_count_ && _qsz > thr_cnt) {
+        std::lock_guard<std::mutex> lock(thr_mtx_);
+        const TimePointT            now = ClockT::now();
+
+        doJoinExitedWorkers(exit_thr_vec_);
+
+        if (_qsz > thr_cnt_.load() && thr_cnt_.load() < config_.max_worker_count_ && running_.load() && doCanSpawnWorker(now)) {
+            if (config_.worker_spawn_interval_.count() != 0) {
+                const uint64_t done_job_cnt = done_job_cnt_.load(std::memory_order_relaxed);
+                const auto     elapsed = std::chrono::duration<double>(now - spawn_time_).count();
+
+                spawn_job_rate_     = elapsed > 0 ? static_cast<double>(done_job_cnt - spawn_done_job_cnt_) / elapsed : 0;
+                spawn_time_         = now;
+                spawn_done_job_cnt_ = done_job_cnt;
             }
+            thr_vec_.emplace_back(worker_factory_fnc_());
+            ++thr_cnt_;
+            solid_statistic_max(statistic_.max_worker_count_, thr_vec_.size());
+            solid_statistic_inc(statistic_.spawn_count_);
+#ifdef SOLID_HAS_STATISTICS
+            statistic_.sampleWorkerCount(std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time_).count(), thr_cnt_.load());
+#endif
         }
     }
-    solid_statistic_max(statistic_.max_jobs_in_queue_, qsz);
+}
+//-----------------------------------------------------------------------------
+// called under thr_mtx_ lock
+template <typename Job, size_t QNBits>
+bool WorkPool<Job, QNBits>::doCanSpawnWorker(const TimePointT& _now)
+{
+    if (thr_cnt_.load() <= config_.min_worker_count_) {
+        return true;
+    }
+
+    if (config_.hasQueueLatency() && doIsQueueLatencyBelow(config_.worker_grow_latency_, _now)) {
+        solid_statistic_inc(statistic_.spawn_throttle_count_);
+        return false;
+    }
+
+    if (config_.worker_spawn_interval_.count() == 0) {
+        return true;
+    }
+
+    const auto elapsed = _now - spawn_time_;
+
+    if (elapsed < config_.worker_spawn_interval_ * spawn_backoff_) {
+        solid_statistic_inc(statistic_.spawn_throttle_count_);
+        return false;
+    }
+
+    const uint64_t done_job_cnt = done_job_cnt_.load(std::memory_order_relaxed);
+    const double   job_rate = static_cast<double>(done_job_cnt - spawn_done_job_cnt_) / std::chrono::duration<double>(elapsed).count();
+
+    if (spawn_job_rate_ != 0 && job_rate * 100 < spawn_job_rate_ * (100 + config_.worker_spawn_min_gain_percent_)) {
+        //the last spawned worker did not help - probably the jobs are blocking
+        spawn_time_         = _now;
+        spawn_done_job_cnt_ = done_job_cnt;
+        spawn_job_rate_     = job_rate;
+        if (spawn_backoff_ < max_spawn_backoff) {
+            spawn_backoff_ *= 2;
+        }
+        solid_statistic_inc(statistic_.spawn_throttle_count_);
+        return false;
+    }
+
+    spawn_backoff_ = 1;
+    return true;
+}
+//-----------------------------------------------------------------------------
+// called under mtx_ lock with an empty job queue
+template <typename Job, size_t QNBits>
+bool WorkPool<Job, QNBits>::doTryRetireWorker()
+{
+    std::lock_guard<std::mutex> lock(thr_mtx_);
+
+    if (!running_.load() || thr_cnt_.load() <= config_.min_worker_count_) {
+        return false;
+    }
+
+    --thr_cnt_;
+
+    doJoinExitedWorkers(exit_thr_vec_);
+
+    const auto thr_id = std::this_thread::get_id();
+    for (auto it = thr_vec_.begin(); it != thr_vec_.end(); ++it) {
+        if (it->get_id() == thr_id) {
+            exit_thr_vec_.emplace_back(std::move(*it));
+            thr_vec_.erase(it);
+            break;
+        }
+    }
+
+    solid_dbg(workpool_logger, Verbose, this << " retire worker - remaining " << thr_cnt_.load());
+    solid_statistic_inc(statistic_.retire_count_);
+#ifdef SOLID_HAS_STATISTICS
+    statistic_.sampleWorkerCount(std::chrono::duration_cast<std::chrono::milliseconds>(ClockT::now() - start_time_).count(), thr_cnt_.load());
+#endif
+    return true;
+}
+//-----------------------------------------------------------------------------
+// called by a worker whose jobs did not wait - it keeps running while jobs are queued
+template <typename Job, size_t QNBits>
+bool WorkPool<Job, QNBits>::doTryRetireBusyWorker()
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    return job_q_.empty() && doTryRetireWorker();
+}
+//-----------------------------------------------------------------------------
+// called by the worker right after pop - returns the job's queue wait in microseconds
+template <typename Job, size_t QNBits>
+uint64_t WorkPool<Job, QNBits>::doRecordQueueLatency(const JobStub& _rjob)
+{
+    const TimePointT now     = ClockT::now();
+    const uint64_t   wait_us = std::chrono::duration_cast<std::chrono::microseconds>(now - _rjob.push_time_).count();
+    const uint64_t   avg_us  = queue_latency_us_.load(std::memory_order_relaxed);
+
+    //racy read-modify-write - a lost sample only slows the average down
+    queue_latency_us_.store(avg_us - avg_us / 8 + wait_us / 8, std::memory_order_relaxed);
+    pop_time_us_.store(std::chrono::duration_cast<std::chrono::microseconds>(now - start_time_).count(), std::memory_order_relaxed);
+
+    solid_statistic_max(statistic_.max_queue_latency_us_, wait_us);
+    return wait_us;
+}
+//-----------------------------------------------------------------------------
+// while all workers are busy nothing is popped - the time since the last pop counts as wait too
+template <typename Job, size_t QNBits>
+bool WorkPool<Job, QNBits>::doIsQueueLatencyBelow(const std::chrono::microseconds _latency, const TimePointT& _now) const
+{
+    const uint64_t latency_us   = _latency.count();
+    const uint64_t now_us       = std::chrono::duration_cast<std::chrono::microseconds>(_now - start_time_).count();
+    const uint64_t pop_time_us  = pop_time_us_.load(std::memory_order_relaxed);
+    const uint64_t since_pop_us = now_us > pop_time_us ? now_us - pop_time_us : 0;
+
+    return queue_latency_us_.load(std::memory_order_relaxed) < latency_us && since_pop_us < latency_us;
+}
+//-----------------------------------------------------------------------------
+template <typename Job, size_t QNBits>
+void WorkPool<Job, QNBits>::doJoinExitedWorkers(ThreadVectorT& _rthr_vec)
+{
+    for (auto& t : _rthr_vec) {
+        t.join();
+    }
+    _rthr_vec.clear();
 }
 //-----------------------------------------------------------------------------
 template <typename Job, size_t QNBits>
 bool WorkPool<Job, QNBits>::doWaitJob(std::unique_lock<std::mutex>& _lock)
 {
     while (job_q_.empty() && running_.load(std::memory_order_relaxed)) {
-        sig_cnd_.wait(_lock);
+        if (config_.worker_idle_timeout_.count() == 0) {
+            sig_cnd_.wait(_lock);
+        } else if (sig_cnd_.wait_for(_lock, config_.worker_idle_timeout_) == std::cv_status::timeout && job_q_.empty() && doTryRetireWorker()) {
+            return false;
+        }
     }
     return !job_q_.empty();
 }
 //-----------------------------------------------------------------------------
 template <typename Job, size_t QNBits>
-bool WorkPool<Job, QNBits>::pop(Job& _rjob)
+bool WorkPool<Job, QNBits>::pop(JobStub& _rjob)
 {
 
     std::unique_lock<std::mutex> lock(mtx_);
@@ -292,14 +584,24 @@ void WorkPool<Job, QNBits>::doStop()
     } else {
         return;
     }
+    ThreadVectorT thr_vec;
+    ThreadVectorT exit_thr_vec;
     {
         std::unique_lock<std::mutex> lock(thr_mtx_);
-        sig_cnd_.notify_all();
+        thr_vec.swap(thr_vec_);
+        exit_thr_vec.swap(exit_thr_vec_);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+    }
+    sig_cnd_.notify_all();
 
-        for (auto& t : thr_vec_) {
-            t.join();
-        }
-        thr_vec_.clear();
+    doJoinExitedWorkers(thr_vec);
+    doJoinExitedWorkers(exit_thr_vec);
+    {
+        //workers retiring while we were joining
+        std::unique_lock<std::mutex> lock(thr_mtx_);
+        doJoinExitedWorkers(exit_thr_vec_);
     }
     dumpStatistics();
 }
@@ -316,12 +618,29 @@ void WorkPool<Job, QNBits>::doStart(
     auto lambda = [_job_handler_fnc, this, _args...]() {
         return std::thread(
             [this](JobHandlerFnc _job_handler_fnc, Args&&... _args) {
-                uint64_t job_count = 0;
-                Job      job;
+                uint64_t   job_count = 0;
+                JobStub    job;
+                const bool count_jobs     = config_.worker_spawn_interval_.count() != 0;
+                const bool shrink_latency = config_.hasQueueLatency() && config_.worker_idle_timeout_.count() != 0;
+                TimePointT busy_time      = ClockT::now(); //last time a job waited at least worker_shrink_latency_
 
                 while (pop(job)) {
-                    _job_handler_fnc(job, std::forward<Args>(_args)...);
+                    if (config_.hasQueueLatency() && doRecordQueueLatency(job) >= static_cast<uint64_t>(config_.worker_shrink_latency_.count())) {
+                        busy_time = ClockT::now();
+                    }
+                    _job_handler_fnc(job.job_, std::forward<Args>(_args)...);
                     solid_statistic_inc(job_count);
+                    if (count_jobs) {
+                        done_job_cnt_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    if (shrink_latency && (ClockT::now() - busy_time) >= config_.worker_idle_timeout_) {
+                        //jobs do not wait for workers - there are more workers than needed
+                        if (doTryRetireBusyWorker()) {
+                            solid_statistic_inc(statistic_.latency_retire_count_);
+                            break;
+                        }
+                        busy_time = ClockT::now();
+                    }
                 }
 
                 solid_dbg(workpool_logger, Verbose, this << " worker exited after handling " << job_count << " jobs");
@@ -345,11 +664,16 @@ void WorkPool<Job, QNBits>::doStart(
         {
             std::unique_lock<std::mutex> lock(thr_mtx_);
 
+            start_time_ = spawn_time_ = ClockT::now();
+
             for (size_t i = 0; i < _start_wkr_cnt; ++i) {
                 thr_vec_.emplace_back(worker_factory_fnc_());
                 solid_statistic_max(statistic_.max_worker_count_, thr_vec_.size());
             }
             thr_cnt_ += _start_wkr_cnt;
+#ifdef SOLID_HAS_STATISTICS
+            statistic_.sampleWorkerCount(0, thr_cnt_.load());
+#endif
         }
     }
 }
@@ -7,9 +7,16 @@
 #include "solid/frame/mprpc/mprpcconfiguration.hpp"
 #include "solid/frame/mprpc/mprpcservice.hpp"
 
+#include "solid/utility/string.hpp"
+
 #include "mprpc_echo_messages.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 using namespace solid;
 using namespace std;
@@ -22,10 +29,12 @@ using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
 struct Parameters {
     Parameters()
         : port("3333")
+        , busy_poll_usec(0)
     {
     }
 
     string port;
+    size_t busy_poll_usec;
 };
 
 //-----------------------------------------------------------------------------
@@ -55,6 +64,50 @@ struct MessageSetup {
     }
 };
 
+//round-trip times of _count requests sent one after the other
+void ping(frame::mprpc::ServiceT& _ripcservice, const string& _recipient, const size_t _count)
+{
+    vector<uint64_t> rtt_vec; //microseconds
+
+    rtt_vec.reserve(_count);
+
+    for (size_t i = 0; i <= _count; ++i) {
+        promise<ErrorConditionT> prom;
+        const auto               start_time = chrono::steady_clock::now();
+        ErrorConditionT          err        = _ripcservice.sendRequest(
+            _recipient.c_str(), make_shared<ipc_echo::Message>("ping"),
+            [&prom](
+                frame::mprpc::ConnectionContext& /*_rctx*/,
+                std::shared_ptr<ipc_echo::Message>& /*_rsent_msg_ptr*/,
+                std::shared_ptr<ipc_echo::Message>& /*_rrecv_msg_ptr*/,
+                ErrorConditionT const& _rerror) {
+                prom.set_value(_rerror);
+            });
+
+        if (!err) {
+            err = prom.get_future().get();
+        }
+        if (err) {
+            cout << "Error sending ping to " << _recipient << ". Error: " << err.message() << endl;
+            return;
+        }
+        if (i != 0) { //the first request also pays for the connection setup
+            rtt_vec.push_back(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time).count());
+        }
+    }
+
+    if (rtt_vec.empty()) {
+        return;
+    }
+
+    sort(rtt_vec.begin(), rtt_vec.end());
+
+    cout << "ping " << _recipient << " count = " << rtt_vec.size()
+         << " p50 = " << rtt_vec[rtt_vec.size() / 2] << "us"
+         << " p99 = " << rtt_vec[(rtt_vec.size() * 99) / 100] << "us"
+         << " max = " << rtt_vec.back() << "us" << endl;
+}
+
 } // namespace ipc_echo_client
 
 //-----------------------------------------------------------------------------
@@ -81,7 +134,13 @@ int main(int argc, char* argv[])
         frame::aio::Resolver   resolver(cwp);
         ErrorConditionT        err;
 
-        scheduler.start(1);
+        if (p.busy_poll_usec != 0) {
+            frame::aio::BusyPollConfiguration busy_poll_cfg;
+            busy_poll_cfg.budget = chrono::microseconds(p.busy_poll_usec);
+            scheduler.start([busy_poll_cfg]() { return frame::aio::Reactor::configureBusyPoll(busy_poll_cfg); }, []() {}, 1);
+        } else {
+            scheduler.start(1);
+        }
 
         {
             auto                        proto = ipc_echo::ProtocolT::create();
@@ -103,6 +162,15 @@ int main(int argc, char* argv[])
             if (line == "q" || line == "Q" || line == "quit") {
                 break;
             }
+            if (line.compare(0, 5, "ping ") == 0) {
+                istringstream iss(line.substr(5));
+                string        recipient;
+                size_t        count = 1000;
+
+                iss >> recipient >> count;
+                ipc_echo_client::ping(ipcservice, recipient, count);
+                continue;
+            }
             {
                 string recipient;
                 size_t offset = line.find(' ');
@@ -123,8 +191,11 @@ int main(int argc, char* argv[])
 
 bool parseArguments(Parameters& _par, int argc, char* argv[])
 {
-    if (argc == 2) {
+    if (argc >= 2) {
         _par.port = argv[1];
     }
+    if (argc >= 3) {
+        _par.busy_poll_usec = make_number(argv[2]);
+    }
     return true;
 }
@@ -7,8 +7,11 @@
 #include "solid/frame/mprpc/mprpcconfiguration.hpp"
 #include "solid/frame/mprpc/mprpcservice.hpp"
 
+#include "solid/utility/string.hpp"
+
 #include "mprpc_echo_messages.hpp"
 
+#include <chrono>
 #include <iostream>
 
 using namespace solid;
@@ -23,11 +26,13 @@ struct Parameters {
     Parameters()
         : listener_port("0")
         , listener_addr("0.0.0.0")
+        , busy_poll_usec(0)
     {
     }
 
     string listener_port;
     string listener_addr;
+    size_t busy_poll_usec;
 };
 
 //-----------------------------------------------------------------------------
@@ -84,7 +89,13 @@ int main(int argc, char* argv[])
         frame::mprpc::ServiceT ipcservice(manager);
         ErrorConditionT        err;
 
-        scheduler.start(1);
+        if (p.busy_poll_usec != 0) {
+            frame::aio::BusyPollConfiguration busy_poll_cfg;
+            busy_poll_cfg.budget = chrono::microseconds(p.busy_poll_usec);
+            scheduler.start([busy_poll_cfg]() { return frame::aio::Reactor::configureBusyPoll(busy_poll_cfg); }, []() {}, 1);
+        } else {
+            scheduler.start(1);
+        }
 
         {
             auto                        proto = ipc_echo::ProtocolT::create();
@@ -117,7 +128,10 @@ int main(int argc, char* argv[])
 
 bool parseArguments(Parameters& _par, int argc, char* argv[])
 {
-    if (argc == 2) {
+    if (argc >= 3) {
+        _par.busy_poll_usec = make_number(argv[2]);
+    }
+    if (argc >= 2) {
         size_t pos;
 
         _par.listener_addr = argv[1];